@@ -0,0 +1,528 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AsyncFileHandle.h"
+
+DECLARE_CYCLE_STAT(TEXT("Async file read"), STAT_AsyncFileRead, STATGROUP_AsyncIO);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Async file reads"), STAT_AsyncFileReads, STATGROUP_AsyncIO);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Async file reads merged"), STAT_AsyncFileReadsMerged, STATGROUP_AsyncIO);
+
+static int32 GAsyncReadThreads = 4;
+static FAutoConsoleVariableRef CVarAsyncReadThreads(
+	TEXT("s.AsyncReadThreads"),
+	GAsyncReadThreads,
+	TEXT("Number of IO threads serving async file reads. Read when the first async read is requested.\n") \
+	TEXT("0 serves the reads on the requesting thread."),
+	ECVF_Default
+	);
+
+static int32 GAsyncReadMaxBatchKB = 1024;
+static FAutoConsoleVariableRef CVarAsyncReadMaxBatchKB(
+	TEXT("s.AsyncReadMaxBatchKB"),
+	GAsyncReadMaxBatchKB,
+	TEXT("Largest span in KB that queued async reads of one file are merged into."),
+	ECVF_Default
+	);
+
+static int32 GAsyncReadMaxGapKB = 64;
+static FAutoConsoleVariableRef CVarAsyncReadMaxGapKB(
+	TEXT("s.AsyncReadMaxGapKB"),
+	GAsyncReadMaxGapKB,
+	TEXT("Largest gap in KB between async reads of one file that are merged, the bytes in between are read and thrown away."),
+	ECVF_Default
+	);
+
+
+IAsyncReadRequest::~IAsyncReadRequest()
+{
+	check(PollCompletion());
+	if (Memory && !bUserSuppliedMemory)
+	{
+		FMemory::Free(Memory);
+	}
+}
+
+
+/**
+ * Request of a FQueuedAsyncReadFileHandle, queued in FAsyncReadScheduler until an IO thread reads it.
+ */
+class FQueuedAsyncReadRequest : public IAsyncReadRequest
+{
+public:
+	FQueuedAsyncReadRequest(FQueuedAsyncReadFileHandle* InOwner, FAsyncFileCallBack* InCallback, bool bInSizeRequest, uint8* InUserSuppliedMemory, int64 InOffset, int64 InBytesToRead, EAsyncIOPriority InPriority)
+		: IAsyncReadRequest(InCallback, bInSizeRequest, InUserSuppliedMemory)
+		, Owner(InOwner)
+		, Offset(InOffset)
+		, BytesToRead(InBytesToRead)
+		, Priority(InPriority)
+		, SequenceNumber(0)
+		, DoneEvent(FPlatformProcess::GetSynchEventFromPool(true))
+	{
+		Owner->NumRequests.Increment();
+	}
+
+	virtual ~FQueuedAsyncReadRequest()
+	{
+		FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+		Owner->NumRequests.Decrement();
+	}
+
+	FORCEINLINE bool IsSizeRequest() const
+	{
+		return bSizeRequest;
+	}
+
+	FORCEINLINE bool IsCanceled() const
+	{
+		return bCanceled;
+	}
+
+	/** Returns the memory to read into, allocating it if the caller didn't supply any. */
+	uint8* GetDestination()
+	{
+		if (!Memory)
+		{
+			Memory = (uint8*)FMemory::Malloc(BytesToRead);
+		}
+		return Memory;
+	}
+
+	FORCEINLINE void SetSizeResult(int64 InSize)
+	{
+		Size = InSize;
+	}
+
+	/** Completes the request once it is no longer queued. Failed and cancelled requests have no results. */
+	void Complete(bool bSucceeded)
+	{
+		if (!bSucceeded || bCanceled)
+		{
+			Size = -1;
+			if (Memory && !bUserSuppliedMemory)
+			{
+				FMemory::Free(Memory);
+			}
+			Memory = nullptr;
+		}
+
+		// Waiters spin on PollCompletion after the event, the request may be deleted as soon as SetComplete marks it complete.
+		DoneEvent->Trigger();
+		SetComplete();
+	}
+
+	/** Completes a request that was never read as cancelled. */
+	void CompleteCanceled()
+	{
+		bCanceled = true;
+		Complete(false);
+	}
+
+	/** Handle the request was made on. */
+	FQueuedAsyncReadFileHandle* const Owner;
+	/** Offset of the first byte to read. */
+	const int64 Offset;
+	/** Number of bytes to read. */
+	const int64 BytesToRead;
+	/** Priority of the request. */
+	const EAsyncIOPriority Priority;
+	/** Order the request was queued in, older requests of the same priority are read first. */
+	uint64 SequenceNumber;
+
+protected:
+	virtual void WaitCompletionImpl(float TimeLimitSeconds) override
+	{
+		const uint32 WaitTime = TimeLimitSeconds > 0.0f ? FMath::Max<uint32>((uint32)(TimeLimitSeconds * 1000.0f), 1) : MAX_uint32;
+		if (DoneEvent->Wait(WaitTime))
+		{
+			// The callback may still be running.
+			while (!PollCompletion())
+			{
+				FPlatformProcess::Sleep(0.0f);
+			}
+		}
+	}
+
+	virtual void CancelImpl() override;
+
+private:
+	/** Triggered right before the request completes. */
+	FEvent* DoneEvent;
+};
+
+
+/**
+ * Queue of async read requests shared by all FQueuedAsyncReadFileHandles, serviced by a pool of IO threads.
+ * The IO threads run until Shutdown, after which requests are read on the thread that makes them.
+ */
+class FAsyncReadScheduler : public FRunnable
+{
+public:
+	static FAsyncReadScheduler& Get()
+	{
+		static FAsyncReadScheduler* Scheduler = new FAsyncReadScheduler();
+		return *Scheduler;
+	}
+
+	/** True once Get has created the scheduler. */
+	static bool IsCreated()
+	{
+		return bCreated;
+	}
+
+	/** Queues a request, or reads it right away if there are no IO threads. */
+	void Enqueue(FQueuedAsyncReadRequest* Request)
+	{
+		INC_DWORD_STAT(STAT_AsyncFileReads);
+		if (Threads.Num() == 0)
+		{
+			TArray<FQueuedAsyncReadRequest*> Batch;
+			Batch.Add(Request);
+			ExecuteBatch(Batch);
+			return;
+		}
+
+		{
+			FScopeLock ScopeLock(&QueueCritical);
+			Request->SequenceNumber = NextSequenceNumber++;
+			Queue.Add(Request);
+		}
+		WorkEvent->Trigger();
+	}
+
+	/**
+	 * Removes a request from the queue.
+	 *
+	 * @return true if the request was queued, false if an IO thread is reading it or it is complete.
+	 */
+	bool Dequeue(FQueuedAsyncReadRequest* Request)
+	{
+		FScopeLock ScopeLock(&QueueCritical);
+		return Queue.RemoveSingleSwap(Request) > 0;
+	}
+
+	virtual uint32 Run() override
+	{
+		TArray<FQueuedAsyncReadRequest*> Batch;
+		while (StopTaskCounter.GetValue() == 0)
+		{
+			Batch.Reset();
+			if (PopBatch(Batch))
+			{
+				ExecuteBatch(Batch);
+			}
+			else
+			{
+				WorkEvent->Wait(100);
+			}
+		}
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		StopTaskCounter.Increment();
+		WorkEvent->Trigger();
+	}
+
+	/** Stops and deletes the IO threads, then reads whatever is still queued on the calling thread so no request is left waiting. */
+	void Shutdown()
+	{
+		if (Threads.Num() == 0)
+		{
+			return;
+		}
+
+		Stop();
+		for (FRunnableThread* Thread : Threads)
+		{
+			Thread->Kill(true);
+			delete Thread;
+		}
+		Threads.Empty();
+
+		TArray<FQueuedAsyncReadRequest*> Batch;
+		for (;;)
+		{
+			Batch.Reset();
+			if (!PopBatch(Batch))
+			{
+				break;
+			}
+			ExecuteBatch(Batch);
+		}
+
+		FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+		WorkEvent = nullptr;
+	}
+
+private:
+	FAsyncReadScheduler()
+		: NextSequenceNumber(0)
+		, WorkEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	{
+		const int32 NumThreads = FPlatformProcess::SupportsMultithreading() ? FMath::Clamp(GAsyncReadThreads, 0, 32) : 0;
+		for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+		{
+			Threads.Add(FRunnableThread::Create(this, *FString::Printf(TEXT("AsyncReadThread %d"), ThreadIndex), 0, TPri_AboveNormal));
+		}
+		bCreated = true;
+	}
+
+	/**
+	 * Takes the highest priority request off the queue, together with queued reads of the same handle that can be read along with it.
+	 *
+	 * @return false if the queue was empty.
+	 */
+	bool PopBatch(TArray<FQueuedAsyncReadRequest*>& Batch)
+	{
+		bool bMoreWork = false;
+		{
+			FScopeLock ScopeLock(&QueueCritical);
+			if (Queue.Num() == 0)
+			{
+				return false;
+			}
+
+			// Highest priority first, oldest first within a priority. The queue is short enough that a linear scan is cheaper than keeping it sorted.
+			int32 BestIndex = 0;
+			for (int32 Index = 1; Index < Queue.Num(); ++Index)
+			{
+				const FQueuedAsyncReadRequest* Request = Queue[Index];
+				const FQueuedAsyncReadRequest* Best = Queue[BestIndex];
+				if (Request->Priority > Best->Priority || (Request->Priority == Best->Priority && Request->SequenceNumber < Best->SequenceNumber))
+				{
+					BestIndex = Index;
+				}
+			}
+			FQueuedAsyncReadRequest* Primary = Queue[BestIndex];
+			Queue.RemoveAtSwap(BestIndex, 1, false);
+			Batch.Add(Primary);
+
+			if (!Primary->IsSizeRequest())
+			{
+				const int64 MaxBatchSize = (int64)FMath::Max(GAsyncReadMaxBatchKB, 0) * 1024;
+				const int64 MaxGap = (int64)FMath::Max(GAsyncReadMaxGapKB, 0) * 1024;
+				int64 Start = Primary->Offset;
+				int64 End = Primary->Offset + Primary->BytesToRead;
+
+				// Grow the span by every queued read of the same handle that is close enough, until nothing else fits.
+				bool bGrew = true;
+				while (bGrew)
+				{
+					bGrew = false;
+					for (int32 Index = 0; Index < Queue.Num(); ++Index)
+					{
+						FQueuedAsyncReadRequest* Request = Queue[Index];
+						if (Request->Owner != Primary->Owner || Request->IsSizeRequest())
+						{
+							continue;
+						}
+						const int64 RequestEnd = Request->Offset + Request->BytesToRead;
+						if (Request->Offset > End + MaxGap || RequestEnd + MaxGap < Start)
+						{
+							continue;
+						}
+						const int64 NewStart = FMath::Min(Start, Request->Offset);
+						const int64 NewEnd = FMath::Max(End, RequestEnd);
+						if (NewEnd - NewStart > MaxBatchSize)
+						{
+							continue;
+						}
+						Start = NewStart;
+						End = NewEnd;
+						Batch.Add(Request);
+						Queue.RemoveAtSwap(Index--, 1, false);
+						bGrew = true;
+					}
+				}
+			}
+			bMoreWork = Queue.Num() > 0;
+		}
+
+		// Wake another IO thread for the rest of the queue.
+		if (bMoreWork && WorkEvent)
+		{
+			WorkEvent->Trigger();
+		}
+		return true;
+	}
+
+	/** Reads and completes a batch from PopBatch. */
+	void ExecuteBatch(TArray<FQueuedAsyncReadRequest*>& Batch)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AsyncFileRead);
+
+		FQueuedAsyncReadRequest* Primary = Batch[0];
+		FQueuedAsyncReadFileHandle* Owner = Primary->Owner;
+		if (Primary->IsSizeRequest())
+		{
+			Primary->SetSizeResult(Primary->IsCanceled() ? -1 : Owner->GetSize());
+			Primary->Complete(true);
+		}
+		else if (Batch.Num() == 1)
+		{
+			const bool bSucceeded = !Primary->IsCanceled() && Owner->ReadAt(Primary->GetDestination(), Primary->Offset, Primary->BytesToRead);
+			Primary->Complete(bSucceeded);
+		}
+		else
+		{
+			INC_DWORD_STAT_BY(STAT_AsyncFileReadsMerged, Batch.Num() - 1);
+
+			int64 Start = MAX_int64;
+			int64 End = 0;
+			for (FQueuedAsyncReadRequest* Request : Batch)
+			{
+				Start = FMath::Min(Start, Request->Offset);
+				End = FMath::Max(End, Request->Offset + Request->BytesToRead);
+			}
+
+			uint8* Span = (uint8*)FMemory::Malloc(End - Start);
+			const bool bSpanSucceeded = Owner->ReadAt(Span, Start, End - Start);
+			for (FQueuedAsyncReadRequest* Request : Batch)
+			{
+				bool bSucceeded = !Request->IsCanceled();
+				if (bSucceeded && bSpanSucceeded)
+				{
+					FMemory::Memcpy(Request->GetDestination(), Span + (Request->Offset - Start), Request->BytesToRead);
+				}
+				else if (bSucceeded)
+				{
+					// A single bad request, e.g. one past the end of the file, fails the whole span, so each request is retried on its own.
+					bSucceeded = Owner->ReadAt(Request->GetDestination(), Request->Offset, Request->BytesToRead);
+				}
+				Request->Complete(bSucceeded);
+			}
+			FMemory::Free(Span);
+		}
+	}
+
+	/** Queued requests, guarded by QueueCritical. */
+	TArray<FQueuedAsyncReadRequest*> Queue;
+	/** Guards Queue and NextSequenceNumber. */
+	FCriticalSection QueueCritical;
+	/** Sequence number of the next queued request. */
+	uint64 NextSequenceNumber;
+	/** Wakes an IO thread when requests are queued. */
+	FEvent* WorkEvent;
+	/** The IO threads. */
+	TArray<FRunnableThread*> Threads;
+	/** Non-zero once the IO threads should exit. */
+	FThreadSafeCounter StopTaskCounter;
+	/** Set by the constructor, so shutdown doesn't start threads just to stop them. */
+	static bool bCreated;
+};
+
+bool FAsyncReadScheduler::bCreated = false;
+
+
+void FQueuedAsyncReadFileHandle::ShutdownIOThreads()
+{
+	if (FAsyncReadScheduler::IsCreated())
+	{
+		FAsyncReadScheduler::Get().Shutdown();
+	}
+}
+
+
+void FQueuedAsyncReadRequest::CancelImpl()
+{
+	// Requests that are being read complete when their read finishes.
+	if (FAsyncReadScheduler::Get().Dequeue(this))
+	{
+		CompleteCanceled();
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+	FQueuedAsyncReadFileHandle.
+-----------------------------------------------------------------------------*/
+
+FQueuedAsyncReadFileHandle::~FQueuedAsyncReadFileHandle()
+{
+	checkf(NumRequests.GetValue() == 0, TEXT("Async read handle deleted with %d requests that haven't been deleted"), NumRequests.GetValue());
+}
+
+IAsyncReadRequest* FQueuedAsyncReadFileHandle::SizeRequest(FAsyncFileCallBack* CompleteCallback)
+{
+	FQueuedAsyncReadRequest* Request = new FQueuedAsyncReadRequest(this, CompleteCallback, true, nullptr, 0, 0, AIOP_High);
+	FAsyncReadScheduler::Get().Enqueue(Request);
+	return Request;
+}
+
+IAsyncReadRequest* FQueuedAsyncReadFileHandle::ReadRequest(int64 Offset, int64 BytesToRead, EAsyncIOPriority Priority, FAsyncFileCallBack* CompleteCallback, uint8* UserSuppliedMemory)
+{
+	check(Offset >= 0 && BytesToRead > 0);
+	FQueuedAsyncReadRequest* Request = new FQueuedAsyncReadRequest(this, CompleteCallback, false, UserSuppliedMemory, Offset, BytesToRead, Priority);
+	FAsyncReadScheduler::Get().Enqueue(Request);
+	return Request;
+}
+
+
+/*-----------------------------------------------------------------------------
+	FGenericAsyncReadFileHandle.
+-----------------------------------------------------------------------------*/
+
+FGenericAsyncReadFileHandle::FGenericAsyncReadFileHandle(IPlatformFile* InPlatformFile, const TCHAR* InFilename, int64 InBaseOffset, int64 InSize)
+	: PlatformFile(InPlatformFile)
+	, Filename(InFilename)
+	, BaseOffset(InBaseOffset)
+	, Size(InSize)
+{
+	check(PlatformFile);
+}
+
+FGenericAsyncReadFileHandle::~FGenericAsyncReadFileHandle()
+{
+	for (IFileHandle* Handle : FreeHandles)
+	{
+		delete Handle;
+	}
+}
+
+int64 FGenericAsyncReadFileHandle::GetSize()
+{
+	FScopeLock ScopeLock(&Lock);
+	if (Size < 0)
+	{
+		const int64 FileSize = PlatformFile->FileSize(*Filename);
+		if (FileSize >= 0)
+		{
+			Size = FMath::Max<int64>(FileSize - BaseOffset, 0);
+		}
+	}
+	return Size;
+}
+
+bool FGenericAsyncReadFileHandle::ReadAt(uint8* Destination, int64 Offset, int64 BytesToRead)
+{
+	// Never read past the end of a range.
+	const int64 RangeSize = GetSize();
+	if (RangeSize >= 0 && Offset + BytesToRead > RangeSize)
+	{
+		return false;
+	}
+
+	IFileHandle* Handle = nullptr;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (FreeHandles.Num() > 0)
+		{
+			Handle = FreeHandles.Pop(false);
+		}
+	}
+	if (!Handle)
+	{
+		Handle = PlatformFile->OpenRead(*Filename);
+		if (!Handle)
+		{
+			return false;
+		}
+	}
+
+	const bool bSucceeded = Handle->Seek(BaseOffset + Offset) && Handle->Read(Destination, BytesToRead);
+
+	FScopeLock ScopeLock(&Lock);
+	FreeHandles.Add(Handle);
+	return bSucceeded;
+}
@@ -11,6 +11,27 @@ DEFINE_STAT(STAT_FTriggerEventGraphTask);
 DEFINE_STAT(STAT_ParallelFor);
 DEFINE_STAT(STAT_ParallelForTask);
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Work Stealing Local Pops"), STAT_TaskGraph_WorkStealingLocalPops, STATGROUP_Threading);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Work Stealing Shared Pops"), STAT_TaskGraph_WorkStealingSharedPops, STATGROUP_Threading);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Work Stealing Steals"), STAT_TaskGraph_WorkStealingSteals, STATGROUP_Threading);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Work Stealing Failed Steal Passes"), STAT_TaskGraph_WorkStealingFailedSteals, STATGROUP_Threading);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Work Stealing Idle Waits"), STAT_TaskGraph_WorkStealingIdleWaits, STATGROUP_Threading);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Work Stealing Idle Time (us)"), STAT_TaskGraph_WorkStealingIdleMicroseconds, STATGROUP_Threading);
+
+#if STATS
+/**
+ *	Registers a dword counter stat in STATGROUP_Threading at runtime, for the per worker work stealing counters.
+ *	The number of workers is only known at startup, so these can't be declared with DECLARE_DWORD_COUNTER_STAT.
+ */
+static TStatId CreateWorkStealingCounterStat(const FString& Description)
+{
+	typedef FStatGroup_STATGROUP_Threading FGroup;
+	const FName StatName(*Description);
+	FStartupMessages::Get().AddMetadata(StatName, *Description, FGroup::GetGroupName(), FGroup::GetGroupCategory(), FGroup::GetDescription(), true, EStatDataType::ST_int64, false);
+	return IStatGroupEnableManager::Get().GetHighPerformanceEnableForStat(StatName, FGroup::GetGroupName(), FGroup::GetGroupCategory(), FGroup::DefaultEnable, true, EStatDataType::ST_int64, *Description, false);
+}
+#endif
+
 namespace ENamedThreads
 {
 	CORE_API Type RenderThread = ENamedThreads::GameThread; // defaults to game and is set and reset by the render thread itself
@@ -198,6 +219,12 @@ static FAutoConsoleVariableRef CVarNumWorkerThreadsToIgnore(
 	ECVF_Cheat
 	);
 
+/** 
+ *	If set on the command line (-TaskGraphWorkStealing), anythread tasks use per-worker deques with work stealing instead of the shared incoming queues.
+ *	This is latched when the task graph starts; tasks sitting in a worker deque could not be migrated if it changed later.
+**/
+static bool GTaskGraphWorkStealing = false;
+
 static int32 GFastScheduler = 0;
 #if USE_NEW_LOCK_FREE_LISTS
 static int32 GFastSchedulerLatched = 1;
@@ -333,6 +360,112 @@ private:
 
 };
 
+/** 
+ *	FWorkStealingTaskDeque
+ *	Bounded, lock free Chase-Lev deque of tasks owned by a single worker thread.
+ *	The owner pushes and pops at the bottom (LIFO, keeping children hot in cache); any other thread may steal from the top (FIFO).
+**/
+class FWorkStealingTaskDeque
+{
+public:
+	FWorkStealingTaskDeque()
+		: Top(0)
+		, Bottom(0)
+	{
+		FMemory::Memzero((void*)Tasks, sizeof(Tasks));
+	}
+
+	/** 
+	 *	Pushes a task at the bottom. Must only be called from the owning thread.
+	 *	@return false if the deque is full, in which case the caller must queue the task somewhere else.
+	**/
+	bool Push(FBaseGraphTask* Task)
+	{
+		const int64 LocalBottom = Bottom;
+		if (LocalBottom - Top >= CAPACITY)
+		{
+			return false;
+		}
+		Tasks[LocalBottom & (CAPACITY - 1)] = Task;
+		// the task must be visible to thieves before the new bottom is
+		FPlatformMisc::MemoryBarrier();
+		Bottom = LocalBottom + 1;
+		return true;
+	}
+
+	/** 
+	 *	Pops the most recently pushed task. Must only be called from the owning thread.
+	 *	@return The task or nullptr if the deque is empty or the last task was stolen concurrently.
+	**/
+	FBaseGraphTask* Pop()
+	{
+		const int64 LocalBottom = Bottom - 1;
+		Bottom = LocalBottom;
+		// the reservation of the bottom slot must be visible before we look at the top
+		FPlatformMisc::MemoryBarrier();
+		const int64 LocalTop = Top;
+		if (LocalTop > LocalBottom)
+		{
+			Bottom = LocalTop;
+			return nullptr;
+		}
+		FBaseGraphTask* Task = Tasks[LocalBottom & (CAPACITY - 1)];
+		if (LocalTop == LocalBottom)
+		{
+			// last task, we race any thieves for it
+			if (FPlatformAtomics::InterlockedCompareExchange(&Top, LocalTop + 1, LocalTop) != LocalTop)
+			{
+				Task = nullptr;
+			}
+			Bottom = LocalTop + 1;
+		}
+		return Task;
+	}
+
+	/** 
+	 *	Steals the oldest task. Can be called from any thread.
+	 *	@return The task or nullptr if the deque is empty or we lost a race for the task.
+	**/
+	FBaseGraphTask* Steal()
+	{
+		const int64 LocalTop = Top;
+		FPlatformMisc::MemoryBarrier();
+		const int64 LocalBottom = Bottom;
+		if (LocalTop >= LocalBottom)
+		{
+			return nullptr;
+		}
+		FBaseGraphTask* Task = Tasks[LocalTop & (CAPACITY - 1)];
+		if (FPlatformAtomics::InterlockedCompareExchange(&Top, LocalTop + 1, LocalTop) != LocalTop)
+		{
+			return nullptr;
+		}
+		return Task;
+	}
+
+	/** Best guess whether the deque is empty, only meant as a hint. **/
+	FORCEINLINE bool IsEmptyFast() const
+	{
+		return Bottom <= Top;
+	}
+
+private:
+	enum
+	{
+		/** Max number of tasks a worker keeps locally, must be a power of two. Overflow goes to the shared queue. **/
+		CAPACITY = 1024
+	};
+
+	/** Index of the oldest task, advanced by thieves and by the owner when it takes the last task. **/
+	volatile int64 Top;
+	uint8 PadToAvoidContention0[PLATFORM_CACHE_LINE_SIZE - sizeof(int64)];
+	/** Index one past the newest task, only written by the owner. **/
+	volatile int64 Bottom;
+	uint8 PadToAvoidContention1[PLATFORM_CACHE_LINE_SIZE - sizeof(int64)];
+	/** Ring buffer of tasks. **/
+	FBaseGraphTask* volatile Tasks[CAPACITY];
+};
+
 /** 
  *	FTaskThreadBase
  *	Base class for a thread that executes tasks
@@ -465,7 +598,10 @@ public:
 	 */
 	virtual uint32 Run() override
 	{
+		// Worker threads allocate heavily from tasks, so let them use the allocator's per-thread caches.
+		FMemory::SetupTLSCachesOnCurrentThread();
 		ProcessTasksUntilQuit(0);
+		FMemory::ClearAndDisableTLSCachesOnCurrentThread();
 		return 0;
 	}
 
@@ -1033,6 +1169,64 @@ public:
 		return !!Queue.RecursionGuard;
 	}
 
+	// Work stealing API, only used with -TaskGraphWorkStealing
+
+	/** Per worker counters, written by the owning thread only. **/
+	struct FWorkStealingCounters
+	{
+		uint32 LocalPops;
+		uint32 SharedPops;
+		uint32 Steals;
+		uint32 FailedSteals;
+		uint32 IdleWaits;
+		uint64 IdleCycles;
+
+		FWorkStealingCounters()
+		{
+			FMemory::Memzero(*this);
+		}
+	};
+
+	/** Queues a task spawned by this thread on its own deque. Must be called from this thread. @return false if the deque is full. **/
+	FORCEINLINE bool PushLocalTask(FBaseGraphTask* Task)
+	{
+		return LocalTasks.Push(Task);
+	}
+
+	/** Pops the newest task from this thread's deque. Must be called from this thread. **/
+	FORCEINLINE FBaseGraphTask* PopLocalTask()
+	{
+		return LocalTasks.Pop();
+	}
+
+	/** Steals the oldest task from this thread's deque. Called from other workers. **/
+	FORCEINLINE FBaseGraphTask* StealTask()
+	{
+		return LocalTasks.IsEmptyFast() ? nullptr : LocalTasks.Steal();
+	}
+
+	/** Counters since startup, read without synchronization for reporting. **/
+	FWorkStealingCounters& GetWorkStealingCounters()
+	{
+		return TotalCounters;
+	}
+
+	/** Counters since the last flush to the stats system. **/
+	FWorkStealingCounters& GetPendingWorkStealingCounters()
+	{
+		return PendingCounters;
+	}
+
+	/** Registers the per worker stats of this thread. Called once at startup, before the thread runs. **/
+	void CreateWorkStealingStats(int32 WorkerIndex)
+	{
+#if STATS
+		StealsStatId = CreateWorkStealingCounterStat(FString::Printf(TEXT("Work Stealing Steals (Worker %d)"), WorkerIndex));
+		IdleWaitsStatId = CreateWorkStealingCounterStat(FString::Printf(TEXT("Work Stealing Idle Waits (Worker %d)"), WorkerIndex));
+		IdleMicrosecondsStatId = CreateWorkStealingCounterStat(FString::Printf(TEXT("Work Stealing Idle Time (us) (Worker %d)"), WorkerIndex));
+#endif
+	}
+
 private:
 
 	/** 
@@ -1069,7 +1263,21 @@ private:
 					bTasksOpen = false;
 				}
 #endif
-				Stall(StallStatId, bCountAsStall);
+				if (GTaskGraphWorkStealing)
+				{
+					FlushWorkStealingStats();
+					const uint32 StallStartCycles = FPlatformTime::Cycles();
+					Stall(StallStatId, bCountAsStall);
+					const uint32 IdleCycles = FPlatformTime::Cycles() - StallStartCycles;
+					TotalCounters.IdleWaits++;
+					TotalCounters.IdleCycles += IdleCycles;
+					PendingCounters.IdleWaits++;
+					PendingCounters.IdleCycles += IdleCycles;
+				}
+				else
+				{
+					Stall(StallStatId, bCountAsStall);
+				}
 				if (Queue.QuitWhenIdle.GetValue())
 				{
 					break;
@@ -1153,8 +1361,40 @@ private:
 	 */
 	void NotifyStalling();
 
+	/** Publishes the work stealing counters gathered since the last call to the stats system, from this thread. **/
+	void FlushWorkStealingStats()
+	{
+		INC_DWORD_STAT_BY(STAT_TaskGraph_WorkStealingLocalPops, PendingCounters.LocalPops);
+		INC_DWORD_STAT_BY(STAT_TaskGraph_WorkStealingSharedPops, PendingCounters.SharedPops);
+		INC_DWORD_STAT_BY(STAT_TaskGraph_WorkStealingSteals, PendingCounters.Steals);
+		INC_DWORD_STAT_BY(STAT_TaskGraph_WorkStealingFailedSteals, PendingCounters.FailedSteals);
+		INC_DWORD_STAT_BY(STAT_TaskGraph_WorkStealingIdleWaits, PendingCounters.IdleWaits);
+#if STATS
+		const uint32 IdleMicroseconds = uint32(double(PendingCounters.IdleCycles) * FPlatformTime::GetSecondsPerCycle() * 1000000.0);
+		INC_DWORD_STAT_BY(STAT_TaskGraph_WorkStealingIdleMicroseconds, IdleMicroseconds);
+		INC_DWORD_STAT_BY_FName(StealsStatId.GetName(), PendingCounters.Steals);
+		INC_DWORD_STAT_BY_FName(IdleWaitsStatId.GetName(), PendingCounters.IdleWaits);
+		INC_DWORD_STAT_BY_FName(IdleMicrosecondsStatId.GetName(), IdleMicroseconds);
+#endif
+		PendingCounters = FWorkStealingCounters();
+	}
+
 	/** Array of queues, only the first one is used for unnamed threads. **/
 	FThreadTaskQueue Queue;
+
+	/** Tasks spawned by tasks running on this thread, only used with work stealing. **/
+	FWorkStealingTaskDeque LocalTasks;
+
+	/** Work stealing counters since startup and since the last stats flush. **/
+	FWorkStealingCounters TotalCounters;
+	FWorkStealingCounters PendingCounters;
+
+#if STATS
+	/** Per worker stats, the totals over all workers use the statically declared STAT_TaskGraph_WorkStealing* stats. **/
+	TStatId StealsStatId;
+	TStatId IdleWaitsStatId;
+	TStatId IdleMicrosecondsStatId;
+#endif
 };
 
 /** 
@@ -1227,6 +1467,11 @@ public:
 		// Cap number of extra threads to the platform worker thread count
 		NumThreads = FMath::Min(NumThreads, NumNamedThreads + FPlatformMisc::NumberOfWorkerThreadsToSpawn());
 		UE_LOG(LogTaskGraph, Log, TEXT("Started task graph with %d named threads and %d total threads."), NumNamedThreads, NumThreads);
+		GTaskGraphWorkStealing = FPlatformProcess::SupportsMultithreading() && FParse::Param(FCommandLine::Get(), TEXT("TaskGraphWorkStealing"));
+		if (GTaskGraphWorkStealing)
+		{
+			UE_LOG(LogTaskGraph, Log, TEXT("Task graph is using per worker deques with work stealing; TaskGraph.FastScheduler is ignored."));
+		}
 		check(NumThreads - NumNamedThreads >= 1);  // need at least one pure worker thread
 		check(NumThreads <= MAX_THREADS);
 		check(!NextStealFromThread.GetValue()); // reentrant?
@@ -1248,6 +1493,10 @@ public:
 				WorkerThreads[ThreadIndex].TaskGraphWorker = new FNamedTaskThread;
 			}
 			WorkerThreads[ThreadIndex].TaskGraphWorker->Setup(ENamedThreads::Type(ThreadIndex), PerThreadIDTLSSlot, &WorkerThreads[ThreadIndex]);
+			if (bAnyTaskThread && GTaskGraphWorkStealing)
+			{
+				static_cast<FTaskThreadAnyThread*>(WorkerThreads[ThreadIndex].TaskGraphWorker)->CreateWorkStealingStats(ThreadIndex - NumNamedThreads);
+			}
 		}
 
 		TaskGraphImplementationSingleton = this; // now reentrancy is ok
@@ -1301,6 +1550,11 @@ public:
 
 		TestRandomizedThreads();
 		checkThreadGraph(NextUnnamedThreadMod);
+		if (GTaskGraphWorkStealing && ENamedThreads::GetThreadIndex(ThreadToExecuteOn) == ENamedThreads::AnyThread)
+		{
+			QueueTaskWorkStealing(Task, InCurrentThreadIfKnown);
+			return;
+		}
 		if (GFastSchedulerLatched != GFastScheduler && IsInGameThread())
 		{
 #if USE_NEW_LOCK_FREE_LISTS
@@ -1560,6 +1814,136 @@ public:
 		TGraphTask<FTriggerEventGraphTask>::CreateTask(&Tasks, CurrentThreadIfKnown).ConstructAndDispatchWhenReady(InEvent);
 	}
 
+	// Work stealing scheduler
+
+	/** 
+	 *	Queues an anythread task when work stealing is enabled.
+	 *	Normal priority tasks queued from a worker stay on that worker's deque, everything else goes to the shared queues.
+	 *	@param	Task; the task to queue
+	 *	@param	InCurrentThreadIfKnown; This should be the current thread if it is known, or otherwise use ENamedThreads::AnyThread and the current thread will be determined.
+	**/
+	void QueueTaskWorkStealing(FBaseGraphTask* Task, ENamedThreads::Type InCurrentThreadIfKnown)
+	{
+		ENamedThreads::Type CurrentThreadIfKnown;
+		if (ENamedThreads::GetThreadIndex(InCurrentThreadIfKnown) == ENamedThreads::AnyThread)
+		{
+			CurrentThreadIfKnown = GetCurrentThread();
+		}
+		else
+		{
+			CurrentThreadIfKnown = ENamedThreads::GetThreadIndex(InCurrentThreadIfKnown);
+			checkThreadGraph(CurrentThreadIfKnown == GetCurrentThread());
+		}
+
+		const bool bHiPri = !!ENamedThreads::GetPriority(Task->ThreadToExecuteOn);
+		const bool bFromWorker = CurrentThreadIfKnown != ENamedThreads::AnyThread && CurrentThreadIfKnown >= NumNamedThreads;
+		if (bHiPri)
+		{
+			WorkStealingTasksHiPri.Push(Task);
+		}
+		else if (!bFromWorker || !AnyThreadWorker(CurrentThreadIfKnown).PushLocalTask(Task))
+		{
+			WorkStealingTasks.Push(Task);
+		}
+
+		// Wake someone to pick up the task (or steal it), the same way the default scheduler does.
+		FTaskThreadBase* TempTarget = StalledUnnamedThreads.Pop();
+		if (TempTarget && GNumWorkerThreadsToIgnore && (TempTarget->GetThreadId() - NumNamedThreads) >= GetNumWorkerThreads())
+		{
+			TempTarget = nullptr;
+		}
+		ENamedThreads::Type ThreadToWake;
+		if (TempTarget)
+		{
+			ThreadToWake = TempTarget->GetThreadId();
+		}
+		else
+		{
+			check(NextUnnamedThreadMod - GNumWorkerThreadsToIgnore > 0); // can't tune it to zero task threads
+			ThreadToWake = ENamedThreads::Type((uint32(NextUnnamedThreadForTaskFromUnknownThread.Increment()) % uint32(NextUnnamedThreadMod - GNumWorkerThreadsToIgnore)) + NumNamedThreads);
+		}
+		if (ThreadToWake != CurrentThreadIfKnown)
+		{
+			Thread(ThreadToWake).WakeUp();
+		}
+	}
+
+	/** 
+	 *	Finds work for a worker when work stealing is enabled: high priority tasks first, then the worker's own deque,
+	 *	then the shared queue and finally the deques of the other workers.
+	 *	@param	ThreadInNeed; Id of the thread requesting work.
+	 *	@return Task to execute, or nullptr if no work was found and the thread should stall.
+	**/
+	FBaseGraphTask* FindWorkStealing(ENamedThreads::Type ThreadInNeed)
+	{
+		FTaskThreadAnyThread& Worker = AnyThreadWorker(ThreadInNeed);
+		FTaskThreadAnyThread::FWorkStealingCounters& Pending = Worker.GetPendingWorkStealingCounters();
+		FTaskThreadAnyThread::FWorkStealingCounters& Total = Worker.GetWorkStealingCounters();
+
+		if (FBaseGraphTask* Task = WorkStealingTasksHiPri.Pop())
+		{
+			Pending.SharedPops++;
+			Total.SharedPops++;
+			return Task;
+		}
+		if (FBaseGraphTask* Task = Worker.PopLocalTask())
+		{
+			Pending.LocalPops++;
+			Total.LocalPops++;
+			return Task;
+		}
+		if (FBaseGraphTask* Task = WorkStealingTasks.Pop())
+		{
+			Pending.SharedPops++;
+			Total.SharedPops++;
+			return Task;
+		}
+
+		// Start at a different victim each time so thieves spread out.
+		const int32 NumWorkers = NumThreads - NumNamedThreads;
+		const int32 FirstVictim = int32(uint32(NextStealFromThread.Increment()) % uint32(NumWorkers));
+		for (int32 Offset = 0; Offset < NumWorkers; Offset++)
+		{
+			const ENamedThreads::Type Victim = ENamedThreads::Type(NumNamedThreads + (FirstVictim + Offset) % NumWorkers);
+			if (Victim == ThreadInNeed)
+			{
+				continue;
+			}
+			if (FBaseGraphTask* Task = AnyThreadWorker(Victim).StealTask())
+			{
+				Pending.Steals++;
+				Total.Steals++;
+				return Task;
+			}
+		}
+		Pending.FailedSteals++;
+		Total.FailedSteals++;
+		return nullptr;
+	}
+
+	/** Logs the work stealing counters of every worker since startup. **/
+	void DumpWorkStealingStats(FOutputDevice& Ar)
+	{
+		if (!GTaskGraphWorkStealing)
+		{
+			Ar.Logf(TEXT("Task graph work stealing is disabled, run with -TaskGraphWorkStealing to enable it."));
+			return;
+		}
+		Ar.Logf(TEXT("Worker  LocalPops SharedPops     Steals FailedSteals  IdleWaits   Idle(ms)"));
+		for (int32 ThreadIndex = NumNamedThreads; ThreadIndex < NumThreads; ThreadIndex++)
+		{
+			const FTaskThreadAnyThread::FWorkStealingCounters& Counters = AnyThreadWorker(ThreadIndex).GetWorkStealingCounters();
+			Ar.Logf(TEXT("%6d %10u %10u %10u %12u %10u %10.2f"),
+				ThreadIndex - NumNamedThreads,
+				Counters.LocalPops,
+				Counters.SharedPops,
+				Counters.Steals,
+				Counters.FailedSteals,
+				Counters.IdleWaits,
+				double(Counters.IdleCycles) * FPlatformTime::GetSecondsPerCycle() * 1000.0);
+		}
+	}
+
 	// Scheduling utilities
 
 	void StartTaskThread(int32 IndexToStart)
@@ -1987,7 +2371,7 @@ public:
 	**/
 	void NotifyStalling(ENamedThreads::Type StallingThread)
 	{
-		if (StallingThread >= NumNamedThreads && !GFastSchedulerLatched)
+		if (StallingThread >= NumNamedThreads && (GTaskGraphWorkStealing || !GFastSchedulerLatched))
 		{
 			StalledUnnamedThreads.Push(&Thread(StallingThread));
 		}
@@ -2020,6 +2404,17 @@ private:
 		return *WorkerThreads[Index].TaskGraphWorker;
 	}
 
+	/** 
+	 *	Internal function to verify an index and return the corresponding unnamed worker thread
+	 *	@param	Index; Id of the worker to retrieve, must not be a named thread.
+	 *	@return	Reference to the corresponding worker.
+	**/
+	FTaskThreadAnyThread& AnyThreadWorker(int32 Index)
+	{
+		checkThreadGraph(Index >= NumNamedThreads);
+		return (FTaskThreadAnyThread&)Thread(Index);
+	}
+
 	/** 
 	 *	Examines the TLS to determine the identity of the current thread.
 	 *	@return	Id of the thread that is this thread or ENamedThreads::AnyThread if this thread is unknown or is a named thread that has not attached yet.
@@ -2084,6 +2479,10 @@ private:
 	FCriticalSection CriticalSectionForSortingIncomingAnyThreadTasks;
 	FCriticalSection CriticalSectionForSortingIncomingAnyThreadTasksHiPri;
 
+	/** Shared queues used with work stealing, for tasks queued from outside the workers and for local deque overflow. **/
+	TLockFreePointerListFIFO<FBaseGraphTask>		WorkStealingTasks;
+	TLockFreePointerListFIFO<FBaseGraphTask>		WorkStealingTasksHiPri;
+
 	// we use a single atomic to control the state of the anythread queues. This limits the maximum number of threads.
 	struct FAtomicStateBitfield
 	{
@@ -2188,6 +2587,10 @@ private:
 
 FBaseGraphTask* FTaskThreadAnyThread::FindWork()
 {
+	if (GTaskGraphWorkStealing)
+	{
+		return FTaskGraphImplementation::Get().FindWorkStealing(ThreadId);
+	}
 	return FTaskGraphImplementation::Get().FindWork(ThreadId);
 }
 
@@ -2196,6 +2599,20 @@ void FTaskThreadAnyThread::NotifyStalling()
 	return FTaskGraphImplementation::Get().NotifyStalling(ThreadId);
 }
 
+static void DumpWorkStealingStats(const TArray<FString>& Args)
+{
+	if (FTaskGraphInterface::IsRunning())
+	{
+		FTaskGraphImplementation::Get().DumpWorkStealingStats(*GLog);
+	}
+}
+
+static FAutoConsoleCommand DumpWorkStealingStatsCommand(
+	TEXT("TaskGraph.DumpWorkStealingStats"),
+	TEXT("Logs per worker local pop, steal and idle counters of the work stealing scheduler (-TaskGraphWorkStealing)."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&DumpWorkStealingStats)
+	);
+
 
 
 // Statics in FTaskGraphInterface
@@ -18,6 +18,97 @@ const TCHAR* IPlatformFile::GetPhysicalTypeName()
 	return TEXT("PhysicalFile");
 }
 
+/**
+ * Region of a FGenericMappedFileHandle, a copy of the file data.
+ */
+class FGenericMappedFileRegion : public IMappedFileRegion
+{
+public:
+	FGenericMappedFileRegion(uint8* InData, int64 InSize)
+		: IMappedFileRegion(InData, InSize)
+		, Data(InData)
+	{
+	}
+
+	virtual ~FGenericMappedFileRegion()
+	{
+		FMemory::Free(Data);
+	}
+
+private:
+	uint8* Data;
+};
+
+/**
+ * Fallback for platform files that can't map files, reads each region into memory.
+ */
+class FGenericMappedFileHandle : public IMappedFileHandle
+{
+public:
+	FGenericMappedFileHandle(IFileHandle* InFileHandle)
+		: IMappedFileHandle(InFileHandle->Size())
+		, FileHandle(InFileHandle)
+	{
+	}
+
+	virtual ~FGenericMappedFileHandle()
+	{
+		delete FileHandle;
+	}
+
+	virtual bool IsMemoryMapped() const override
+	{
+		return false;
+	}
+
+	virtual IMappedFileRegion* MapRegion(int64 Offset, int64 BytesToMap) override
+	{
+		if (Offset < 0 || Offset >= GetFileSize() || BytesToMap <= 0)
+		{
+			return nullptr;
+		}
+		BytesToMap = FMath::Min(BytesToMap, GetFileSize() - Offset);
+
+		uint8* Data = (uint8*)FMemory::Malloc(BytesToMap);
+		bool bSucceeded;
+		{
+			FScopeLock ScopeLock(&CriticalSection);
+			bSucceeded = FileHandle->Seek(Offset) && FileHandle->Read(Data, BytesToMap);
+		}
+		if (!bSucceeded)
+		{
+			FMemory::Free(Data);
+			return nullptr;
+		}
+		return new FGenericMappedFileRegion(Data, BytesToMap);
+	}
+
+private:
+	/** Handle the regions are read with. */
+	IFileHandle* FileHandle;
+	/** Guards the file position of FileHandle. */
+	FCriticalSection CriticalSection;
+};
+
+IMappedFileHandle* IPlatformFile::OpenMapped(const TCHAR* Filename)
+{
+	IFileHandle* FileHandle = OpenRead(Filename);
+	if (!FileHandle)
+	{
+		return nullptr;
+	}
+	return new FGenericMappedFileHandle(FileHandle);
+}
+
+IAsyncReadFileHandle* IPlatformFile::OpenAsyncRead(const TCHAR* Filename)
+{
+	if (!FileExists(Filename))
+	{
+		return nullptr;
+	}
+	return new FGenericAsyncReadFileHandle(this, Filename);
+}
+
 void IPlatformFile::GetTimeStampPair(const TCHAR* PathA, const TCHAR* PathB, FDateTime& OutTimeStampA, FDateTime& OutTimeStampB)
 {
 	if (GetLowerLevel())
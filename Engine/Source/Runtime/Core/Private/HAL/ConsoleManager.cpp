@@ -72,7 +72,7 @@ public:
 	 * @param InHelp must not be 0, must not be empty
 	 */
 	FConsoleVariableBase(const TCHAR* InHelp, EConsoleVariableFlags InFlags)
-		:Flags(InFlags), bWarnedAboutThreadSafety(false)
+		:bChangeQueued(false), Flags(InFlags), bWarnedAboutThreadSafety(false), bHasHandle(0)
 	{
 		SetHelp(InHelp);
 	}
@@ -156,10 +156,26 @@ public:
 
 		Flags = (EConsoleVariableFlags)(((uint32)Flags & ~ECVF_SetByMask) | SetBy);
 
+		FConsoleManager& ConsoleManager = (FConsoleManager&)IConsoleManager::Get();
+		ConsoleManager.OnCVarValueChanged(this);
+
 		OnChangedCallback.ExecuteIfBound(this);
 	}
 
-	
+	/** Set once a handle was requested, after that every change has to be published to the handle */
+	void SetHasHandle()
+	{
+		FPlatformAtomics::InterlockedExchange(&bHasHandle, 1);
+	}
+
+	bool HasHandle() const
+	{
+		return bHasHandle != 0;
+	}
+
+	/** True while the variable is in FConsoleManager::ChangedVariables, guarded by its ChangedVariablesSynchronizationObject */
+	bool bChangeQueued;
+
 protected: // -----------------------------------------
 
 	// not using TCHAR* to allow chars support reloading of modules (otherwise we would keep a pointer into the module)
@@ -172,6 +188,9 @@ protected: // -----------------------------------------
 	/** True if this console variable has been used on the wrong thread and we have warned about it. */
 	mutable bool bWarnedAboutThreadSafety;
 
+	/** Non-zero once a handle was requested, read without a lock by Set() on any thread */
+	volatile int32 bHasHandle;
+
 	// @return 0:main thread, 1: render thread, later more
 	uint32 GetShadowIndex() const
 	{
@@ -537,6 +556,45 @@ IConsoleVariable* FConsoleManager::RegisterConsoleVariableBitRef(const TCHAR* CV
 
 void FConsoleManager::CallAllConsoleVariableSinks()
 {
+	// sinks might set variables again, those are handled the next time
+	TArray<IConsoleVariable*> Changed;
+	TArray<FConsoleVariableBatchDelegate> BatchSinks;
+	{
+		FScopeLock ScopeLock(&ChangedVariablesSynchronizationObject);
+		Exchange(Changed, ChangedVariables);
+		for(IConsoleVariable* Var : Changed)
+		{
+			static_cast<FConsoleVariableBase*>(Var)->bChangeQueued = false;
+		}
+		// sinks can be registered from other threads while they are called
+		if(Changed.Num())
+		{
+			BatchSinks = ConsoleVariableBatchSinks;
+		}
+	}
+
+	if(Changed.Num())
+	{
+		{
+			FScopeLock ScopeLock(&ConsoleObjectsSynchronizationObject);
+
+			for(IConsoleVariable* Var : Changed)
+			{
+				FConsoleVariableSnapshotBuffer* Buffer = VariableSnapshots.FindRef(Var);
+
+				if(Buffer)
+				{
+					PublishVariableSnapshot(*Buffer, Var);
+				}
+			}
+		}
+
+		for(int32 i = 0; i < BatchSinks.Num(); ++i)
+		{
+			BatchSinks[i].ExecuteIfBound(Changed);
+		}
+	}
+
 	if(bCallAllConsoleVariableSinks)
 	{
 		for(uint32 i = 0; i < (uint32)ConsoleVariableChangeSinks.Num(); ++i)
@@ -559,6 +617,34 @@ void FConsoleManager::UnregisterConsoleVariableSink_Handle(FConsoleVariableSinkH
 	ConsoleVariableChangeSinks.RemoveAll([=](const FConsoleCommandDelegate& Delegate){ return Handle.HasSameHandle(Delegate); });
 }
 
+FConsoleVariableSinkHandle FConsoleManager::RegisterConsoleVariableBatchSink_Handle(const FConsoleVariableBatchDelegate& Command)
+{
+	FScopeLock ScopeLock(&ChangedVariablesSynchronizationObject);
+	ConsoleVariableBatchSinks.Add(Command);
+	NumConsoleVariableBatchSinks.Set(ConsoleVariableBatchSinks.Num());
+	return FConsoleVariableSinkHandle(Command.GetHandle());
+}
+
+void FConsoleManager::UnregisterConsoleVariableBatchSink_Handle(FConsoleVariableSinkHandle Handle)
+{
+	FScopeLock ScopeLock(&ChangedVariablesSynchronizationObject);
+	ConsoleVariableBatchSinks.RemoveAll([=](const FConsoleVariableBatchDelegate& Delegate){ return Handle.HasSameHandle(Delegate); });
+	NumConsoleVariableBatchSinks.Set(ConsoleVariableBatchSinks.Num());
+}
+
+void FConsoleManager::PublishVariableSnapshot(FConsoleVariableSnapshotBuffer& Buffer, IConsoleVariable* Var)
+{
+	FConsoleVariableSnapshot* Published = Buffer.Published;
+	FConsoleVariableSnapshot* Next = (Published == &Buffer.Values[0]) ? &Buffer.Values[1] : &Buffer.Values[0];
+
+	Next->IntValue = Var->GetInt();
+	Next->FloatValue = Var->GetFloat();
+	Next->Serial = Published ? Published->Serial + 1 : 0;
+
+	// the exchange is a full barrier, readers never see a partially written value
+	FPlatformAtomics::InterlockedExchangePtr((void**)&Buffer.Published, Next);
+}
+
 class FConsoleCommand : public FConsoleCommandBase
 {
 
@@ -803,6 +889,30 @@ IConsoleVariable* FConsoleManager::FindConsoleVariable(const TCHAR* Name) const
 	return 0;
 }
 
+FConsoleVariableHandle FConsoleManager::FindConsoleVariableHandle(const TCHAR* Name)
+{
+	IConsoleVariable* Var = FindConsoleVariable(Name);
+
+	if(!Var)
+	{
+		return FConsoleVariableHandle();
+	}
+
+	FScopeLock ScopeLock(&ConsoleObjectsSynchronizationObject);
+
+	FConsoleVariableSnapshotBuffer*& Buffer = VariableSnapshots.FindOrAdd(Var);
+
+	if(!Buffer)
+	{
+		Buffer = new FConsoleVariableSnapshotBuffer;
+		Buffer->Published = nullptr;
+		PublishVariableSnapshot(*Buffer, Var);
+		static_cast<FConsoleVariableBase*>(Var)->SetHasHandle();
+	}
+
+	return FConsoleVariableHandle(Buffer);
+}
+
 IConsoleObject* FConsoleManager::FindConsoleObject(const TCHAR* Name) const
 {
 	IConsoleObject* CVar = FindConsoleObjectUnfiltered(Name);
@@ -855,6 +965,18 @@ void FConsoleManager::UnregisterConsoleObject(const TCHAR* Name, bool bKeepState
 		}
 		else
 		{
+			if(CVar)
+			{
+				// handles keep the last published value
+				FConsoleVariableSnapshotBuffer* Buffer = nullptr;
+				if(VariableSnapshots.RemoveAndCopyValue(CVar, Buffer))
+				{
+					RetiredVariableSnapshots.Add(Buffer);
+				}
+				FScopeLock ScopeLock(&ChangedVariablesSynchronizationObject);
+				ChangedVariables.Remove(CVar);
+			}
+
 			ConsoleObjects.Remove(Name);
 			Object->Release();
 		}
@@ -1285,6 +1407,22 @@ void FConsoleManager::OnCVarChanged()
 	bCallAllConsoleVariableSinks = true;
 }
 
+void FConsoleManager::OnCVarValueChanged(FConsoleVariableBase* Var)
+{
+	// can be called from any thread that sets a variable, the change is published on the game thread in CallAllConsoleVariableSinks()
+	if(!Var->HasHandle() && NumConsoleVariableBatchSinks.GetValue() == 0)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&ChangedVariablesSynchronizationObject);
+	if(!Var->bChangeQueued)
+	{
+		Var->bChangeQueued = true;
+		ChangedVariables.Add(Var);
+	}
+}
+
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 uint32 GConsoleManagerSinkTestCounter = 0;
 void TestSinkCallback()
@@ -1301,6 +1439,13 @@ void TestConsoleVariableCallback(IConsoleVariable* Var)
 
 	++GConsoleVariableCallbackTestCounter;
 }
+uint32 GConsoleVariableBatchTestCounter = 0;
+int32 GConsoleVariableBatchTestNum = 0;
+void TestConsoleVariableBatchCallback(const TArray<IConsoleVariable*>& ChangedVariables)
+{
+	GConsoleVariableBatchTestNum = ChangedVariables.Num();
+	++GConsoleVariableBatchTestCounter;
+}
 #endif // !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 
 void FConsoleManager::Test()
@@ -1476,6 +1621,56 @@ void FConsoleManager::Test()
 
 	UnregisterConsoleVariableSink_Handle(TestSinkCallbackHandle);
 
+	// handles and batch sinks ---------
+
+	{
+		GConsoleVariableBatchTestCounter = 0;
+		auto TestBatchCallbackHandle = RegisterConsoleVariableBatchSink_Handle(FConsoleVariableBatchDelegate::CreateStatic(&TestConsoleVariableBatchCallback));
+
+		check(!FindConsoleVariableHandle(TEXT("TestNameH")).IsValid());
+
+		IConsoleVariable* VarH = RegisterConsoleVariable(TEXT("TestNameH"), 1, TEXT("TestHelpH"), ECVF_Default);
+		IConsoleVariable* VarI = RegisterConsoleVariable(TEXT("TestNameI"), 1.5f, TEXT("TestHelpI"), ECVF_RenderThreadSafe);
+		FConsoleVariableHandle HandleH = FindConsoleVariableHandle(TEXT("TestNameH"));
+		FConsoleVariableHandle HandleI = FindConsoleVariableHandle(TEXT("TestNameI"));
+		check(HandleH.IsValid() && HandleI.IsValid());
+		check(HandleH.GetInt() == 1);
+		check(HandleI.GetFloat() == 1.5f);
+		const uint32 SerialH = HandleH.GetSerial();
+
+		// the handles only see the change at the next frame boundary
+		VarH->Set(TEXT("2"), ECVF_SetByConsole);
+		VarH->Set(TEXT("3"), ECVF_SetByConsole);
+		VarI->Set(TEXT("2.5"), ECVF_SetByConsole);
+		check(HandleH.GetInt() == 1);
+		check(HandleH.GetSerial() == SerialH);
+
+		IConsoleManager::Get().CallAllConsoleVariableSinks();
+		check(HandleH.GetInt() == 3);
+		check(HandleH.GetSerial() != SerialH);
+		check(FMath::IsNearlyEqual(HandleI.GetFloat(), 2.5f, KINDA_SMALL_NUMBER));
+
+		// one batch for all the changes, each variable only once
+		check(GConsoleVariableBatchTestCounter == 1);
+		check(GConsoleVariableBatchTestNum == 2);
+
+		IConsoleManager::Get().CallAllConsoleVariableSinks();
+		check(GConsoleVariableBatchTestCounter == 1);
+
+		// handles keep the last value after the variable is gone
+		UnregisterConsoleObject(TEXT("TestNameH"), false);
+		UnregisterConsoleObject(TEXT("TestNameI"), false);
+		check(HandleH.GetInt() == 3);
+
+		UnregisterConsoleVariableBatchSink_Handle(TestBatchCallbackHandle);
+
+		// without handles or batch sinks, changes aren't tracked
+		IConsoleVariable* VarJ = RegisterConsoleVariable(TEXT("TestNameJ"), 1, TEXT("TestHelpJ"), ECVF_Default);
+		VarJ->Set(2, ECVF_SetByConsole);
+		check(!ChangedVariables.Num());
+		UnregisterConsoleObject(TEXT("TestNameJ"), false);
+	}
+
 #endif // !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 }
 
@@ -0,0 +1,360 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+
+#if LOCK_CONTENTION_PROFILER
+
+DECLARE_STATS_GROUP(TEXT("Lock Contention"), STATGROUP_LockContention, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sampled Lock Acquires"), STAT_LockContention_Acquires, STATGROUP_LockContention);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Contended Lock Acquires"), STAT_LockContention_Contended, STATGROUP_LockContention);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Lock Wait Time (ms)"), STAT_LockContention_WaitTime, STATGROUP_LockContention);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sampled Event Waits"), STAT_LockContention_EventWaits, STATGROUP_LockContention);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Event Wait Time (ms)"), STAT_LockContention_EventWaitTime, STATGROUP_LockContention);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dropped Acquires"), STAT_LockContention_Dropped, STATGROUP_LockContention);
+
+
+namespace LockContentionProfiler
+{
+	enum
+	{
+		/** Number of records, a power of two */
+		NumEntries = 4096,
+		/** Number of records looked at before giving up on a lock */
+		MaxProbes = 32,
+		/** Number of callstack frames shown per lock in the report */
+		NumReportedFrames = 3,
+	};
+
+	/** Record of one lock, updated with atomics only since it is written from inside FCriticalSection::Lock */
+	struct FEntry
+	{
+		void* volatile Lock;
+		ELockContentionType Type;
+		volatile int32 NumAcquires;
+		volatile int32 NumContended;
+		volatile int64 WaitCycles;
+		volatile int32 MaxWaitCycles;
+		uint32 MaxWaitOwnerThreadId;
+		uint64 MaxWaitCallstack[FLockContentionRecord::MaxCallstackDepth];
+	};
+
+	static FEntry Entries[NumEntries];
+
+	/** Acquires of locks that didn't find a free record */
+	static volatile int32 NumDroppedAcquires = 0;
+
+	/** Per thread sampling counter */
+	static uint32 SampleCounterTlsSlot = 0;
+	static bool bSampleCounterTlsSlotAllocated = false;
+
+	/** Totals at the last UpdateStats, to turn them into per frame counts */
+	struct FTotals
+	{
+		uint64 NumLockAcquires;
+		uint64 NumLockContended;
+		uint64 LockWaitCycles;
+		uint64 NumEventWaits;
+		uint64 EventWaitCycles;
+		uint64 NumDropped;
+	};
+	static FTotals LastTotals;
+
+	static FEntry* FindOrAddEntry(const void* Lock, ELockContentionType Type)
+	{
+		const uint32 Hash = (uint32)(((UPTRINT)Lock >> 4) * 0x9E3779B1u) >> 20;
+		for (uint32 Probe = 0; Probe < MaxProbes; Probe++)
+		{
+			FEntry& Entry = Entries[(Hash + Probe) & (NumEntries - 1)];
+			void* CurrentLock = Entry.Lock;
+			if (CurrentLock == Lock)
+			{
+				return &Entry;
+			}
+			if (!CurrentLock)
+			{
+				void* PreviousLock = FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Entry.Lock, (void*)Lock, nullptr);
+				if (!PreviousLock)
+				{
+					Entry.Type = Type;
+					return &Entry;
+				}
+				if (PreviousLock == Lock)
+				{
+					return &Entry;
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	static void GetTotals(FTotals& OutTotals)
+	{
+		FMemory::Memzero(OutTotals);
+		for (int32 Index = 0; Index < NumEntries; Index++)
+		{
+			const FEntry& Entry = Entries[Index];
+			if (!Entry.Lock)
+			{
+				continue;
+			}
+			if (Entry.Type == ELockContentionType::Event)
+			{
+				OutTotals.NumEventWaits += (uint32)Entry.NumAcquires;
+				OutTotals.EventWaitCycles += (uint64)Entry.WaitCycles;
+			}
+			else
+			{
+				OutTotals.NumLockAcquires += (uint32)Entry.NumAcquires;
+				OutTotals.NumLockContended += (uint32)Entry.NumContended;
+				OutTotals.LockWaitCycles += (uint64)Entry.WaitCycles;
+			}
+		}
+		OutTotals.NumDropped = (uint32)NumDroppedAcquires;
+	}
+
+	/** @return whether the frame belongs to the profiler or the instrumented lock rather than to the caller */
+	static bool IsProfilerFrame(const FString& Symbol)
+	{
+		return Symbol.Contains(TEXT("LockContentionProfiler"))
+			|| Symbol.Contains(TEXT("LockProfiled"))
+			|| Symbol.Contains(TEXT("ContentionTrackingEvent"))
+			|| Symbol.Contains(TEXT("CaptureStackBackTrace"));
+	}
+}
+
+
+volatile int32 FLockContentionProfiler::SampleInterval = 0;
+
+
+void FLockContentionProfiler::Start(int32 InSampleInterval)
+{
+	using namespace LockContentionProfiler;
+
+	if (!bSampleCounterTlsSlotAllocated)
+	{
+		SampleCounterTlsSlot = FPlatformTLS::AllocTlsSlot();
+		bSampleCounterTlsSlotAllocated = true;
+	}
+	FPlatformMisc::MemoryBarrier();
+	FPlatformAtomics::InterlockedExchange(&SampleInterval, FMath::Max(InSampleInterval, 1));
+}
+
+
+void FLockContentionProfiler::Stop()
+{
+	FPlatformAtomics::InterlockedExchange(&SampleInterval, 0);
+}
+
+
+void FLockContentionProfiler::Reset()
+{
+	using namespace LockContentionProfiler;
+
+	FMemory::Memzero((void*)Entries, sizeof(Entries));
+	FPlatformAtomics::InterlockedExchange(&NumDroppedAcquires, 0);
+	FMemory::Memzero(LastTotals);
+}
+
+
+bool FLockContentionProfiler::ShouldSample()
+{
+	using namespace LockContentionProfiler;
+
+	const int32 Interval = SampleInterval;
+	if (Interval <= 1)
+	{
+		return Interval == 1;
+	}
+
+	// the counter lives in a TLS slot so sampling doesn't make threads share a cache line
+	UPTRINT Counter = (UPTRINT)FPlatformTLS::GetTlsValue(SampleCounterTlsSlot) + 1;
+	const bool bSample = Counter >= (UPTRINT)Interval;
+	if (bSample)
+	{
+		Counter = 0;
+	}
+	FPlatformTLS::SetTlsValue(SampleCounterTlsSlot, (void*)Counter);
+	return bSample;
+}
+
+
+uint32 FLockContentionProfiler::GetCycles()
+{
+	return FPlatformTime::Cycles();
+}
+
+
+uint32 FLockContentionProfiler::GetCurrentThreadId()
+{
+	return FPlatformTLS::GetCurrentThreadId();
+}
+
+
+void FLockContentionProfiler::RecordAcquire(const void* Lock, ELockContentionType Type, bool bContended, uint32 WaitCycles, uint32 OwnerThreadId)
+{
+	using namespace LockContentionProfiler;
+
+	FEntry* Entry = FindOrAddEntry(Lock, Type);
+	if (!Entry)
+	{
+		FPlatformAtomics::InterlockedIncrement(&NumDroppedAcquires);
+		return;
+	}
+
+	FPlatformAtomics::InterlockedIncrement(&Entry->NumAcquires);
+	if (bContended)
+	{
+		FPlatformAtomics::InterlockedIncrement(&Entry->NumContended);
+	}
+	if (WaitCycles)
+	{
+		FPlatformAtomics::InterlockedAdd(&Entry->WaitCycles, (int64)WaitCycles);
+
+		// only the waiter that raised the maximum captures its own callstack, the maximum rarely changes once warmed up
+		int32 MaxWaitCycles = Entry->MaxWaitCycles;
+		while ((uint32)MaxWaitCycles < WaitCycles)
+		{
+			if (FPlatformAtomics::InterlockedCompareExchange(&Entry->MaxWaitCycles, (int32)WaitCycles, MaxWaitCycles) == MaxWaitCycles)
+			{
+				Entry->MaxWaitOwnerThreadId = OwnerThreadId;
+				FMemory::Memzero(Entry->MaxWaitCallstack);
+				FPlatformStackWalk::CaptureStackBackTrace(Entry->MaxWaitCallstack, FLockContentionRecord::MaxCallstackDepth);
+				break;
+			}
+			MaxWaitCycles = Entry->MaxWaitCycles;
+		}
+	}
+}
+
+
+void FLockContentionProfiler::GetRecords(TArray<FLockContentionRecord>& OutRecords)
+{
+	using namespace LockContentionProfiler;
+
+	OutRecords.Reset();
+	for (int32 Index = 0; Index < NumEntries; Index++)
+	{
+		const FEntry& Entry = Entries[Index];
+		if (!Entry.Lock || !Entry.NumAcquires)
+		{
+			continue;
+		}
+
+		FLockContentionRecord& Record = OutRecords[OutRecords.AddUninitialized()];
+		Record.Lock = Entry.Lock;
+		Record.Type = Entry.Type;
+		Record.NumAcquires = (uint32)Entry.NumAcquires;
+		Record.NumContended = (uint32)Entry.NumContended;
+		Record.WaitCycles = (uint64)Entry.WaitCycles;
+		Record.MaxWaitCycles = (uint32)Entry.MaxWaitCycles;
+		Record.MaxWaitOwnerThreadId = Entry.MaxWaitOwnerThreadId;
+		FMemory::Memcpy(Record.MaxWaitCallstack, Entry.MaxWaitCallstack, sizeof(Record.MaxWaitCallstack));
+	}
+
+	OutRecords.Sort([](const FLockContentionRecord& A, const FLockContentionRecord& B)
+	{
+		return A.WaitCycles > B.WaitCycles;
+	});
+}
+
+
+void FLockContentionProfiler::Dump(FOutputDevice& Ar, int32 MaxLocks)
+{
+	using namespace LockContentionProfiler;
+
+	TArray<FLockContentionRecord> Records;
+	GetRecords(Records);
+
+	Ar.Logf(TEXT("Lock contention: %s, sample interval %d, %d locks recorded, %d acquires dropped"), IsEnabled() ? TEXT("recording") : TEXT("stopped"), (int32)SampleInterval, Records.Num(), (int32)NumDroppedAcquires);
+
+	for (int32 RecordIndex = 0; RecordIndex < FMath::Min(Records.Num(), MaxLocks); RecordIndex++)
+	{
+		const FLockContentionRecord& Record = Records[RecordIndex];
+		if (Record.Type == ELockContentionType::Event)
+		{
+			Ar.Logf(TEXT("  Event 0x%016llx: %u waits, %u timed out, %.2f ms waited, longest %.2f ms"),
+				(uint64)(UPTRINT)Record.Lock, Record.NumAcquires, Record.NumContended, FPlatformTime::GetSecondsPerCycle() * Record.WaitCycles * 1000.0, FPlatformTime::ToMilliseconds(Record.MaxWaitCycles));
+		}
+		else
+		{
+			Ar.Logf(TEXT("  Lock 0x%016llx: %u acquires, %u contended (%.1f%%), %.2f ms waited, longest %.2f ms while thread %u held it"),
+				(uint64)(UPTRINT)Record.Lock, Record.NumAcquires, Record.NumContended, 100.0f * Record.NumContended / Record.NumAcquires,
+				FPlatformTime::GetSecondsPerCycle() * Record.WaitCycles * 1000.0, FPlatformTime::ToMilliseconds(Record.MaxWaitCycles), Record.MaxWaitOwnerThreadId);
+		}
+
+		int32 NumFrames = 0;
+		for (int32 FrameIndex = 0; FrameIndex < FLockContentionRecord::MaxCallstackDepth && Record.MaxWaitCallstack[FrameIndex] && NumFrames < NumReportedFrames; FrameIndex++)
+		{
+			ANSICHAR AddressInformation[512];
+			AddressInformation[0] = 0;
+			FPlatformStackWalk::ProgramCounterToHumanReadableString(FrameIndex, Record.MaxWaitCallstack[FrameIndex], AddressInformation, ARRAY_COUNT(AddressInformation) - 1);
+			const FString Symbol(AddressInformation);
+			if (!IsProfilerFrame(Symbol))
+			{
+				Ar.Logf(TEXT("      %s"), *Symbol);
+				NumFrames++;
+			}
+		}
+	}
+}
+
+
+void FLockContentionProfiler::UpdateStats()
+{
+	using namespace LockContentionProfiler;
+
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	FTotals Totals;
+	GetTotals(Totals);
+
+	// a Reset or address reuse can make the totals go down, report nothing for that frame
+	const bool bValid = Totals.NumLockAcquires >= LastTotals.NumLockAcquires && Totals.NumEventWaits >= LastTotals.NumEventWaits;
+	if (bValid)
+	{
+		const double MillisecondsPerCycle = FPlatformTime::GetSecondsPerCycle() * 1000.0;
+		SET_DWORD_STAT(STAT_LockContention_Acquires, (uint32)(Totals.NumLockAcquires - LastTotals.NumLockAcquires));
+		SET_DWORD_STAT(STAT_LockContention_Contended, (uint32)(Totals.NumLockContended - LastTotals.NumLockContended));
+		SET_FLOAT_STAT(STAT_LockContention_WaitTime, (float)(MillisecondsPerCycle * (Totals.LockWaitCycles - LastTotals.LockWaitCycles)));
+		SET_DWORD_STAT(STAT_LockContention_EventWaits, (uint32)(Totals.NumEventWaits - LastTotals.NumEventWaits));
+		SET_FLOAT_STAT(STAT_LockContention_EventWaitTime, (float)(MillisecondsPerCycle * (Totals.EventWaitCycles - LastTotals.EventWaitCycles)));
+		SET_DWORD_STAT(STAT_LockContention_Dropped, (uint32)(Totals.NumDropped - LastTotals.NumDropped));
+	}
+	LastTotals = Totals;
+}
+
+
+static void LockContentionCommand(const TArray<FString>& Args)
+{
+	const FString Command = Args.Num() ? Args[0] : FString(TEXT("Dump"));
+	const int32 Value = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 0;
+
+	if (Command == TEXT("Start"))
+	{
+		FLockContentionProfiler::Start(Value > 0 ? Value : 1);
+	}
+	else if (Command == TEXT("Stop"))
+	{
+		FLockContentionProfiler::Stop();
+	}
+	else if (Command == TEXT("Reset"))
+	{
+		FLockContentionProfiler::Reset();
+	}
+	else
+	{
+		FLockContentionProfiler::Dump(*GLog, Value > 0 ? Value : 20);
+	}
+}
+
+static FAutoConsoleCommand LockContentionConsoleCommand(
+	TEXT("LockContention"),
+	TEXT("Controls the lock contention profiler: Start [SampleInterval], Stop, Reset or Dump [MaxLocks]. Per frame totals are in stat LockContention."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&LockContentionCommand)
+	);
+
+#endif // LOCK_CONTENTION_PROFILER
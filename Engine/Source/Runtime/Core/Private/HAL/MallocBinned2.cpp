@@ -33,6 +33,13 @@
 #	define BINNED2_PEAK_STATCOUNTER(PeakCounter, CompareVal)
 #endif
 
+// Once per-thread caches are allowed the allocator is internally thread safe and guards its shared tables with its own mutex.
+#if BINNED2_ALLOW_RUNTIME_TLS_CACHES
+#	define BINNED2_SCOPE_LOCK() FScopeLock BinnedScopeLock(&Mutex)
+#else
+#	define BINNED2_SCOPE_LOCK()
+#endif
+
 /** Malloc binned allocator specific stats. */
 DECLARE_MEMORY_STAT_EXTERN(TEXT("Binned Os Current"),		STAT_Binned2_OsCurrent,STATGROUP_MemoryAllocator, CORE_API);
 DECLARE_MEMORY_STAT_EXTERN(TEXT("Binned Os Peak"),			STAT_Binned2_OsPeak,STATGROUP_MemoryAllocator, CORE_API);
@@ -43,6 +50,10 @@ DECLARE_MEMORY_STAT_EXTERN(TEXT("Binned Used Peak"),		STAT_Binned2_UsedPeak,STAT
 DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Binned Current Allocs"),	STAT_Binned2_CurrentAllocs,STATGROUP_MemoryAllocator, CORE_API);
 DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Binned Total Allocs"),		STAT_Binned2_TotalAllocs,STATGROUP_MemoryAllocator, CORE_API);
 DECLARE_MEMORY_STAT_EXTERN(TEXT("Binned Slack Current"),	STAT_Binned2_SlackCurrent,STATGROUP_MemoryAllocator, CORE_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Binned TLS Cached Current"),	STAT_Binned2_TlsCachedCurrent,STATGROUP_MemoryAllocator, CORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Binned TLS Cache Hits"),	STAT_Binned2_TlsCacheHits,STATGROUP_MemoryAllocator, CORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Binned TLS Cache Misses"),	STAT_Binned2_TlsCacheMisses,STATGROUP_MemoryAllocator, CORE_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Binned TLS Cache Hit Rate"),	STAT_Binned2_TlsCacheHitRate,STATGROUP_MemoryAllocator, CORE_API);
 
 /** Malloc binned allocator specific stats. */
 DEFINE_STAT(STAT_Binned2_OsCurrent);
@@ -54,6 +65,10 @@ DEFINE_STAT(STAT_Binned2_UsedPeak);
 DEFINE_STAT(STAT_Binned2_CurrentAllocs);
 DEFINE_STAT(STAT_Binned2_TotalAllocs);
 DEFINE_STAT(STAT_Binned2_SlackCurrent);
+DEFINE_STAT(STAT_Binned2_TlsCachedCurrent);
+DEFINE_STAT(STAT_Binned2_TlsCacheHits);
+DEFINE_STAT(STAT_Binned2_TlsCacheMisses);
+DEFINE_STAT(STAT_Binned2_TlsCacheHitRate);
 
 // Block sizes are based around getting the maximum amount of allocations per pool, with as little alignment waste as possible.
 // Block sizes should be close to even divisors of the POOL_SIZE, and well distributed. They must be 16-byte aligned as well.
@@ -172,6 +187,95 @@ struct FMallocBinned2::PoolHashBucket
 	}
 };
 
+/**
+ * Per-thread cache of free small blocks, one singly linked list per bin.
+ * Only the owning thread pushes and pops; registration and flushing happen under the allocator mutex.
+ */
+struct FMallocBinned2::FPerThreadFreeBlockLists
+{
+	/** A cached block; only the link is stored so even the smallest bin can hold one. */
+	struct FFreeBlock
+	{
+		FFreeBlock* Next;
+	};
+
+	struct FFreeBlockList
+	{
+		FFreeBlock* Head;
+		uint32      Count;
+	};
+
+	FFreeBlockList Lists[POOL_COUNT];
+
+	/** Link in FMallocBinned2::RegisteredFreeBlockLists. */
+	FPerThreadFreeBlockLists*  Next;
+	FPerThreadFreeBlockLists** PrevLink;
+
+#if STATS
+	// Written by the owning thread only, read without synchronization when gathering stats.
+	uint64 Hits;
+	uint64 Misses;
+	uint64 Frees;
+	uint64 Refills;
+	uint64 Flushes;
+#endif
+
+	FPerThreadFreeBlockLists()
+		: Next    (nullptr)
+		, PrevLink(nullptr)
+#if STATS
+		, Hits    (0)
+		, Misses  (0)
+		, Frees   (0)
+		, Refills (0)
+		, Flushes (0)
+#endif
+	{
+		FMemory::Memzero(Lists);
+	}
+
+	FORCEINLINE void* PopBlock(uint32 PoolIndex)
+	{
+		FFreeBlockList& List  = Lists[PoolIndex];
+		FFreeBlock*     Block = List.Head;
+		if (Block)
+		{
+			List.Head = Block->Next;
+			--List.Count;
+		}
+		return Block;
+	}
+
+	FORCEINLINE void PushBlock(uint32 PoolIndex, void* Ptr)
+	{
+		FFreeBlockList& List  = Lists[PoolIndex];
+		FFreeBlock*     Block = (FFreeBlock*)Ptr;
+		Block->Next = List.Head;
+		List.Head   = Block;
+		++List.Count;
+	}
+
+	void Link( FPerThreadFreeBlockLists*& Before )
+	{
+		if( Before )
+		{
+			Before->PrevLink = &Next;
+		}
+		Next     = Before;
+		PrevLink = &Before;
+		Before   = this;
+	}
+
+	void Unlink()
+	{
+		if( Next )
+		{
+			Next->PrevLink = PrevLink;
+		}
+		*PrevLink = Next;
+	}
+};
+
 struct FMallocBinned2::Private
 {
 	static_assert(ARRAY_COUNT(GMallocBinned2BlockSizes) == POOL_COUNT, "Block size array size must match POOL_COUNT");
@@ -247,8 +351,10 @@ struct FMallocBinned2::Private
 		{
 			if (!Collision->FirstPool)
 			{
-				Collision->Key       = Key;
 				Collision->FirstPool = CreateIndirect(Allocator);
+				// FindPoolInfo() runs without the lock, so the key must not become visible before the table it guards.
+				FPlatformMisc::MemoryBarrier();
+				Collision->Key       = Key;
 
 				return &Collision->FirstPool[PoolIndex];
 			}
@@ -296,11 +402,17 @@ struct FMallocBinned2::Private
 
 		NewBucket->Key = Key;
 
+		// Make the new bucket fully initialized before it becomes reachable by unlocked FindPoolInfo() walks.
+		FPlatformMisc::MemoryBarrier();
 		Allocator.HashBuckets[Hash].Link(NewBucket);
 
 		return &NewBucket->FirstPool[PoolIndex];
 	}
 
+	/**
+	 * Finds the FPoolInfo for a live allocation. This does not require the mutex: the hash buckets are only ever
+	 * appended to, and the bookkeeping of an allocation is not modified while the allocation is outstanding.
+	 */
 	static FPoolInfo* FindPoolInfo(FMallocBinned2& Allocator, void* InPtr, void*& AllocationBase)
 	{
 		const UPTRINT PageSize = (UPTRINT)Allocator.PageSize;
@@ -421,7 +533,148 @@ struct FMallocBinned2::Private
 		return Align(Free, Alignment);
 	}
 
+	/**
+	 * Returns a block to its pool, releasing the pool to the OS when it becomes empty.
+	 * NOTE: The caller must hold the allocator mutex.
+	 */
+	static void FreePooledBlock(FMallocBinned2& Allocator, FPoolInfo* Pool, void* BasePtr, void* Ptr)
+	{
+		FPoolTable* Table = Allocator.MemSizeToPoolTable[Pool->TableIndex];
+#if STATS
+		Table->ActiveRequests--;
+#endif
+		// If this pool was exhausted, move to available list.
+		if (!Pool->FirstMem)
+		{
+			Pool->Unlink();
+			Pool->Link(Table->FirstPool);
+		}
+
+		check((UPTRINT)BasePtr <= (UPTRINT)Ptr);
+
+		uint32 AlignOffset = ((UPTRINT)Ptr - (UPTRINT)BasePtr) % Table->BlockSize;
+
+		// Patch pointer to include previously applied alignment.
+		Ptr = (void*)((PTRINT)Ptr - (PTRINT)AlignOffset);
+
+		// Free a pooled allocation.
+		FFreeMem* Free		= (FFreeMem*)Ptr;
+		Free->NumFreeBlocks	= 1;
+		Free->Next			= Pool->FirstMem;
+		Pool->FirstMem		= Free;
+		BINNED2_ADD_STATCOUNTER(Allocator.Stats.UsedCurrent, -(int64)Table->BlockSize);
+
+		// Free this pool.
+		checkSlow(Pool->Taken >= 1);
+		if( --Pool->Taken == 0 )
+		{
+#if STATS
+			Table->NumActivePools--;
+#endif
+			// Free the OS memory.
+			SIZE_T OsBytes = Pool->GetOsBytes(Allocator.PageSize, Allocator.BinnedOSTableIndex);
+			BINNED2_ADD_STATCOUNTER(Allocator.Stats.OsCurrent,    -(int64)OsBytes);
+			BINNED2_ADD_STATCOUNTER(Allocator.Stats.WasteCurrent, -(int64)(OsBytes - Pool->AllocSize));
+			Pool->Unlink();
+			Pool->SetAllocationSizes(0, 0, 0, Allocator.BinnedOSTableIndex);
+			Allocator.CachedOSPageAllocator.Free(BasePtr, OsBytes);
+		}
+	}
+
+#if BINNED2_ALLOW_RUNTIME_TLS_CACHES
+	static FORCEINLINE FPerThreadFreeBlockLists* GetFreeBlockLists(const FMallocBinned2& Allocator)
+	{
+		return (FPerThreadFreeBlockLists*)FPlatformTLS::GetTlsValue(Allocator.BinnedTlsSlot);
+	}
+
+	/**
+	 * Moves half a bin's worth of blocks from the pools into a per-thread cache.
+	 * NOTE: The caller must hold the allocator mutex.
+	 *
+	 * @param TableIndex - requested size, used to tag new pools the same way the uncached path does
+	 */
+	static void RefillFreeBlockList(FMallocBinned2& Allocator, FPerThreadFreeBlockLists& Lists, uint32 PoolIndex, uint32 TableIndex)
+	{
+		FPoolTable& Table = Allocator.PoolTable[PoolIndex];
+		const uint32 Count = FMath::Max<uint32>(Allocator.MaxTlsCachedBlocks[PoolIndex] / 2, 1);
+
+		for (uint32 Index = 0; Index < Count; ++Index)
+		{
+			FPoolInfo* Pool = Table.FirstPool;
+			if (!Pool)
+			{
+				Pool = AllocatePoolMemory(Allocator, Table, BINNED_ALLOC_POOL_SIZE, TableIndex);
+			}
+			Lists.PushBlock(PoolIndex, AllocateBlockFromPool(Allocator, Table, Pool, 1));
+		}
+
+#if STATS
+		// Cached blocks count as active requests until they are flushed back.
+		Table.TotalRequests    += Count;
+		Table.ActiveRequests   += Count;
+		Table.MaxActiveRequests = FMath::Max(Table.MaxActiveRequests, Table.ActiveRequests);
+		Lists.Refills++;
+#endif
+	}
+
+	/**
+	 * Returns up to Count blocks from a per-thread cache to their pools.
+	 * NOTE: The caller must hold the allocator mutex.
+	 */
+	static void FlushFreeBlockList(FMallocBinned2& Allocator, FPerThreadFreeBlockLists& Lists, uint32 PoolIndex, uint32 Count)
+	{
+		for (; Count; --Count)
+		{
+			void* Block = Lists.PopBlock(PoolIndex);
+			if (!Block)
+			{
+				break;
+			}
+
+			void* BasePtr;
+			FPoolInfo* Pool = FindPoolInfo(Allocator, Block, BasePtr);
+			checkSlow(Pool && Pool->TableIndex < Allocator.BinnedSizeLimit);
+			FreePooledBlock(Allocator, Pool, BasePtr, Block);
+		}
+
+#if STATS
+		Lists.Flushes++;
+#endif
+	}
+#endif // BINNED2_ALLOW_RUNTIME_TLS_CACHES
+
 #if	STATS
+	/**
+	 * Sums the counters of all live per-thread caches into the allocator stats.
+	 * NOTE: The caller must hold the allocator mutex.
+	 */
+	static void GatherTlsCacheStats(FMallocBinned2& Allocator, uint64& OutHits, uint64& OutMisses, uint64& OutFrees, uint64& OutRefills, uint64& OutFlushes)
+	{
+		OutHits    = Allocator.Stats.TlsCacheHits;
+		OutMisses  = Allocator.Stats.TlsCacheMisses;
+		OutFrees   = Allocator.Stats.TlsCacheFrees;
+		OutRefills = Allocator.Stats.TlsCacheRefills;
+		OutFlushes = Allocator.Stats.TlsCacheFlushes;
+
+		uint64 CachedBytes = 0;
+#if BINNED2_ALLOW_RUNTIME_TLS_CACHES
+		for (FPerThreadFreeBlockLists* Lists = Allocator.RegisteredFreeBlockLists; Lists; Lists = Lists->Next)
+		{
+			OutHits    += Lists->Hits;
+			OutMisses  += Lists->Misses;
+			OutFrees   += Lists->Frees;
+			OutRefills += Lists->Refills;
+			OutFlushes += Lists->Flushes;
+
+			for (uint32 PoolIndex = 0; PoolIndex < POOL_COUNT; ++PoolIndex)
+			{
+				CachedBytes += (uint64)Lists->Lists[PoolIndex].Count * Allocator.PoolTable[PoolIndex].BlockSize;
+			}
+		}
+#endif
+		Allocator.Stats.TlsCachedCurrent = CachedBytes;
+	}
+
 	static void UpdateSlackStat(FMallocBinned2& Allocator)
 	{
 		SIZE_T LocalWaste = Allocator.Stats.WasteCurrent;
@@ -442,8 +695,12 @@ void FMallocBinned2::GetAllocatorStats( FGenericMemoryStats& out_Stats )
 	FMalloc::GetAllocatorStats( out_Stats );
 
 #if	STATS
+	BINNED2_SCOPE_LOCK();
 	Private::UpdateSlackStat(*this);
 
+	uint64 TlsHits, TlsMisses, TlsFrees, TlsRefills, TlsFlushes;
+	Private::GatherTlsCacheStats(*this, TlsHits, TlsMisses, TlsFrees, TlsRefills, TlsFlushes);
+
 	// Malloc binned stats.
 	out_Stats.Add( GET_STATDESCRIPTION( STAT_Binned2_OsCurrent ),     Stats.OsCurrent );
 	out_Stats.Add( GET_STATDESCRIPTION( STAT_Binned2_OsPeak ),        Stats.OsPeak );
@@ -454,6 +711,9 @@ void FMallocBinned2::GetAllocatorStats( FGenericMemoryStats& out_Stats )
 	out_Stats.Add( GET_STATDESCRIPTION( STAT_Binned2_CurrentAllocs ), Stats.CurrentAllocs );
 	out_Stats.Add( GET_STATDESCRIPTION( STAT_Binned2_TotalAllocs ),   Stats.TotalAllocs );
 	out_Stats.Add( GET_STATDESCRIPTION( STAT_Binned2_SlackCurrent ),  Stats.SlackCurrent );
+	out_Stats.Add( GET_STATDESCRIPTION( STAT_Binned2_TlsCachedCurrent ), Stats.TlsCachedCurrent );
+	out_Stats.Add( GET_STATDESCRIPTION( STAT_Binned2_TlsCacheHits ),     TlsHits );
+	out_Stats.Add( GET_STATDESCRIPTION( STAT_Binned2_TlsCacheMisses ),   TlsMisses );
 #endif // STATS
 }
 
@@ -472,6 +732,10 @@ void FMallocBinned2::InitializeStatsMetadata()
 	GET_STATFNAME(STAT_Binned2_CurrentAllocs);
 	GET_STATFNAME(STAT_Binned2_TotalAllocs);
 	GET_STATFNAME(STAT_Binned2_SlackCurrent);
+	GET_STATFNAME(STAT_Binned2_TlsCachedCurrent);
+	GET_STATFNAME(STAT_Binned2_TlsCacheHits);
+	GET_STATFNAME(STAT_Binned2_TlsCacheMisses);
+	GET_STATFNAME(STAT_Binned2_TlsCacheHitRate);
 }
 
 FMallocBinned2::FMallocBinned2(uint32 InPageSize, uint64 AddressLimit)
@@ -485,6 +749,10 @@ FMallocBinned2::FMallocBinned2(uint32 InPageSize, uint64 AddressLimit)
 	, BinnedSizeLimit      (Private::PAGE_SIZE_LIMIT / 2)
 	, BinnedOSTableIndex   (BinnedSizeLimit + EXTENDED_PAGE_POOL_ALLOCATION_COUNT)
 	, HashBucketFreeList   (nullptr)
+#if BINNED2_ALLOW_RUNTIME_TLS_CACHES
+	, BinnedTlsSlot        (FPlatformTLS::AllocTlsSlot())
+	, RegisteredFreeBlockLists(nullptr)
+#endif
 {
 	check(FMath::IsPowerOfTwo(PageSize));
 	check(FMath::IsPowerOfTwo(AddressLimit));
@@ -503,6 +771,9 @@ FMallocBinned2::FMallocBinned2(uint32 InPageSize, uint64 AddressLimit)
 		PoolTable[Index].BlockSize  = GMallocBinned2BlockSizes[Index];
 #if STATS
 		PoolTable[Index].MinRequest = GMallocBinned2BlockSizes[Index];
+#endif
+#if BINNED2_ALLOW_RUNTIME_TLS_CACHES
+		MaxTlsCachedBlocks[Index]   = FMath::Clamp<uint32>(BINNED2_MAX_TLS_CACHED_BYTES_PER_BIN / GMallocBinned2BlockSizes[Index], 2, BINNED2_MAX_TLS_CACHED_BLOCKS_PER_BIN);
 #endif
 	}
 
@@ -535,7 +806,11 @@ FMallocBinned2::~FMallocBinned2()
 
 bool FMallocBinned2::IsInternallyThreadSafe() const
 { 
+#if BINNED2_ALLOW_RUNTIME_TLS_CACHES
+	return true;
+#else
 	return false;
+#endif
 }
 
 void* FMallocBinned2::Malloc(SIZE_T Size, uint32 Alignment)
@@ -560,6 +835,35 @@ void* FMallocBinned2::Malloc(SIZE_T Size, uint32 Alignment)
 
 		checkSlow(Size <= Table->BlockSize);
 
+#if BINNED2_ALLOW_RUNTIME_TLS_CACHES
+		if (FPerThreadFreeBlockLists* Lists = Private::GetFreeBlockLists(*this))
+		{
+			const uint32 PoolIndex = (uint32)(Table - PoolTable);
+
+			void* Result = Lists->PopBlock(PoolIndex);
+			if (!Result)
+			{
+				{
+					BINNED2_SCOPE_LOCK();
+					Private::RefillFreeBlockList(*this, *Lists, PoolIndex, Size);
+				}
+				Result = Lists->PopBlock(PoolIndex);
+#if STATS
+				Lists->Misses++;
+#endif
+			}
+#if STATS
+			else
+			{
+				Lists->Hits++;
+			}
+#endif
+			return Align(Result, Alignment);
+		}
+#endif
+
+		BINNED2_SCOPE_LOCK();
+
 		Private::TrackStats(Table, Size);
 
 		FPoolInfo* Pool = Table->FirstPool;
@@ -581,6 +885,8 @@ void* FMallocBinned2::Malloc(SIZE_T Size, uint32 Alignment)
 
 		checkSlow(Size <= Table->BlockSize);
 
+		BINNED2_SCOPE_LOCK();
+
 		Private::TrackStats(Table, Size);
 
 		FPoolInfo* Pool = Table->FirstPool;
@@ -593,6 +899,8 @@ void* FMallocBinned2::Malloc(SIZE_T Size, uint32 Alignment)
 		return Result;
 	}
 
+	BINNED2_SCOPE_LOCK();
+
 	// Use OS for large allocations.
 	UPTRINT AlignedSize = Align(Size, PageSize);
 	FFreeMem* Result = (FFreeMem*)CachedOSPageAllocator.Allocate(AlignedSize);
@@ -691,6 +999,7 @@ void* FMallocBinned2::Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment)
 	}
 
 	//need a lock to cover the SetAllocationSizes()
+	BINNED2_SCOPE_LOCK();
 	int32 UsedChange = (NewSize - Pool->AllocSize);
 
 	// Keep as-is, reallocation isn't worth the overhead.
@@ -723,49 +1032,38 @@ void FMallocBinned2::Free( void* Ptr )
 #endif
 	checkSlow(Pool);
 	checkSlow(Pool->AllocSize != 0);
-	if (Pool->TableIndex < BinnedOSTableIndex)
+
+#if BINNED2_ALLOW_RUNTIME_TLS_CACHES
+	if (Pool->TableIndex < BinnedSizeLimit)
 	{
-		FPoolTable* Table = MemSizeToPoolTable[Pool->TableIndex];
-#if STATS
-		Table->ActiveRequests--;
-#endif
-		// If this pool was exhausted, move to available list.
-		if (!Pool->FirstMem)
+		if (FPerThreadFreeBlockLists* Lists = Private::GetFreeBlockLists(*this))
 		{
-			Pool->Unlink();
-			Pool->Link(Table->FirstPool);
-		}
-
-		check((UPTRINT)BasePtr <= (UPTRINT)Ptr);
+			FPoolTable*  Table     = MemSizeToPoolTable[Pool->TableIndex];
+			const uint32 PoolIndex = (uint32)(Table - PoolTable);
 
-		uint32 AlignOffset = ((UPTRINT)Ptr - (UPTRINT)BasePtr) % Table->BlockSize;
-
-		// Patch pointer to include previously applied alignment.
-		Ptr = (void*)((PTRINT)Ptr - (PTRINT)AlignOffset);
-
-		// Free a pooled allocation.
-		FFreeMem* Free		= (FFreeMem*)Ptr;
-		Free->NumFreeBlocks	= 1;
-		Free->Next			= Pool->FirstMem;
-		Pool->FirstMem		= Free;
-		BINNED2_ADD_STATCOUNTER(Stats.UsedCurrent, -(int64)Table->BlockSize);
+			if (Lists->Lists[PoolIndex].Count >= MaxTlsCachedBlocks[PoolIndex])
+			{
+				BINNED2_SCOPE_LOCK();
+				Private::FlushFreeBlockList(*this, *Lists, PoolIndex, MaxTlsCachedBlocks[PoolIndex] / 2);
+			}
 
-		// Free this pool.
-		checkSlow(Pool->Taken >= 1);
-		if( --Pool->Taken == 0 )
-		{
+			// Cache the start of the block, undoing any alignment applied by Malloc.
+			check((UPTRINT)BasePtr <= (UPTRINT)Ptr);
+			Lists->PushBlock(PoolIndex, (uint8*)Ptr - ((UPTRINT)Ptr - (UPTRINT)BasePtr) % Table->BlockSize);
 #if STATS
-			Table->NumActivePools--;
+			Lists->Frees++;
 #endif
-			// Free the OS memory.
-			SIZE_T OsBytes = Pool->GetOsBytes(PageSize, BinnedOSTableIndex);
-			BINNED2_ADD_STATCOUNTER(Stats.OsCurrent,    -(int64)OsBytes);
-			BINNED2_ADD_STATCOUNTER(Stats.WasteCurrent, -(int64)(OsBytes - Pool->AllocSize));
-			Pool->Unlink();
-			Pool->SetAllocationSizes(0, 0, 0, BinnedOSTableIndex);
-			CachedOSPageAllocator.Free(BasePtr, OsBytes);
+			return;
 		}
 	}
+#endif
+
+	BINNED2_SCOPE_LOCK();
+
+	if (Pool->TableIndex < BinnedOSTableIndex)
+	{
+		Private::FreePooledBlock(*this, Pool, BasePtr, Ptr);
+	}
 	else
 	{
 		// Free an OS allocation.
@@ -779,6 +1077,54 @@ void FMallocBinned2::Free( void* Ptr )
 	}
 }
 
+void FMallocBinned2::SetupTLSCachesOnCurrentThread()
+{
+#if BINNED2_ALLOW_RUNTIME_TLS_CACHES
+	if (Private::GetFreeBlockLists(*this))
+	{
+		return;
+	}
+
+	// The slot is still empty, so this allocation goes through the locked path.
+	FPerThreadFreeBlockLists* Lists = new (FMallocBinned2::Malloc(sizeof(FPerThreadFreeBlockLists), DEFAULT_ALIGNMENT)) FPerThreadFreeBlockLists();
+	{
+		BINNED2_SCOPE_LOCK();
+		Lists->Link(RegisteredFreeBlockLists);
+	}
+	FPlatformTLS::SetTlsValue(BinnedTlsSlot, Lists);
+#endif
+}
+
+void FMallocBinned2::ClearAndDisableTLSCachesOnCurrentThread()
+{
+#if BINNED2_ALLOW_RUNTIME_TLS_CACHES
+	FPerThreadFreeBlockLists* Lists = Private::GetFreeBlockLists(*this);
+	if (!Lists)
+	{
+		return;
+	}
+
+	FPlatformTLS::SetTlsValue(BinnedTlsSlot, nullptr);
+	{
+		BINNED2_SCOPE_LOCK();
+		for (uint32 PoolIndex = 0; PoolIndex < POOL_COUNT; ++PoolIndex)
+		{
+			Private::FlushFreeBlockList(*this, *Lists, PoolIndex, Lists->Lists[PoolIndex].Count);
+		}
+#if STATS
+		// Keep the counters of exited threads so the hit rate covers the whole run.
+		Stats.TlsCacheHits    += Lists->Hits;
+		Stats.TlsCacheMisses  += Lists->Misses;
+		Stats.TlsCacheFrees   += Lists->Frees;
+		Stats.TlsCacheRefills += Lists->Refills;
+		Stats.TlsCacheFlushes += Lists->Flushes;
+#endif
+		Lists->Unlink();
+	}
+	FMallocBinned2::Free(Lists);
+#endif
+}
+
 bool FMallocBinned2::GetAllocationSize(void* Original, SIZE_T& SizeOut)
 {
 	if (!Original)
@@ -793,6 +1139,8 @@ bool FMallocBinned2::GetAllocationSize(void* Original, SIZE_T& SizeOut)
 
 bool FMallocBinned2::ValidateHeap()
 {
+	BINNED2_SCOPE_LOCK();
+
 	for (FPoolTable& Table : PoolTable)
 	{
 		for( FPoolInfo** PoolPtr = &Table.FirstPool; *PoolPtr; PoolPtr = &(*PoolPtr)->Next )
@@ -821,7 +1169,12 @@ void FMallocBinned2::UpdateStats()
 	FMalloc::UpdateStats();
 #if STATS
 
-	Private::UpdateSlackStat(*this);
+	uint64 TlsHits, TlsMisses, TlsFrees, TlsRefills, TlsFlushes;
+	{
+		BINNED2_SCOPE_LOCK();
+		Private::UpdateSlackStat(*this);
+		Private::GatherTlsCacheStats(*this, TlsHits, TlsMisses, TlsFrees, TlsRefills, TlsFlushes);
+	}
 
 	SET_MEMORY_STAT( STAT_Binned2_OsCurrent,     Stats.OsCurrent );
 	SET_MEMORY_STAT( STAT_Binned2_OsPeak,        Stats.OsPeak );
@@ -832,6 +1185,10 @@ void FMallocBinned2::UpdateStats()
 	SET_DWORD_STAT ( STAT_Binned2_CurrentAllocs, Stats.CurrentAllocs );
 	SET_DWORD_STAT ( STAT_Binned2_TotalAllocs,   Stats.TotalAllocs );
 	SET_MEMORY_STAT( STAT_Binned2_SlackCurrent,  Stats.SlackCurrent );
+	SET_MEMORY_STAT( STAT_Binned2_TlsCachedCurrent, Stats.TlsCachedCurrent );
+	SET_DWORD_STAT ( STAT_Binned2_TlsCacheHits,     TlsHits );
+	SET_DWORD_STAT ( STAT_Binned2_TlsCacheMisses,   TlsMisses );
+	SET_FLOAT_STAT ( STAT_Binned2_TlsCacheHitRate,  TlsHits + TlsMisses ? 100.0f * TlsHits / (TlsHits + TlsMisses) : 0.0f );
 #endif
 }
 
@@ -839,9 +1196,13 @@ void FMallocBinned2::DumpAllocatorStats( class FOutputDevice& Ar )
 {
 	FBufferedOutputDevice BufferedOutput;
 	{
+		BINNED2_SCOPE_LOCK();
 		ValidateHeap();
 #if STATS
 		Private::UpdateSlackStat(*this);
+
+		uint64 TlsHits, TlsMisses, TlsFrees, TlsRefills, TlsFlushes;
+		Private::GatherTlsCacheStats(*this, TlsHits, TlsMisses, TlsFrees, TlsRefills, TlsFlushes);
 #if !NO_LOGGING
 		// This is all of the memory including stuff too big for the pools
 		BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "Allocator Stats for %s:" ), GetDescriptiveName() );
@@ -856,6 +1217,12 @@ void FMallocBinned2::DumpAllocatorStats( class FOutputDevice& Ar )
 
 		BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "Allocs      % 6i Current / % 6i Total" ), Stats.CurrentAllocs, Stats.TotalAllocs );
 
+		// Blocks held by per-thread caches are counted as used by the pool tables below.
+		BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "TLS Cached  %.2f MB, hit rate %.2f%% (%llu hits, %llu misses, %llu frees, %llu refills, %llu flushes)" ),
+									  Stats.TlsCachedCurrent / (1024.0f * 1024.0f),
+									  TlsHits + TlsMisses ? 100.0f * TlsHits / (TlsHits + TlsMisses) : 0.0f,
+									  TlsHits, TlsMisses, TlsFrees, TlsRefills, TlsFlushes );
+
 		// This is the memory tracked inside individual allocation pools
 		BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "" ) );
 		BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "Block Size Num Pools Max Pools Cur Allocs Total Allocs Min Req Max Req Mem Used Mem Slack Mem Waste Efficiency" ) );
@@ -10,6 +10,10 @@ DEFINE_STAT( STAT_EventWaitWithId );
 DEFINE_STAT( STAT_EventTriggerWithId );
 
 DECLARE_DWORD_COUNTER_STAT( TEXT( "ThreadPoolDummyCounter" ), STAT_ThreadPoolDummyCounter, STATGROUP_ThreadPoolAsyncTasks );
+DECLARE_DWORD_ACCUMULATOR_STAT( TEXT( "Queued Work" ), STAT_ThreadPool_QueuedWork, STATGROUP_ThreadPoolAsyncTasks );
+DECLARE_DWORD_COUNTER_STAT( TEXT( "Executed Work" ), STAT_ThreadPool_WorkExecuted, STATGROUP_ThreadPoolAsyncTasks );
+DECLARE_FLOAT_COUNTER_STAT( TEXT( "Work Wait Time (ms)" ), STAT_ThreadPool_WaitTime, STATGROUP_ThreadPoolAsyncTasks );
+DECLARE_FLOAT_COUNTER_STAT( TEXT( "Work Execution Time (ms)" ), STAT_ThreadPool_ExecutionTime, STATGROUP_ThreadPoolAsyncTasks );
 
 /** The global thread pool */
 FQueuedThreadPool* GThreadPool = nullptr;
@@ -371,6 +375,9 @@ protected:
 	/** My Thread  */
 	FRunnableThread* Thread;
 
+	/** How long the last job took, read by the pool in ReturnToPoolOrGetNextJob. */
+	uint32 LastWorkCycles;
+
 	/**
 	 * The real thread entry point. It waits for work events to be queued. Once
 	 * an event is queued, it executes it and goes back to waiting.
@@ -396,8 +403,10 @@ protected:
 			check(LocalQueuedWork || TimeToDie); // well you woke me up, where is the job or termination request?
 			while (LocalQueuedWork)
 			{
+				const uint32 StartCycles = FPlatformTime::Cycles();
 				// Tell the object to do the work
 				LocalQueuedWork->DoThreadedWork();
+				LastWorkCycles = FPlatformTime::Cycles() - StartCycles;
 				// Let the object cleanup before we remove our ref to it
 				LocalQueuedWork = OwningThreadPool->ReturnToPoolOrGetNextJob(this);
 			} 
@@ -414,6 +423,7 @@ public:
 		, QueuedWork(nullptr)
 		, OwningThreadPool(nullptr)
 		, Thread(nullptr)
+		, LastWorkCycles(0)
 	{ }
 
 	/**
@@ -423,9 +433,10 @@ public:
 	 * @param InPool The thread pool interface used to place this thread back into the pool of available threads when its work is done
 	 * @param InStackSize The size of the stack to create. 0 means use the current thread's stack size
 	 * @param ThreadPriority priority of new thread
+	 * @param AffinityMask CPU affinity of the new thread
 	 * @return True if the thread and all of its initialization was successful, false otherwise
 	 */
-	virtual bool Create(class FQueuedThreadPool* InPool,uint32 InStackSize = 0,EThreadPriority ThreadPriority=TPri_Normal)
+	virtual bool Create(class FQueuedThreadPool* InPool,uint32 InStackSize = 0,EThreadPriority ThreadPriority=TPri_Normal,uint64 AffinityMask=FPlatformAffinity::GetPoolThreadMask())
 	{
 		static int32 PoolThreadIndex = 0;
 		const FString PoolThreadName = FString::Printf( TEXT( "PoolThread %d" ), PoolThreadIndex );
@@ -433,7 +444,7 @@ public:
 
 		OwningThreadPool = InPool;
 		DoWorkEvent = FPlatformProcess::GetSynchEventFromPool();
-		Thread = FRunnableThread::Create(this, *PoolThreadName, InStackSize, ThreadPriority, FPlatformAffinity::GetPoolThreadMask());
+		Thread = FRunnableThread::Create(this, *PoolThreadName, InStackSize, ThreadPriority, AffinityMask);
 		check(Thread);
 		return true;
 	}
@@ -482,9 +493,45 @@ public:
 		DoWorkEvent->Trigger();
 	}
 
+	/** @return how long the last job took, only valid in ReturnToPoolOrGetNextJob */
+	uint32 GetLastWorkCycles() const
+	{
+		return LastWorkCycles;
+	}
 };
 
 
+/*-----------------------------------------------------------------------------
+	FQueuedThreadPoolHistogram
+-----------------------------------------------------------------------------*/
+
+uint32 FQueuedThreadPoolHistogram::GetCount() const
+{
+	uint32 Count = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++)
+	{
+		Count += Buckets[Bucket];
+	}
+	return Count;
+}
+
+uint64 FQueuedThreadPoolHistogram::GetPercentile(float Percentile) const
+{
+	const uint32 Count = GetCount();
+	const uint32 Target = FMath::Max<uint32>((uint32)FMath::CeilToInt(Count * FMath::Clamp(Percentile, 0.0f, 1.0f)), 1);
+	uint32 Sum = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++)
+	{
+		Sum += Buckets[Bucket];
+		if (Sum >= Target)
+		{
+			return Bucket ? (1ull << Bucket) - 1 : 0;
+		}
+	}
+	return 0;
+}
+
+
 /**
  * Implementation of a queued thread pool.
  */
@@ -492,8 +539,15 @@ class FQueuedThreadPoolBase : public FQueuedThreadPool
 {
 protected:
 
-	/** The work queue to pull from. */
-	TArray<IQueuedWork*> QueuedWork;
+	/** Queued work and when it was queued. */
+	struct FQueuedWorkEntry
+	{
+		IQueuedWork* Work;
+		uint32 QueuedCycles;
+	};
+
+	/** The work queues to pull from, one per priority band. */
+	TArray<FQueuedWorkEntry> QueuedWork[(int32)EQueuedWorkPriority::Count];
 	
 	/** The thread pool to dole work out to. */
 	TArray<FQueuedThread*> QueuedThreads;
@@ -501,18 +555,46 @@ protected:
 	/** All threads in the pool. */
 	TArray<FQueuedThread*> AllThreads;
 
+	/** Threads that left the pool after SetNumThreads, idle until they are killed. */
+	TArray<FQueuedThread*> RetiredThreads;
+
+	/** Number of busy threads that leave the pool when they finish their job. */
+	int32 NumThreadsToRetire;
+
 	/** The synchronization object used to protect access to the queued work. */
 	FCriticalSection* SynchQueue;
 
 	/** If true, indicates the destruction process has taken place. */
 	bool TimeToDie;
 
+	/** Settings for threads created after Create. */
+	uint32 StackSize;
+	EThreadPriority ThreadPriority;
+
+	/** Affinity masks new threads are spread over, the default pool thread mask if empty. */
+	TArray<uint64> AffinityMasks;
+	int32 NextAffinityGroup;
+
+	/** Name in the metrics. */
+	FString Name;
+
+	/** Metrics, protected by SynchQueue. */
+	uint64 NumExecuted;
+	FQueuedThreadPoolHistogram QueueDepthHistogram;
+	FQueuedThreadPoolHistogram WaitTimeHistogram;
+	FQueuedThreadPoolHistogram ExecutionTimeHistogram;
+
 public:
 
 	/** Default constructor. */
 	FQueuedThreadPoolBase()
-		: SynchQueue(nullptr)
+		: NumThreadsToRetire(0)
+		, SynchQueue(nullptr)
 		, TimeToDie(0)
+		, StackSize(0)
+		, ThreadPriority(TPri_Normal)
+		, NextAffinityGroup(0)
+		, NumExecuted(0)
 	{ }
 
 	/** Virtual destructor (cleans up the synchronization objects). */
@@ -521,39 +603,27 @@ public:
 		Destroy();
 	}
 
-	virtual bool Create(uint32 InNumQueuedThreads,uint32 StackSize = (32 * 1024),EThreadPriority ThreadPriority=TPri_Normal) override
+	virtual bool Create(uint32 InNumQueuedThreads,uint32 InStackSize = (32 * 1024),EThreadPriority InThreadPriority=TPri_Normal,const TCHAR* InName = TEXT("UnnamedThreadPool")) override
 	{
 		// Make sure we have synch objects
 		bool bWasSuccessful = true;
 		check(SynchQueue == nullptr);
 		SynchQueue = new FCriticalSection();
-		FScopeLock Lock(SynchQueue);
-		// Presize the array so there is no extra memory allocated
-		check(QueuedThreads.Num() == 0);
-		QueuedThreads.Empty(InNumQueuedThreads);
-
-		// Check for stack size override.
-		if( OverrideStackSize > StackSize )
-		{
-			StackSize = OverrideStackSize;
-		}
-
-		// Now create each thread and add it to the array
-		for (uint32 Count = 0; Count < InNumQueuedThreads && bWasSuccessful == true; Count++)
 		{
-			// Create a new queued thread
-			FQueuedThread* pThread = new FQueuedThread();
-			// Now create the thread and add it if ok
-			if (pThread->Create(this,StackSize,ThreadPriority) == true)
+			FScopeLock Lock(SynchQueue);
+			// Presize the array so there is no extra memory allocated
+			check(QueuedThreads.Num() == 0);
+			QueuedThreads.Empty(InNumQueuedThreads);
+
+			// Check for stack size override.
+			StackSize = FMath::Max(InStackSize, OverrideStackSize);
+			ThreadPriority = InThreadPriority;
+			Name = InName;
+
+			// Now create each thread and add it to the array
+			for (uint32 Count = 0; Count < InNumQueuedThreads && bWasSuccessful == true; Count++)
 			{
-				QueuedThreads.Add(pThread);
-				AllThreads.Add(pThread);
-			}
-			else
-			{
-				// Failed to fully create so clean up
-				bWasSuccessful = false;
-				delete pThread;
+				bWasSuccessful = CreateThread() != nullptr;
 			}
 		}
 		// Destroy any created threads if the full set was not successful
@@ -561,6 +631,11 @@ public:
 		{
 			Destroy();
 		}
+		else
+		{
+			FScopeLock Lock(&GetAllPoolsCriticalSection());
+			GetAllPools().Add(this);
+		}
 		return bWasSuccessful;
 	}
 
@@ -568,17 +643,25 @@ public:
 	{
 		if (SynchQueue)
 		{
+			{
+				FScopeLock Lock(&GetAllPoolsCriticalSection());
+				GetAllPools().Remove(this);
+			}
 			{
 				FScopeLock Lock(SynchQueue);
 				TimeToDie = 1;
 				FPlatformMisc::MemoryBarrier();
 				// Clean up all queued objects
-				for (int32 Index = 0; Index < QueuedWork.Num(); Index++)
+				for (int32 Priority = 0; Priority < (int32)EQueuedWorkPriority::Count; Priority++)
 				{
-					QueuedWork[Index]->Abandon();
+					for (int32 Index = 0; Index < QueuedWork[Priority].Num(); Index++)
+					{
+						QueuedWork[Priority][Index].Work->Abandon();
+					}
+					DEC_DWORD_STAT_BY(STAT_ThreadPool_QueuedWork, QueuedWork[Priority].Num());
+					// Empty out the invalid pointers
+					QueuedWork[Priority].Empty();
 				}
-				// Empty out the invalid pointers
-				QueuedWork.Empty();
 			}
 			// wait for all threads to finish up
 			while (1)
@@ -595,6 +678,7 @@ public:
 			// Delete all threads
 			{
 				FScopeLock Lock(SynchQueue);
+				AllThreads.Append(RetiredThreads);
 				// Now tell each thread to die and delete those
 				for (int32 Index = 0; Index < AllThreads.Num(); Index++)
 				{
@@ -603,6 +687,8 @@ public:
 				}
 				QueuedThreads.Empty();
 				AllThreads.Empty();
+				RetiredThreads.Empty();
+				NumThreadsToRetire = 0;
 			}
 			delete SynchQueue;
 			SynchQueue = nullptr;
@@ -613,10 +699,15 @@ public:
 	{
 		// this is a estimate of the number of queued jobs. 
 		// no need for thread safe lock as the queuedWork array isn't moved around in memory so unless this class is being destroyed then we don't need to wrory about it
-		return QueuedWork.Num();
+		int32 NumQueuedJobs = 0;
+		for (int32 Priority = 0; Priority < (int32)EQueuedWorkPriority::Count; Priority++)
+		{
+			NumQueuedJobs += QueuedWork[Priority].Num();
+		}
+		return NumQueuedJobs;
 	}
 
-	void AddQueuedWork(IQueuedWork* InQueuedWork) override
+	void AddQueuedWork(IQueuedWork* InQueuedWork, EQueuedWorkPriority InPriority = EQueuedWorkPriority::Normal) override
 	{
 		if (TimeToDie)
 		{
@@ -624,11 +715,13 @@ public:
 			return;
 		}
 		check(InQueuedWork != nullptr);
+		check(InPriority < EQueuedWorkPriority::Count);
 		FQueuedThread* Thread = nullptr;
 		// Check to see if a thread is available. Make sure no other threads
 		// can manipulate the thread pool while we do this.
 		check(SynchQueue);
 		FScopeLock sl(SynchQueue);
+		QueueDepthHistogram.Add(GetNumQueuedJobs());
 		if (QueuedThreads.Num() > 0)
 		{
 			// Cycle through all available threads to make sure that stats are up to date.
@@ -642,13 +735,18 @@ public:
 		if (Thread != nullptr)
 		{
 			// We have a thread, so tell it to do the work
+			WaitTimeHistogram.Add(0);
 			Thread->DoWork(InQueuedWork);
 		}
 		else
 		{
 			// There were no threads available, queue the work to be done
 			// as soon as one does become available
-			QueuedWork.Add(InQueuedWork);
+			FQueuedWorkEntry Entry;
+			Entry.Work = InQueuedWork;
+			Entry.QueuedCycles = FPlatformTime::Cycles();
+			QueuedWork[(int32)InPriority].Add(Entry);
+			INC_DWORD_STAT(STAT_ThreadPool_QueuedWork);
 		}
 	}
 
@@ -661,7 +759,17 @@ public:
 		check(InQueuedWork != nullptr);
 		check(SynchQueue);
 		FScopeLock sl(SynchQueue);
-		return !!QueuedWork.RemoveSingle(InQueuedWork);
+		for (int32 Priority = 0; Priority < (int32)EQueuedWorkPriority::Count; Priority++)
+		{
+			const int32 Index = QueuedWork[Priority].IndexOfByPredicate([InQueuedWork](const FQueuedWorkEntry& Entry) { return Entry.Work == InQueuedWork; });
+			if (Index != INDEX_NONE)
+			{
+				QueuedWork[Priority].RemoveAt(Index);
+				DEC_DWORD_STAT(STAT_ThreadPool_QueuedWork);
+				return true;
+			}
+		}
+		return false;
 	}
 
 	virtual IQueuedWork* ReturnToPoolOrGetNextJob(FQueuedThread* InQueuedThread) override
@@ -670,18 +778,38 @@ public:
 		IQueuedWork* Work = nullptr;
 		// Check to see if there is any work to be done
 		FScopeLock sl(SynchQueue);
+
+		const double ExecutionMicroseconds = FPlatformTime::ToSeconds(InQueuedThread->GetLastWorkCycles()) * 1000000.0;
+		ExecutionTimeHistogram.Add((uint64)ExecutionMicroseconds);
+		NumExecuted++;
+		INC_DWORD_STAT(STAT_ThreadPool_WorkExecuted);
+		INC_FLOAT_STAT_BY(STAT_ThreadPool_ExecutionTime, (float)(ExecutionMicroseconds / 1000.0));
+
 		if (TimeToDie)
 		{
-			check(!QueuedWork.Num());  // we better not have anything if we are dying
+			check(!GetNumQueuedJobs());  // we better not have anything if we are dying
 		}
-		if (QueuedWork.Num() > 0)
+		if (NumThreadsToRetire > 0)
 		{
-			// Grab the oldest work in the queue. This is slower than
-			// getting the most recent but prevents work from being
-			// queued and never done
-			Work = QueuedWork[0];
-			// Remove it from the list so no one else grabs it
-			QueuedWork.RemoveAt(0);
+			// the pool was shrunk while this thread was busy
+			NumThreadsToRetire--;
+			AllThreads.RemoveSingleSwap(InQueuedThread);
+			RetiredThreads.Add(InQueuedThread);
+			return nullptr;
+		}
+		for (int32 Priority = 0; Priority < (int32)EQueuedWorkPriority::Count && !Work; Priority++)
+		{
+			if (QueuedWork[Priority].Num() > 0)
+			{
+				// Grab the oldest work in the highest priority queue. This is slower than
+				// getting the most recent but prevents work from being
+				// queued and never done
+				const FQueuedWorkEntry Entry = QueuedWork[Priority][0];
+				Work = Entry.Work;
+				// Remove it from the list so no one else grabs it
+				QueuedWork[Priority].RemoveAt(0);
+				RecordDequeue(Entry);
+			}
 		}
 		if (!Work)
 		{
@@ -690,8 +818,210 @@ public:
 		}
 		return Work;
 	}
+
+	virtual void SetNumThreads(uint32 InNumQueuedThreads) override
+	{
+		check(InNumQueuedThreads > 0);
+		check(SynchQueue);
+
+		TArray<FQueuedThread*> ThreadsToKill;
+		{
+			FScopeLock Lock(SynchQueue);
+			if (TimeToDie)
+			{
+				return;
+			}
+
+			// threads that retired since the last call are idle by now
+			ThreadsToKill = MoveTemp(RetiredThreads);
+			RetiredThreads.Reset();
+
+			int32 NumToAdd = (int32)InNumQueuedThreads - (AllThreads.Num() - NumThreadsToRetire);
+			if (NumToAdd > 0)
+			{
+				// keep the busy threads that were about to leave first
+				const int32 NumKept = FMath::Min(NumToAdd, NumThreadsToRetire);
+				NumThreadsToRetire -= NumKept;
+				NumToAdd -= NumKept;
+
+				for (int32 Count = 0; Count < NumToAdd; Count++)
+				{
+					FQueuedThread* Thread = CreateThread();
+					if (!Thread)
+					{
+						break;
+					}
+					// put the new thread to work right away if anything is waiting
+					for (int32 Priority = 0; Priority < (int32)EQueuedWorkPriority::Count; Priority++)
+					{
+						if (QueuedWork[Priority].Num() > 0)
+						{
+							const FQueuedWorkEntry Entry = QueuedWork[Priority][0];
+							QueuedWork[Priority].RemoveAt(0);
+							RecordDequeue(Entry);
+							QueuedThreads.RemoveSingleSwap(Thread);
+							Thread->DoWork(Entry.Work);
+							break;
+						}
+					}
+				}
+			}
+			else
+			{
+				// idle threads leave right away, busy ones when they finish their job
+				int32 NumToRemove = -NumToAdd;
+				while (NumToRemove > 0 && QueuedThreads.Num() > 0)
+				{
+					FQueuedThread* Thread = QueuedThreads.Pop(false);
+					AllThreads.RemoveSingleSwap(Thread);
+					ThreadsToKill.Add(Thread);
+					NumToRemove--;
+				}
+				NumThreadsToRetire += NumToRemove;
+			}
+		}
+
+		// idle threads only wait for their event, so they can be killed without holding the lock
+		for (FQueuedThread* Thread : ThreadsToKill)
+		{
+			Thread->KillThread();
+			delete Thread;
+		}
+	}
+
+	virtual int32 GetNumThreads() const override
+	{
+		check(SynchQueue);
+		FScopeLock Lock(SynchQueue);
+		return AllThreads.Num() - NumThreadsToRetire;
+	}
+
+	virtual void SetAffinityGroups(const TArray<uint64>& InAffinityMasks) override
+	{
+		if (SynchQueue)
+		{
+			FScopeLock Lock(SynchQueue);
+			AffinityMasks = InAffinityMasks;
+		}
+		else
+		{
+			AffinityMasks = InAffinityMasks;
+		}
+	}
+
+	virtual void GetMetrics(FQueuedThreadPoolMetrics& OutMetrics, bool bReset = false) override
+	{
+		check(SynchQueue);
+		FScopeLock Lock(SynchQueue);
+
+		OutMetrics.NumThreads = AllThreads.Num() - NumThreadsToRetire;
+		OutMetrics.NumIdleThreads = QueuedThreads.Num();
+		for (int32 Priority = 0; Priority < (int32)EQueuedWorkPriority::Count; Priority++)
+		{
+			OutMetrics.QueueDepth[Priority] = QueuedWork[Priority].Num();
+		}
+		OutMetrics.NumExecuted = NumExecuted;
+		OutMetrics.QueueDepthHistogram = QueueDepthHistogram;
+		OutMetrics.WaitTimeHistogram = WaitTimeHistogram;
+		OutMetrics.ExecutionTimeHistogram = ExecutionTimeHistogram;
+
+		if (bReset)
+		{
+			NumExecuted = 0;
+			QueueDepthHistogram.Reset();
+			WaitTimeHistogram.Reset();
+			ExecutionTimeHistogram.Reset();
+		}
+	}
+
+	const FString& GetName() const
+	{
+		return Name;
+	}
+
+	/** All created pools, for ThreadPool.DumpMetrics. */
+	static TArray<FQueuedThreadPoolBase*>& GetAllPools()
+	{
+		static TArray<FQueuedThreadPoolBase*> AllPools;
+		return AllPools;
+	}
+
+	static FCriticalSection& GetAllPoolsCriticalSection()
+	{
+		static FCriticalSection AllPoolsCriticalSection;
+		return AllPoolsCriticalSection;
+	}
+
+protected:
+
+	/** Creates a thread in the next affinity group and adds it to the idle threads, SynchQueue must be locked. */
+	FQueuedThread* CreateThread()
+	{
+		const uint64 AffinityMask = AffinityMasks.Num() ? AffinityMasks[NextAffinityGroup++ % AffinityMasks.Num()] : FPlatformAffinity::GetPoolThreadMask();
+
+		// Create a new queued thread
+		FQueuedThread* pThread = new FQueuedThread();
+		// Now create the thread and add it if ok
+		if (pThread->Create(this,StackSize,ThreadPriority,AffinityMask) == true)
+		{
+			QueuedThreads.Add(pThread);
+			AllThreads.Add(pThread);
+			return pThread;
+		}
+
+		// Failed to fully create so clean up
+		delete pThread;
+		return nullptr;
+	}
+
+	/** Updates the metrics for work taken off a queue, SynchQueue must be locked. */
+	void RecordDequeue(const FQueuedWorkEntry& Entry)
+	{
+		const double WaitMicroseconds = FPlatformTime::ToSeconds(FPlatformTime::Cycles() - Entry.QueuedCycles) * 1000000.0;
+		WaitTimeHistogram.Add((uint64)WaitMicroseconds);
+		DEC_DWORD_STAT(STAT_ThreadPool_QueuedWork);
+		INC_FLOAT_STAT_BY(STAT_ThreadPool_WaitTime, (float)(WaitMicroseconds / 1000.0));
+	}
 };
 
+/** Logs the metrics of one histogram, skipping empty buckets. */
+static void DumpQueuedThreadPoolHistogram(FOutputDevice& Ar, const TCHAR* HistogramName, const TCHAR* Unit, const FQueuedThreadPoolHistogram& Histogram)
+{
+	Ar.Logf(TEXT("    %s: %u samples, p50 <= %llu %s, p90 <= %llu %s, p99 <= %llu %s"), HistogramName, Histogram.GetCount(),
+		Histogram.GetPercentile(0.5f), Unit, Histogram.GetPercentile(0.9f), Unit, Histogram.GetPercentile(0.99f), Unit);
+	for (int32 Bucket = 0; Bucket < FQueuedThreadPoolHistogram::NumBuckets; Bucket++)
+	{
+		if (Histogram.Buckets[Bucket])
+		{
+			Ar.Logf(TEXT("      < %8llu %s: %u"), 1ull << Bucket, Unit, Histogram.Buckets[Bucket]);
+		}
+	}
+}
+
+static void DumpQueuedThreadPoolMetrics(const TArray<FString>& Args)
+{
+	const bool bReset = Args.Contains(TEXT("Reset"));
+
+	FScopeLock Lock(&FQueuedThreadPoolBase::GetAllPoolsCriticalSection());
+	for (FQueuedThreadPoolBase* Pool : FQueuedThreadPoolBase::GetAllPools())
+	{
+		FQueuedThreadPoolMetrics Metrics;
+		Pool->GetMetrics(Metrics, bReset);
+
+		GLog->Logf(TEXT("%s: %d threads (%d idle), queued high %d normal %d low %d, %llu executed"), *Pool->GetName(), Metrics.NumThreads, Metrics.NumIdleThreads,
+			Metrics.QueueDepth[(int32)EQueuedWorkPriority::High], Metrics.QueueDepth[(int32)EQueuedWorkPriority::Normal], Metrics.QueueDepth[(int32)EQueuedWorkPriority::Low], Metrics.NumExecuted);
+		DumpQueuedThreadPoolHistogram(*GLog, TEXT("Queue depth"), TEXT("jobs"), Metrics.QueueDepthHistogram);
+		DumpQueuedThreadPoolHistogram(*GLog, TEXT("Wait time"), TEXT("us"), Metrics.WaitTimeHistogram);
+		DumpQueuedThreadPoolHistogram(*GLog, TEXT("Execution time"), TEXT("us"), Metrics.ExecutionTimeHistogram);
+	}
+}
+
+static FAutoConsoleCommand DumpQueuedThreadPoolMetricsCommand(
+	TEXT("ThreadPool.DumpMetrics"),
+	TEXT("Logs thread counts, queue depths and the queue depth, wait time and execution time histograms of all queued thread pools. Add Reset to start new histograms."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&DumpQueuedThreadPoolMetrics)
+	);
+
 uint32 FQueuedThreadPool::OverrideStackSize = 0;
 
 FQueuedThreadPool* FQueuedThreadPool::Allocate()
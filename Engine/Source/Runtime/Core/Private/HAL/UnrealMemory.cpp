@@ -114,6 +114,24 @@ void FMemory::Free( void* Original )
 	return GMalloc->Free( Original );
 }
 
+void FMemory::SetupTLSCachesOnCurrentThread()
+{
+	if( !GMalloc )
+	{
+		GCreateMalloc();
+		CA_ASSUME( GMalloc != NULL );	// Don't want to assert, but suppress static analysis warnings about potentially NULL GMalloc
+	}
+	GMalloc->SetupTLSCachesOnCurrentThread();
+}
+
+void FMemory::ClearAndDisableTLSCachesOnCurrentThread()
+{
+	if( GMalloc )
+	{
+		GMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+}
+
 void* FMemory::GPUMalloc(SIZE_T Count, uint32 Alignment /* = DEFAULT_ALIGNMENT */)
 {
 	return FPlatformMemory::GPUMalloc(Count, Alignment);
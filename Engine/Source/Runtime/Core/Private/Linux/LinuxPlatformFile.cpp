@@ -3,6 +3,7 @@
 #include "CorePrivatePCH.h"
 #include <sys/file.h>	// flock()
 #include <sys/stat.h>   // mkdirp()
+#include <sys/mman.h>   // mmap()
 
 DEFINE_LOG_CATEGORY_STATIC(LogLinuxPlatformFile, Log, All);
 
@@ -319,6 +320,134 @@ __thread FFileHandleLinux* FFileHandleLinux::ActiveHandles[ FFileHandleLinux::AC
 __thread double FFileHandleLinux::AccessTimes[ FFileHandleLinux::ACTIVE_HANDLE_COUNT ];
 #endif // MANAGE_FILE_HANDLES
 
+/**
+ * Linux async read handle. pread doesn't use the file position, so all IO threads share one descriptor.
+ */
+class FLinuxAsyncReadFileHandle : public FQueuedAsyncReadFileHandle
+{
+	enum {READ_SIZE = 1024 * 1024};
+
+public:
+	explicit FLinuxAsyncReadFileHandle(int32 InFileHandle)
+		: FileHandle(InFileHandle)
+	{
+		check(FileHandle > -1);
+	}
+
+	virtual ~FLinuxAsyncReadFileHandle()
+	{
+		close(FileHandle);
+	}
+
+	virtual int64 GetSize() override
+	{
+		struct stat FileInfo;
+		if (fstat(FileHandle, &FileInfo) == -1)
+		{
+			return -1;
+		}
+		return FileInfo.st_size;
+	}
+
+	virtual bool ReadAt(uint8* Destination, int64 Offset, int64 BytesToRead) override
+	{
+		while (BytesToRead > 0)
+		{
+			const ssize_t ThisRead = pread(FileHandle, Destination, FMath::Min<int64>(READ_SIZE, BytesToRead), Offset);
+			if (ThisRead == -1 && errno == EINTR)
+			{
+				continue;
+			}
+			if (ThisRead <= 0)
+			{
+				return false;
+			}
+			Destination += ThisRead;
+			Offset += ThisRead;
+			BytesToRead -= ThisRead;
+		}
+		return true;
+	}
+
+private:
+	// Holds the internal file handle.
+	int32 FileHandle;
+};
+
+/**
+ * Linux mapped region, the mapping starts at the page boundary below the requested offset.
+ */
+class FLinuxMappedFileRegion : public IMappedFileRegion
+{
+public:
+	FLinuxMappedFileRegion(void* InMappingBase, SIZE_T InMappingSize, int64 AlignmentPadding, int64 InMappedSize)
+		: IMappedFileRegion((const uint8*)InMappingBase + AlignmentPadding, InMappedSize)
+		, MappingBase(InMappingBase)
+		, MappingSize(InMappingSize)
+	{
+	}
+
+	virtual ~FLinuxMappedFileRegion()
+	{
+		if (munmap(MappingBase, MappingSize) != 0)
+		{
+			int ErrNo = errno;
+			UE_LOG(LogLinuxPlatformFile, Warning, TEXT("munmap failed: errno=%d (%s)"), ErrNo, ANSI_TO_TCHAR(strerror(ErrNo)));
+		}
+	}
+
+private:
+	/** Start of the mapping, page aligned. */
+	void* MappingBase;
+	/** Size of the mapping. */
+	SIZE_T MappingSize;
+};
+
+/**
+ * Linux mapped file handle, the descriptor stays open so regions can be mapped until the handle is deleted.
+ */
+class FLinuxMappedFileHandle : public IMappedFileHandle
+{
+public:
+	FLinuxMappedFileHandle(int32 InFileHandle, int64 InFileSize)
+		: IMappedFileHandle(InFileSize)
+		, FileHandle(InFileHandle)
+	{
+		check(FileHandle > -1);
+	}
+
+	virtual ~FLinuxMappedFileHandle()
+	{
+		close(FileHandle);
+	}
+
+	virtual IMappedFileRegion* MapRegion(int64 Offset, int64 BytesToMap) override
+	{
+		if (Offset < 0 || Offset >= GetFileSize() || BytesToMap <= 0)
+		{
+			return nullptr;
+		}
+		BytesToMap = FMath::Min(BytesToMap, GetFileSize() - Offset);
+
+		static const int64 PageSize = sysconf(_SC_PAGESIZE);
+		const int64 AlignmentPadding = Offset % PageSize;
+		const SIZE_T MappingSize = (SIZE_T)(BytesToMap + AlignmentPadding);
+
+		void* MappingBase = mmap(nullptr, MappingSize, PROT_READ, MAP_PRIVATE, FileHandle, Offset - AlignmentPadding);
+		if (MappingBase == MAP_FAILED)
+		{
+			int ErrNo = errno;
+			UE_LOG(LogLinuxPlatformFile, Warning, TEXT("mmap of %lld bytes at %lld failed: errno=%d (%s)"), (int64)MappingSize, Offset - AlignmentPadding, ErrNo, ANSI_TO_TCHAR(strerror(ErrNo)));
+			return nullptr;
+		}
+		return new FLinuxMappedFileRegion(MappingBase, MappingSize, AlignmentPadding, BytesToMap);
+	}
+
+private:
+	// Holds the internal file handle.
+	int32 FileHandle;
+};
+
 /**
  * A class to handle case insensitive file opening. This is a band-aid, non-performant approach,
  * without any caching.
@@ -801,6 +930,35 @@ IFileHandle* FLinuxPlatformFile::OpenRead(const TCHAR* Filename, bool bAllowWrit
 	return nullptr;
 }
 
+IAsyncReadFileHandle* FLinuxPlatformFile::OpenAsyncRead(const TCHAR* Filename)
+{
+	FString MappedToName;
+	int32 Handle = GCaseInsensMapper.OpenCaseInsensitiveRead(NormalizeFilename(Filename), MappedToName);
+	if (Handle != -1)
+	{
+		return new FLinuxAsyncReadFileHandle(Handle);
+	}
+	return nullptr;
+}
+
+IMappedFileHandle* FLinuxPlatformFile::OpenMapped(const TCHAR* Filename)
+{
+	FString MappedToName;
+	int32 Handle = GCaseInsensMapper.OpenCaseInsensitiveRead(NormalizeFilename(Filename), MappedToName);
+	if (Handle == -1)
+	{
+		return nullptr;
+	}
+
+	struct stat FileInfo;
+	if (fstat(Handle, &FileInfo) == -1)
+	{
+		close(Handle);
+		return nullptr;
+	}
+	return new FLinuxMappedFileHandle(Handle, FileInfo.st_size);
+}
+
 IFileHandle* FLinuxPlatformFile::OpenWrite(const TCHAR* Filename, bool bAppend, bool bAllowRead)
 {
 	int Flags = O_CREAT | O_CLOEXEC;	// prevent children from inheriting this
@@ -2,6 +2,7 @@
 
 #include "CorePrivatePCH.h"
 #include "CompressedGrowableBuffer.h"
+#include "LZ4Compression.h"
 #include "ThirdParty/zlib/zlib-1.2.5/Inc/zlib.h"
 
 
@@ -143,6 +144,143 @@ bool appUncompressMemoryZLIB( void* UncompressedBuffer, int32 UncompressedSize,
 	return bOperationSucceeded;
 }
 
+/**
+ * Thread-safe LZ4 compression routine, see FLZ4Compression. COMPRESS_BiasMemory selects the HC compressor and
+ * COMPRESS_BiasSpeed skips faster over incompressible data.
+ */
+static bool appCompressMemoryLZ4( ECompressionFlags Flags, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize )
+{
+	DECLARE_SCOPE_CYCLE_COUNTER( TEXT( "Compress Memory LZ4" ), STAT_appCompressMemoryLZ4, STATGROUP_Compression );
+
+	int32 Result;
+	if( Flags & COMPRESS_BiasMemory )
+	{
+		Result = FLZ4Compression::CompressHC( (const uint8*)UncompressedBuffer, UncompressedSize, (uint8*)CompressedBuffer, CompressedSize, 256 );
+	}
+	else
+	{
+		Result = FLZ4Compression::Compress( (const uint8*)UncompressedBuffer, UncompressedSize, (uint8*)CompressedBuffer, CompressedSize, (Flags & COMPRESS_BiasSpeed) ? 8 : 1 );
+	}
+
+	// The block is empty if it didn't fit into the output buffer.
+	if( Result == 0 )
+	{
+		return false;
+	}
+	CompressedSize = Result;
+	return true;
+}
+
+/**
+ * Thread-safe LZ4 decompression routine, fails on corrupt data instead of reading or writing out of bounds.
+ */
+static bool appUncompressMemoryLZ4( void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize )
+{
+	DECLARE_SCOPE_CYCLE_COUNTER( TEXT( "Uncompress Memory LZ4" ), STAT_appUncompressMemoryLZ4, STATGROUP_Compression );
+
+	return FLZ4Compression::Uncompress( (uint8*)UncompressedBuffer, UncompressedSize, (const uint8*)CompressedBuffer, CompressedSize );
+}
+
+/** Codec for COMPRESS_ZLIB. */
+class FZlibCompressionCodec : public ICompressionCodec
+{
+public:
+	virtual const TCHAR* GetName() const override
+	{
+		return TEXT("ZLIB");
+	}
+
+	virtual int32 CompressMemoryBound( ECompressionFlags Flags, int32 UncompressedSize ) const override
+	{
+		return compressBound( UncompressedSize );
+	}
+
+	virtual bool CompressMemory( ECompressionFlags Flags, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize ) const override
+	{
+		return appCompressMemoryZLIB( CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize );
+	}
+
+	virtual bool UncompressMemory( void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize ) const override
+	{
+		return appUncompressMemoryZLIB( UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize );
+	}
+};
+
+/** Codec for COMPRESS_GZIP, only supports compression. */
+class FGzipCompressionCodec : public ICompressionCodec
+{
+public:
+	virtual const TCHAR* GetName() const override
+	{
+		return TEXT("GZIP");
+	}
+
+	virtual int32 CompressMemoryBound( ECompressionFlags Flags, int32 UncompressedSize ) const override
+	{
+		// appCompressMemoryGZIP never writes more than the uncompressed size.
+		return UncompressedSize;
+	}
+
+	virtual bool CompressMemory( ECompressionFlags Flags, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize ) const override
+	{
+		return appCompressMemoryGZIP( CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize );
+	}
+
+	virtual bool UncompressMemory( void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize ) const override
+	{
+		UE_LOG(LogCompression, Warning, TEXT("FCompression::UncompressMemory - GZIP decompression is not supported"));
+		return false;
+	}
+};
+
+/** Codec for COMPRESS_LZ4. */
+class FLZ4CompressionCodec : public ICompressionCodec
+{
+public:
+	virtual const TCHAR* GetName() const override
+	{
+		return TEXT("LZ4");
+	}
+
+	virtual int32 CompressMemoryBound( ECompressionFlags Flags, int32 UncompressedSize ) const override
+	{
+		return FLZ4Compression::CompressBound( UncompressedSize );
+	}
+
+	virtual bool CompressMemory( ECompressionFlags Flags, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize ) const override
+	{
+		return appCompressMemoryLZ4( Flags, CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize );
+	}
+
+	virtual bool UncompressMemory( void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize ) const override
+	{
+		return appUncompressMemoryLZ4( UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize );
+	}
+};
+
+/**
+ * Gets the codecs indexed by compression type, the built in codecs are registered on first use.
+ */
+static ICompressionCodec** GetCompressionCodecs()
+{
+	static FZlibCompressionCodec ZlibCodec;
+	static FGzipCompressionCodec GzipCodec;
+	static FLZ4CompressionCodec LZ4Codec;
+	static struct FCompressionCodecs
+	{
+		ICompressionCodec* Codecs[COMPRESSION_FLAGS_TYPE_MASK + 1];
+
+		FCompressionCodecs()
+		{
+			FMemory::Memzero( Codecs, sizeof(Codecs) );
+			Codecs[COMPRESS_ZLIB] = &ZlibCodec;
+			Codecs[COMPRESS_GZIP] = &GzipCodec;
+			Codecs[COMPRESS_LZ4] = &LZ4Codec;
+		}
+	} CompressionCodecs;
+	return CompressionCodecs.Codecs;
+}
+
 /** Time spent compressing data in seconds. */
 double FCompression::CompressorTime		= 0;
 /** Number of bytes before compression.		*/
@@ -176,6 +314,37 @@ static ECompressionFlags CheckGlobalCompressionFlags(ECompressionFlags Flags)
 	return Flags;
 }
 
+void FCompression::RegisterCodec( ECompressionFlags Type, ICompressionCodec* Codec )
+{
+	check(Type != COMPRESS_None && (Type & ~COMPRESSION_FLAGS_TYPE_MASK) == 0);
+	check(Codec);
+	GetCompressionCodecs()[Type] = Codec;
+}
+
+void FCompression::UnregisterCodec( ECompressionFlags Type )
+{
+	check((Type & ~COMPRESSION_FLAGS_TYPE_MASK) == 0);
+	GetCompressionCodecs()[Type] = NULL;
+}
+
+ICompressionCodec* FCompression::FindCodec( ECompressionFlags Flags )
+{
+	return GetCompressionCodecs()[Flags & COMPRESSION_FLAGS_TYPE_MASK];
+}
+
+ECompressionFlags FCompression::GetCompressionTypeFromName( const TCHAR* Name )
+{
+	ICompressionCodec** Codecs = GetCompressionCodecs();
+	for( int32 Type = 1; Type <= COMPRESSION_FLAGS_TYPE_MASK; Type++ )
+	{
+		if( Codecs[Type] && FCString::Stricmp( Codecs[Type]->GetName(), Name ) == 0 )
+		{
+			return (ECompressionFlags)Type;
+		}
+	}
+	return COMPRESS_None;
+}
+
 /**
 * Thread-safe abstract compression routine to query memory requirements for a compression operation.
 *
@@ -186,18 +355,15 @@ static ECompressionFlags CheckGlobalCompressionFlags(ECompressionFlags Flags)
 int32 FCompression::CompressMemoryBound( ECompressionFlags Flags, int32 UncompressedSize ) 
 {
 	int32 CompressionBound = UncompressedSize;
+	ICompressionCodec* Codec = FindCodec(Flags);
 	// make sure a valid compression scheme was provided
-	check(Flags & COMPRESS_ZLIB);
+	check(Codec);
 
 	Flags = CheckGlobalCompressionFlags(Flags);
 
-	switch(Flags & COMPRESSION_FLAGS_TYPE_MASK)
+	if( Codec )
 	{
-	case COMPRESS_ZLIB:
-		CompressionBound = compressBound(UncompressedSize);
-		break;
-	default:
-		break;
+		CompressionBound = Codec->CompressMemoryBound(Flags, UncompressedSize);
 	}
 
 	return CompressionBound;
@@ -218,24 +384,22 @@ bool FCompression::CompressMemory( ECompressionFlags Flags, void* CompressedBuff
 {
 	double CompressorStartTime = FPlatformTime::Seconds();
 
+	ICompressionCodec* Codec = FindCodec(Flags);
 	// make sure a valid compression scheme was provided
-	check(Flags & COMPRESS_ZLIB || Flags & COMPRESS_GZIP);
+	check(Codec);
 
 	bool bCompressSucceeded = false;
 
 	Flags = CheckGlobalCompressionFlags(Flags);
 
-	switch(Flags & COMPRESSION_FLAGS_TYPE_MASK)
+	if( Codec )
 	{
-		case COMPRESS_ZLIB:
-			bCompressSucceeded = appCompressMemoryZLIB(CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize);
-			break;
-		case COMPRESS_GZIP:
-			bCompressSucceeded = appCompressMemoryGZIP(CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize);
-			break;
-		default:
-			UE_LOG(LogCompression, Warning, TEXT("appCompressMemory - This compression type not supported"));
-			bCompressSucceeded =  false;
+		bCompressSucceeded = Codec->CompressMemory(Flags, CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize);
+	}
+	else
+	{
+		UE_LOG(LogCompression, Warning, TEXT("appCompressMemory - This compression type not supported"));
+		bCompressSucceeded =  false;
 	}
 
 	// Keep track of compression time and stats.
@@ -268,39 +432,40 @@ bool FCompression::UncompressMemory( ECompressionFlags Flags, void* Uncompressed
 	// Keep track of time spent uncompressing memory.
 	STAT(double UncompressorStartTime = FPlatformTime::Seconds();)
 	
+	ICompressionCodec* Codec = FindCodec(Flags);
 	// make sure a valid compression scheme was provided
-	check(Flags & COMPRESS_ZLIB);
+	check(Codec);
 
 	bool bUncompressSucceeded = false;
 
-	switch(Flags & COMPRESSION_FLAGS_TYPE_MASK)
+	if( Codec )
 	{
-		case COMPRESS_ZLIB:
-			bUncompressSucceeded = appUncompressMemoryZLIB(UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize);
-			if (!bUncompressSucceeded)
+		bUncompressSucceeded = Codec->UncompressMemory(UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize);
+		if (!bUncompressSucceeded)
+		{
+			// This is only to skip serialization errors caused by asset corruption 
+			// that can be fixed during re-save, should never be disabled by default!
+			static struct FFailOnUncompressErrors
 			{
-				// This is only to skip serialization errors caused by asset corruption 
-				// that can be fixed during re-save, should never be disabled by default!
-				static struct FFailOnUncompressErrors
+				bool Value;
+				FFailOnUncompressErrors()
+					: Value(true) // fail by default
 				{
-					bool Value;
-					FFailOnUncompressErrors()
-						: Value(true) // fail by default
-					{
-						GConfig->GetBool(TEXT("Core.System"), TEXT("FailOnUncompressErrors"), Value, GEngineIni);
-					}
-				} FailOnUncompressErrors;
-				if (!FailOnUncompressErrors.Value)
-				{
-					bUncompressSucceeded = true;
+					GConfig->GetBool(TEXT("Core.System"), TEXT("FailOnUncompressErrors"), Value, GEngineIni);
 				}
-				// Always log an error
-				UE_LOG(LogCompression, Error, TEXT("FCompression::UncompressMemory - Failed to uncompress memory (%d/%d), this may indicate the asset is corrupt!"), CompressedSize, UncompressedSize);
+			} FailOnUncompressErrors;
+			if (!FailOnUncompressErrors.Value)
+			{
+				bUncompressSucceeded = true;
 			}
-			break;
-		default:
-			UE_LOG(LogCompression, Warning, TEXT("FCompression::UncompressMemory - This compression type not supported"));
-			bUncompressSucceeded = false;
+			// Always log an error
+			UE_LOG(LogCompression, Error, TEXT("FCompression::UncompressMemory - Failed to uncompress memory (%d/%d), this may indicate the asset is corrupt!"), CompressedSize, UncompressedSize);
+		}
+	}
+	else
+	{
+		UE_LOG(LogCompression, Warning, TEXT("FCompression::UncompressMemory - This compression type not supported"));
+		bUncompressSucceeded = false;
 	}
 
 #if	STATS
@@ -313,6 +478,147 @@ bool FCompression::UncompressMemory( ECompressionFlags Flags, void* Uncompressed
 	return bUncompressSucceeded;
 }
 
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Compresses files in chunks with every registered codec and setting and logs ratio and throughput.
+ *
+ * CompressionBenchmark [Directory] [-Wildcard=*.uasset] [-ChunkSize=KB] [-MaxMB=MB]
+ */
+static void RunCompressionBenchmark( const TCHAR* Cmd, FOutputDevice& Ar )
+{
+	FString Directory = FParse::Token(Cmd, false);
+	if( Directory.IsEmpty() || Directory.StartsWith(TEXT("-")) )
+	{
+		Directory = FPaths::GameContentDir();
+	}
+	FString Wildcard = TEXT("*");
+	FParse::Value(Cmd, TEXT("-Wildcard="), Wildcard);
+	int32 ChunkSizeKB = LOADING_COMPRESSION_CHUNK_SIZE / 1024;
+	FParse::Value(Cmd, TEXT("-ChunkSize="), ChunkSizeKB);
+	int32 MaxMB = 256;
+	FParse::Value(Cmd, TEXT("-MaxMB="), MaxMB);
+
+	const int32 ChunkSize = FMath::Clamp<int32>(ChunkSizeKB * 1024, 1024, FCompression::MaxUncompressedSize);
+	const int64 MaxBytes = (int64)FMath::Max(MaxMB, 1) * 1024 * 1024;
+
+	// Load everything up front so that disk speed doesn't affect the results.
+	TArray<FString> Filenames;
+	IFileManager::Get().FindFilesRecursive(Filenames, *Directory, *Wildcard, true, false);
+	TArray<uint8> Content;
+	for( const FString& Filename : Filenames )
+	{
+		TArray<uint8> FileData;
+		if( FFileHelper::LoadFileToArray(FileData, *Filename, FILEREAD_Silent) )
+		{
+			const int32 NumBytes = (int32)FMath::Min<int64>(FileData.Num(), MaxBytes - Content.Num());
+			Content.Append(FileData.GetData(), NumBytes);
+			if( Content.Num() >= MaxBytes )
+			{
+				break;
+			}
+		}
+	}
+	if( Content.Num() == 0 )
+	{
+		Ar.Logf(TEXT("CompressionBenchmark: no files matching %s found in %s"), *Wildcard, *Directory);
+		return;
+	}
+
+	const int32 NumChunks = (Content.Num() + ChunkSize - 1) / ChunkSize;
+	const double ContentMB = Content.Num() / (1024.0 * 1024.0);
+	Ar.Logf(TEXT("CompressionBenchmark: %.1f MB from %d files in %s, %d KB chunks"), ContentMB, Filenames.Num(), *Directory, ChunkSize / 1024);
+	Ar.Logf(TEXT("%-8s %-11s %7s %14s %16s"), TEXT("Codec"), TEXT("Setting"), TEXT("Ratio"), TEXT("Compress MB/s"), TEXT("Decompress MB/s"));
+
+	static const struct
+	{
+		ECompressionFlags Option;
+		const TCHAR* Name;
+	} Settings[] =
+	{
+		{ COMPRESS_BiasSpeed, TEXT("BiasSpeed") },
+		{ COMPRESS_None, TEXT("Default") },
+		{ COMPRESS_BiasMemory, TEXT("BiasMemory") },
+	};
+
+	TArray<uint8> Compressed;
+	TArray<int32> CompressedSizes;
+	TArray<uint8> Uncompressed;
+	Uncompressed.SetNumUninitialized(ChunkSize);
+
+	for( int32 Type = 1; Type <= COMPRESSION_FLAGS_TYPE_MASK; Type++ )
+	{
+		ICompressionCodec* Codec = FCompression::FindCodec((ECompressionFlags)Type);
+		if( !Codec )
+		{
+			continue;
+		}
+
+		for( const auto& Setting : Settings )
+		{
+			const ECompressionFlags Flags = (ECompressionFlags)(Type | Setting.Option);
+			const int32 Bound = Codec->CompressMemoryBound(Flags, ChunkSize);
+			Compressed.SetNumUninitialized(Bound * NumChunks);
+			CompressedSizes.SetNumUninitialized(NumChunks);
+
+			bool bCompressSucceeded = true;
+			int64 TotalCompressedSize = 0;
+			double StartTime = FPlatformTime::Seconds();
+			for( int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++ )
+			{
+				const int32 Offset = ChunkIndex * ChunkSize;
+				CompressedSizes[ChunkIndex] = Bound;
+				bCompressSucceeded &= Codec->CompressMemory(Flags, &Compressed[ChunkIndex * Bound], CompressedSizes[ChunkIndex], &Content[Offset], FMath::Min(ChunkSize, Content.Num() - Offset));
+				TotalCompressedSize += CompressedSizes[ChunkIndex];
+			}
+			const double CompressTime = FPlatformTime::Seconds() - StartTime;
+			if( !bCompressSucceeded )
+			{
+				Ar.Logf(TEXT("%-8s %-11s compression failed"), Codec->GetName(), Setting.Name);
+				continue;
+			}
+
+			bool bUncompressSucceeded = true;
+			double UncompressTime = 0.0;
+			for( int32 ChunkIndex = 0; ChunkIndex < NumChunks && bUncompressSucceeded; ChunkIndex++ )
+			{
+				const int32 Offset = ChunkIndex * ChunkSize;
+				const int32 Size = FMath::Min(ChunkSize, Content.Num() - Offset);
+				StartTime = FPlatformTime::Seconds();
+				bUncompressSucceeded = Codec->UncompressMemory(Uncompressed.GetData(), Size, &Compressed[ChunkIndex * Bound], CompressedSizes[ChunkIndex]);
+				UncompressTime += FPlatformTime::Seconds() - StartTime;
+				bUncompressSucceeded = bUncompressSucceeded && FMemory::Memcmp(Uncompressed.GetData(), &Content[Offset], Size) == 0;
+			}
+
+			const double Ratio = (double)Content.Num() / FMath::Max<int64>(TotalCompressedSize, 1);
+			const double CompressSpeed = ContentMB / FMath::Max(CompressTime, 1e-9);
+			if( bUncompressSucceeded )
+			{
+				Ar.Logf(TEXT("%-8s %-11s %7.3f %14.1f %16.1f"), Codec->GetName(), Setting.Name, Ratio, CompressSpeed, ContentMB / FMath::Max(UncompressTime, 1e-9));
+			}
+			else
+			{
+				Ar.Logf(TEXT("%-8s %-11s %7.3f %14.1f %16s"), Codec->GetName(), Setting.Name, Ratio, CompressSpeed, TEXT("n/a"));
+			}
+		}
+	}
+}
+
+static class FCompressionExec : private FSelfRegisteringExec
+{
+	virtual bool Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar ) override
+	{
+		if( FParse::Command( &Cmd, TEXT("CompressionBenchmark") ) )
+		{
+			RunCompressionBenchmark( Cmd, Ar );
+			return true;
+		}
+		return false;
+	}
+} CompressionExec;
+
+#endif // !UE_BUILD_SHIPPING
+
 /*-----------------------------------------------------------------------------
 	FCompressedGrowableBuffer.
 -----------------------------------------------------------------------------*/
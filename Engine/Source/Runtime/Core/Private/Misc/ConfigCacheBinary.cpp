@@ -0,0 +1,393 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "ConfigCacheIni.h"
+#include "RemoteConfigIni.h"
+#include "EngineVersion.h"
+
+/*-----------------------------------------------------------------------------
+	FConfigCacheBinary
+
+	File layout, everything is 4 byte aligned and stored in the native byte order
+	as the cache never leaves the machine that wrote it:
+
+		FHeader
+		FSectionEntry[NumSections]		in the order of the config file
+		FValueEntry[NumValues]			grouped by section, in the order they are added back
+		int32[NumSections]				section indices sorted by name hash
+		TCHAR[NumChars]					null terminated strings
+-----------------------------------------------------------------------------*/
+
+namespace ConfigCacheBinary
+{
+	enum
+	{
+		Magic = 0x49474643,	// "CFGI"
+		Version = 1,
+	};
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 CharSize;
+		uint32 Padding;
+		uint64 SourceHash;
+		int32 NumSections;
+		int32 NumValues;
+		int32 NumChars;
+		int32 Padding2;
+	};
+
+	struct FSectionEntry
+	{
+		uint32 NameHash;
+		int32 NameOffset;
+		int32 FirstValue;
+		int32 NumValues;
+	};
+
+	struct FValueEntry
+	{
+		uint32 KeyHash;
+		int32 KeyOffset;
+		int32 ValueOffset;
+	};
+
+	/** Case insensitive hash, as both section names and keys are compared case insensitive */
+	static uint32 HashString(const TCHAR* Str)
+	{
+		uint32 Hash = 2166136261u;
+		for (; *Str; ++Str)
+		{
+			Hash = (Hash ^ (uint32)FChar::ToLower(*Str)) * 16777619u;
+		}
+		return Hash;
+	}
+
+	/** Case sensitive string keys, so values that only differ in case are kept apart */
+	struct FCaseSensitiveKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false>
+	{
+		static FORCEINLINE bool Matches(KeyInitType A, KeyInitType B)
+		{
+			return A.Equals(B, ESearchCase::CaseSensitive);
+		}
+		static FORCEINLINE uint32 GetKeyHash(KeyInitType Key)
+		{
+			return FCrc::StrCrc32(*Key);
+		}
+	};
+
+	/** Builds the string table, sharing repeated strings like array keys */
+	class FStringTableWriter
+	{
+	public:
+		int32 Add(const TCHAR* Str)
+		{
+			if (int32* Existing = Offsets.Find(Str))
+			{
+				return *Existing;
+			}
+			const int32 Offset = Chars.Num();
+			Chars.Append(Str, FCString::Strlen(Str) + 1);
+			Offsets.Add(Str, Offset);
+			return Offset;
+		}
+
+		TArray<TCHAR> Chars;
+
+	private:
+		TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveKeyFuncs> Offsets;
+	};
+
+	static bool GBinaryConfigCacheEnabled = true;
+	static bool GBinaryConfigCacheEnabledLatched = false;
+}
+
+bool FConfigCacheBinary::IsEnabled()
+{
+	using namespace ConfigCacheBinary;
+
+	// the command line is not set up when the statics are initialized
+	if (!GBinaryConfigCacheEnabledLatched)
+	{
+		GBinaryConfigCacheEnabled = !FParse::Param(FCommandLine::Get(), TEXT("NoBinaryConfigCache"));
+		GBinaryConfigCacheEnabledLatched = true;
+	}
+	return GBinaryConfigCacheEnabled;
+}
+
+void FConfigCacheBinary::SetEnabled(bool bInEnabled)
+{
+	using namespace ConfigCacheBinary;
+
+	GBinaryConfigCacheEnabled = bInEnabled;
+	GBinaryConfigCacheEnabledLatched = true;
+}
+
+uint64 FConfigCacheBinary::HashSourceHierarchy(const FConfigFileHierarchy& Hierarchy)
+{
+	using namespace ConfigCacheBinary;
+
+	const FString BuildVersion = FEngineVersion::Current().ToString();
+	const uint32 FormatVersion = Version;
+
+	uint64 Hash = FCrc::MemHash64(*BuildVersion, BuildVersion.Len() * sizeof(TCHAR));
+	Hash = FCrc::MemHash64(&FormatVersion, sizeof(FormatVersion), Hash);
+
+	for (const auto& HierarchyIt : Hierarchy)
+	{
+		const FIniFilename& Ini = HierarchyIt.Value;
+
+		// remote files have no timestamp we can trust
+		if (!IsUsingLocalIniFile(*Ini.Filename, nullptr))
+		{
+			return 0;
+		}
+
+		const int64 Size = IFileManager::Get().FileSize(*Ini.Filename);
+		const int64 Ticks = Size >= 0 ? IFileManager::Get().GetTimeStamp(*Ini.Filename).GetTicks() : 0;
+		const uint8 Entry[2] = { (uint8)HierarchyIt.Key, (uint8)Ini.bRequired };
+
+		Hash = FCrc::MemHash64(Entry, sizeof(Entry), Hash);
+		Hash = FCrc::MemHash64(*Ini.Filename, Ini.Filename.Len() * sizeof(TCHAR), Hash);
+		Hash = FCrc::MemHash64(&Size, sizeof(Size), Hash);
+		Hash = FCrc::MemHash64(&Ticks, sizeof(Ticks), Hash);
+	}
+
+	// 0 means not cacheable
+	return Hash ? Hash : 1;
+}
+
+FString FConfigCacheBinary::GetCacheFilename(const FString& DestIniFilename)
+{
+	return FPaths::GetPath(DestIniFilename) / TEXT("BinaryCache") / FPaths::GetBaseFilename(DestIniFilename) + TEXT(".bin");
+}
+
+bool FConfigCacheBinary::Save(const FString& Filename, uint64 SourceHash, const FConfigFile& ConfigFile)
+{
+	using namespace ConfigCacheBinary;
+
+	TArray<FSectionEntry> Sections;
+	TArray<FValueEntry> Values;
+	FStringTableWriter Strings;
+
+	Sections.Reserve(ConfigFile.Num());
+
+	TArray<FName> Keys;
+	TMap<FName, TArray<const FString*>> ValuesByKey;
+	TMap<FName, int32> NextValueByKey;
+
+	for (TMap<FString, FConfigSection>::TConstIterator SectionIt(ConfigFile); SectionIt; ++SectionIt)
+	{
+		const FConfigSection& Section = SectionIt.Value();
+
+		FSectionEntry& SectionEntry = Sections[Sections.AddUninitialized()];
+		SectionEntry.NameHash = HashString(*SectionIt.Key());
+		SectionEntry.NameOffset = Strings.Add(*SectionIt.Key());
+		SectionEntry.FirstValue = Values.Num();
+		SectionEntry.NumValues = Section.Num();
+
+		// keys keep their positions, but the values of each key are written in the order MultiFind returns them,
+		// so adding them back links them up the same way and Find and MultiFind give the same results as before
+		Keys.Reset();
+		ValuesByKey.Reset();
+		NextValueByKey.Reset();
+		Section.GetKeys(Keys);
+		for (const FName& Key : Keys)
+		{
+			TArray<const FString*>& KeyValues = ValuesByKey.Add(Key);
+			Section.MultiFindPointer(Key, KeyValues, true);
+		}
+
+		for (FConfigSectionMap::TConstIterator ValueIt(Section); ValueIt; ++ValueIt)
+		{
+			const FName Key = ValueIt.Key();
+			int32& NextValue = NextValueByKey.FindOrAdd(Key);
+			const FString& Value = *ValuesByKey.FindChecked(Key)[NextValue++];
+
+			const FString KeyString = Key.ToString();
+			FValueEntry& ValueEntry = Values[Values.AddUninitialized()];
+			ValueEntry.KeyHash = HashString(*KeyString);
+			ValueEntry.KeyOffset = Strings.Add(*KeyString);
+			ValueEntry.ValueOffset = Strings.Add(*Value);
+		}
+	}
+
+	TArray<int32> SectionLookup;
+	SectionLookup.AddUninitialized(Sections.Num());
+	for (int32 Index = 0; Index < Sections.Num(); ++Index)
+	{
+		SectionLookup[Index] = Index;
+	}
+	SectionLookup.Sort([&Sections](int32 A, int32 B) { return Sections[A].NameHash < Sections[B].NameHash; });
+
+	FHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.CharSize = sizeof(TCHAR);
+	Header.SourceHash = SourceHash;
+	Header.NumSections = Sections.Num();
+	Header.NumValues = Values.Num();
+	Header.NumChars = Strings.Chars.Num();
+
+	TArray<uint8> Output;
+	Output.Reserve(sizeof(Header) + Sections.Num() * sizeof(FSectionEntry) + Values.Num() * sizeof(FValueEntry) + SectionLookup.Num() * sizeof(int32) + Strings.Chars.Num() * sizeof(TCHAR));
+	Output.Append((const uint8*)&Header, sizeof(Header));
+	Output.Append((const uint8*)Sections.GetData(), Sections.Num() * sizeof(FSectionEntry));
+	Output.Append((const uint8*)Values.GetData(), Values.Num() * sizeof(FValueEntry));
+	Output.Append((const uint8*)SectionLookup.GetData(), SectionLookup.Num() * sizeof(int32));
+	Output.Append((const uint8*)Strings.Chars.GetData(), Strings.Chars.Num() * sizeof(TCHAR));
+
+	return FFileHelper::SaveArrayToFile(Output, *Filename);
+}
+
+bool FConfigCacheBinary::Load(const FString& Filename, uint64 SourceHash)
+{
+	using namespace ConfigCacheBinary;
+
+	Data.Empty();
+
+	if (SourceHash == 0 || !FFileHelper::LoadFileToArray(Data, *Filename, FILEREAD_Silent))
+	{
+		Data.Empty();
+		return false;
+	}
+
+	// validate everything once so the lookups don't need to
+	bool bValid = Data.Num() >= sizeof(FHeader);
+	const FHeader& Header = *(const FHeader*)Data.GetData();
+
+	bValid = bValid
+		&& Header.Magic == Magic
+		&& Header.Version == Version
+		&& Header.CharSize == sizeof(TCHAR)
+		&& Header.SourceHash == SourceHash
+		&& Header.NumSections >= 0
+		&& Header.NumValues >= 0
+		&& Header.NumChars >= 0
+		&& (int64)Data.Num() == (int64)sizeof(FHeader) + (int64)Header.NumSections * (sizeof(FSectionEntry) + sizeof(int32)) + (int64)Header.NumValues * sizeof(FValueEntry) + (int64)Header.NumChars * sizeof(TCHAR);
+
+	if (bValid)
+	{
+		const FSectionEntry* Sections = (const FSectionEntry*)(Data.GetData() + sizeof(FHeader));
+		const FValueEntry* Values = (const FValueEntry*)(Sections + Header.NumSections);
+		const int32* SectionLookup = (const int32*)(Values + Header.NumValues);
+		const TCHAR* Chars = (const TCHAR*)(SectionLookup + Header.NumSections);
+
+		bValid = Header.NumChars == 0 || Chars[Header.NumChars - 1] == 0;
+
+		int32 NextValue = 0;
+		for (int32 Index = 0; bValid && Index < Header.NumSections; ++Index)
+		{
+			const FSectionEntry& Section = Sections[Index];
+			bValid = Section.NameOffset >= 0 && Section.NameOffset < Header.NumChars
+				&& Section.FirstValue == NextValue && Section.NumValues >= 0 && Section.NumValues <= Header.NumValues - NextValue
+				&& SectionLookup[Index] >= 0 && SectionLookup[Index] < Header.NumSections;
+			NextValue += Section.NumValues;
+		}
+		bValid = bValid && NextValue == Header.NumValues;
+
+		for (int32 Index = 0; bValid && Index < Header.NumValues; ++Index)
+		{
+			bValid = Values[Index].KeyOffset >= 0 && Values[Index].KeyOffset < Header.NumChars
+				&& Values[Index].ValueOffset >= 0 && Values[Index].ValueOffset < Header.NumChars;
+		}
+	}
+
+	if (!bValid)
+	{
+		UE_LOG(LogConfig, Log, TEXT("Ignoring outdated or damaged binary config cache %s"), *Filename);
+		Data.Empty();
+		return false;
+	}
+
+	return true;
+}
+
+const TCHAR* FConfigCacheBinary::FindValue(const TCHAR* SectionName, const TCHAR* Key) const
+{
+	using namespace ConfigCacheBinary;
+
+	if (!IsLoaded())
+	{
+		return nullptr;
+	}
+
+	const FHeader& Header = *(const FHeader*)Data.GetData();
+	const FSectionEntry* Sections = (const FSectionEntry*)(Data.GetData() + sizeof(FHeader));
+	const FValueEntry* Values = (const FValueEntry*)(Sections + Header.NumSections);
+	const int32* SectionLookup = (const int32*)(Values + Header.NumValues);
+	const TCHAR* Chars = (const TCHAR*)(SectionLookup + Header.NumSections);
+
+	// binary search for the first section with the hash, then walk the ones that share it
+	const uint32 SectionHash = HashString(SectionName);
+	int32 Low = 0;
+	int32 High = Header.NumSections;
+	while (Low < High)
+	{
+		const int32 Middle = (Low + High) / 2;
+		if (Sections[SectionLookup[Middle]].NameHash < SectionHash)
+		{
+			Low = Middle + 1;
+		}
+		else
+		{
+			High = Middle;
+		}
+	}
+
+	const uint32 KeyHash = HashString(Key);
+	for (; Low < Header.NumSections && Sections[SectionLookup[Low]].NameHash == SectionHash; ++Low)
+	{
+		const FSectionEntry& Section = Sections[SectionLookup[Low]];
+		if (FCString::Stricmp(Chars + Section.NameOffset, SectionName) != 0)
+		{
+			continue;
+		}
+
+		// Find returns the value of the key that was added last
+		for (int32 Index = Section.FirstValue + Section.NumValues - 1; Index >= Section.FirstValue; --Index)
+		{
+			const FValueEntry& Value = Values[Index];
+			if (Value.KeyHash == KeyHash && FCString::Stricmp(Chars + Value.KeyOffset, Key) == 0)
+			{
+				return Chars + Value.ValueOffset;
+			}
+		}
+		return nullptr;
+	}
+
+	return nullptr;
+}
+
+void FConfigCacheBinary::CopyTo(FConfigFile& ConfigFile) const
+{
+	using namespace ConfigCacheBinary;
+
+	ConfigFile.Empty();
+
+	if (!IsLoaded())
+	{
+		return;
+	}
+
+	const FHeader& Header = *(const FHeader*)Data.GetData();
+	const FSectionEntry* Sections = (const FSectionEntry*)(Data.GetData() + sizeof(FHeader));
+	const FValueEntry* Values = (const FValueEntry*)(Sections + Header.NumSections);
+	const int32* SectionLookup = (const int32*)(Values + Header.NumValues);
+	const TCHAR* Chars = (const TCHAR*)(SectionLookup + Header.NumSections);
+
+	ConfigFile.Reserve(Header.NumSections);
+	for (int32 SectionIndex = 0; SectionIndex < Header.NumSections; ++SectionIndex)
+	{
+		const FSectionEntry& SectionEntry = Sections[SectionIndex];
+		FConfigSection& Section = ConfigFile.Add(Chars + SectionEntry.NameOffset, FConfigSection());
+
+		for (int32 Index = SectionEntry.FirstValue; Index < SectionEntry.FirstValue + SectionEntry.NumValues; ++Index)
+		{
+			Section.Add(FName(Chars + Values[Index].KeyOffset), Chars + Values[Index].ValueOffset);
+		}
+	}
+}
@@ -2585,6 +2585,63 @@ static void LoadAnIniFile(const FString& FilenameToLoad, FConfigFile& ConfigFile
 	}
 }
 
+/**
+ * Same as LoadIniFileHierarchy, but goes through the binary cache that is kept next to the generated ini, see FConfigCacheBinary.
+ * The cache is written after the text files were parsed and used until any of the source files change.
+ *
+ * @param DestIniFilename - the generated ini the hierarchy belongs to, used to name the cache
+ */
+static bool LoadIniFileHierarchyWithBinaryCache(const FConfigFileHierarchy& HierarchyToLoad, FConfigFile& ConfigFile, const bool bUseCache, const FString& DestIniFilename)
+{
+	const uint64 SourceHash = FConfigCacheBinary::IsEnabled() ? FConfigCacheBinary::HashSourceHierarchy(HierarchyToLoad) : 0;
+	if (SourceHash == 0)
+	{
+		return LoadIniFileHierarchy(HierarchyToLoad, ConfigFile, bUseCache);
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FString CacheFilename = FConfigCacheBinary::GetCacheFilename(DestIniFilename);
+
+	FConfigCacheBinary BinaryCache;
+	if (BinaryCache.Load(CacheFilename, SourceHash))
+	{
+		BinaryCache.CopyTo(ConfigFile);
+		ConfigFile.SourceIniHierarchy = HierarchyToLoad;
+
+#if INI_CACHE
+		// the cache only holds the fully merged result, which is what the last checkpoint of the hierarchy maps to
+		ConfigFile.CacheKey = TEXT("");
+		const FIniFilename* LastIni = nullptr;
+		for (auto& HierarchyIt : HierarchyToLoad)
+		{
+			LastIni = &HierarchyIt.Value;
+		}
+		if (bUseCache && LastIni && LastIni->CacheKey.Len() > 0)
+		{
+			ConfigFile.CacheKey = LastIni->CacheKey;
+			HierarchyCache.Add(LastIni->CacheKey, ConfigFile);
+		}
+#endif
+
+		UE_LOG(LogConfig, Log, TEXT("Loaded the source hierarchy of %s from the binary config cache in %.2f ms"), *DestIniFilename, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		return true;
+	}
+
+	const bool bResult = LoadIniFileHierarchy(HierarchyToLoad, ConfigFile, bUseCache);
+
+	UE_LOG(LogConfig, Log, TEXT("Parsed the source hierarchy of %s in %.2f ms"), *DestIniFilename, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	// an empty hierarchy means LoadIniFileHierarchy skipped the files, and we don't write files in multiprocess mode to avoid contention
+	if (bResult && ConfigFile.SourceIniHierarchy.Num() > 0
+		&& !(GConfig && GConfig->AreFileOperationsDisabled())
+		&& !FParse::Param(FCommandLine::Get(), TEXT("Multiprocess")))
+	{
+		FConfigCacheBinary::Save(CacheFilename, SourceHash, ConfigFile);
+	}
+
+	return bResult;
+}
+
 /**
  * This will load up two .ini files and then determine if the destination one is outdated.
  * Outdatedness is determined by the following mechanic:
@@ -2602,7 +2659,7 @@ static void LoadAnIniFile(const FString& FilenameToLoad, FConfigFile& ConfigFile
  */
 static bool GenerateDestIniFile(FConfigFile& DestConfigFile, const FString& DestIniFilename, const FConfigFileHierarchy& SourceIniHierarchy, bool bAllowGeneratedINIs, const bool bUseHierarchyCache)
 {
-	bool bResult = LoadIniFileHierarchy(SourceIniHierarchy, *DestConfigFile.SourceConfigFile, bUseHierarchyCache);
+	bool bResult = LoadIniFileHierarchyWithBinaryCache(SourceIniHierarchy, *DestConfigFile.SourceConfigFile, bUseHierarchyCache, DestIniFilename);
 	if ( bResult == false )
 	{
 		return false;
@@ -3,9 +3,33 @@
 #include "CorePrivatePCH.h"
 #include "Crc.h"
 
+// MemCrc32 can fold the data with PCLMULQDQ on x64 CPUs that support it (checked at runtime in FCrc::Init)
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_64BITS && (PLATFORM_WINDOWS || PLATFORM_LINUX || PLATFORM_MAC)
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#define CRC_USE_CLMUL 1
+		#include <intrin.h>
+		#define CRC_CLMUL_FUNCTION
+	#elif defined(__clang__) ? (__clang_major__ > 3 || (__clang_major__ == 3 && __clang_minor__ >= 8)) : (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+		// the intrinsics are compiled for the function only, the rest of the module can still run on CPUs without them
+		#define CRC_USE_CLMUL 1
+		#include <cpuid.h>
+		#define CRC_CLMUL_FUNCTION __attribute__((target("pclmul,sse4.1")))
+	#endif
+#endif
+#ifndef CRC_USE_CLMUL
+	#define CRC_USE_CLMUL 0
+#endif
+#if CRC_USE_CLMUL
+	#include <wmmintrin.h>
+	#include <smmintrin.h>
+#endif
+
 /** CRC 32 polynomial */
 enum { Crc32Poly = 0x04c11db7 };
 
+/** Whether MemCrc32 can use the carry-less multiply path, set by FCrc::Init */
+static bool GCrcUseClmul = false;
+
 uint32 FCrc::CRCTable_DEPRECATED[256] = 
 {
 	0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9, 0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005, 0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61, 0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD,
@@ -380,7 +404,117 @@ void FCrc::Init()
 		}
 	}
 #endif // !UE_BUILD_SHIPPING
+
+#if CRC_USE_CLMUL
+	// CPUID leaf 1: ECX bit 1 is PCLMULQDQ, bit 19 is SSE4.1
+	uint32 CPUInfo[4] = { 0, 0, 0, 0 };
+#if defined(_MSC_VER) && !defined(__clang__)
+	__cpuid((int32*)CPUInfo, 1);
+#else
+	__get_cpuid(1, &CPUInfo[0], &CPUInfo[1], &CPUInfo[2], &CPUInfo[3]);
+#endif
+	GCrcUseClmul = (CPUInfo[2] & (1 << 1)) && (CPUInfo[2] & (1 << 19));
+#endif
+}
+
+bool FCrc::IsMemCrc32HardwareAccelerated()
+{
+	return GCrcUseClmul;
+}
+
+#if CRC_USE_CLMUL
+/**
+ * CRC32 of a block using carry-less multiplication to fold 64 bytes per iteration, then Barrett reduction.
+ * See "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" (Gopal et al, Intel); the constants are
+ * for the bit reflected Crc32Poly, so this gives exactly the same result as the tables.
+ *
+ * @param Data		Data to hash
+ * @param Length	Length of the data, at least 64 and a multiple of 16
+ * @param CRC		Running CRC, already inverted
+ * @return			New running CRC, not inverted
+ */
+CRC_CLMUL_FUNCTION static uint32 MemCrc32Clmul(const uint8* Data, int32 Length, uint32 CRC)
+{
+	MS_ALIGN(16) static const uint64 K1K2[2] GCC_ALIGN(16) = { 0x0154442bd4ull, 0x01c6e41596ull };
+	MS_ALIGN(16) static const uint64 K3K4[2] GCC_ALIGN(16) = { 0x01751997d0ull, 0x00ccaa009eull };
+	MS_ALIGN(16) static const uint64 K5K0[2] GCC_ALIGN(16) = { 0x0163cd6124ull, 0x0000000000ull };
+	MS_ALIGN(16) static const uint64 Poly[2] GCC_ALIGN(16) = { 0x01db710641ull, 0x01f7011641ull };
+
+	checkSlow(Length >= 64 && (Length & 15) == 0);
+
+	__m128i X1 = _mm_loadu_si128((const __m128i*)(Data + 0x00));
+	__m128i X2 = _mm_loadu_si128((const __m128i*)(Data + 0x10));
+	__m128i X3 = _mm_loadu_si128((const __m128i*)(Data + 0x20));
+	__m128i X4 = _mm_loadu_si128((const __m128i*)(Data + 0x30));
+	X1 = _mm_xor_si128(X1, _mm_cvtsi32_si128((int32)CRC));
+	__m128i X0 = _mm_load_si128((const __m128i*)K1K2);
+	Data += 64;
+	Length -= 64;
+
+	// Fold 64 bytes at a time into four accumulators
+	while (Length >= 64)
+	{
+		__m128i X5 = _mm_clmulepi64_si128(X1, X0, 0x00);
+		__m128i X6 = _mm_clmulepi64_si128(X2, X0, 0x00);
+		__m128i X7 = _mm_clmulepi64_si128(X3, X0, 0x00);
+		__m128i X8 = _mm_clmulepi64_si128(X4, X0, 0x00);
+		X1 = _mm_clmulepi64_si128(X1, X0, 0x11);
+		X2 = _mm_clmulepi64_si128(X2, X0, 0x11);
+		X3 = _mm_clmulepi64_si128(X3, X0, 0x11);
+		X4 = _mm_clmulepi64_si128(X4, X0, 0x11);
+		X1 = _mm_xor_si128(_mm_xor_si128(X1, X5), _mm_loadu_si128((const __m128i*)(Data + 0x00)));
+		X2 = _mm_xor_si128(_mm_xor_si128(X2, X6), _mm_loadu_si128((const __m128i*)(Data + 0x10)));
+		X3 = _mm_xor_si128(_mm_xor_si128(X3, X7), _mm_loadu_si128((const __m128i*)(Data + 0x20)));
+		X4 = _mm_xor_si128(_mm_xor_si128(X4, X8), _mm_loadu_si128((const __m128i*)(Data + 0x30)));
+		Data += 64;
+		Length -= 64;
+	}
+
+	// Fold the accumulators into one
+	X0 = _mm_load_si128((const __m128i*)K3K4);
+	__m128i X5 = _mm_clmulepi64_si128(X1, X0, 0x00);
+	X1 = _mm_clmulepi64_si128(X1, X0, 0x11);
+	X1 = _mm_xor_si128(_mm_xor_si128(X1, X2), X5);
+	X5 = _mm_clmulepi64_si128(X1, X0, 0x00);
+	X1 = _mm_clmulepi64_si128(X1, X0, 0x11);
+	X1 = _mm_xor_si128(_mm_xor_si128(X1, X3), X5);
+	X5 = _mm_clmulepi64_si128(X1, X0, 0x00);
+	X1 = _mm_clmulepi64_si128(X1, X0, 0x11);
+	X1 = _mm_xor_si128(_mm_xor_si128(X1, X4), X5);
+
+	// Fold the remaining 16 byte blocks
+	while (Length >= 16)
+	{
+		X2 = _mm_loadu_si128((const __m128i*)Data);
+		X5 = _mm_clmulepi64_si128(X1, X0, 0x00);
+		X1 = _mm_clmulepi64_si128(X1, X0, 0x11);
+		X1 = _mm_xor_si128(_mm_xor_si128(X1, X2), X5);
+		Data += 16;
+		Length -= 16;
+	}
+
+	// Fold 128 bits to 64 bits
+	X2 = _mm_clmulepi64_si128(X1, X0, 0x10);
+	X3 = _mm_setr_epi32(~0, 0, ~0, 0);
+	X1 = _mm_srli_si128(X1, 8);
+	X1 = _mm_xor_si128(X1, X2);
+	X0 = _mm_loadl_epi64((const __m128i*)K5K0);
+	X2 = _mm_srli_si128(X1, 4);
+	X1 = _mm_and_si128(X1, X3);
+	X1 = _mm_clmulepi64_si128(X1, X0, 0x00);
+	X1 = _mm_xor_si128(X1, X2);
+
+	// Barrett reduction to 32 bits
+	X0 = _mm_load_si128((const __m128i*)Poly);
+	X2 = _mm_and_si128(X1, X3);
+	X2 = _mm_clmulepi64_si128(X2, X0, 0x10);
+	X2 = _mm_and_si128(X2, X3);
+	X2 = _mm_clmulepi64_si128(X2, X0, 0x00);
+	X1 = _mm_xor_si128(X1, X2);
+
+	return (uint32)_mm_extract_epi32(X1, 1);
 }
+#endif // CRC_USE_CLMUL
 
 uint32 FCrc::MemCrc32( const void* InData, int32 Length, uint32 CRC/*=0 */ )
 {
@@ -391,6 +525,17 @@ uint32 FCrc::MemCrc32( const void* InData, int32 Length, uint32 CRC/*=0 */ )
 
 	const uint8* __restrict Data = (uint8*)InData;
 
+#if CRC_USE_CLMUL
+	if (GCrcUseClmul && Length >= 64)
+	{
+		// the folding handles whole 16 byte blocks, the tail goes through the tables below
+		const int32 FoldLength = Length & ~15;
+		CRC = MemCrc32Clmul(Data, FoldLength, CRC);
+		Data += FoldLength;
+		Length -= FoldLength;
+	}
+#endif
+
 	// First we need to align to 32-bits
 	int32 InitBytes = Align(Data, 4) - Data;
 
@@ -479,3 +624,108 @@ uint32 FCrc::MemCrc_DEPRECATED(const void* InData, int32 Length, uint32 CRC/*=0
 
 	return BYTESWAP_ORDER32(~CRC);
 }
+
+namespace Crc64Private
+{
+	static const uint64 Prime1 = 0x9E3779B185EBCA87ull;
+	static const uint64 Prime2 = 0xC2B2AE3D27D4EB4Full;
+	static const uint64 Prime3 = 0x165667B19E3779F9ull;
+	static const uint64 Prime4 = 0x85EBCA77C2B2AE63ull;
+	static const uint64 Prime5 = 0x27D4EB2F165667C5ull;
+
+	FORCEINLINE uint64 Rotl(uint64 Value, int32 Shift)
+	{
+		return (Value << Shift) | (Value >> (64 - Shift));
+	}
+
+	FORCEINLINE uint64 Read64(const uint8* Data)
+	{
+		uint64 Value;
+		FMemory::Memcpy(&Value, Data, sizeof(Value));
+		return INTEL_ORDER64(Value);
+	}
+
+	FORCEINLINE uint32 Read32(const uint8* Data)
+	{
+		uint32 Value;
+		FMemory::Memcpy(&Value, Data, sizeof(Value));
+		return INTEL_ORDER32(Value);
+	}
+
+	FORCEINLINE uint64 Round(uint64 Acc, uint64 Input)
+	{
+		Acc += Input * Prime2;
+		Acc = Rotl(Acc, 31);
+		return Acc * Prime1;
+	}
+
+	FORCEINLINE uint64 MergeRound(uint64 Acc, uint64 Value)
+	{
+		Acc ^= Round(0, Value);
+		return Acc * Prime1 + Prime4;
+	}
+}
+
+uint64 FCrc::MemHash64( const void* InData, int64 Length, uint64 Seed/*=0 */ )
+{
+	// xxHash64, see https://github.com/Cyan4973/xxHash
+	using namespace Crc64Private;
+
+	const uint8* Data = (const uint8*)InData;
+	const uint8* const End = Data + Length;
+	uint64 Hash;
+
+	if (Length >= 32)
+	{
+		const uint8* const Limit = End - 32;
+		uint64 V1 = Seed + Prime1 + Prime2;
+		uint64 V2 = Seed + Prime2;
+		uint64 V3 = Seed;
+		uint64 V4 = Seed - Prime1;
+		do
+		{
+			V1 = Round(V1, Read64(Data));
+			V2 = Round(V2, Read64(Data + 8));
+			V3 = Round(V3, Read64(Data + 16));
+			V4 = Round(V4, Read64(Data + 24));
+			Data += 32;
+		}
+		while (Data <= Limit);
+
+		Hash = Rotl(V1, 1) + Rotl(V2, 7) + Rotl(V3, 12) + Rotl(V4, 18);
+		Hash = MergeRound(Hash, V1);
+		Hash = MergeRound(Hash, V2);
+		Hash = MergeRound(Hash, V3);
+		Hash = MergeRound(Hash, V4);
+	}
+	else
+	{
+		Hash = Seed + Prime5;
+	}
+
+	Hash += (uint64)Length;
+
+	for (; Data + 8 <= End; Data += 8)
+	{
+		Hash ^= Round(0, Read64(Data));
+		Hash = Rotl(Hash, 27) * Prime1 + Prime4;
+	}
+	if (Data + 4 <= End)
+	{
+		Hash ^= (uint64)Read32(Data) * Prime1;
+		Hash = Rotl(Hash, 23) * Prime2 + Prime3;
+		Data += 4;
+	}
+	for (; Data < End; ++Data)
+	{
+		Hash ^= (*Data) * Prime5;
+		Hash = Rotl(Hash, 11) * Prime1;
+	}
+
+	Hash ^= Hash >> 33;
+	Hash *= Prime2;
+	Hash ^= Hash >> 29;
+	Hash *= Prime3;
+	Hash ^= Hash >> 32;
+	return Hash;
+}
@@ -15,6 +15,80 @@ enum class EEventPoolTypes
 	ManualReset
 };
 
+#if LOCK_CONTENTION_PROFILER
+
+/**
+ * Pooled event that reports its waits to the lock contention profiler.
+ *
+ * Pooled events are wrapped once when they are created, so the wrapper is recycled along with the event.
+ */
+class FContentionTrackingEvent
+	: public FEvent
+{
+public:
+
+	/**
+	 * Creates and initializes a new instance.
+	 *
+	 * @param InEvent The event to forward to, owned by this wrapper.
+	 */
+	explicit FContentionTrackingEvent(FEvent* InEvent)
+		: InnerEvent(InEvent)
+	{
+		check(InnerEvent);
+	}
+
+	virtual ~FContentionTrackingEvent()
+	{
+		delete InnerEvent;
+	}
+
+public:
+
+	// FEvent interface
+
+	virtual bool Create(bool bIsManualReset = false) override
+	{
+		return InnerEvent->Create(bIsManualReset);
+	}
+
+	virtual bool IsManualReset() override
+	{
+		return InnerEvent->IsManualReset();
+	}
+
+	virtual void Trigger() override
+	{
+		InnerEvent->Trigger();
+	}
+
+	virtual void Reset() override
+	{
+		InnerEvent->Reset();
+	}
+
+	virtual bool Wait(uint32 WaitTime, const bool bIgnoreThreadIdleStats = false) override
+	{
+		if (!FLockContentionProfiler::IsEnabled() || !FLockContentionProfiler::ShouldSample())
+		{
+			return InnerEvent->Wait(WaitTime, bIgnoreThreadIdleStats);
+		}
+
+		const uint32 StartCycles = FLockContentionProfiler::GetCycles();
+		const bool bTriggered = InnerEvent->Wait(WaitTime, bIgnoreThreadIdleStats);
+		FLockContentionProfiler::RecordAcquire(this, ELockContentionType::Event, !bTriggered, FLockContentionProfiler::GetCycles() - StartCycles);
+		return bTriggered;
+	}
+
+private:
+
+	/** The platform event. */
+	FEvent* InnerEvent;
+};
+
+#endif
+
+
 /**
  * Template class for event pools.
  *
@@ -58,6 +132,9 @@ public:
 			PRAGMA_DISABLE_DEPRECATION_WARNINGS
 			Result = FPlatformProcess::CreateSynchEvent((PoolType == EEventPoolTypes::ManualReset));
 			PRAGMA_ENABLE_DEPRECATION_WARNINGS
+#if LOCK_CONTENTION_PROFILER
+			Result = new FContentionTrackingEvent(Result);
+#endif
 		}
 
 		Result->AdvanceStats();
@@ -0,0 +1,446 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "LZ4Compression.h"
+
+
+namespace LZ4CompressionConstants
+{
+	/** Shortest match the format can encode. */
+	const int32 MinMatch = 4;
+	/** The last bytes of a block are always literals. */
+	const int32 LastLiterals = 5;
+	/** The last match has to start at least this many bytes before the end of the block. */
+	const int32 MFLimit = 12;
+	/** Largest offset the format can encode. */
+	const int32 MaxDistance = 65535;
+	/** Bits of the fast compressor hash table. */
+	const int32 HashLog = 14;
+	/** Bits of the HC compressor hash table. */
+	const int32 HCHashLog = 15;
+	/** The fast compressor starts skipping bytes after 2^SkipTrigger failed probes. */
+	const uint32 SkipTrigger = 6;
+}
+
+
+static FORCEINLINE uint32 ReadUnaligned32(const uint8* Ptr)
+{
+	uint32 Value;
+	FMemory::Memcpy(&Value, Ptr, sizeof(Value));
+	return Value;
+}
+
+static FORCEINLINE uint64 ReadUnaligned64(const uint8* Ptr)
+{
+	uint64 Value;
+	FMemory::Memcpy(&Value, Ptr, sizeof(Value));
+	return Value;
+}
+
+static FORCEINLINE uint32 HashSequence(uint32 Sequence, int32 HashLog)
+{
+	return (Sequence * 2654435761u) >> (32 - HashLog);
+}
+
+/** Counts how many bytes at Ptr match the bytes at Ref, without reading at or past Limit. */
+static FORCEINLINE int32 CountMatch(const uint8* Ptr, const uint8* Ref, const uint8* Limit)
+{
+	const uint8* Start = Ptr;
+	while (Ptr + 8 <= Limit && ReadUnaligned64(Ptr) == ReadUnaligned64(Ref))
+	{
+		Ptr += 8;
+		Ref += 8;
+	}
+	while (Ptr < Limit && *Ptr == *Ref)
+	{
+		++Ptr;
+		++Ref;
+	}
+	return (int32)(Ptr - Start);
+}
+
+/** Writes the 255 byte run that extends a length field which doesn't fit into its token nibble. */
+static FORCEINLINE uint8* WriteLength(uint8* Out, int32 Length)
+{
+	for (; Length >= 255; Length -= 255)
+	{
+		*Out++ = 255;
+	}
+	*Out++ = (uint8)Length;
+	return Out;
+}
+
+/** Checks that a sequence with the given lengths fits between Out and OutEnd. */
+static FORCEINLINE bool HasRoomForSequence(const uint8* Out, const uint8* OutEnd, int32 LiteralLength, int32 MatchLength)
+{
+	return OutEnd - Out >= 1 + LiteralLength + LiteralLength / 255 + 1 + 2 + MatchLength / 255 + 1;
+}
+
+/**
+ * Writes a sequence of literals followed by a match.
+ *
+ * @param MatchLength Match length minus MinMatch.
+ */
+static uint8* WriteSequence(uint8* Out, const uint8* Literals, int32 LiteralLength, int32 Offset, int32 MatchLength)
+{
+	uint8* Token = Out++;
+	if (LiteralLength >= 15)
+	{
+		*Token = 15 << 4;
+		Out = WriteLength(Out, LiteralLength - 15);
+	}
+	else
+	{
+		*Token = (uint8)(LiteralLength << 4);
+	}
+	FMemory::Memcpy(Out, Literals, LiteralLength);
+	Out += LiteralLength;
+
+	*Out++ = (uint8)(Offset & 0xff);
+	*Out++ = (uint8)(Offset >> 8);
+
+	if (MatchLength >= 15)
+	{
+		*Token |= 15;
+		Out = WriteLength(Out, MatchLength - 15);
+	}
+	else
+	{
+		*Token |= (uint8)MatchLength;
+	}
+	return Out;
+}
+
+/**
+ * Writes the literals that end every block and returns the compressed size, or 0 if they don't fit.
+ */
+static int32 WriteLastLiterals(uint8* Compressed, uint8* Out, const uint8* OutEnd, const uint8* Literals, int32 LiteralLength)
+{
+	if (OutEnd - Out < 1 + LiteralLength + LiteralLength / 255 + 1)
+	{
+		return 0;
+	}
+	if (LiteralLength >= 15)
+	{
+		*Out++ = 15 << 4;
+		Out = WriteLength(Out, LiteralLength - 15);
+	}
+	else
+	{
+		*Out++ = (uint8)(LiteralLength << 4);
+	}
+	FMemory::Memcpy(Out, Literals, LiteralLength);
+	Out += LiteralLength;
+	return (int32)(Out - Compressed);
+}
+
+int32 FLZ4Compression::Compress(const uint8* Uncompressed, int32 UncompressedSize, uint8* Compressed, int32 CompressedCapacity, int32 Acceleration)
+{
+	using namespace LZ4CompressionConstants;
+
+	const uint8* Anchor = Uncompressed;
+	const uint8* const InEnd = Uncompressed + UncompressedSize;
+	uint8* Out = Compressed;
+	uint8* const OutEnd = Compressed + CompressedCapacity;
+
+	if (UncompressedSize > MFLimit)
+	{
+		// Positions are stored relative to the start of the block, a zeroed table points everything at the first byte.
+		uint32* HashTable = (uint32*)FMemory::Malloc(sizeof(uint32) << HashLog);
+		FMemory::Memzero(HashTable, sizeof(uint32) << HashLog);
+
+		const uint8* const MatchLimit = InEnd - LastLiterals;
+		const uint8* const InputLimit = InEnd - MFLimit;
+		const uint32 SearchStart = (uint32)FMath::Max(Acceleration, 1) << SkipTrigger;
+		const uint8* In = Uncompressed + 1;
+
+		while (In <= InputLimit)
+		{
+			// Probe one position at a time, stepping further the longer nothing matches.
+			const uint8* Match = nullptr;
+			uint32 SearchCount = SearchStart;
+			while (In <= InputLimit)
+			{
+				const uint32 Sequence = ReadUnaligned32(In);
+				const uint32 Hash = HashSequence(Sequence, HashLog);
+				const uint8* Candidate = Uncompressed + HashTable[Hash];
+				HashTable[Hash] = (uint32)(In - Uncompressed);
+				if (Candidate < In && In - Candidate <= MaxDistance && ReadUnaligned32(Candidate) == Sequence)
+				{
+					Match = Candidate;
+					break;
+				}
+				In += SearchCount++ >> SkipTrigger;
+			}
+			if (!Match)
+			{
+				break;
+			}
+
+			while (In > Anchor && Match > Uncompressed && In[-1] == Match[-1])
+			{
+				--In;
+				--Match;
+			}
+
+			const int32 LiteralLength = (int32)(In - Anchor);
+			const int32 MatchLength = CountMatch(In + MinMatch, Match + MinMatch, MatchLimit);
+			if (!HasRoomForSequence(Out, OutEnd, LiteralLength, MatchLength))
+			{
+				FMemory::Free(HashTable);
+				return 0;
+			}
+			Out = WriteSequence(Out, Anchor, LiteralLength, (int32)(In - Match), MatchLength);
+
+			In += MinMatch + MatchLength;
+			Anchor = In;
+			if (In <= InputLimit)
+			{
+				// Remember a position inside the match, it often starts the next one.
+				HashTable[HashSequence(ReadUnaligned32(In - 2), HashLog)] = (uint32)(In - 2 - Uncompressed);
+			}
+		}
+
+		FMemory::Free(HashTable);
+	}
+
+	return WriteLastLiterals(Compressed, Out, OutEnd, Anchor, (int32)(InEnd - Anchor));
+}
+
+/**
+ * Hash chains over the last 64 KB of input, used by the HC compressor.
+ */
+class FLZ4HashChains
+{
+	const uint8* const Uncompressed;
+	/** Most recent position of each hash, INDEX_NONE if there is none. */
+	int32* Head;
+	/** Distance to the previous position with the same hash, indexed by position modulo the window size, 0 ends the chain. */
+	uint16* Chain;
+	/** First position that hasn't been inserted yet. */
+	int32 NextToInsert;
+
+public:
+
+	FLZ4HashChains(const uint8* InUncompressed)
+		: Uncompressed(InUncompressed)
+		, NextToInsert(0)
+	{
+		using namespace LZ4CompressionConstants;
+		Head = (int32*)FMemory::Malloc(sizeof(int32) << HCHashLog);
+		FMemory::Memset(Head, 0xff, sizeof(int32) << HCHashLog);
+		Chain = (uint16*)FMemory::Malloc(sizeof(uint16) * (MaxDistance + 1));
+		FMemory::Memzero(Chain, sizeof(uint16) * (MaxDistance + 1));
+	}
+
+	~FLZ4HashChains()
+	{
+		FMemory::Free(Head);
+		FMemory::Free(Chain);
+	}
+
+	/**
+	 * Finds the longest earlier match for In, after inserting all positions before it.
+	 *
+	 * @return Match length including MinMatch, 0 if there is no match.
+	 */
+	int32 FindLongestMatch(const uint8* In, const uint8* MatchLimit, int32 MaxAttempts, const uint8*& OutMatch)
+	{
+		using namespace LZ4CompressionConstants;
+
+		const int32 Position = (int32)(In - Uncompressed);
+		for (; NextToInsert < Position; ++NextToInsert)
+		{
+			const uint32 Hash = HashSequence(ReadUnaligned32(Uncompressed + NextToInsert), HCHashLog);
+			const int32 Previous = Head[Hash];
+			const int32 Distance = Previous == INDEX_NONE ? 0 : NextToInsert - Previous;
+			Chain[NextToInsert & MaxDistance] = (uint16)(Distance > MaxDistance ? 0 : Distance);
+			Head[Hash] = NextToInsert;
+		}
+
+		const uint32 Sequence = ReadUnaligned32(In);
+		int32 BestLength = 0;
+		int32 Candidate = Head[HashSequence(Sequence, HCHashLog)];
+		for (int32 Attempt = 0; Attempt < MaxAttempts && Candidate != INDEX_NONE && Position - Candidate <= MaxDistance; ++Attempt)
+		{
+			const uint8* CandidatePtr = Uncompressed + Candidate;
+			if (ReadUnaligned32(CandidatePtr) == Sequence)
+			{
+				const int32 Length = MinMatch + CountMatch(In + MinMatch, CandidatePtr + MinMatch, MatchLimit);
+				if (Length > BestLength)
+				{
+					BestLength = Length;
+					OutMatch = CandidatePtr;
+				}
+			}
+			const int32 Distance = Chain[Candidate & MaxDistance];
+			if (Distance == 0)
+			{
+				break;
+			}
+			Candidate -= Distance;
+		}
+		return BestLength;
+	}
+};
+
+int32 FLZ4Compression::CompressHC(const uint8* Uncompressed, int32 UncompressedSize, uint8* Compressed, int32 CompressedCapacity, int32 MaxAttempts)
+{
+	using namespace LZ4CompressionConstants;
+
+	const uint8* Anchor = Uncompressed;
+	const uint8* const InEnd = Uncompressed + UncompressedSize;
+	uint8* Out = Compressed;
+	uint8* const OutEnd = Compressed + CompressedCapacity;
+
+	if (UncompressedSize > MFLimit)
+	{
+		FLZ4HashChains HashChains(Uncompressed);
+		const uint8* const MatchLimit = InEnd - LastLiterals;
+		const uint8* const InputLimit = InEnd - MFLimit;
+		const uint8* In = Uncompressed;
+
+		while (In <= InputLimit)
+		{
+			const uint8* Match = nullptr;
+			int32 Length = HashChains.FindLongestMatch(In, MatchLimit, MaxAttempts, Match);
+			if (Length < MinMatch)
+			{
+				++In;
+				continue;
+			}
+
+			// A longer match one byte later is worth an extra literal.
+			while (In + 1 <= InputLimit)
+			{
+				const uint8* NextMatch = nullptr;
+				const int32 NextLength = HashChains.FindLongestMatch(In + 1, MatchLimit, MaxAttempts, NextMatch);
+				if (NextLength <= Length)
+				{
+					break;
+				}
+				++In;
+				Match = NextMatch;
+				Length = NextLength;
+			}
+
+			const int32 LiteralLength = (int32)(In - Anchor);
+			if (!HasRoomForSequence(Out, OutEnd, LiteralLength, Length - MinMatch))
+			{
+				return 0;
+			}
+			Out = WriteSequence(Out, Anchor, LiteralLength, (int32)(In - Match), Length - MinMatch);
+			In += Length;
+			Anchor = In;
+		}
+	}
+
+	return WriteLastLiterals(Compressed, Out, OutEnd, Anchor, (int32)(InEnd - Anchor));
+}
+
+/** Reads the 255 byte run that extends a length field, fails if it runs past the end of the input. */
+static FORCEINLINE bool ReadLength(const uint8*& In, const uint8* InEnd, SIZE_T& Length)
+{
+	uint32 Byte;
+	do
+	{
+		if (In >= InEnd)
+		{
+			return false;
+		}
+		Byte = *In++;
+		Length += Byte;
+	}
+	while (Byte == 255);
+	return true;
+}
+
+bool FLZ4Compression::Uncompress(uint8* Uncompressed, int32 UncompressedSize, const uint8* Compressed, int32 CompressedSize)
+{
+	using namespace LZ4CompressionConstants;
+
+	const uint8* In = Compressed;
+	const uint8* const InEnd = Compressed + CompressedSize;
+	uint8* Out = Uncompressed;
+	uint8* const OutEnd = Uncompressed + UncompressedSize;
+
+	while (In < InEnd)
+	{
+		const uint32 Token = *In++;
+
+		SIZE_T LiteralLength = Token >> 4;
+		if (LiteralLength == 15 && !ReadLength(In, InEnd, LiteralLength))
+		{
+			return false;
+		}
+		if (LiteralLength > (SIZE_T)(InEnd - In) || LiteralLength > (SIZE_T)(OutEnd - Out))
+		{
+			return false;
+		}
+		if (LiteralLength <= 16 && InEnd - In >= 16 && OutEnd - Out >= 16)
+		{
+			// Short literal runs are copied with a fixed size, the extra bytes are overwritten by what follows.
+			FMemory::Memcpy(Out, In, 16);
+		}
+		else
+		{
+			FMemory::Memcpy(Out, In, LiteralLength);
+		}
+		In += LiteralLength;
+		Out += LiteralLength;
+
+		// The last sequence only has literals.
+		if (In == InEnd)
+		{
+			break;
+		}
+
+		if (InEnd - In < 2)
+		{
+			return false;
+		}
+		const SIZE_T Offset = In[0] | (In[1] << 8);
+		In += 2;
+		if (Offset == 0 || Offset > (SIZE_T)(Out - Uncompressed))
+		{
+			return false;
+		}
+
+		SIZE_T MatchLength = Token & 15;
+		if (MatchLength == 15 && !ReadLength(In, InEnd, MatchLength))
+		{
+			return false;
+		}
+		MatchLength += MinMatch;
+		if (MatchLength > (SIZE_T)(OutEnd - Out))
+		{
+			return false;
+		}
+
+		const uint8* Match = Out - Offset;
+		if (Offset >= 8 && (SIZE_T)(OutEnd - Out) >= MatchLength + 8)
+		{
+			// Copy 8 bytes at a time, the source never overlaps the 8 bytes being written.
+			uint8* const CopyEnd = Out + MatchLength;
+			do
+			{
+				FMemory::Memcpy(Out, Match, 8);
+				Out += 8;
+				Match += 8;
+			}
+			while (Out < CopyEnd);
+			Out = CopyEnd;
+		}
+		else
+		{
+			// Overlapping matches repeat the last Offset bytes.
+			for (SIZE_T Index = 0; Index < MatchLength; ++Index)
+			{
+				Out[Index] = Match[Index];
+			}
+			Out += MatchLength;
+		}
+	}
+
+	return In == InEnd && Out == OutEnd;
+}
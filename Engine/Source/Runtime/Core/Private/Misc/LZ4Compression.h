@@ -0,0 +1,46 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/**
+ * Encoder and decoder for the LZ4 block format, used by COMPRESS_LZ4.
+ *
+ * Blocks are interchangeable with the reference LZ4 library (LZ4_compress_default, LZ4_compress_HC and
+ * LZ4_decompress_safe), so the codec can be swapped for it without resaving data.
+ */
+struct FLZ4Compression
+{
+	/**
+	 * Gets the worst case compressed size of a block.
+	 *
+	 * @param UncompressedSize Size of the uncompressed block in bytes.
+	 * @return Maximum number of bytes Compress and CompressHC may write.
+	 */
+	static int32 CompressBound(int32 UncompressedSize)
+	{
+		return UncompressedSize + UncompressedSize / 255 + 16;
+	}
+
+	/**
+	 * Compresses a block with a single hash table probe per position.
+	 *
+	 * @param Acceleration Values above 1 skip faster over incompressible data, trading ratio for speed.
+	 * @return Compressed size, 0 if the block doesn't fit into CompressedCapacity.
+	 */
+	static int32 Compress(const uint8* Uncompressed, int32 UncompressedSize, uint8* Compressed, int32 CompressedCapacity, int32 Acceleration);
+
+	/**
+	 * Compresses a block with hash chains and lazy matching. Much slower than Compress but smaller, decoding speed is the same.
+	 *
+	 * @param MaxAttempts Number of earlier positions tried per position.
+	 * @return Compressed size, 0 if the block doesn't fit into CompressedCapacity.
+	 */
+	static int32 CompressHC(const uint8* Uncompressed, int32 UncompressedSize, uint8* Compressed, int32 CompressedCapacity, int32 MaxAttempts);
+
+	/**
+	 * Decompresses a block. Never reads or writes outside of the given buffers, even for corrupt data.
+	 *
+	 * @return true if the block decoded to exactly UncompressedSize bytes.
+	 */
+	static bool Uncompress(uint8* Uncompressed, int32 UncompressedSize, const uint8* Compressed, int32 CompressedSize);
+};
@@ -5,6 +5,7 @@
 DECLARE_MEMORY_STAT(TEXT("MemStack Large Block"), STAT_MemStackLargeBLock,STATGROUP_Memory);
 DECLARE_MEMORY_STAT(TEXT("PageAllocator Free"), STAT_PageAllocatorFree, STATGROUP_Memory);
 DECLARE_MEMORY_STAT(TEXT("PageAllocator Used"), STAT_PageAllocatorUsed, STATGROUP_Memory);
+DECLARE_MEMORY_STAT(TEXT("Arena Peak (largest thread)"), STAT_ArenaPeak, STATGROUP_Memory);
 
 TLockFreeFixedSizeAllocator<FPageAllocator::PageSize, FThreadSafeCounter> FPageAllocator::TheAllocator;
 TLockFreeFixedSizeAllocator<FPageAllocator::SmallPageSize, FThreadSafeCounter> FPageAllocator::TheSmallAllocator;
@@ -113,3 +114,78 @@ bool FMemStackBase::ContainsPointer(const void* Pointer) const
 
 	return false;
 }
+
+/*-----------------------------------------------------------------------------
+	FArenaMemStack implementation.
+-----------------------------------------------------------------------------*/
+
+/** All live arenas, for DumpStats. */
+static TArray<FArenaMemStack*>& GetAllArenas()
+{
+	static TArray<FArenaMemStack*> AllArenas;
+	return AllArenas;
+}
+
+static FCriticalSection& GetAllArenasCriticalSection()
+{
+	static FCriticalSection AllArenasCriticalSection;
+	return AllArenasCriticalSection;
+}
+
+/** Largest peak of any arena, for the stat. */
+static int32 GArenaPeakByteCount = 0;
+
+FArenaMemStack::FArenaMemStack()
+	: PeakByteCount(0)
+{
+	FScopeLock Lock(&GetAllArenasCriticalSection());
+	GetAllArenas().Add(this);
+}
+
+FArenaMemStack::~FArenaMemStack()
+{
+	FScopeLock Lock(&GetAllArenasCriticalSection());
+	GetAllArenas().RemoveSingleSwap(this);
+}
+
+void FArenaMemStack::UpdatePeakByteCount()
+{
+	const int32 ByteCount = GetByteCount();
+	if (ByteCount > PeakByteCount)
+	{
+		PeakByteCount = ByteCount;
+
+		int32 GlobalPeak = GArenaPeakByteCount;
+		while (ByteCount > GlobalPeak)
+		{
+			if (FPlatformAtomics::InterlockedCompareExchange(&GArenaPeakByteCount, ByteCount, GlobalPeak) == GlobalPeak)
+			{
+				SET_MEMORY_STAT(STAT_ArenaPeak, ByteCount);
+				break;
+			}
+			GlobalPeak = GArenaPeakByteCount;
+		}
+	}
+}
+
+void FArenaMemStack::DumpStats(FOutputDevice& Ar)
+{
+	FScopeLock Lock(&GetAllArenasCriticalSection());
+	Ar.Logf(TEXT("%d arenas, largest peak %d bytes"), GetAllArenas().Num(), GArenaPeakByteCount);
+	for (const FArenaMemStack* Arena : GetAllArenas())
+	{
+		// other threads may be using their arenas, so only report the counters, never walk their chunks
+		Ar.Logf(TEXT("  Thread %u: peak %d bytes, %d open scopes"), Arena->ThreadId, Arena->GetPeakByteCount(), Arena->GetNumMarks());
+	}
+}
+
+static void DumpArenaStats(const TArray<FString>& Args)
+{
+	FArenaMemStack::DumpStats(*GLog);
+}
+
+static FAutoConsoleCommand DumpArenaStatsCommand(
+	TEXT("Memory.DumpArenaStats"),
+	TEXT("Logs the peak usage of the per thread arenas used by TArenaAllocator."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&DumpArenaStats)
+	);
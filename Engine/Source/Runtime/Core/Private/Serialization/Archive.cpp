@@ -68,6 +68,7 @@ void FArchive::Reset()
 	ArIsSaving							= false;
 	ArIsTransacting						= false;
 	ArWantBinaryPropertySerialization	= false;
+	ArUseUnversionedPropertySerialization = false;
 	ArForceUnicode						= false;
 	ArIsPersistent						= false;
 	ArIsError							= false;
@@ -113,6 +114,7 @@ void FArchive::CopyTrivialFArchiveStatusMembers(const FArchive& ArchiveToCopy)
 	ArIsSaving                           = ArchiveToCopy.ArIsSaving;
 	ArIsTransacting                      = ArchiveToCopy.ArIsTransacting;
 	ArWantBinaryPropertySerialization    = ArchiveToCopy.ArWantBinaryPropertySerialization;
+	ArUseUnversionedPropertySerialization = ArchiveToCopy.ArUseUnversionedPropertySerialization;
 	ArForceUnicode                       = ArchiveToCopy.ArForceUnicode;
 	ArIsPersistent                       = ArchiveToCopy.ArIsPersistent;
 	ArIsError                            = ArchiveToCopy.ArIsError;
@@ -374,8 +376,13 @@ void FArchive::SerializeCompressed( void* V, int64 Length, ECompressionFlags Fla
 			check( PackageFileTag.CompressedSize   == PACKAGE_FILE_TAG );
 		}
 
+		// Codecs other than ZLIB store their compression type in the upper 32 bits of the chunk size, it overrides the passed in type.
+		// Data without a stored type was written by ZLIB, including all data saved before codec types were stored.
+		const int32 StoredCompressionType = (int32)(PackageFileTag.UncompressedSize >> 32) & COMPRESSION_FLAGS_TYPE_MASK;
+		Flags = (ECompressionFlags)((Flags & COMPRESSION_FLAGS_OPTIONS_MASK) | (StoredCompressionType != COMPRESS_None ? StoredCompressionType : COMPRESS_ZLIB));
+
 		// Handle change in compression chunk size in backward compatible way.
-		int64 LoadingCompressionChunkSize = PackageFileTag.UncompressedSize;
+		int64 LoadingCompressionChunkSize = PackageFileTag.UncompressedSize & 0xffffffff;
 		if (LoadingCompressionChunkSize == PACKAGE_FILE_TAG)
 		{
 			LoadingCompressionChunkSize = LOADING_COMPRESSION_CHUNK_SIZE;
@@ -427,8 +434,10 @@ void FArchive::SerializeCompressed( void* V, int64 Length, ECompressionFlags Fla
 
 		// Serialize package file tag used to determine endianess in LoadCompressedData.
 		FCompressedChunkInfo PackageFileTag;
+		// ZLIB keeps the original layout, other codecs store their compression type in the upper 32 bits of the chunk size.
+		const int64 CompressionType = Flags & COMPRESSION_FLAGS_TYPE_MASK;
 		PackageFileTag.CompressedSize	= PACKAGE_FILE_TAG;
-		PackageFileTag.UncompressedSize	= GSavingCompressionChunkSize;
+		PackageFileTag.UncompressedSize	= GSavingCompressionChunkSize | (CompressionType != COMPRESS_ZLIB ? CompressionType << 32 : 0);
 		*this << PackageFileTag;
 
 		// Figure out how many chunks there are going to be based on uncompressed size and compression chunk size.
@@ -249,7 +249,11 @@ void FAsyncIOSystemBase::FulfillCompressedRead( const FAsyncIORequest& IORequest
 		}
 	}
 
-	int32						CompressionChunkSize	= HeaderData[1];
+	int32						CompressionChunkSize	= (int32)(HeaderData[1] & 0xffffffff);
+
+	// codecs other than ZLIB store their compression type in the upper 32 bits of the chunk size, data without one is ZLIB
+	const int32					StoredCompressionType	= (int32)(HeaderData[1] >> 32) & COMPRESSION_FLAGS_TYPE_MASK;
+	ECompressionFlags			CompressionFlags		= (ECompressionFlags)((IORequest.CompressionFlags & COMPRESSION_FLAGS_OPTIONS_MASK) | (StoredCompressionType != COMPRESS_None ? StoredCompressionType : COMPRESS_ZLIB));
 	
 	// handle old packages that don't have the chunk size in the header, in which case
 	// we can use the old hardcoded size
@@ -354,7 +358,7 @@ void FAsyncIOSystemBase::FulfillCompressedRead( const FAsyncIORequest& IORequest
 	while( !bHasProcessedAllData )
 	{
 		FAsyncTask<FAsyncUncompress> UncompressTask(
-			IORequest.CompressionFlags,
+			CompressionFlags,
 			UncompressedBuffer,
 			CompressionChunks[CurrentChunkIndex].UncompressedSize,
 			CompressedBuffer[CurrentBufferIndex],
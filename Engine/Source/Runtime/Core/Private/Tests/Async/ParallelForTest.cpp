@@ -0,0 +1,87 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+#include "ParallelFor.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForTest, "System.Core.Async.ParallelFor", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+
+namespace ParallelForTest
+{
+	const int32 NumItems = 100003;
+}
+
+
+/** Checks that every item in the array was visited exactly once. */
+static bool AllVisitedOnce(const TArray<int32>& Visits)
+{
+	for (int32 Count : Visits)
+	{
+		if (Count != 1)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool FParallelForTest::RunTest(const FString& Parameters)
+{
+	using namespace ParallelForTest;
+
+	TArray<int32> Visits;
+
+	// per item body
+	Visits.Init(0, NumItems);
+	ParallelFor(NumItems, [&Visits](int32 Index)
+	{
+		FPlatformAtomics::InterlockedIncrement(&Visits[Index]);
+	});
+	TestTrue(TEXT("ParallelFor must call the body once per item"), AllVisitedOnce(Visits));
+
+	// range body
+	Visits.Init(0, NumItems);
+	ParallelForRange(NumItems, [&Visits](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; Index++)
+		{
+			FPlatformAtomics::InterlockedIncrement(&Visits[Index]);
+		}
+	});
+	TestTrue(TEXT("ParallelForRange must cover every item exactly once"), AllVisitedOnce(Visits));
+
+	// per thread contexts
+	TArray<int64> Contexts;
+	ParallelForWithTaskContext(Contexts, NumItems, [](int64& Context, int32 Begin, int32 End)
+	{
+		Context += End - Begin;
+	});
+	int64 ContextTotal = 0;
+	for (int64 Context : Contexts)
+	{
+		ContextTotal += Context;
+	}
+	TestEqual(TEXT("ParallelForWithTaskContext contexts must add up to the number of items"), ContextTotal, (int64)NumItems);
+
+	// reduce, threaded and single threaded
+	auto SumBody = [](int64& Sum, int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; Index++)
+		{
+			Sum += Index;
+		}
+	};
+	auto Add = [](const int64& A, const int64& B)
+	{
+		return A + B;
+	};
+	const int64 ExpectedSum = (int64)NumItems * (NumItems - 1) / 2;
+	TestEqual(TEXT("ParallelForReduce must add up every item"), ParallelForReduce(NumItems, (int64)0, SumBody, Add), ExpectedSum);
+	TestEqual(TEXT("Single threaded ParallelForReduce must add up every item"), ParallelForReduce(NumItems, (int64)0, SumBody, Add, true), ExpectedSum);
+	TestEqual(TEXT("ParallelForReduce over no items must return the identity"), ParallelForReduce(0, (int64)7, SumBody, Add), (int64)7);
+
+	return true;
+}
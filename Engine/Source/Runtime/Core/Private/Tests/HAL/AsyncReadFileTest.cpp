@@ -0,0 +1,178 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncReadFileTest, "System.Core.HAL.AsyncReadFile", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+
+namespace AsyncReadFileTest
+{
+	const int32 FileSize = 4 * 1024 * 1024;
+	const int32 NumSmallReads = 256;
+	const int32 SmallReadSize = 4096;
+}
+
+
+/** Value of the test file at an offset. */
+static FORCEINLINE uint8 TestFileByte(int64 Offset)
+{
+	return (uint8)((Offset * 7) ^ (Offset >> 11));
+}
+
+
+/** Checks that Data matches the test file at Offset. */
+static bool MatchesTestFile(const uint8* Data, int64 Offset, int64 Size)
+{
+	for (int64 Index = 0; Index < Size; ++Index)
+	{
+		if (Data[Index] != TestFileByte(Offset + Index))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool FAsyncReadFileTest::RunTest(const FString& Parameters)
+{
+	using namespace AsyncReadFileTest;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString Filename = FPaths::AutomationTransientDir() / TEXT("AsyncReadFileTest.bin");
+
+	TArray<uint8> Contents;
+	Contents.SetNumUninitialized(FileSize);
+	for (int32 Index = 0; Index < FileSize; ++Index)
+	{
+		Contents[Index] = TestFileByte(Index);
+	}
+	if (!FFileHelper::SaveArrayToFile(Contents, *Filename))
+	{
+		AddError(FString::Printf(TEXT("Failed to write %s"), *Filename));
+		return false;
+	}
+
+	TestTrue(TEXT("Missing files can't be opened"), PlatformFile.OpenAsyncRead(*(Filename + TEXT(".missing"))) == nullptr);
+
+	IAsyncReadFileHandle* Handle = PlatformFile.OpenAsyncRead(*Filename);
+	if (!Handle)
+	{
+		AddError(FString::Printf(TEXT("Failed to open %s for async reads"), *Filename));
+		return false;
+	}
+
+	// size request
+	IAsyncReadRequest* SizeRequest = Handle->SizeRequest();
+	TestTrue(TEXT("Size request completes"), SizeRequest->WaitCompletion());
+	TestEqual(TEXT("Size request returns the file size"), SizeRequest->GetSizeResults(), (int64)FileSize);
+	delete SizeRequest;
+
+	// many small reads with callbacks, these are merged into larger reads while they are queued
+	FThreadSafeCounter NumCallbacks;
+	FThreadSafeCounter NumBadResults;
+	FAsyncFileCallBack Callback = [&NumCallbacks, &NumBadResults](bool bWasCancelled, IAsyncReadRequest* Request)
+	{
+		NumCallbacks.Increment();
+		if (bWasCancelled)
+		{
+			NumBadResults.Increment();
+		}
+	};
+
+	FRandomStream Random(0);
+	TArray<IAsyncReadRequest*> Requests;
+	TArray<int64> Offsets;
+	for (int32 Index = 0; Index < NumSmallReads; ++Index)
+	{
+		const int64 Offset = Random.RandRange(0, FileSize - SmallReadSize);
+		const EAsyncIOPriority Priority = (EAsyncIOPriority)Random.RandRange(AIOP_Low, AIOP_High);
+		Offsets.Add(Offset);
+		Requests.Add(Handle->ReadRequest(Offset, SmallReadSize, Priority, &Callback));
+	}
+	for (int32 Index = 0; Index < Requests.Num(); ++Index)
+	{
+		IAsyncReadRequest* Request = Requests[Index];
+		Request->WaitCompletion();
+		uint8* Data = Request->GetReadResults();
+		if (!Data || !MatchesTestFile(Data, Offsets[Index], SmallReadSize))
+		{
+			NumBadResults.Increment();
+		}
+		FMemory::Free(Data);
+		delete Request;
+	}
+	TestEqual(TEXT("Every small read calls its callback once"), NumCallbacks.GetValue(), NumSmallReads);
+	TestEqual(TEXT("Small reads return the file contents"), NumBadResults.GetValue(), 0);
+
+	// large read into caller supplied memory
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(FileSize - 1000);
+	IAsyncReadRequest* LargeRequest = Handle->ReadRequest(1000, Buffer.Num(), AIOP_Normal, nullptr, Buffer.GetData());
+	LargeRequest->WaitCompletion();
+	TestTrue(TEXT("Large read uses the supplied memory"), LargeRequest->GetReadResults() == Buffer.GetData());
+	TestTrue(TEXT("Large read returns the file contents"), MatchesTestFile(Buffer.GetData(), 1000, Buffer.Num()));
+	delete LargeRequest;
+
+	// reads past the end fail
+	IAsyncReadRequest* FailedRequest = Handle->ReadRequest(FileSize - 10, 20);
+	FailedRequest->WaitCompletion();
+	TestTrue(TEXT("Reads past the end of the file fail"), FailedRequest->GetReadResults() == nullptr);
+	delete FailedRequest;
+
+	// a read past the end queued among reads next to it only fails itself, even if they are merged into one span
+	const int32 NumNeighborReads = 32;
+	Requests.Reset();
+	Offsets.Reset();
+	for (int32 Index = 0; Index < NumNeighborReads; ++Index)
+	{
+		const int64 Offset = FileSize - (int64)(NumNeighborReads - Index) * SmallReadSize;
+		Offsets.Add(Offset);
+		Requests.Add(Handle->ReadRequest(Offset, SmallReadSize, AIOP_Low));
+		if (Index == NumNeighborReads / 2)
+		{
+			FailedRequest = Handle->ReadRequest(FileSize - 10, 20, AIOP_Low);
+		}
+	}
+	FailedRequest->WaitCompletion();
+	TestTrue(TEXT("Read past the end among other reads fails"), FailedRequest->GetReadResults() == nullptr);
+	delete FailedRequest;
+	NumBadResults.Reset();
+	for (int32 Index = 0; Index < Requests.Num(); ++Index)
+	{
+		IAsyncReadRequest* Request = Requests[Index];
+		Request->WaitCompletion();
+		uint8* Data = Request->GetReadResults();
+		if (!Data || !MatchesTestFile(Data, Offsets[Index], SmallReadSize))
+		{
+			NumBadResults.Increment();
+		}
+		FMemory::Free(Data);
+		delete Request;
+	}
+	TestEqual(TEXT("Reads next to a read past the end return the file contents"), NumBadResults.GetValue(), 0);
+
+	// cancellation, queued requests complete right away and requests that were already read keep their results
+	NumCallbacks.Reset();
+	Requests.Reset();
+	for (int32 Index = 0; Index < NumSmallReads; ++Index)
+	{
+		Requests.Add(Handle->ReadRequest((int64)Index * SmallReadSize, SmallReadSize, AIOP_Low, &Callback));
+	}
+	for (IAsyncReadRequest* Request : Requests)
+	{
+		Request->Cancel();
+	}
+	for (IAsyncReadRequest* Request : Requests)
+	{
+		TestTrue(TEXT("Cancelled request completes"), Request->WaitCompletion());
+		delete Request;
+	}
+	TestEqual(TEXT("Every cancelled read calls its callback once"), NumCallbacks.GetValue(), NumSmallReads);
+
+	delete Handle;
+	PlatformFile.DeleteFile(*Filename);
+	return true;
+}
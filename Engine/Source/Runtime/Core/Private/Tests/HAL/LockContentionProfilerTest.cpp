@@ -0,0 +1,147 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+
+#if LOCK_CONTENTION_PROFILER
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLockContentionProfilerTest, "System.Core.HAL.LockContentionProfiler", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+
+namespace LockContentionProfilerTest
+{
+	/** Takes the lock once, which blocks while the test holds it. */
+	class FLockingRunnable : public FRunnable
+	{
+	public:
+		FLockingRunnable(FCriticalSection& InCriticalSection)
+			: CriticalSection(InCriticalSection)
+		{ }
+
+		virtual uint32 Run() override
+		{
+			Started.Increment();
+			FScopeLock Lock(&CriticalSection);
+			return 0;
+		}
+
+		FCriticalSection& CriticalSection;
+		FThreadSafeCounter Started;
+	};
+
+	/**
+	 * Holds CriticalSection on the calling thread while a second thread blocks on it.
+	 *
+	 * @param WaiterSampleInterval If not 0, the profiler is restarted with this interval once the lock is held
+	 */
+	void Contend(FCriticalSection& CriticalSection, int32 WaiterSampleInterval = 0)
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (WaiterSampleInterval)
+		{
+			FLockContentionProfiler::Start(WaiterSampleInterval);
+		}
+
+		FLockingRunnable Runnable(CriticalSection);
+		FRunnableThread* Thread = FRunnableThread::Create(&Runnable, TEXT("LockContentionProfilerTest"));
+		while (!Runnable.Started.GetValue())
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}
+		// give the thread time to block on the lock
+		FPlatformProcess::Sleep(0.05f);
+
+		CriticalSection.Unlock();
+		Thread->WaitForCompletion();
+		delete Thread;
+		CriticalSection.Lock();
+	}
+
+	const FLockContentionRecord* FindRecord(const TArray<FLockContentionRecord>& Records, const void* Lock)
+	{
+		return Records.FindByPredicate([Lock](const FLockContentionRecord& Record) { return Record.Lock == Lock; });
+	}
+}
+
+
+bool FLockContentionProfilerTest::RunTest(const FString& Parameters)
+{
+	using namespace LockContentionProfilerTest;
+
+	if (!FPlatformProcess::SupportsMultithreading())
+	{
+		return true;
+	}
+
+	const bool bWasEnabled = FLockContentionProfiler::IsEnabled();
+	FLockContentionProfiler::Reset();
+	FLockContentionProfiler::Start(1);
+
+	FCriticalSection CriticalSection;
+	FEvent* Event = FPlatformProcess::GetSynchEventFromPool();
+	Contend(CriticalSection);
+	Event->Wait(1);
+
+	FLockContentionProfiler::Stop();
+
+	TArray<FLockContentionRecord> Records;
+	FLockContentionProfiler::GetRecords(Records);
+
+	const FLockContentionRecord* LockRecord = FindRecord(Records, &CriticalSection);
+	if (TestNotNull(TEXT("The critical section must be recorded"), LockRecord))
+	{
+		TestEqual(TEXT("Every acquire must be recorded"), LockRecord->NumAcquires, 3u);
+		TestEqual(TEXT("The blocked thread must be recorded as contended"), LockRecord->NumContended, 1u);
+		TestTrue(TEXT("The blocked thread must have waited"), LockRecord->MaxWaitCycles > 0 && LockRecord->WaitCycles >= LockRecord->MaxWaitCycles);
+		TestEqual(TEXT("The owner must be the test thread"), LockRecord->MaxWaitOwnerThreadId, FPlatformTLS::GetCurrentThreadId());
+		TestTrue(TEXT("The longest wait must have a callstack"), LockRecord->MaxWaitCallstack[0] != 0);
+	}
+
+	const FLockContentionRecord* EventRecord = FindRecord(Records, Event);
+	if (TestNotNull(TEXT("The pooled event must be recorded"), EventRecord))
+	{
+		TestTrue(TEXT("The event must be recorded as an event"), EventRecord->Type == ELockContentionType::Event);
+		TestEqual(TEXT("The timed out wait must be recorded"), EventRecord->NumContended, 1u);
+	}
+	FPlatformProcess::ReturnSynchEventToPool(Event);
+
+	// sampling records every Nth acquire of the thread
+	FLockContentionProfiler::Reset();
+	FLockContentionProfiler::Start(4);
+	for (int32 Index = 0; Index < 100; Index++)
+	{
+		FScopeLock Lock(&CriticalSection);
+	}
+	FLockContentionProfiler::Stop();
+
+	FLockContentionProfiler::GetRecords(Records);
+	LockRecord = FindRecord(Records, &CriticalSection);
+	if (TestNotNull(TEXT("The sampled critical section must be recorded"), LockRecord))
+	{
+		TestEqual(TEXT("Every 4th acquire must be recorded"), LockRecord->NumAcquires, 25u);
+	}
+
+	// the holder is tracked on every acquire, so it is known even if its own acquire wasn't sampled
+	FLockContentionProfiler::Reset();
+	FLockContentionProfiler::Start(MAX_int32);
+	Contend(CriticalSection, 1);
+	FLockContentionProfiler::Stop();
+
+	FLockContentionProfiler::GetRecords(Records);
+	LockRecord = FindRecord(Records, &CriticalSection);
+	if (TestNotNull(TEXT("The sampled contended acquire must be recorded"), LockRecord))
+	{
+		TestEqual(TEXT("Only the blocked thread's acquire must be sampled"), LockRecord->NumContended, 1u);
+		TestEqual(TEXT("The unsampled holder must be reported"), LockRecord->MaxWaitOwnerThreadId, FPlatformTLS::GetCurrentThreadId());
+	}
+
+	FLockContentionProfiler::Reset();
+	if (bWasEnabled)
+	{
+		FLockContentionProfiler::Start();
+	}
+
+	return true;
+}
+
+#endif // LOCK_CONTENTION_PROFILER
@@ -0,0 +1,132 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMallocThroughputTest, "System.Core.HAL.Malloc Multithreaded Throughput", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+
+namespace MallocThroughputTest
+{
+	const int32 NumThreads = 8;
+	const int32 NumIterations = 200000;
+	const int32 NumLiveAllocations = 256;
+	const int32 MaxAllocationSize = 512;
+}
+
+
+/**
+ * Allocates and frees small blocks in a loop, keeping a rolling window of live allocations so
+ * frees don't always hit the block that was just allocated.
+ */
+class FMallocThroughputRunnable
+	: public FRunnable
+{
+public:
+
+	FMallocThroughputRunnable(bool bInUseTLSCaches, int32 InSeed, FThreadSafeCounter& InNumFinished)
+		: bUseTLSCaches(bInUseTLSCaches)
+		, Seed(InSeed)
+		, NumFinished(InNumFinished)
+	{ }
+
+	virtual uint32 Run() override
+	{
+		using namespace MallocThroughputTest;
+
+		if (bUseTLSCaches)
+		{
+			FMemory::SetupTLSCachesOnCurrentThread();
+		}
+
+		FRandomStream Random(Seed);
+		void* Live[NumLiveAllocations] = { nullptr };
+
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			void*& Slot = Live[Iteration % NumLiveAllocations];
+			FMemory::Free(Slot);
+			Slot = FMemory::Malloc(Random.RandRange(1, MaxAllocationSize));
+		}
+
+		for (void* Ptr : Live)
+		{
+			FMemory::Free(Ptr);
+		}
+
+		if (bUseTLSCaches)
+		{
+			FMemory::ClearAndDisableTLSCachesOnCurrentThread();
+		}
+
+		NumFinished.Increment();
+		return 0;
+	}
+
+private:
+
+	bool bUseTLSCaches;
+	int32 Seed;
+	FThreadSafeCounter& NumFinished;
+};
+
+
+/** Runs the allocation loop on NumThreads threads and returns the elapsed wall time in seconds. */
+static double RunMallocThroughput(bool bUseTLSCaches)
+{
+	using namespace MallocThroughputTest;
+
+	FThreadSafeCounter NumFinished;
+	TArray<FMallocThroughputRunnable*> Runnables;
+	TArray<FRunnableThread*> Threads;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+	{
+		FMallocThroughputRunnable* Runnable = new FMallocThroughputRunnable(bUseTLSCaches, ThreadIndex, NumFinished);
+		Runnables.Add(Runnable);
+		Threads.Add(FRunnableThread::Create(Runnable, *FString::Printf(TEXT("MallocThroughputTest%d"), ThreadIndex)));
+	}
+
+	for (FRunnableThread* Thread : Threads)
+	{
+		Thread->WaitForCompletion();
+		delete Thread;
+	}
+
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+	for (FMallocThroughputRunnable* Runnable : Runnables)
+	{
+		delete Runnable;
+	}
+
+	check(NumFinished.GetValue() == NumThreads);
+	return Elapsed;
+}
+
+
+bool FMallocThroughputTest::RunTest(const FString& Parameters)
+{
+	using namespace MallocThroughputTest;
+
+	if (!FPlatformProcess::SupportsMultithreading())
+	{
+		return true;
+	}
+
+	const double TotalOperations = 2.0 * NumThreads * NumIterations;
+
+	const double LockedTime = RunMallocThroughput(false);
+	const double CachedTime = RunMallocThroughput(true);
+
+	AddLogItem(FString::Printf(TEXT("%s, %d threads: %.2f Mops/s without TLS caches, %.2f Mops/s with TLS caches (%.2fx)"),
+		GMalloc->GetDescriptiveName(), NumThreads,
+		TotalOperations / LockedTime / 1000000.0,
+		TotalOperations / CachedTime / 1000000.0,
+		LockedTime / CachedTime));
+
+	return true;
+}
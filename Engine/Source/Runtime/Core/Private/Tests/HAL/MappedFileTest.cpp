@@ -0,0 +1,106 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMappedFileTest, "System.Core.HAL.MappedFile", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+
+namespace MappedFileTest
+{
+	const int32 FileSize = 1024 * 1024 + 123;
+}
+
+
+/** Value of the test file at an offset. */
+static FORCEINLINE uint8 MappedTestFileByte(int64 Offset)
+{
+	return (uint8)((Offset * 13) ^ (Offset >> 9));
+}
+
+
+/** Maps a region and checks its size and contents, returns false if anything doesn't match. */
+static bool MapAndVerify(IMappedFileHandle* Handle, int64 Offset, int64 BytesToMap, int64 ExpectedSize)
+{
+	IMappedFileRegion* Region = Handle->MapRegion(Offset, BytesToMap);
+	if (!Region)
+	{
+		return false;
+	}
+
+	bool bMatches = Region->GetMappedSize() == ExpectedSize;
+	const uint8* Data = Region->GetMappedPtr();
+	for (int64 Index = 0; bMatches && Index < ExpectedSize; ++Index)
+	{
+		bMatches = Data[Index] == MappedTestFileByte(Offset + Index);
+	}
+	delete Region;
+	return bMatches;
+}
+
+
+/** Runs the region checks on a handle opened by the platform file or by the generic fallback. */
+static void TestMappedHandle(FAutomationTestBase& Test, IMappedFileHandle* Handle, const TCHAR* Kind)
+{
+	using namespace MappedFileTest;
+
+	Test.TestEqual(FString::Printf(TEXT("%s handle has the file size"), Kind), Handle->GetFileSize(), (int64)FileSize);
+	Test.TestTrue(FString::Printf(TEXT("%s maps the whole file"), Kind), MapAndVerify(Handle, 0, FileSize, FileSize));
+	Test.TestTrue(FString::Printf(TEXT("%s maps unaligned regions"), Kind), MapAndVerify(Handle, 4097, 10000, 10000));
+	Test.TestTrue(FString::Printf(TEXT("%s clamps regions to the end of the file"), Kind), MapAndVerify(Handle, FileSize - 100, 1000, 100));
+	Test.TestTrue(FString::Printf(TEXT("%s rejects regions past the end of the file"), Kind), Handle->MapRegion(FileSize, 10) == nullptr);
+
+	// regions outlive each other in any order
+	IMappedFileRegion* First = Handle->MapRegion(100, 5000);
+	IMappedFileRegion* Second = Handle->MapRegion(200, 5000);
+	Test.TestTrue(FString::Printf(TEXT("%s maps overlapping regions"), Kind), First && Second && First->GetMappedPtr()[100] == Second->GetMappedPtr()[0]);
+	delete First;
+	delete Second;
+}
+
+
+bool FMappedFileTest::RunTest(const FString& Parameters)
+{
+	using namespace MappedFileTest;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString Filename = FPaths::AutomationTransientDir() / TEXT("MappedFileTest.bin");
+
+	TArray<uint8> Contents;
+	Contents.SetNumUninitialized(FileSize);
+	for (int32 Index = 0; Index < FileSize; ++Index)
+	{
+		Contents[Index] = MappedTestFileByte(Index);
+	}
+	if (!FFileHelper::SaveArrayToFile(Contents, *Filename))
+	{
+		AddError(FString::Printf(TEXT("Failed to write %s"), *Filename));
+		return false;
+	}
+
+	TestTrue(TEXT("Missing files can't be mapped"), PlatformFile.OpenMapped(*(Filename + TEXT(".missing"))) == nullptr);
+
+	IMappedFileHandle* Handle = PlatformFile.OpenMapped(*Filename);
+	if (!Handle)
+	{
+		AddError(FString::Printf(TEXT("Failed to open %s for mapping"), *Filename));
+		return false;
+	}
+	TestMappedHandle(*this, Handle, Handle->IsMemoryMapped() ? TEXT("Mapped") : TEXT("Fallback"));
+	delete Handle;
+
+	// the generic fallback every platform file inherits
+	IMappedFileHandle* FallbackHandle = PlatformFile.IPlatformFile::OpenMapped(*Filename);
+	if (!FallbackHandle)
+	{
+		AddError(FString::Printf(TEXT("Failed to open %s with the generic fallback"), *Filename));
+		return false;
+	}
+	TestFalse(TEXT("Generic fallback regions are copies"), FallbackHandle->IsMemoryMapped());
+	TestMappedHandle(*this, FallbackHandle, TEXT("Fallback"));
+	delete FallbackHandle;
+
+	PlatformFile.DeleteFile(*Filename);
+	return true;
+}
@@ -0,0 +1,157 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQueuedThreadPoolTest, "System.Core.HAL.QueuedThreadPool", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+
+namespace QueuedThreadPoolTest
+{
+	/** Blocks its thread until the gate is opened. */
+	class FGateWork : public IQueuedWork
+	{
+	public:
+		FGateWork()
+			: Gate(FPlatformProcess::GetSynchEventFromPool(true))
+		{ }
+
+		~FGateWork()
+		{
+			FPlatformProcess::ReturnSynchEventToPool(Gate);
+		}
+
+		virtual void DoThreadedWork() override
+		{
+			Started.Increment();
+			Gate->Wait();
+			Finished.Increment();
+		}
+
+		virtual void Abandon() override
+		{ }
+
+		FEvent* Gate;
+		FThreadSafeCounter Started;
+		FThreadSafeCounter Finished;
+	};
+
+	/** Records the order in which it ran. */
+	class FOrderedWork : public IQueuedWork
+	{
+	public:
+		FOrderedWork(FThreadSafeCounter& InOrderCounter)
+			: OrderCounter(InOrderCounter)
+			, Order(-1)
+		{ }
+
+		virtual void DoThreadedWork() override
+		{
+			Order = OrderCounter.Increment();
+		}
+
+		virtual void Abandon() override
+		{ }
+
+		FThreadSafeCounter& OrderCounter;
+		volatile int32 Order;
+	};
+
+	/** Waits up to a few seconds for the condition, returns whether it became true. */
+	template<typename TCondition>
+	bool WaitFor(TCondition Condition)
+	{
+		const double EndTime = FPlatformTime::Seconds() + 5.0;
+		while (!Condition())
+		{
+			if (FPlatformTime::Seconds() > EndTime)
+			{
+				return false;
+			}
+			FPlatformProcess::Sleep(0.001f);
+		}
+		return true;
+	}
+}
+
+
+bool FQueuedThreadPoolTest::RunTest(const FString& Parameters)
+{
+	using namespace QueuedThreadPoolTest;
+
+	if (!FPlatformProcess::SupportsMultithreading())
+	{
+		return true;
+	}
+
+	FQueuedThreadPool* Pool = FQueuedThreadPool::Allocate();
+	Pool->Create(1, 32 * 1024, TPri_Normal, TEXT("QueuedThreadPoolTest"));
+	TestEqual(TEXT("The pool must have the created number of threads"), Pool->GetNumThreads(), 1);
+
+	// priority bands
+	{
+		FGateWork GateWork;
+		Pool->AddQueuedWork(&GateWork);
+		TestTrue(TEXT("The gate work must start"), WaitFor([&GateWork]() { return GateWork.Started.GetValue() == 1; }));
+
+		FThreadSafeCounter OrderCounter;
+		FOrderedWork LowWork(OrderCounter);
+		FOrderedWork NormalWork(OrderCounter);
+		FOrderedWork HighWork(OrderCounter);
+		Pool->AddQueuedWork(&LowWork, EQueuedWorkPriority::Low);
+		Pool->AddQueuedWork(&NormalWork, EQueuedWorkPriority::Normal);
+		Pool->AddQueuedWork(&HighWork, EQueuedWorkPriority::High);
+
+		FQueuedThreadPoolMetrics Metrics;
+		Pool->GetMetrics(Metrics);
+		TestEqual(TEXT("Every band must hold its queued work"), Metrics.QueueDepth[(int32)EQueuedWorkPriority::High] + Metrics.QueueDepth[(int32)EQueuedWorkPriority::Normal] + Metrics.QueueDepth[(int32)EQueuedWorkPriority::Low], 3);
+
+		GateWork.Gate->Trigger();
+		TestTrue(TEXT("The queued work must run"), WaitFor([&LowWork]() { return LowWork.Order != -1; }));
+		TestTrue(TEXT("Work must run highest band first"), HighWork.Order == 1 && NormalWork.Order == 2 && LowWork.Order == 3);
+	}
+
+	// thread count changes
+	{
+		Pool->SetNumThreads(4);
+		TestEqual(TEXT("Growing must add threads"), Pool->GetNumThreads(), 4);
+
+		FGateWork GateWork;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			Pool->AddQueuedWork(&GateWork);
+		}
+		TestTrue(TEXT("All threads must pick up work"), WaitFor([&GateWork]() { return GateWork.Started.GetValue() == 4; }));
+
+		// all threads are busy, so they leave when they are done
+		Pool->SetNumThreads(2);
+		TestEqual(TEXT("Shrinking must lower the thread count right away"), Pool->GetNumThreads(), 2);
+
+		GateWork.Gate->Trigger();
+		TestTrue(TEXT("Busy threads must finish their work"), WaitFor([&GateWork]() { return GateWork.Finished.GetValue() == 4; }));
+
+		FThreadSafeCounter OrderCounter;
+		FOrderedWork Work(OrderCounter);
+		Pool->AddQueuedWork(&Work);
+		TestTrue(TEXT("The shrunk pool must still run work"), WaitFor([&Work]() { return Work.Order != -1; }));
+
+		Pool->SetNumThreads(1);
+		TestEqual(TEXT("Shrinking idle threads must lower the thread count"), Pool->GetNumThreads(), 1);
+	}
+
+	FQueuedThreadPoolMetrics Metrics;
+	TestTrue(TEXT("Waiting for the last jobs to be returned"), WaitFor([Pool, &Metrics]() { Pool->GetMetrics(Metrics); return Metrics.NumExecuted == 9; }));
+	TestEqual(TEXT("Every executed job must be in the execution time histogram"), Metrics.ExecutionTimeHistogram.GetCount(), 9u);
+	TestEqual(TEXT("Every started job must be in the wait time histogram"), Metrics.WaitTimeHistogram.GetCount(), 9u);
+	TestEqual(TEXT("Every added job must be in the queue depth histogram"), Metrics.QueueDepthHistogram.GetCount(), 9u);
+
+	Pool->GetMetrics(Metrics, true);
+	Pool->GetMetrics(Metrics);
+	TestEqual(TEXT("Resetting must clear the metrics"), Metrics.NumExecuted, (uint64)0);
+
+	Pool->Destroy();
+	delete Pool;
+
+	return true;
+}
@@ -0,0 +1,54 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FArenaAllocatorTest, "System.Core.Misc.ArenaAllocator", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+
+bool FArenaAllocatorTest::RunTest(const FString& Parameters)
+{
+	FArenaMemStack& Arena = FArenaMemStack::Get();
+	const int32 OuterByteCount = Arena.GetByteCount();
+
+	{
+		FArenaScope OuterScope;
+
+		TArray<int32, TArenaAllocator<>> Array;
+		for (int32 Index = 0; Index < 1000; ++Index)
+		{
+			Array.Add(Index);
+		}
+		TestTrue(TEXT("Array elements must live in the arena"), Arena.ContainsPointer(Array.GetData()));
+
+		const int32 ByteCountBeforeInner = Arena.GetByteCount();
+		{
+			FArenaScope InnerScope;
+
+			TMap<int32, int32, TArenaSetAllocator<>> Map;
+			TSet<int32, DefaultKeyFuncs<int32>, TArenaSetAllocator<>> Set;
+			for (int32 Index = 0; Index < 1000; ++Index)
+			{
+				Map.Add(Index, Index * 2);
+				Set.Add(Index);
+			}
+			TestTrue(TEXT("Map must find every key"), Map.FindRef(999) == 1998 && Map.Num() == 1000);
+			TestTrue(TEXT("Set must find every key"), Set.Contains(500) && Set.Num() == 1000);
+			TestTrue(TEXT("The inner scope must allocate from the arena"), Arena.GetByteCount() > ByteCountBeforeInner);
+		}
+		TestEqual(TEXT("Ending the inner scope must rewind to where it started"), Arena.GetByteCount(), ByteCountBeforeInner);
+
+		int32 Sum = 0;
+		for (int32 Value : Array)
+		{
+			Sum += Value;
+		}
+		TestEqual(TEXT("Outer scope allocations must survive the inner scope"), Sum, 999 * 1000 / 2);
+	}
+
+	TestEqual(TEXT("Ending the outer scope must free everything it allocated"), Arena.GetByteCount(), OuterByteCount);
+	TestTrue(TEXT("The peak must cover the largest scope"), Arena.GetPeakByteCount() > OuterByteCount);
+
+	return true;
+}
@@ -0,0 +1,187 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCompressionTest, "System.Core.Misc.Compression", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+
+/** Fills Data with a mix of repeated text and random bytes, roughly as compressible as cooked content. */
+static void MakeTestData(TArray<uint8>& Data, int32 Size, int32 Seed)
+{
+	static const ANSICHAR Words[] = "Engine Content Texture Material StaticMesh Blueprint Default Scene Component ";
+	FRandomStream Random(Seed);
+
+	Data.SetNumUninitialized(Size);
+	for (int32 Index = 0; Index < Size; ++Index)
+	{
+		Data[Index] = Random.RandRange(0, 7) == 0 ? (uint8)Random.RandRange(0, 255) : (uint8)Words[Index % (ARRAY_COUNT(Words) - 1)];
+	}
+}
+
+
+/** Compresses and decompresses Data with the given flags, returns false if anything fails or the data changes. */
+static bool RoundTrip(ECompressionFlags Flags, const TArray<uint8>& Data)
+{
+	TArray<uint8> Compressed;
+	int32 CompressedSize = FCompression::CompressMemoryBound(Flags, Data.Num());
+	Compressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(Flags, Compressed.GetData(), CompressedSize, Data.GetData(), Data.Num()))
+	{
+		return false;
+	}
+
+	TArray<uint8> Uncompressed;
+	Uncompressed.SetNumUninitialized(Data.Num());
+	return FCompression::UncompressMemory(Flags, Uncompressed.GetData(), Uncompressed.Num(), Compressed.GetData(), CompressedSize)
+		&& Uncompressed == Data;
+}
+
+
+/**
+ * Decompresses with the LZ4 codec directly, so failures aren't logged as errors, into a buffer followed by guard bytes.
+ * Returns the result of the codec and sets bGuardIntact to false if the decoder wrote past UncompressedSize.
+ */
+static bool UncompressLZ4Guarded(const uint8* Compressed, int32 CompressedSize, int32 UncompressedSize, bool& bGuardIntact)
+{
+	static const int32 GuardSize = 64;
+	static const uint8 GuardByte = 0xcd;
+
+	TArray<uint8> Uncompressed;
+	Uncompressed.SetNumUninitialized(UncompressedSize + GuardSize);
+	FMemory::Memset(Uncompressed.GetData() + UncompressedSize, GuardByte, GuardSize);
+	const bool bResult = FCompression::FindCodec(COMPRESS_LZ4)->UncompressMemory(Uncompressed.GetData(), UncompressedSize, Compressed, CompressedSize);
+
+	bGuardIntact = true;
+	for (int32 Index = UncompressedSize; Index < Uncompressed.Num(); ++Index)
+	{
+		bGuardIntact = bGuardIntact && Uncompressed[Index] == GuardByte;
+	}
+	return bResult;
+}
+
+
+bool FCompressionTest::RunTest(const FString& Parameters)
+{
+	// codec registry
+	TestEqual(TEXT("LZ4 is registered by name"), FCompression::GetCompressionTypeFromName(TEXT("lz4")), COMPRESS_LZ4);
+	TestEqual(TEXT("ZLIB is registered by name"), FCompression::GetCompressionTypeFromName(TEXT("ZLIB")), COMPRESS_ZLIB);
+	TestEqual(TEXT("Unknown names are rejected"), FCompression::GetCompressionTypeFromName(TEXT("Unknown")), COMPRESS_None);
+	TestTrue(TEXT("Option flags don't affect the codec lookup"), FCompression::FindCodec((ECompressionFlags)(COMPRESS_LZ4 | COMPRESS_BiasMemory)) == FCompression::FindCodec(COMPRESS_LZ4));
+
+	// round trips of every setting, including blocks too small for any match
+	static const int32 Sizes[] = { 1, 12, 13, 100, 4096, 65536 + 123, 256 * 1024 };
+	static const ECompressionFlags FlagsToTest[] =
+	{
+		COMPRESS_ZLIB,
+		COMPRESS_LZ4,
+		(ECompressionFlags)(COMPRESS_LZ4 | COMPRESS_BiasSpeed),
+		(ECompressionFlags)(COMPRESS_LZ4 | COMPRESS_BiasMemory),
+	};
+
+	TArray<uint8> Data;
+	for (int32 Size : Sizes)
+	{
+		MakeTestData(Data, Size, Size);
+		for (ECompressionFlags Flags : FlagsToTest)
+		{
+			TestTrue(FString::Printf(TEXT("Round trip of %d bytes with flags 0x%x"), Size, (int32)Flags), RoundTrip(Flags, Data));
+		}
+	}
+
+	// incompressible and constant data
+	FRandomStream Random(0);
+	Data.SetNumUninitialized(100000);
+	for (uint8& Byte : Data)
+	{
+		Byte = (uint8)Random.RandRange(0, 255);
+	}
+	TestTrue(TEXT("Round trip of random data with LZ4"), RoundTrip(COMPRESS_LZ4, Data));
+	TestTrue(TEXT("Round trip of random data with LZ4 HC"), RoundTrip((ECompressionFlags)(COMPRESS_LZ4 | COMPRESS_BiasMemory), Data));
+
+	FMemory::Memzero(Data.GetData(), Data.Num());
+	TestTrue(TEXT("Round trip of zeros with LZ4"), RoundTrip(COMPRESS_LZ4, Data));
+	TestTrue(TEXT("Round trip of zeros with LZ4 HC"), RoundTrip((ECompressionFlags)(COMPRESS_LZ4 | COMPRESS_BiasMemory), Data));
+
+	// truncated and corrupt LZ4 blocks fail without writing out of bounds
+	MakeTestData(Data, 65536, 2);
+	TArray<uint8> Compressed;
+	int32 CompressedSize = FCompression::CompressMemoryBound(COMPRESS_LZ4, Data.Num());
+	Compressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(COMPRESS_LZ4, Compressed.GetData(), CompressedSize, Data.GetData(), Data.Num()))
+	{
+		AddError(TEXT("Failed to compress the LZ4 corruption test data"));
+		return false;
+	}
+
+	bool bGuardIntact = false;
+	TestTrue(TEXT("Intact LZ4 block decodes"), UncompressLZ4Guarded(Compressed.GetData(), CompressedSize, Data.Num(), bGuardIntact) && bGuardIntact);
+	const int32 TruncatedSizes[] = { 0, 1, 2, 100, CompressedSize / 2, CompressedSize - 1 };
+	for (int32 TruncatedSize : TruncatedSizes)
+	{
+		TestFalse(FString::Printf(TEXT("LZ4 block truncated to %d bytes fails"), TruncatedSize), UncompressLZ4Guarded(Compressed.GetData(), TruncatedSize, Data.Num(), bGuardIntact));
+		TestTrue(FString::Printf(TEXT("LZ4 block truncated to %d bytes stays in bounds"), TruncatedSize), bGuardIntact);
+	}
+	TestFalse(TEXT("LZ4 block decoded into a too small buffer fails"), UncompressLZ4Guarded(Compressed.GetData(), CompressedSize, Data.Num() - 1, bGuardIntact));
+	TestTrue(TEXT("LZ4 block decoded into a too small buffer stays in bounds"), bGuardIntact);
+
+	// corrupt bytes may still decode into the right amount of garbage, but must never write past the output
+	FRandomStream CorruptRandom(3);
+	for (int32 Pass = 0; Pass < 200; ++Pass)
+	{
+		TArray<uint8> Corrupt = Compressed;
+		Corrupt.SetNum(CompressedSize);
+		for (int32 Flip = 0; Flip < 4; ++Flip)
+		{
+			Corrupt[CorruptRandom.RandRange(0, CompressedSize - 1)] = (uint8)CorruptRandom.RandRange(0, 255);
+		}
+		UncompressLZ4Guarded(Corrupt.GetData(), Corrupt.Num(), Data.Num(), bGuardIntact);
+		if (!bGuardIntact)
+		{
+			AddError(FString::Printf(TEXT("Corrupt LZ4 block %d wrote past the output buffer"), Pass));
+			break;
+		}
+	}
+
+	// hand made blocks: a match before the start of the output and a literal run longer than the input
+	static const uint8 MatchBeforeStart[] = { 0x10, 'A', 0x05, 0x00, 0x00 };
+	TestFalse(TEXT("LZ4 match before the start of the output fails"), UncompressLZ4Guarded(MatchBeforeStart, ARRAY_COUNT(MatchBeforeStart), 6, bGuardIntact));
+	static const uint8 LiteralsPastInput[] = { 0xf0, 0xff, 0x10, 'A', 'B' };
+	TestFalse(TEXT("LZ4 literal run past the end of the input fails"), UncompressLZ4Guarded(LiteralsPastInput, ARRAY_COUNT(LiteralsPastInput), 1024, bGuardIntact));
+
+	// archives store the codec so readers don't need to know it
+	MakeTestData(Data, 300000, 1);
+	TArray<uint8> ArchiveBytes;
+	{
+		FMemoryWriter Writer(ArchiveBytes);
+		Writer.SerializeCompressed(Data.GetData(), Data.Num(), COMPRESS_LZ4);
+	}
+	TArray<uint8> Loaded;
+	Loaded.SetNumZeroed(Data.Num());
+	{
+		FMemoryReader Reader(ArchiveBytes);
+		Reader.SerializeCompressed(Loaded.GetData(), Loaded.Num(), COMPRESS_ZLIB);
+	}
+	TestTrue(TEXT("LZ4 archive loads with ZLIB flags"), Loaded == Data);
+
+	// ZLIB archives keep the original header
+	ArchiveBytes.Reset();
+	{
+		FMemoryWriter Writer(ArchiveBytes);
+		Writer.SerializeCompressed(Data.GetData(), Data.Num(), COMPRESS_ZLIB);
+	}
+	int64 ChunkSize = 0;
+	FMemory::Memcpy(&ChunkSize, ArchiveBytes.GetData() + sizeof(int64), sizeof(ChunkSize));
+	TestTrue(TEXT("ZLIB archive header is unchanged"), (ChunkSize >> 32) == 0);
+
+	// archives without a stored codec are ZLIB, whatever the reader asks for
+	Loaded.SetNumZeroed(Data.Num());
+	{
+		FMemoryReader Reader(ArchiveBytes);
+		Reader.SerializeCompressed(Loaded.GetData(), Loaded.Num(), COMPRESS_LZ4);
+	}
+	TestTrue(TEXT("ZLIB archive loads with LZ4 flags"), Loaded == Data);
+
+	return true;
+}
@@ -0,0 +1,125 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConfigCacheBinaryTest, "System.Core.Misc.Config Binary Cache", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+
+namespace ConfigCacheBinaryTest
+{
+	const int32 NumLoads = 10;
+}
+
+
+/** Loads the Engine hierarchy NumLoads times and returns the average time in milliseconds. */
+static double MeasureEngineIniLoad()
+{
+	using namespace ConfigCacheBinaryTest;
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumLoads; ++Index)
+	{
+		FConfigFile ConfigFile;
+		FConfigCacheIni::LoadLocalIniFile(ConfigFile, TEXT("Engine"), true, nullptr, true);
+	}
+	return (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumLoads;
+}
+
+
+/** Checks that both files have the same sections and that MultiFind returns the same values for every key. */
+static bool ConfigFilesMatch(const FConfigFile& A, const FConfigFile& B)
+{
+	if (A.Num() != B.Num())
+	{
+		return false;
+	}
+
+	TArray<FName> Keys;
+	TArray<FString> ValuesA;
+	TArray<FString> ValuesB;
+	for (TMap<FString, FConfigSection>::TConstIterator It(A); It; ++It)
+	{
+		const FConfigSection* SectionB = B.Find(It.Key());
+		if (!SectionB || SectionB->Num() != It.Value().Num())
+		{
+			return false;
+		}
+
+		Keys.Reset();
+		It.Value().GetKeys(Keys);
+		for (const FName& Key : Keys)
+		{
+			ValuesA.Reset();
+			ValuesB.Reset();
+			It.Value().MultiFind(Key, ValuesA, true);
+			SectionB->MultiFind(Key, ValuesB, true);
+			if (ValuesA != ValuesB)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+
+bool FConfigCacheBinaryTest::RunTest(const FString& Parameters)
+{
+	const bool bWasEnabled = FConfigCacheBinary::IsEnabled();
+
+	FConfigFile Parsed;
+	FConfigCacheBinary::SetEnabled(false);
+	FConfigCacheIni::LoadLocalIniFile(Parsed, TEXT("Engine"), true, nullptr, true);
+	const double ParsedTime = MeasureEngineIniLoad();
+
+	// the first load writes the cache if it is missing or outdated
+	FConfigFile Cached;
+	FConfigCacheBinary::SetEnabled(true);
+	FConfigCacheIni::LoadLocalIniFile(Cached, TEXT("Engine"), true, nullptr, true);
+	const double CachedTime = MeasureEngineIniLoad();
+
+	FConfigCacheBinary::SetEnabled(bWasEnabled);
+
+	AddLogItem(FString::Printf(TEXT("Engine ini source hierarchy: %.2f ms parsed, %.2f ms from the binary cache"), ParsedTime, CachedTime));
+
+	if (!Parsed.SourceConfigFile || !Cached.SourceConfigFile)
+	{
+		AddError(TEXT("Loading the Engine ini didn't create the source config file"));
+		return false;
+	}
+	TestTrue(TEXT("The cached source hierarchy must match the parsed one"), ConfigFilesMatch(*Parsed.SourceConfigFile, *Cached.SourceConfigFile));
+
+	// lookups in place
+	const FString Filename = FPaths::AutomationTransientDir() / TEXT("ConfigCacheBinaryTest.bin");
+	const uint64 SourceHash = 0x1234;
+	TestTrue(TEXT("Save must write the cache"), FConfigCacheBinary::Save(Filename, SourceHash, *Parsed.SourceConfigFile));
+
+	FConfigCacheBinary BinaryCache;
+	TestFalse(TEXT("Load must reject a cache written for other sources"), BinaryCache.Load(Filename, SourceHash + 1));
+	TestTrue(TEXT("Load must accept its own cache"), BinaryCache.Load(Filename, SourceHash));
+
+	int32 NumMismatches = 0;
+	TArray<FName> Keys;
+	for (TMap<FString, FConfigSection>::TConstIterator It(*Parsed.SourceConfigFile); It; ++It)
+	{
+		Keys.Reset();
+		It.Value().GetKeys(Keys);
+		for (const FName& Key : Keys)
+		{
+			const FString* Expected = It.Value().Find(Key);
+			const TCHAR* Found = BinaryCache.FindValue(*It.Key(), *Key.ToString());
+			if (!Expected || !Found || FCString::Strcmp(**Expected, Found) != 0)
+			{
+				++NumMismatches;
+			}
+		}
+	}
+	TestEqual(TEXT("FindValue must return what Find returns"), NumMismatches, 0);
+	TestNull(TEXT("FindValue must not find missing sections"), BinaryCache.FindValue(TEXT("ConfigCacheBinaryTest.Missing"), TEXT("Key")));
+
+	IFileManager::Get().Delete(*Filename);
+
+	return true;
+}
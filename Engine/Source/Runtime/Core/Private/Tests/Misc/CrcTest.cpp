@@ -0,0 +1,119 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCrcTest, "System.Core.Misc.Crc", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHashBenchmarkTest, "System.Core.Misc.Hash Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+
+/** Byte at a time CRC32 using the first table, the reference every MemCrc32 path must match. */
+static uint32 ReferenceMemCrc32(const void* InData, int32 Length, uint32 CRC)
+{
+	const uint8* Data = (const uint8*)InData;
+	CRC = ~CRC;
+	for (int32 Index = 0; Index < Length; ++Index)
+	{
+		CRC = (CRC >> 8) ^ FCrc::CRCTablesSB8[0][(CRC & 0xFF) ^ Data[Index]];
+	}
+	return ~CRC;
+}
+
+
+bool FCrcTest::RunTest(const FString& Parameters)
+{
+	// well known CRC32 check value
+	const ANSICHAR* Check = "123456789";
+	TestEqual(TEXT("MemCrc32 of the check string"), FCrc::MemCrc32(Check, 9), 0xCBF43926u);
+
+	// every length and alignment around the block sizes of the table and the carry-less multiply paths
+	TArray<uint8> Buffer;
+	Buffer.AddUninitialized(4096 + 16);
+	FRandomStream Random(1234);
+	for (uint8& Byte : Buffer)
+	{
+		Byte = (uint8)Random.RandHelper(256);
+	}
+
+	int32 NumMismatches = 0;
+	for (int32 Offset = 0; Offset < 16; ++Offset)
+	{
+		for (int32 Length = 0; Length <= 4096; Length += (Length < 256 ? 1 : 61))
+		{
+			const uint32 Seed = (uint32)Length * 2654435761u;
+			if (FCrc::MemCrc32(Buffer.GetData() + Offset, Length, Seed) != ReferenceMemCrc32(Buffer.GetData() + Offset, Length, Seed))
+			{
+				++NumMismatches;
+			}
+		}
+	}
+	TestEqual(TEXT("MemCrc32 must match the byte at a time reference for every length and alignment"), NumMismatches, 0);
+
+	// xxHash64 reference values
+	TestEqual(TEXT("MemHash64 of an empty buffer"), FCrc::MemHash64("", 0), 0xEF46DB3751D8E999ull);
+	TestEqual(TEXT("MemHash64 of \"a\""), FCrc::MemHash64("a", 1), 0xD24EC4F1A98C6E5Bull);
+	TestEqual(TEXT("MemHash64 of \"abc\""), FCrc::MemHash64("abc", 3), 0x44BC2CF5AD770999ull);
+	const ANSICHAR* Long = "Nobody inspects the spammish repetition";
+	TestEqual(TEXT("MemHash64 of a string longer than one stripe"), FCrc::MemHash64(Long, FCStringAnsi::Strlen(Long)), 0xFBCEA83C8A378BF1ull);
+
+	return true;
+}
+
+
+/** Runs Func over Buffer until at least MinBytes have been hashed and returns the throughput in MB/s. */
+template <typename FuncType>
+static double MeasureHashThroughput(const TArray<uint8>& Buffer, int32 BlockSize, FuncType Func)
+{
+	const int64 MinBytes = 256 * 1024 * 1024;
+	const int32 NumBlocks = Buffer.Num() / BlockSize;
+	uint64 Sink = 0;
+	int64 BytesHashed = 0;
+
+	const double StartTime = FPlatformTime::Seconds();
+	while (BytesHashed < MinBytes)
+	{
+		for (int32 Block = 0; Block < NumBlocks; ++Block)
+		{
+			Sink += Func(Buffer.GetData() + Block * BlockSize, BlockSize);
+		}
+		BytesHashed += NumBlocks * BlockSize;
+	}
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+	// keep the optimizer from dropping the hashing
+	FPlatformMisc::MemoryBarrier();
+	if (Sink == 0x1234)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Hash sink hit"));
+	}
+	return BytesHashed / Elapsed / (1024.0 * 1024.0);
+}
+
+
+bool FHashBenchmarkTest::RunTest(const FString& Parameters)
+{
+	TArray<uint8> Buffer;
+	Buffer.AddUninitialized(1024 * 1024);
+	FRandomStream Random(1234);
+	for (uint8& Byte : Buffer)
+	{
+		Byte = (uint8)Random.RandHelper(256);
+	}
+
+	AddLogItem(FString::Printf(TEXT("MemCrc32 hardware acceleration: %s"), FCrc::IsMemCrc32HardwareAccelerated() ? TEXT("yes") : TEXT("no")));
+
+	const int32 BlockSizes[] = { 16, 64, 256, 4096, 64 * 1024 };
+	for (int32 BlockSize : BlockSizes)
+	{
+		const double Reference = MeasureHashThroughput(Buffer, BlockSize, [](const uint8* Data, int32 Length) { return (uint64)ReferenceMemCrc32(Data, Length, 0); });
+		const double Crc32 = MeasureHashThroughput(Buffer, BlockSize, [](const uint8* Data, int32 Length) { return (uint64)FCrc::MemCrc32(Data, Length); });
+		const double Crc32Deprecated = MeasureHashThroughput(Buffer, BlockSize, [](const uint8* Data, int32 Length) { return (uint64)FCrc::MemCrc_DEPRECATED(Data, Length); });
+		const double Hash64 = MeasureHashThroughput(Buffer, BlockSize, [](const uint8* Data, int32 Length) { return FCrc::MemHash64(Data, Length); });
+
+		AddLogItem(FString::Printf(TEXT("%6d byte blocks: byte CRC32 %8.1f MB/s, MemCrc32 %8.1f MB/s, MemCrc_DEPRECATED %8.1f MB/s, MemHash64 %8.1f MB/s"),
+			BlockSize, Reference, Crc32, Crc32Deprecated, Hash64));
+	}
+
+	return true;
+}
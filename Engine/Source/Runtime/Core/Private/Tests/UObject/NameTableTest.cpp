@@ -0,0 +1,124 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNameTableConcurrencyTest, "System.Core.UObject.Name Table Concurrent Creation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+
+namespace NameTableTest
+{
+	const int32 NumThreads = 8;
+	const int32 NumUniqueNamesPerThread = 50000;
+	const int32 NumSharedNames = 1000;
+	const int32 NumSharedLookupsPerThread = 200000;
+}
+
+
+/**
+ * Creates names that only this thread uses, then repeatedly finds or adds a set of names shared by all threads,
+ * which is what async loading does with the names in package name maps.
+ */
+class FNameTableTestRunnable
+	: public FRunnable
+{
+public:
+
+	FNameTableTestRunnable(int32 InThreadIndex, int32 InRunIndex)
+		: ThreadIndex(InThreadIndex)
+		, RunIndex(InRunIndex)
+	{ }
+
+	virtual uint32 Run() override
+	{
+		using namespace NameTableTest;
+
+		for (int32 Index = 0; Index < NumUniqueNamesPerThread; ++Index)
+		{
+			FName(*FString::Printf(TEXT("NameTableTest_%d_Unique_%d_%d"), RunIndex, ThreadIndex, Index));
+		}
+
+		SharedNames.Reserve(NumSharedNames);
+		for (int32 Index = 0; Index < NumSharedLookupsPerThread; ++Index)
+		{
+			const int32 SharedIndex = (Index * 7 + ThreadIndex) % NumSharedNames;
+			FName Name(*FString::Printf(TEXT("NameTableTest_%d_Shared_%d"), RunIndex, SharedIndex));
+			if (Index < NumSharedNames)
+			{
+				SharedNames.Add(Name);
+			}
+		}
+
+		return 0;
+	}
+
+	int32 ThreadIndex;
+	int32 RunIndex;
+	/** The first shared names this thread created, in creation order, so the main thread can check that every thread got the same entries. */
+	TArray<FName> SharedNames;
+};
+
+
+bool FNameTableConcurrencyTest::RunTest(const FString& Parameters)
+{
+	using namespace NameTableTest;
+
+	if (!FPlatformProcess::SupportsMultithreading())
+	{
+		return true;
+	}
+
+	// names are never freed, so use a different set every time the test runs
+	static int32 RunIndex = 0;
+	RunIndex++;
+
+	const int32 NumNamesBefore = FName::GetMaxNames();
+	TArray<FNameTableTestRunnable*> Runnables;
+	TArray<FRunnableThread*> Threads;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+	{
+		FNameTableTestRunnable* Runnable = new FNameTableTestRunnable(ThreadIndex, RunIndex);
+		Runnables.Add(Runnable);
+		Threads.Add(FRunnableThread::Create(Runnable, *FString::Printf(TEXT("NameTableTest%d"), ThreadIndex)));
+	}
+
+	for (FRunnableThread* Thread : Threads)
+	{
+		Thread->WaitForCompletion();
+		delete Thread;
+	}
+
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+	// every thread must have resolved the shared names to the same entries
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+	{
+		for (int32 Index = 0; Index < NumSharedNames; ++Index)
+		{
+			const int32 SharedIndex = (Index * 7 + ThreadIndex) % NumSharedNames;
+			const FName Expected(*FString::Printf(TEXT("NameTableTest_%d_Shared_%d"), RunIndex, SharedIndex), FNAME_Find);
+			if (Runnables[ThreadIndex]->SharedNames[Index] != Expected || Expected.GetComparisonIndex() < NumNamesBefore)
+			{
+				AddError(FString::Printf(TEXT("Thread %d got a different entry for shared name %d"), ThreadIndex, SharedIndex));
+				break;
+			}
+		}
+	}
+
+	const int32 NumNamesAdded = FName::GetMaxNames() - NumNamesBefore;
+
+	for (FNameTableTestRunnable* Runnable : Runnables)
+	{
+		delete Runnable;
+	}
+
+	const double NumOperations = NumThreads * (double)(NumUniqueNamesPerThread + NumSharedLookupsPerThread);
+	AddLogItem(FString::Printf(TEXT("%d threads: %.2f M names/s (%d added, %.2f ms)"),
+		NumThreads, NumOperations / Elapsed / 1000000.0, NumNamesAdded, Elapsed * 1000.0));
+
+	return true;
+}
@@ -222,6 +222,16 @@ FCriticalSection* FName::GetCriticalSection()
 	return CriticalSection;
 }
 
+/** Insertion locks for the hash buckets, created by FName::StaticInit. */
+static FCriticalSection* GNameHashShardCriticalSections[FNameDefs::NameHashShardCount];
+
+FCriticalSection* FName::GetHashShardCriticalSection(uint32 HashIndex)
+{
+	FCriticalSection* CriticalSection = GNameHashShardCriticalSections[HashIndex & (FNameDefs::NameHashShardCount - 1)];
+	checkSlow(CriticalSection);
+	return CriticalSection;
+}
+
 FString FName::NameToDisplayString( const FString& InDisplayName, const bool bIsBool )
 {
 	// Copy the characters out so that we can modify the string in place
@@ -587,6 +597,55 @@ struct FNameInitHelper<WIDECHAR>
 	}
 };
 
+/** Folds a character for the case insensitive hash. Ansi names are pure ansi, so a plain ascii fold is enough for them. */
+FORCEINLINE uint32 NameHashFoldCase(ANSICHAR Char)
+{
+	return (uint8)((Char >= 'a' && Char <= 'z') ? Char - ('a' - 'A') : Char);
+}
+
+FORCEINLINE uint32 NameHashFoldCase(WIDECHAR Char)
+{
+	return (uint32)TChar<WIDECHAR>::ToUpper(Char);
+}
+
+FORCEINLINE uint32 NameHashChar(ANSICHAR Char)
+{
+	return (uint8)Char;
+}
+
+FORCEINLINE uint32 NameHashChar(WIDECHAR Char)
+{
+	return (uint32)Char;
+}
+
+/**
+ * Hashes a name for the name hash. This is an FNV-1a over characters followed by a final mix so the low bits used
+ * for the bucket index are well distributed; it is much cheaper than the table driven CRCs.
+ */
+template <typename TCharType>
+static FORCEINLINE uint32 GetNameHash(const TCharType* InName, const ENameCase ComparisonMode)
+{
+	uint32 Hash = 0x811c9dc5;
+	if (ComparisonMode == ENameCase::IgnoreCase)
+	{
+		for (; *InName; ++InName)
+		{
+			Hash = (Hash ^ NameHashFoldCase(*InName)) * 0x01000193;
+		}
+	}
+	else
+	{
+		for (; *InName; ++InName)
+		{
+			Hash = (Hash ^ NameHashChar(*InName)) * 0x01000193;
+		}
+	}
+	Hash ^= Hash >> 16;
+	Hash *= 0x85ebca6b;
+	Hash ^= Hash >> 13;
+	return Hash;
+}
+
 template <typename TCharType>
 bool FName::InitInternal_FindOrAdd(const TCharType* InName, const EFindName FindType, const int32 HardcodeIndex, int32& OutComparisonIndex, int32& OutDisplayIndex)
 {
@@ -626,11 +685,11 @@ bool FName::InitInternal_FindOrAddNameEntry(const TCharType* InName, const EFind
 {
 	CallNameCreationHook();
 	// Hash value of string
-	const int32 iHash = ( (ComparisonMode == ENameCase::IgnoreCase) ? FCrc::Strihash_DEPRECATED( InName ) : FCrc::StrCrc32( InName ) ) & (ARRAY_COUNT(NameHash)-1);
+	const int32 iHash = GetNameHash( InName, ComparisonMode ) & (ARRAY_COUNT(NameHash)-1);
 
 	if (OutIndex < 0)
 	{
-		// Try to find the name in the hash.
+		// Try to find the name in the hash. This doesn't lock, entries are only ever pushed on the head of a bucket with an atomic exchange.
 		for( FNameEntry* Hash=NameHash[iHash]; Hash; Hash=Hash->HashNext )
 		{
 			FPlatformMisc::Prefetch( Hash->HashNext );
@@ -666,8 +725,8 @@ bool FName::InitInternal_FindOrAddNameEntry(const TCharType* InName, const EFind
 			return false;
 		}
 	}
-	// acquire the lock
-	FScopeLock ScopeLock(GetCriticalSection());
+	// acquire the insertion lock for this bucket
+	FScopeLock ScopeLock(GetHashShardCriticalSection(iHash));
 	if (OutIndex < 0)
 	{
 		// Try to find the name in the hash. AGAIN...we might have been adding from a different thread and we just missed it
@@ -685,15 +744,20 @@ bool FName::InitInternal_FindOrAddNameEntry(const TCharType* InName, const EFind
 	}
 	FNameEntry* OldHash=NameHash[iHash];
 	TNameEntryArray& Names = GetNames();
-	if (OutIndex < 0)
+	FNameEntry* NewEntry;
 	{
-		OutIndex = Names.AddZeroed(1);
-	}
-	else
-	{
-		check(OutIndex < Names.Num());
+		// the name table and the entry pool are shared by all buckets
+		FScopeLock TableLock(GetCriticalSection());
+		if (OutIndex < 0)
+		{
+			OutIndex = Names.AddZeroed(1);
+		}
+		else
+		{
+			check(OutIndex < Names.Num());
+		}
+		NewEntry = AllocateNameEntry( InName, OutIndex, OldHash, FNameInitHelper<TCharType>::IsAnsi );
 	}
-	FNameEntry* NewEntry = AllocateNameEntry( InName, OutIndex, OldHash, FNameInitHelper<TCharType>::IsAnsi );
 	if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Names[OutIndex], NewEntry, NULL) != NULL) // we use an atomic operation to check for unexpected concurrency, verify alignment, etc
 	{
 		UE_LOG(LogUnrealNames, Fatal, TEXT("Hardcoded name '%s' at index %i was duplicated (or unexpected concurrency). Existing entry is '%s'."), *NewEntry->GetPlainNameString(), NewEntry->GetIndex(), *Names[OutIndex]->GetPlainNameString() );
@@ -769,6 +833,11 @@ void FName::StaticInit()
 	{
 		NameHash[HashIndex] = NULL;
 	}
+	check((FNameDefs::NameHashShardCount & (FNameDefs::NameHashShardCount - 1)) == 0 && FNameDefs::NameHashShardCount <= FNameDefs::NameHashBucketCount);
+	for (uint32 ShardIndex = 0; ShardIndex < FNameDefs::NameHashShardCount; ShardIndex++)
+	{
+		GNameHashShardCriticalSections[ShardIndex] = new FCriticalSection();
+	}
 
 	{
 		FScopeLock ScopeLock(GetCriticalSection());
@@ -846,7 +915,7 @@ void FName::DisplayHash( FOutputDevice& Ar )
 			MemUsed += FNameEntry::GetSize( Hash->GetNameLength(), Hash->IsWide() );
 		}
 	}
-	Ar.Logf( TEXT("Hash: %i names, %i/%i hash bins, Mem in bytes %i"), NameCount, UsedBins, ARRAY_COUNT(NameHash), MemUsed);
+	Ar.Logf( TEXT("Hash: %i names, %i/%i hash bins, %i insertion locks, Mem in bytes %i"), NameCount, UsedBins, ARRAY_COUNT(NameHash), FNameDefs::NameHashShardCount, MemUsed);
 }
 
 bool FName::SplitNameWithCheck(const WIDECHAR* OldName, WIDECHAR* NewName, int32 NewNameLen, int32& NewNumber)
@@ -0,0 +1,241 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	AsyncFileHandle.h: Asynchronous file read interfaces
+=============================================================================*/
+
+#pragma once
+
+#include "IOBase.h"
+
+class IAsyncReadRequest;
+class IPlatformFile;
+class IFileHandle;
+
+/**
+ * Callback for completed async read requests. Called exactly once per request on the thread that completed it, usually an IO thread.
+ * bWasCancelled is true if the request was cancelled, the results are not valid then.
+ */
+typedef TFunction<void(bool bWasCancelled, IAsyncReadRequest* Request)> FAsyncFileCallBack;
+
+
+/**
+ * An outstanding async size or read request. Requests have to be complete before they are deleted, use WaitCompletion if in doubt.
+ */
+class CORE_API IAsyncReadRequest
+{
+public:
+	IAsyncReadRequest(FAsyncFileCallBack* InCallback, bool bInSizeRequest, uint8* InUserSuppliedMemory)
+		: Size(-1)
+		, Memory(InUserSuppliedMemory)
+		, bSizeRequest(bInSizeRequest)
+		, bUserSuppliedMemory(InUserSuppliedMemory != nullptr)
+	{
+		if (InCallback)
+		{
+			Callback = *InCallback;
+		}
+	}
+
+	/** Destructor, the request has to be complete. Frees the results unless they were taken with GetReadResults. */
+	virtual ~IAsyncReadRequest();
+
+	/** Returns true if the request is complete and its callback was called. */
+	FORCEINLINE bool PollCompletion() const
+	{
+		return bCompleteAndCallbackCalled;
+	}
+
+	/**
+	 * Waits for the request to complete.
+	 *
+	 * @param TimeLimitSeconds	Maximum time to wait, 0 waits forever.
+	 * @return					true if the request is complete.
+	 */
+	bool WaitCompletion(float TimeLimitSeconds = 0.0f)
+	{
+		if (!PollCompletion())
+		{
+			WaitCompletionImpl(TimeLimitSeconds);
+		}
+		return PollCompletion();
+	}
+
+	/** Cancels the request. Queued requests complete right away, requests that are being read complete when the read finishes. */
+	void Cancel()
+	{
+		if (!PollCompletion())
+		{
+			bCanceled = true;
+			CancelImpl();
+		}
+	}
+
+	/** Returns the size of the file for a complete size request, -1 if it failed or was cancelled. */
+	FORCEINLINE int64 GetSizeResults() const
+	{
+		check(PollCompletion() && bSizeRequest);
+		return Size;
+	}
+
+	/**
+	 * Returns the data of a complete read request, nullptr if it failed or was cancelled. Unless the memory was supplied by the caller,
+	 * the caller takes ownership of it and frees it with FMemory::Free.
+	 */
+	uint8* GetReadResults()
+	{
+		check(PollCompletion() && !bSizeRequest);
+		uint8* Result = Memory;
+		if (!bUserSuppliedMemory)
+		{
+			Memory = nullptr;
+		}
+		return Result;
+	}
+
+protected:
+
+	/** Waits for completion, may return early when the time limit is reached. */
+	virtual void WaitCompletionImpl(float TimeLimitSeconds) = 0;
+
+	/** Cancels the request after bCanceled has been set. */
+	virtual void CancelImpl() = 0;
+
+	/** Calls the callback and marks the request complete. The request may be deleted as soon as this returns, so it has to be the last access. */
+	void SetComplete()
+	{
+		if (Callback)
+		{
+			Callback(bCanceled, this);
+		}
+		bCompleteAndCallbackCalled = true;
+	}
+
+	/** Result of a size request. */
+	int64 Size;
+	/** Result of a read request, either allocated by the request or supplied by the caller. */
+	uint8* Memory;
+	/** Whether this is a size request. */
+	const bool bSizeRequest;
+	/** Whether Memory was supplied by the caller. */
+	const bool bUserSuppliedMemory;
+	/** Set when the request is cancelled. */
+	FThreadSafeBool bCanceled;
+
+private:
+	/** Set after the callback was called. */
+	FThreadSafeBool bCompleteAndCallbackCalled;
+	/** Called when the request completes. */
+	FAsyncFileCallBack Callback;
+};
+
+
+/**
+ * Handle to a file opened for async reads, see IPlatformFile::OpenAsyncRead. All requests have to be complete and deleted before the handle is deleted.
+ */
+class CORE_API IAsyncReadFileHandle
+{
+public:
+	/** Destructor, also the only way to close the handle. */
+	virtual ~IAsyncReadFileHandle()
+	{
+	}
+
+	/**
+	 * Requests the size of the file.
+	 *
+	 * @param CompleteCallback	Called when the request completes, can be nullptr.
+	 * @return					The request, delete it once it is complete.
+	 */
+	virtual IAsyncReadRequest* SizeRequest(FAsyncFileCallBack* CompleteCallback = nullptr) = 0;
+
+	/**
+	 * Requests bytes from the file.
+	 *
+	 * @param Offset				Offset of the first byte to read.
+	 * @param BytesToRead			Number of bytes to read.
+	 * @param Priority				Higher priority requests are read first.
+	 * @param CompleteCallback		Called when the request completes, can be nullptr.
+	 * @param UserSuppliedMemory	Memory to read into, at least BytesToRead in size. If nullptr, the request allocates the memory.
+	 * @return						The request, delete it once it is complete.
+	 */
+	virtual IAsyncReadRequest* ReadRequest(int64 Offset, int64 BytesToRead, EAsyncIOPriority Priority = AIOP_Normal, FAsyncFileCallBack* CompleteCallback = nullptr, uint8* UserSuppliedMemory = nullptr) = 0;
+};
+
+
+/**
+ * Async read handle serviced by a shared pool of IO threads (s.AsyncReadThreads).
+ *
+ * Queued requests are read in priority order. When an IO thread picks a read, it also takes queued reads of the same handle that are
+ * close to it and reads the whole span at once (s.AsyncReadMaxBatchKB, s.AsyncReadMaxGapKB), so many small reads cost a few large ones.
+ * Subclasses provide the blocking reads, which may be called from several IO threads at once.
+ */
+class CORE_API FQueuedAsyncReadFileHandle : public IAsyncReadFileHandle
+{
+public:
+	FQueuedAsyncReadFileHandle()
+	{
+	}
+
+	/** Destructor, all requests have to be deleted. */
+	virtual ~FQueuedAsyncReadFileHandle();
+
+	virtual IAsyncReadRequest* SizeRequest(FAsyncFileCallBack* CompleteCallback = nullptr) override;
+	virtual IAsyncReadRequest* ReadRequest(int64 Offset, int64 BytesToRead, EAsyncIOPriority Priority = AIOP_Normal, FAsyncFileCallBack* CompleteCallback = nullptr, uint8* UserSuppliedMemory = nullptr) override;
+
+	/** Returns the size of the file, or -1 if it can't be determined. Called from IO threads. */
+	virtual int64 GetSize() = 0;
+
+	/**
+	 * Reads bytes at an offset. Called from IO threads, possibly several at once.
+	 *
+	 * @return true if all bytes were read.
+	 */
+	virtual bool ReadAt(uint8* Destination, int64 Offset, int64 BytesToRead) = 0;
+
+	/** Stops the shared IO threads, completing anything still queued. Later requests are read on the calling thread. Called on engine exit. */
+	static void ShutdownIOThreads();
+
+private:
+	friend class FQueuedAsyncReadRequest;
+
+	/** Number of requests that haven't been deleted yet. */
+	FThreadSafeCounter NumRequests;
+};
+
+
+/**
+ * Queued async read handle that reads through synchronous handles of a platform file, opening one handle per concurrent read.
+ * Can also expose a range of a file as a file of its own.
+ */
+class CORE_API FGenericAsyncReadFileHandle : public FQueuedAsyncReadFileHandle
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param InPlatformFile	Platform file to open the synchronous handles with.
+	 * @param InFilename		File to read.
+	 * @param InBaseOffset		Offset of the range within the file.
+	 * @param InSize			Size of the range, -1 for the rest of the file.
+	 */
+	FGenericAsyncReadFileHandle(IPlatformFile* InPlatformFile, const TCHAR* InFilename, int64 InBaseOffset = 0, int64 InSize = -1);
+	virtual ~FGenericAsyncReadFileHandle();
+
+	virtual int64 GetSize() override;
+	virtual bool ReadAt(uint8* Destination, int64 Offset, int64 BytesToRead) override;
+
+private:
+	/** Platform file to open the synchronous handles with. */
+	IPlatformFile* PlatformFile;
+	/** File to read. */
+	FString Filename;
+	/** Offset of the range within the file. */
+	int64 BaseOffset;
+	/** Size of the range, -1 until known. */
+	int64 Size;
+	/** Synchronous handles that aren't used by a read. */
+	TArray<IFileHandle*> FreeHandles;
+	/** Guards FreeHandles and Size. */
+	FCriticalSection Lock;
+};
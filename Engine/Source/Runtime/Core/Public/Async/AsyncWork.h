@@ -55,8 +55,9 @@ class FAutoDeleteAsyncTask
 
 	/* Generic start function, not called directly
 		* @param bForceSynchronous if true, this job will be started synchronously, now, on this thread
+		* @param InPriority the priority band the job is queued in
 	**/
-	void Start(bool bForceSynchronous)
+	void Start(bool bForceSynchronous, EQueuedWorkPriority InPriority = EQueuedWorkPriority::Normal)
 	{
 		FPlatformMisc::MemoryBarrier();
 		FQueuedThreadPool* QueuedPool = GThreadPool;
@@ -66,7 +67,7 @@ class FAutoDeleteAsyncTask
 		}
 		if (QueuedPool)
 		{
-			QueuedPool->AddQueuedWork(this);
+			QueuedPool->AddQueuedWork(this, InPriority);
 		}
 		else 
 		{
@@ -182,10 +183,11 @@ public:
 
 	/** 
 	* Run this task on the lo priority thread pool. It is not safe to use this object after this call.
+	* @param InPriority the priority band the job is queued in
 	**/
-	void StartBackgroundTask()
+	void StartBackgroundTask(EQueuedWorkPriority InPriority = EQueuedWorkPriority::Normal)
 	{
-		Start(false);
+		Start(false, InPriority);
 	}
 
 };
@@ -267,8 +269,9 @@ class FAsyncTask
 
 	/* Generic start function, not called directly
 		* @param bForceSynchronous if true, this job will be started synchronously, now, on this thread
+		* @param InPriority the priority band the job is queued in
 	**/
-	void Start(bool bForceSynchronous, FQueuedThreadPool* InQueuedPool)
+	void Start(bool bForceSynchronous, FQueuedThreadPool* InQueuedPool, EQueuedWorkPriority InPriority = EQueuedWorkPriority::Normal)
 	{
 		FScopeCycleCounter Scope( Task.GetStatId(), true );
 		DECLARE_SCOPE_CYCLE_COUNTER( TEXT( "FAsyncTask::Start" ), STAT_FAsyncTask_Start, STATGROUP_ThreadPoolAsyncTasks );
@@ -288,7 +291,7 @@ class FAsyncTask
 				DoneEvent = FPlatformProcess::GetSynchEventFromPool(true);
 			}
 			DoneEvent->Reset();
-			QueuedPool->AddQueuedWork(this);
+			QueuedPool->AddQueuedWork(this, InPriority);
 		}
 		else 
 		{
@@ -495,10 +498,12 @@ public:
 
 	/** 
 	* Queue this task for processing by the background thread pool
+	* @param InQueuedPool the pool to run the task on
+	* @param InPriority the priority band the job is queued in
 	**/
-	void StartBackgroundTask(FQueuedThreadPool* InQueuedPool = GThreadPool)
+	void StartBackgroundTask(FQueuedThreadPool* InQueuedPool = GThreadPool, EQueuedWorkPriority InPriority = EQueuedWorkPriority::Normal)
 	{
-		Start(false, InQueuedPool);
+		Start(false, InQueuedPool, InPriority);
 	}
 
 	/** 
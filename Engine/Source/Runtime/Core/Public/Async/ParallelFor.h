@@ -12,18 +12,31 @@
 // struct to hold the working data; this outlives the ParallelFor call; lifetime is controlled by a shared pointer
 struct FParallelForData
 {
+	enum
+	{
+		/** The work is split into at most this many blocks per thread; threads claim several blocks at once when the blocks are cheap. **/
+		MaxBlocksPerThread = 16,
+		/** Threads try to claim enough blocks to keep each claim around this long, to amortize the cost of claiming without hurting the load balance. **/
+		TargetClaimMicroseconds = 20,
+	};
+
 	int32 Num;
 	int32 BlockSize;
 	int32 LastBlockExtraNum;
-	TFunctionRef<void(int32)> Body;
+	int32 NumThreads;
+	uint32 TargetClaimCycles;
+	// Body(ContextIndex, Begin, End); ContextIndex is unique to each call of Process and is less than NumThreads + 1
+	TFunctionRef<void(int32, int32, int32)> Body;
 	FEvent* Event;
 	FThreadSafeCounter IndexToDo;
 	FThreadSafeCounter NumCompleted;
+	FThreadSafeCounter NextContextIndex;
 	bool bExited;
 	bool bTriggered;
 	bool bSaveLastBlockForMaster;
-	FParallelForData(int32 InTotalNum, int32 InNumThreads, bool bInSaveLastBlockForMaster, TFunctionRef<void(int32)> InBody)
-		: Body(InBody)
+	FParallelForData(int32 InTotalNum, int32 InNumThreads, bool bInSaveLastBlockForMaster, TFunctionRef<void(int32, int32, int32)> InBody)
+		: NumThreads(InNumThreads)
+		, Body(InBody)
 		, Event(FPlatformProcess::GetSynchEventFromPool(false))
 		, bExited(false)
 		, bTriggered(false)
@@ -32,7 +45,7 @@ struct FParallelForData
 		check(InTotalNum >= InNumThreads);
 		BlockSize = 0;
 		Num = 0;
-		for (int32 Div = 3; Div; Div--)
+		for (int32 Div = MaxBlocksPerThread; Div; Div--)
 		{
 			BlockSize = InTotalNum / (InNumThreads * Div);
 			if (BlockSize)
@@ -47,6 +60,7 @@ struct FParallelForData
 		check(BlockSize && Num);
 		LastBlockExtraNum = InTotalNum - Num * BlockSize;
 		check(LastBlockExtraNum >= 0);
+		TargetClaimCycles = FMath::Max<uint32>(1, uint32(TargetClaimMicroseconds / (FPlatformTime::GetSecondsPerCycle() * 1000000.0)));
 	}
 	~FParallelForData()
 	{
@@ -101,42 +115,63 @@ inline bool FParallelForData::Process(int32 TasksToSpawn, TSharedRef<FParallelFo
 	}
 	int32 LocalBlockSize = BlockSize;
 	int32 LocalNum = Num;
+	int32 LocalLastBlockExtraNum = LastBlockExtraNum;
+	int32 LocalNumThreads = NumThreads;
+	uint32 LocalTargetClaimCycles = TargetClaimCycles;
 	bool bLocalSaveLastBlockForMaster = bSaveLastBlockForMaster;
-	TFunctionRef<void(int32)> LocalBody(Body);
+	TFunctionRef<void(int32, int32, int32)> LocalBody(Body);
+	const int32 ContextIndex = NextContextIndex.Increment() - 1;
+	checkSlow(ContextIndex <= LocalNumThreads);
+	// number of blocks to claim at once, adjusted from the measured cost of the previous claim
+	int32 BlocksToClaim = 1;
 	while (true)
 	{
-		int32 MyIndex = IndexToDo.Increment() - 1;
+		// never claim more than a fraction of what is left, so the tail is still shared between the threads
+		const int32 MaxBlocksToClaim = FMath::Max<int32>(1, (LocalNum - IndexToDo.GetValue()) / (LocalNumThreads * 2));
+		const int32 ThisClaim = FMath::Min<int32>(BlocksToClaim, MaxBlocksToClaim);
+		int32 MyIndex = IndexToDo.Add(ThisClaim);
+		int32 MyEnd = FMath::Min<int32>(MyIndex + ThisClaim, LocalNum);
+		bool bLastClaim = MyIndex + ThisClaim >= LocalNum;
 		if (bLocalSaveLastBlockForMaster)
 		{
-			if (!bMaster && MyIndex >= LocalNum - 1)
+			if (!bMaster)
 			{
-				break; // leave the last block for the master, hoping to avoid an event
+				if (MyIndex >= LocalNum - 1)
+				{
+					break; // leave the last block for the master, hoping to avoid an event
+				}
+				MyEnd = FMath::Min<int32>(MyEnd, LocalNum - 1);
 			}
-			else if (bMaster && MyIndex > LocalNum - 1)
+			else if (MyIndex > LocalNum - 1)
 			{
-				MyIndex = LocalNum - 1; // I am the master, I need to take this block, hoping to avoid an event
+				// I am the master, I need to take this block, hoping to avoid an event
+				MyIndex = LocalNum - 1;
+				MyEnd = LocalNum;
 			}
 		}
-		if (MyIndex < LocalNum)
+		if (MyIndex < MyEnd)
 		{
-			int32 ThisBlockSize = LocalBlockSize;
-			if (MyIndex == LocalNum - 1)
+			const uint32 StartCycles = FPlatformTime::Cycles();
+			LocalBody(ContextIndex, MyIndex * LocalBlockSize, MyEnd * LocalBlockSize + (MyEnd == LocalNum ? LocalLastBlockExtraNum : 0));
+			const uint32 ClaimCycles = FPlatformTime::Cycles() - StartCycles;
+			if (ClaimCycles < LocalTargetClaimCycles / 2 && BlocksToClaim < LocalNum)
 			{
-				ThisBlockSize += LastBlockExtraNum;
+				BlocksToClaim *= 2;
 			}
-			for (int32 LocalIndex = 0; LocalIndex < ThisBlockSize; LocalIndex++)
+			else if (ClaimCycles > LocalTargetClaimCycles * 2 && BlocksToClaim > 1)
 			{
-				LocalBody(MyIndex * LocalBlockSize + LocalIndex);
+				BlocksToClaim /= 2;
 			}
 			checkSlow(!bExited);
-			int32 LocalNumCompleted = NumCompleted.Increment();
+			const int32 NumClaimed = MyEnd - MyIndex;
+			int32 LocalNumCompleted = NumCompleted.Add(NumClaimed) + NumClaimed;
 			if (LocalNumCompleted == LocalNum)
 			{
 				return true;
 			}
 			checkSlow(LocalNumCompleted < LocalNum);
 		}
-		if (MyIndex >= LocalNum - 1)
+		if (bLastClaim)
 		{
 			break;
 		}
@@ -145,28 +180,37 @@ inline bool FParallelForData::Process(int32 TasksToSpawn, TSharedRef<FParallelFo
 }
 
 /** 
-	*	General purpose parallel for that uses the taskgraph
-	*	@param Num; number of calls of Body; Body(0), Body(1)....Body(Num - 1)
-	*	@param Body; Function to call from multiple threads
-	*	@param bForceSingleThread; Mostly used for testing, if true, run single threaded instead.
-	*	Notes: Please add stats around to calls to parallel for and within your lambda as appropriate. Do not clog the task graph with long running tasks or tasks that block.
+	*	Returns the number of task graph tasks a ParallelFor over Num items will use; the calling thread works too, so there are at most this plus one concurrent calls of the body.
+	*	@param Num; number of items
+	*	@param bForceSingleThread; if true, the result is 0
 **/
-inline void ParallelFor(int32 Num, TFunctionRef<void(int32)> Body, bool bForceSingleThread = false)
+inline int32 ParallelForNumTasks(int32 Num, bool bForceSingleThread = false)
 {
-	SCOPE_CYCLE_COUNTER(STAT_ParallelFor);
-	check(Num >= 0);
-
 	int32 AnyThreadTasks = 0;
 	if (Num > 1 && !bForceSingleThread && FApp::ShouldUseThreadingForPerformance())
 	{
 		AnyThreadTasks = FMath::Min<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads(), Num - 1);
 	}
+	return AnyThreadTasks;
+}
+
+/** 
+	*	Implementation of the ParallelFor variants; use ParallelFor, ParallelForRange, ParallelForWithTaskContext or ParallelForReduce instead.
+	*	@param Num; number of items
+	*	@param AnyThreadTasks; number of tasks to use, from ParallelForNumTasks
+	*	@param Body; Body(ContextIndex, Begin, End) processes items [Begin, End); ContextIndex is less than AnyThreadTasks + 1 and is never used by two threads at once
+**/
+inline void ParallelForInternal(int32 Num, int32 AnyThreadTasks, TFunctionRef<void(int32, int32, int32)> Body)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ParallelFor);
+	check(Num >= 0);
+
 	if (!AnyThreadTasks)
 	{
 		// no threads, just do it and return
-		for (int32 Index = 0; Index < Num; Index++)
+		if (Num)
 		{
-			Body(Index);
+			Body(0, 0, Num);
 		}
 		return;
 	}
@@ -189,6 +233,97 @@ inline void ParallelFor(int32 Num, TFunctionRef<void(int32)> Body, bool bForceSi
 	// Data must live on until all of the tasks are cleared which might be long after this function exits
 }
 
+/** 
+	*	General purpose parallel for that uses the taskgraph
+	*	@param Num; number of calls of Body; Body(0), Body(1)....Body(Num - 1)
+	*	@param Body; Function to call from multiple threads
+	*	@param bForceSingleThread; Mostly used for testing, if true, run single threaded instead.
+	*	Notes: Please add stats around to calls to parallel for and within your lambda as appropriate. Do not clog the task graph with long running tasks or tasks that block.
+**/
+inline void ParallelFor(int32 Num, TFunctionRef<void(int32)> Body, bool bForceSingleThread = false)
+{
+	ParallelForInternal(Num, ParallelForNumTasks(Num, bForceSingleThread),
+		[&Body](int32 ContextIndex, int32 Begin, int32 End)
+		{
+			for (int32 Index = Begin; Index < End; Index++)
+			{
+				Body(Index);
+			}
+		}
+	);
+}
+
+/** 
+	*	Parallel for that hands out contiguous ranges instead of single items, so fine grained loops pay one call per range rather than one per item.
+	*	The size of the ranges adapts to the measured cost of the body.
+	*	@param Num; total number of items; Body is called with ranges that cover [0, Num) exactly once
+	*	@param Body; Body(Begin, End) processes items Begin to End - 1, called from multiple threads
+	*	@param bForceSingleThread; Mostly used for testing, if true, run single threaded instead.
+	*	Notes: Please add stats around to calls to parallel for and within your lambda as appropriate. Do not clog the task graph with long running tasks or tasks that block.
+**/
+inline void ParallelForRange(int32 Num, TFunctionRef<void(int32, int32)> Body, bool bForceSingleThread = false)
+{
+	ParallelForInternal(Num, ParallelForNumTasks(Num, bForceSingleThread),
+		[&Body](int32 ContextIndex, int32 Begin, int32 End)
+		{
+			Body(Begin, End);
+		}
+	);
+}
+
+/** 
+	*	Range parallel for that gives each participating thread its own context object, for scratch buffers or partial results that should not be shared.
+	*	@param OutContexts; reset to ParallelForNumTasks(Num) + 1 default constructed contexts; contexts that were not used by any thread are left as constructed
+	*	@param Num; total number of items
+	*	@param Body; Body(ContextType& Context, int32 Begin, int32 End), called from multiple threads; a context is never used by two threads at once
+	*	@param bForceSingleThread; Mostly used for testing, if true, run single threaded instead.
+**/
+template<typename ContextType, typename BodyType>
+inline void ParallelForWithTaskContext(TArray<ContextType>& OutContexts, int32 Num, const BodyType& Body, bool bForceSingleThread = false)
+{
+	const int32 AnyThreadTasks = ParallelForNumTasks(Num, bForceSingleThread);
+	OutContexts.Reset(AnyThreadTasks + 1);
+	OutContexts.AddDefaulted(AnyThreadTasks + 1);
+	ContextType* Contexts = OutContexts.GetData();
+	ParallelForInternal(Num, AnyThreadTasks,
+		[Contexts, &Body](int32 ContextIndex, int32 Begin, int32 End)
+		{
+			Body(Contexts[ContextIndex], Begin, End);
+		}
+	);
+}
+
+/** 
+	*	Range parallel for that accumulates a result per thread and combines the partial results on the calling thread.
+	*	The order in which partial results are combined is not deterministic, so Combine should be associative and commutative.
+	*	@param Num; total number of items
+	*	@param Identity; initial value of every partial result and of the final result
+	*	@param Body; Body(ResultType& Accumulator, int32 Begin, int32 End) adds items Begin to End - 1 to Accumulator, called from multiple threads
+	*	@param Combine; ResultType Combine(const ResultType& A, const ResultType& B), only called from the calling thread
+	*	@param bForceSingleThread; Mostly used for testing, if true, run single threaded instead.
+	*	@return The combined result
+**/
+template<typename ResultType, typename BodyType, typename CombineType>
+inline ResultType ParallelForReduce(int32 Num, const ResultType& Identity, const BodyType& Body, const CombineType& Combine, bool bForceSingleThread = false)
+{
+	const int32 AnyThreadTasks = ParallelForNumTasks(Num, bForceSingleThread);
+	TArray<ResultType> Partials;
+	Partials.Init(Identity, AnyThreadTasks + 1);
+	ResultType* PartialData = Partials.GetData();
+	ParallelForInternal(Num, AnyThreadTasks,
+		[PartialData, &Body](int32 ContextIndex, int32 Begin, int32 End)
+		{
+			Body(PartialData[ContextIndex], Begin, End);
+		}
+	);
+	ResultType Result = Identity;
+	for (const ResultType& Partial : Partials)
+	{
+		Result = Combine(Result, Partial);
+	}
+	return Result;
+}
+
 /** 
 	*	General purpose parallel for that uses the taskgraph
 	*	@param Num; number of calls of Body; Body(0), Body(1)....Body(Num - 1)
@@ -218,7 +353,14 @@ inline void ParallelForWithPreWork(int32 Num, TFunctionRef<void(int32)> Body, TF
 		return;
 	}
 	check(Num);
-	FParallelForData* DataPtr = new FParallelForData(Num, AnyThreadTasks, false, Body);
+	auto RangeBody = [&Body](int32 ContextIndex, int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; Index++)
+		{
+			Body(Index);
+		}
+	};
+	FParallelForData* DataPtr = new FParallelForData(Num, AnyThreadTasks, false, RangeBody);
 	TSharedRef<FParallelForData, ESPMode::ThreadSafe> Data = MakeShareable(DataPtr);
 	TGraphTask<FParallelForTask>::CreateTask().ConstructAndDispatchWhenReady(Data, AnyThreadTasks - 1);		
 	// do the prework
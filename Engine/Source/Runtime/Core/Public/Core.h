@@ -75,6 +75,7 @@
 #include "ScriptDelegates.h"
 #include "Delegate.h"					// C++ delegate system
 #include "ThreadingBase.h"				// Non-platform specific multi-threaded support.
+#include "HAL/LockContentionProfiler.h"	// Lock contention profiling.
 #include "Internationalization/Internationalization.h"
 #include "Internationalization/Culture.h"
 #include "Guid.h"						// FGuid class
@@ -88,6 +89,7 @@
 #include "AsyncWork.h"					// Async threaded work
 #include "Archive.h"					// Utility archive classes
 #include "IOBase.h"						// base IO declarations, FIOManager, FIOSystem
+#include "AsyncFileHandle.h"				// Async file read requests
 #include "Variant.h"
 #include "WildcardString.h"
 #include "CircularBuffer.h"
@@ -11,6 +11,7 @@
 class FArchive;
 class FString;
 struct FDateTime;
+class IAsyncReadFileHandle;
 
 /** 
  * File handle interface. 
@@ -63,6 +64,82 @@ public:
 };
 
 
+/**
+ * A read-only region of a file mapped into memory. Deleting the region unmaps it.
+**/
+class CORE_API IMappedFileRegion
+{
+public:
+	IMappedFileRegion(const uint8* InMappedPtr, int64 InMappedSize)
+		: MappedPtr(InMappedPtr)
+		, MappedSize(InMappedSize)
+	{
+	}
+
+	/** Destructor, also the only way to unmap the region **/
+	virtual ~IMappedFileRegion()
+	{
+	}
+
+	/** Return the start of the mapped bytes. Writing to them is not allowed. **/
+	FORCEINLINE const uint8* GetMappedPtr() const
+	{
+		return MappedPtr;
+	}
+
+	/** Return the number of mapped bytes. **/
+	FORCEINLINE int64 GetMappedSize() const
+	{
+		return MappedSize;
+	}
+
+private:
+	const uint8* MappedPtr;
+	int64 MappedSize;
+};
+
+
+/**
+ * Handle to a file opened for memory mapping. All regions mapped from a handle have to be deleted before the handle.
+**/
+class CORE_API IMappedFileHandle
+{
+public:
+	IMappedFileHandle(int64 InFileSize)
+		: FileSize(InFileSize)
+	{
+	}
+
+	/** Destructor, also the only way to close the handle **/
+	virtual ~IMappedFileHandle()
+	{
+	}
+
+	/** Return the size of the file. **/
+	FORCEINLINE int64 GetFileSize() const
+	{
+		return FileSize;
+	}
+
+	/** Return true if regions are views of the file, false if they are copies read into memory by the generic fallback. **/
+	virtual bool IsMemoryMapped() const
+	{
+		return true;
+	}
+
+	/**
+	 * Map a region of the file into memory.
+	 * @param Offset		Offset of the first byte to map, does not need to be aligned to a page.
+	 * @param BytesToMap	Number of bytes to map, clamped to the end of the file.
+	 * @return				The mapped region, or nullptr if it can't be mapped. Delete it to unmap.
+	**/
+	virtual IMappedFileRegion* MapRegion(int64 Offset, int64 BytesToMap) = 0;
+
+private:
+	int64 FileSize;
+};
+
+
 /**
  * Contains the information that's returned from stat'ing a file or directory 
  */
@@ -214,6 +291,22 @@ public:
 	/** Attempt to open a file for writing. If successful will return a non-nullptr pointer. Close the file by delete'ing the handle. **/
 	virtual IFileHandle*	OpenWrite(const TCHAR* Filename, bool bAppend = false, bool bAllowRead = false) = 0;
 
+	/**
+	 * Open a file for read-only memory mapping. The default implementation reads mapped regions into memory through OpenRead,
+	 * see IMappedFileHandle::IsMemoryMapped.
+	 * @param Filename	File to map.
+	 * @return			The handle, or nullptr if the file can't be opened. Close the file by delete'ing the handle.
+	**/
+	virtual IMappedFileHandle*	OpenMapped(const TCHAR* Filename);
+
+	/**
+	 * Open a file for async reads, see IAsyncReadFileHandle. The default implementation services the requests on a pool of IO threads with
+	 * synchronous handles from OpenRead.
+	 * @param Filename	File to read.
+	 * @return			The handle, or nullptr if the file doesn't exist. Close the file by delete'ing the handle.
+	**/
+	virtual IAsyncReadFileHandle*	OpenAsyncRead(const TCHAR* Filename);
+
 	/** Return true if the directory exists. **/
 	virtual bool		DirectoryExists(const TCHAR* Directory) = 0;
 	/** Create a directory and return true if the directory was created or already existed. **/
@@ -28,6 +28,16 @@ public:
 
 			delete Var;
 		}
+
+		for(TMap<IConsoleVariable*, FConsoleVariableSnapshotBuffer*>::TConstIterator PairIt(VariableSnapshots); PairIt; ++PairIt)
+		{
+			delete PairIt.Value();
+		}
+
+		for(FConsoleVariableSnapshotBuffer* Buffer : RetiredVariableSnapshots)
+		{
+			delete Buffer;
+		}
 	}
 	
 	// internally needed or ECVF_RenderThreadSafe
@@ -43,6 +53,9 @@ public:
 
 	void OnCVarChanged();
 
+	/** Remembers the variable for the batch sinks and the handles, called for each Set(), takes at most one lock */
+	void OnCVarValueChanged(FConsoleVariableBase* Var);
+
 	// interface IConsoleManager -----------------------------------
 
 	virtual IConsoleVariable* RegisterConsoleVariable(const TCHAR* Name, int32 DefaultValue, const TCHAR* Help, uint32 Flags) override;
@@ -56,6 +69,8 @@ public:
 
 	virtual FConsoleVariableSinkHandle RegisterConsoleVariableSink_Handle(const FConsoleCommandDelegate& Command) override;
 	virtual void UnregisterConsoleVariableSink_Handle(FConsoleVariableSinkHandle Handle) override;
+	virtual FConsoleVariableSinkHandle RegisterConsoleVariableBatchSink_Handle(const FConsoleVariableBatchDelegate& Command) override;
+	virtual void UnregisterConsoleVariableBatchSink_Handle(FConsoleVariableSinkHandle Handle) override;
 
 	virtual IConsoleCommand* RegisterConsoleCommand(const TCHAR* Name, const TCHAR* Help, const FConsoleCommandDelegate& Command, uint32 Flags) override;
 	virtual IConsoleCommand* RegisterConsoleCommand(const TCHAR* Name, const TCHAR* Help, const FConsoleCommandWithArgsDelegate& Command, uint32 Flags) override;
@@ -65,6 +80,7 @@ public:
 	virtual IConsoleCommand* RegisterConsoleCommand(const TCHAR* Name, const TCHAR* Help, uint32 Flags) override;
 	virtual IConsoleObject* FindConsoleObject(const TCHAR* Name) const override;
 	virtual IConsoleVariable* FindConsoleVariable(const TCHAR* Name) const override;
+	virtual FConsoleVariableHandle FindConsoleVariableHandle(const TCHAR* Name) override;
 	virtual void ForEachConsoleObject(const FConsoleObjectVisitor& Visitor, const TCHAR* ThatStartsWith) const override;
 	virtual bool ProcessUserConsoleInput(const TCHAR* InInput, FOutputDevice& Ar, UWorld* InWorld) override;
 	virtual void AddConsoleHistoryEntry(const TCHAR* Input) override;
@@ -82,6 +98,21 @@ private: // ----------------------------------------------------
 	TArray<FString>	HistoryEntries;
 	bool bHistoryWasLoaded;
 	TArray<FConsoleCommandDelegate>	ConsoleVariableChangeSinks;
+	TArray<FConsoleVariableBatchDelegate> ConsoleVariableBatchSinks;
+
+	/** Variables with a handle or watched by a batch sink that were set since the last CallAllConsoleVariableSinks(), each one only once, guarded by ChangedVariablesSynchronizationObject */
+	TArray<IConsoleVariable*> ChangedVariables;
+
+	/** Guards ChangedVariables and ConsoleVariableBatchSinks, variables can be set from any thread */
+	FCriticalSection ChangedVariablesSynchronizationObject;
+
+	/** Number of batch sinks, so Set() can skip the lock while there are none */
+	FThreadSafeCounter NumConsoleVariableBatchSinks;
+
+	/** Value snapshots of the variables a handle was requested for, guarded by ConsoleObjectsSynchronizationObject */
+	TMap<IConsoleVariable*, FConsoleVariableSnapshotBuffer*> VariableSnapshots;
+	/** Snapshots of released variables, kept alive as handles might still point to them */
+	TArray<FConsoleVariableSnapshotBuffer*> RetiredVariableSnapshots;
 
 	IConsoleThreadPropagation* ThreadPropagationCallback;
 	uint32 ThreadPropagationThreadId;
@@ -96,6 +127,9 @@ private: // ----------------------------------------------------
 	**/
 	mutable FCriticalSection ConsoleObjectsSynchronizationObject;
 
+	/** Writes the current value of the variable into the unpublished half of the buffer and publishes it */
+	static void PublishVariableSnapshot(FConsoleVariableSnapshotBuffer& Buffer, IConsoleVariable* Var);
+
 	/** 
 	 * @param Name must not be 0, must not be empty
 	 * @param Obj must not be 0
@@ -104,6 +104,9 @@ class IConsoleVariable;
 /** Console variable delegate type  This is a void callback function. */
 DECLARE_DELEGATE_OneParam( FConsoleVariableDelegate, IConsoleVariable* );
 
+/** Console variable batch delegate type, called once with all the console variables that changed since the last call.  This is a void callback function. */
+DECLARE_DELEGATE_OneParam( FConsoleVariableBatchDelegate, const TArray< IConsoleVariable* >& );
+
 /** Console command delegate type (takes no arguments.)  This is a void callback function. */
 DECLARE_DELEGATE( FConsoleCommandDelegate );
 
@@ -327,6 +330,84 @@ private:
 };
 
 
+/**
+ * Value of a console variable as seen through a FConsoleVariableHandle.
+ */
+struct FConsoleVariableSnapshot
+{
+	int32 IntValue;
+	float FloatValue;
+	/** Incremented every time a new value is published, to cheaply detect a change */
+	uint32 Serial;
+};
+
+/**
+ * Double buffered storage behind a FConsoleVariableHandle, owned by the console manager.
+ * The game thread fills in the value that is not published and then swaps the Published pointer (see CallAllConsoleVariableSinks),
+ * so the readers never take a lock. Readers should not keep the snapshot reference beyond the current frame as the buffer is reused.
+ */
+struct FConsoleVariableSnapshotBuffer
+{
+	FConsoleVariableSnapshot Values[2];
+	FConsoleVariableSnapshot* volatile Published;
+};
+
+/**
+ * Resolved console variable, cheap to read from any thread.
+ * The value is only updated when the console variable sinks are called, so all threads see the same value for the whole frame.
+ * String console variables are exposed with their int and float conversion.
+ */
+class FConsoleVariableHandle
+{
+public:
+	FConsoleVariableHandle()
+		: Buffer(nullptr)
+	{
+	}
+
+	explicit FConsoleVariableHandle(const FConsoleVariableSnapshotBuffer* InBuffer)
+		: Buffer(InBuffer)
+	{
+	}
+
+	/** @return false if the console variable was not found */
+	bool IsValid() const
+	{
+		return Buffer != nullptr;
+	}
+
+	const FConsoleVariableSnapshot& GetSnapshot() const
+	{
+		checkSlow(Buffer);
+		return *Buffer->Published;
+	}
+
+	int32 GetInt() const
+	{
+		return GetSnapshot().IntValue;
+	}
+
+	float GetFloat() const
+	{
+		return GetSnapshot().FloatValue;
+	}
+
+	bool GetBool() const
+	{
+		return GetSnapshot().IntValue != 0;
+	}
+
+	/** @return value that changes every time a new value is published */
+	uint32 GetSerial() const
+	{
+		return GetSnapshot().Serial;
+	}
+
+private:
+	const FConsoleVariableSnapshotBuffer* Buffer;
+};
+
+
 /**
  * handles console commands and variables, registered console variables are released on destruction
  */
@@ -403,6 +484,18 @@ struct CORE_API IConsoleManager
 	 */
 	virtual void UnregisterConsoleVariableSink_Handle(FConsoleVariableSinkHandle Handle) = 0;
 
+	/**
+	 * The registered command is executed at the same points as the sinks (see CallAllConsoleVariableSinks), once with all the
+	 * console variables that changed since the last call, no matter how often each of them was set
+	 * @param Command
+	 */
+	virtual FConsoleVariableSinkHandle RegisterConsoleVariableBatchSink_Handle(const FConsoleVariableBatchDelegate& Command) = 0;
+
+	/**
+	 * @param Handle returned by RegisterConsoleVariableBatchSink_Handle
+	 */
+	virtual void UnregisterConsoleVariableBatchSink_Handle(FConsoleVariableSinkHandle Handle) = 0;
+
 	// ----------
 
 	/**
@@ -479,6 +572,13 @@ struct CORE_API IConsoleManager
 	 */
 	virtual IConsoleVariable* FindConsoleVariable(const TCHAR* Name) const = 0;
 
+	/**
+	 * Find a console variable and return a handle that can be read without a lookup or lock, meant to be done once and kept
+	 * @param Name must not be 0
+	 * @return invalid handle if the variable wasn't found
+	 */
+	virtual FConsoleVariableHandle FindConsoleVariableHandle(const TCHAR* Name) = 0;
+
 	/**
 	* Find a console variable or command
 	* @param Name must not be 0
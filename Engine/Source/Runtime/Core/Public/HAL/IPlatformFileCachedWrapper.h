@@ -317,6 +317,14 @@ public:
 		}
 		return new FCachedFileHandle(InnerHandle, bAllowRead, true);
 	}
+	virtual IAsyncReadFileHandle*	OpenAsyncRead(const TCHAR* Filename) override
+	{
+		return LowerLevel->OpenAsyncRead(Filename);
+	}
+	virtual IMappedFileHandle*	OpenMapped(const TCHAR* Filename) override
+	{
+		return LowerLevel->OpenMapped(Filename);
+	}
 	virtual bool		DirectoryExists(const TCHAR* Directory) override
 	{
 		return LowerLevel->DirectoryExists(Directory);
@@ -229,6 +229,24 @@ public:
 		FILE_LOG(LogPlatformFile, Log, TEXT("OpenWrite return %llx [%fms]"), uint64(Result), ThisTime);
 		return Result ? (new FLoggedFileHandle(Result, Filename, *this)) : Result;
 	}
+	virtual IAsyncReadFileHandle*	OpenAsyncRead(const TCHAR* Filename) override
+	{
+		FILE_LOG(LogPlatformFile, Log, TEXT("OpenAsyncRead %s"), Filename);
+		double StartTime = FPlatformTime::Seconds();
+		IAsyncReadFileHandle* Result = LowerLevel->OpenAsyncRead(Filename);
+		float ThisTime = 1000.0f * float(FPlatformTime::Seconds() - StartTime);
+		FILE_LOG(LogPlatformFile, Log, TEXT("OpenAsyncRead return %llx [%fms]"), uint64(Result), ThisTime);
+		return Result;
+	}
+	virtual IMappedFileHandle*	OpenMapped(const TCHAR* Filename) override
+	{
+		FILE_LOG(LogPlatformFile, Log, TEXT("OpenMapped %s"), Filename);
+		double StartTime = FPlatformTime::Seconds();
+		IMappedFileHandle* Result = LowerLevel->OpenMapped(Filename);
+		float ThisTime = 1000.0f * float(FPlatformTime::Seconds() - StartTime);
+		FILE_LOG(LogPlatformFile, Log, TEXT("OpenMapped return %llx [%fms]"), uint64(Result), ThisTime);
+		return Result;
+	}
 
 	virtual bool		DirectoryExists(const TCHAR* Directory) override
 	{
@@ -15,6 +15,22 @@ protected:
 	TMap<FString, int64>	FilenameAccessMap;
 	TArray<IFileHandle*>	LogOutput;
 
+	/** Writes Filename to the open order logs the first time it is opened. */
+	void AddToOpenLog(const TCHAR* Filename)
+	{
+		CriticalSection.Lock();
+		if (FilenameAccessMap.Find(Filename) == nullptr)
+		{
+			FilenameAccessMap.Emplace(Filename, ++OpenOrder);
+			FString Text = FString::Printf(TEXT("\"%s\" %llu\n"), Filename, OpenOrder);
+			for (auto File = LogOutput.CreateIterator(); File; ++File)
+			{
+				(*File)->Write((uint8*)StringCast<ANSICHAR>(*Text).Get(), Text.Len());
+			}
+		}
+		CriticalSection.Unlock();
+	}
+
 public:
 
 	FPlatformFileOpenLog()
@@ -138,17 +154,7 @@ public:
 		IFileHandle* Result = LowerLevel->OpenRead(Filename, bAllowWrite);
 		if (Result)
 		{
-			CriticalSection.Lock();
-			if (FilenameAccessMap.Find(Filename) == nullptr)
-			{
-				FilenameAccessMap.Emplace(Filename, ++OpenOrder);
-				FString Text = FString::Printf(TEXT("\"%s\" %llu\n"), Filename, OpenOrder);
-				for (auto File = LogOutput.CreateIterator(); File; ++File)
-				{
-					(*File)->Write((uint8*)StringCast<ANSICHAR>(*Text).Get(), Text.Len());
-				}
-			}
-			CriticalSection.Unlock();
+			AddToOpenLog(Filename);
 		}
 		return Result;
 	}
@@ -156,6 +162,24 @@ public:
 	{
 		return LowerLevel->OpenWrite(Filename, bAppend, bAllowRead);
 	}
+	virtual IAsyncReadFileHandle*	OpenAsyncRead(const TCHAR* Filename) override
+	{
+		IAsyncReadFileHandle* Result = LowerLevel->OpenAsyncRead(Filename);
+		if (Result)
+		{
+			AddToOpenLog(Filename);
+		}
+		return Result;
+	}
+	virtual IMappedFileHandle*	OpenMapped(const TCHAR* Filename) override
+	{
+		IMappedFileHandle* Result = LowerLevel->OpenMapped(Filename);
+		if (Result)
+		{
+			AddToOpenLog(Filename);
+		}
+		return Result;
+	}
 	virtual bool		DirectoryExists(const TCHAR* Directory) override
 	{
 		return LowerLevel->DirectoryExists(Directory);
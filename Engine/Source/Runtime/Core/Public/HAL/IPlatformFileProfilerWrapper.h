@@ -382,6 +382,22 @@ public:
 		OpStat->Duration += FPlatformTime::Seconds() * 1000.0 - OpStat->LastOpTime;
 		return Result ? (new TProfiledFileHandle< StatsType >( Result, Filename, FileStat )) : Result;
 	}
+	virtual IAsyncReadFileHandle*	OpenAsyncRead(const TCHAR* Filename) override
+	{
+		StatsType* FileStat = CreateStat( Filename );
+		FProfiledFileStatsOp* OpStat = FileStat->CreateOpStat( FProfiledFileStatsOp::EOpType::OpenRead );
+		IAsyncReadFileHandle* Result = LowerLevel->OpenAsyncRead(Filename);
+		OpStat->Duration += FPlatformTime::Seconds() * 1000.0 - OpStat->LastOpTime;
+		return Result;
+	}
+	virtual IMappedFileHandle*	OpenMapped(const TCHAR* Filename) override
+	{
+		StatsType* FileStat = CreateStat( Filename );
+		FProfiledFileStatsOp* OpStat = FileStat->CreateOpStat( FProfiledFileStatsOp::EOpType::OpenRead );
+		IMappedFileHandle* Result = LowerLevel->OpenMapped(Filename);
+		OpStat->Duration += FPlatformTime::Seconds() * 1000.0 - OpStat->LastOpTime;
+		return Result;
+	}
 
 	virtual bool		DirectoryExists(const TCHAR* Directory) override
 	{
@@ -624,6 +640,14 @@ public:
 		IFileHandle* Result = LowerLevel->OpenWrite(Filename, bAppend, bAllowRead);
 		return Result ? (new FPlatformFileReadStatsHandle(Result, Filename, &BytePerSecThisTick, &BytesReadThisTick, &ReadsThisTick)) : Result;
 	}
+	virtual IAsyncReadFileHandle*	OpenAsyncRead(const TCHAR* Filename) override
+	{
+		return LowerLevel->OpenAsyncRead(Filename);
+	}
+	virtual IMappedFileHandle*	OpenMapped(const TCHAR* Filename) override
+	{
+		return LowerLevel->OpenMapped(Filename);
+	}
 
 	virtual bool		DirectoryExists(const TCHAR* Directory) override
 	{
@@ -0,0 +1,185 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+class FOutputDevice;
+
+/**
+ * Kinds of synchronization objects tracked by the lock contention profiler.
+ */
+enum class ELockContentionType : uint8
+{
+	/** FCriticalSection, including locks taken through FScopeLock. For these a contended acquire is one that had to wait. */
+	CriticalSection,
+
+	/** Pooled FEvent. For these every wait is recorded and a contended acquire is a wait that timed out. */
+	Event,
+};
+
+
+/**
+ * Aggregated data of one lock, as reported by FLockContentionProfiler::GetRecords.
+ */
+struct FLockContentionRecord
+{
+	enum { MaxCallstackDepth = 8 };
+
+	/** Address of the critical section or event */
+	const void* Lock;
+	/** What kind of object Lock is */
+	ELockContentionType Type;
+	/** Number of sampled acquires (or waits) */
+	uint32 NumAcquires;
+	/** Number of sampled acquires that had to wait */
+	uint32 NumContended;
+	/** Total time spent waiting, in cycles */
+	uint64 WaitCycles;
+	/** Longest wait, in cycles */
+	uint32 MaxWaitCycles;
+	/** Thread that held the lock before the longest wait, 0 for events */
+	uint32 MaxWaitOwnerThreadId;
+	/**
+	 * Callstack of the thread that waited longest (not of the holder), zero terminated if shorter than MaxCallstackDepth.
+	 * For critical sections it is captured when the waiter released the lock again, so it starts at the Unlock inside the profiler.
+	 */
+	uint64 MaxWaitCallstack[MaxCallstackDepth];
+};
+
+
+/**
+ * Sampled acquire of a critical section, kept in the lock until it is released so it can be recorded outside of it.
+ */
+struct FLockContentionSample
+{
+	/** Thread that held the lock before this acquire */
+	uint32 OwnerThreadId;
+	/** How long the acquire waited */
+	uint32 WaitCycles;
+	/** Whether the acquire had to wait */
+	bool bContended;
+};
+
+
+/**
+ * Profiler state embedded in each instrumented critical section. It is only accessed by the thread that holds the lock.
+ */
+struct FLockContentionState
+{
+	/** Thread that acquired the lock last while the profiler was running, updated on every acquire, sampled or not */
+	uint32 LastOwnerThreadId;
+	/** Whether PendingSample has to be recorded when the lock is released */
+	bool bHasPendingSample;
+	/** The sampled acquire of the current holder */
+	FLockContentionSample PendingSample;
+
+	FLockContentionState()
+		: LastOwnerThreadId(0)
+		, bHasPendingSample(false)
+	{
+	}
+
+	/**
+	 * Called with the lock held after every acquire while the profiler is running.
+	 * Recursive acquires of a sampled lock are not sampled again, the outer acquire is recorded when it is released.
+	 */
+	FORCEINLINE void OnAcquired(uint32 ThreadId, bool bSampled, bool bContended, uint32 WaitCycles)
+	{
+		if (bSampled && !bHasPendingSample)
+		{
+			bHasPendingSample = true;
+			PendingSample.OwnerThreadId = LastOwnerThreadId;
+			PendingSample.WaitCycles = WaitCycles;
+			PendingSample.bContended = bContended;
+		}
+		LastOwnerThreadId = ThreadId;
+	}
+
+	/** Called with the lock held right before it is released, returns the sample to record afterwards. */
+	FORCEINLINE FLockContentionSample TakePendingSample()
+	{
+		bHasPendingSample = false;
+		return PendingSample;
+	}
+};
+
+
+/**
+ * Opt-in profiler for FCriticalSection and pooled FEvent contention.
+ *
+ * When compiled in (LOCK_CONTENTION_PROFILER=1, off by default) every critical section checks IsEnabled on Lock, which is the only
+ * cost while the profiler is stopped. Once started, every Nth acquire of each thread is recorded: whether it had
+ * to wait, how long it waited and, for the longest wait of each lock, the waiter's callstack and the thread that held it.
+ * Critical section samples are recorded once the lock is released.
+ * A sample interval of 1 records everything, larger intervals keep the overhead low enough for production.
+ *
+ * Records are kept per lock address in a fixed size table that is updated without taking any lock, so
+ * destroyed locks whose memory is reused share their record with the new lock until Reset is called.
+ * Use the "LockContention" console command to control it and dump the report, the per frame totals go
+ * to STATGROUP_LockContention so "stat LockContention" and stat files pick them up.
+ */
+class CORE_API FLockContentionProfiler
+{
+public:
+
+	/** @return true if the profiler is recording */
+	static FORCEINLINE bool IsEnabled()
+	{
+		return SampleInterval != 0;
+	}
+
+	/**
+	 * Starts recording.
+	 *
+	 * @param InSampleInterval Record every Nth acquire of each thread, 1 records all of them
+	 */
+	static void Start(int32 InSampleInterval = 1);
+
+	/** Stops recording, the records are kept until Reset. */
+	static void Stop();
+
+	/** Clears all records. Records updated by other threads meanwhile may keep part of their old values. */
+	static void Reset();
+
+	/** @return whether the next acquire of the calling thread should be recorded, advances its sampling counter */
+	static bool ShouldSample();
+
+	/** @return the current time in cycles, used by the instrumented locks to time waits */
+	static uint32 GetCycles();
+
+	/** @return the id of the calling thread, used by the instrumented locks to track their holder */
+	static uint32 GetCurrentThreadId();
+
+	/**
+	 * Records an acquire. Critical sections call this after they were released again, so recording doesn't add to the contention.
+	 *
+	 * @param Lock The critical section or event
+	 * @param Type What Lock is
+	 * @param bContended Whether the acquire had to wait (critical sections) or timed out (events)
+	 * @param WaitCycles How long the acquire waited
+	 * @param OwnerThreadId Thread that held the critical section before the acquire, 0 for events
+	 */
+	static void RecordAcquire(const void* Lock, ELockContentionType Type, bool bContended, uint32 WaitCycles, uint32 OwnerThreadId = 0);
+
+	/**
+	 * Gets all records, sorted by total wait time, longest first.
+	 *
+	 * @param OutRecords Receives the records
+	 */
+	static void GetRecords(TArray<FLockContentionRecord>& OutRecords);
+
+	/**
+	 * Writes a report of the locks with the longest total wait time.
+	 *
+	 * @param Ar Where to write the report
+	 * @param MaxLocks How many locks to report
+	 */
+	static void Dump(FOutputDevice& Ar, int32 MaxLocks = 20);
+
+	/** Sets the per frame stats, called from FStats::AdvanceFrame. */
+	static void UpdateStats();
+
+private:
+
+	/** Every Nth acquire is recorded, 0 when stopped */
+	static volatile int32 SampleInterval;
+};
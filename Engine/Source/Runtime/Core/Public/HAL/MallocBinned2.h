@@ -11,6 +11,16 @@
 	#define BINNED2_MAX_CACHED_OS_FREES_BYTE_LIMIT (16*1024*1024)
 #endif
 
+// Threads that opt in through FMemory::SetupTLSCachesOnCurrentThread() keep a bounded free list per small bin
+// and only take the allocator lock to refill or flush it in batches.
+#ifndef BINNED2_ALLOW_RUNTIME_TLS_CACHES
+	#define BINNED2_ALLOW_RUNTIME_TLS_CACHES (!PLATFORM_HTML5)
+#endif
+
+/** Maximum number of blocks a thread may cache per bin; bins with large blocks are further limited by BINNED2_MAX_TLS_CACHED_BYTES_PER_BIN. */
+#define BINNED2_MAX_TLS_CACHED_BLOCKS_PER_BIN (64)
+#define BINNED2_MAX_TLS_CACHED_BYTES_PER_BIN (64*1024)
+
 #if STATS
 #	if PLATFORM_64BITS
 #		define BINNED2_STAT volatile int64
@@ -40,6 +50,7 @@ private:
 	struct FPoolTable;
 	struct FPoolInfo;
 	struct PoolHashBucket;
+	struct FPerThreadFreeBlockLists;
 
 	/** Pool table. */
 	struct FPoolTable
@@ -119,6 +130,20 @@ private:
 
 	TCachedOSPageAllocator<BINNED2_MAX_CACHED_OS_FREES, BINNED2_MAX_CACHED_OS_FREES_BYTE_LIMIT> CachedOSPageAllocator;
 
+#if BINNED2_ALLOW_RUNTIME_TLS_CACHES
+	/** Guards the pool tables, the hash buckets and the OS page cache. Per-thread cache hits never take it. */
+	FCriticalSection Mutex;
+
+	/** TLS slot holding the calling thread's FPerThreadFreeBlockLists, or null if the thread has not opted in. */
+	uint32 BinnedTlsSlot;
+
+	/** Max number of blocks each bin of a per-thread cache may hold. */
+	uint32 MaxTlsCachedBlocks[POOL_COUNT];
+
+	/** All live per-thread caches, used for stats gathering. Guarded by Mutex. */
+	FPerThreadFreeBlockLists* RegisteredFreeBlockLists;
+#endif
+
 #if STATS
 	struct FStats
 	{
@@ -132,6 +157,15 @@ private:
 		BINNED2_STAT		TotalAllocs;
 		/** OsCurrent - WasteCurrent - UsedCurrent. */
 		BINNED2_STAT		SlackCurrent;
+		/** Number of per-thread cache allocation hits, misses and frees, including threads that have already exited. */
+		uint64				TlsCacheHits;
+		uint64				TlsCacheMisses;
+		uint64				TlsCacheFrees;
+		/** Number of batch refills and flushes between per-thread caches and the pools. */
+		uint64				TlsCacheRefills;
+		uint64				TlsCacheFlushes;
+		/** Memory currently held in per-thread caches, refreshed by UpdateStats(). */
+		uint64				TlsCachedCurrent;
 		double				MemTime;
 
 		FStats()
@@ -144,6 +178,12 @@ private:
 			, CurrentAllocs(0)
 			, TotalAllocs  (0)
 			, SlackCurrent (0)
+			, TlsCacheHits   (0)
+			, TlsCacheMisses (0)
+			, TlsCacheFrees  (0)
+			, TlsCacheRefills(0)
+			, TlsCacheFlushes(0)
+			, TlsCachedCurrent(0)
 			, MemTime      (0.0)
 		{
 		}
@@ -185,6 +225,10 @@ public:
 	 */
 	virtual void Free( void* Ptr ) override;
 
+	virtual void SetupTLSCachesOnCurrentThread() override;
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override;
+
 	/**
 	 * If possible determine the size of the memory allocated at the given address
 	 *
@@ -63,6 +63,17 @@ public:
 		}
 	}
 
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		UsedMalloc->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		FScopeLock ScopeLock( &SynchronizationObject );
+		UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+
 	/** Writes allocator stats from the last update into the specified destination. */
 	virtual void GetAllocatorStats( FGenericMemoryStats& out_Stats ) override
 	{
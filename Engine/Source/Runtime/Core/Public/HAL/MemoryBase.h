@@ -95,6 +95,21 @@ public:
 	 * Free
 	 */
 	virtual void Free( void* Original ) = 0;
+
+	/**
+	 * Opts the calling thread in to per-thread caching of small blocks, if the allocator supports it.
+	 * A thread that calls this must call ClearAndDisableTLSCachesOnCurrentThread() before it exits.
+	 */
+	virtual void SetupTLSCachesOnCurrentThread()
+	{
+	}
+
+	/**
+	 * Returns all blocks cached by the calling thread to the allocator and disables per-thread caching for it.
+	 */
+	virtual void ClearAndDisableTLSCachesOnCurrentThread()
+	{
+	}
 		
 	/** 
 	 * Handles any commands passed in on the command line
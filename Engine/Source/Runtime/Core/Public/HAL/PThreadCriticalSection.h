@@ -4,6 +4,7 @@
 
 #include <pthread.h>
 #include <errno.h>
+#include "HAL/LockContentionProfiler.h"
 
 
 /**
@@ -17,6 +18,11 @@ class FPThreadsCriticalSection
 	 */
 	pthread_mutex_t Mutex;
 
+#if LOCK_CONTENTION_PROFILER
+	/** Holder tracking and the pending sample for the lock contention profiler */
+	FLockContentionState ContentionState;
+#endif
+
 public:
 
 	/**
@@ -45,6 +51,13 @@ public:
 	 */
 	FORCEINLINE void Lock(void)
 	{
+#if LOCK_CONTENTION_PROFILER
+		if (FLockContentionProfiler::IsEnabled())
+		{
+			LockProfiled();
+			return;
+		}
+#endif
         pthread_mutex_lock(&Mutex);
 	}
 
@@ -53,10 +66,48 @@ public:
 	 */
 	FORCEINLINE void Unlock(void)
 	{
+#if LOCK_CONTENTION_PROFILER
+		if (ContentionState.bHasPendingSample)
+		{
+			UnlockProfiled();
+			return;
+		}
+#endif
 		pthread_mutex_unlock(&Mutex);
 	}
 
 private:
+#if LOCK_CONTENTION_PROFILER
+	/** Lock that reports to the lock contention profiler */
+	FORCENOINLINE void LockProfiled()
+	{
+		const uint32 ThreadId = FLockContentionProfiler::GetCurrentThreadId();
+		if (!FLockContentionProfiler::ShouldSample())
+		{
+			pthread_mutex_lock(&Mutex);
+			ContentionState.OnAcquired(ThreadId, false, false, 0);
+		}
+		else if (pthread_mutex_trylock(&Mutex) == 0)
+		{
+			ContentionState.OnAcquired(ThreadId, true, false, 0);
+		}
+		else
+		{
+			const uint32 StartCycles = FLockContentionProfiler::GetCycles();
+			pthread_mutex_lock(&Mutex);
+			ContentionState.OnAcquired(ThreadId, true, true, FLockContentionProfiler::GetCycles() - StartCycles);
+		}
+	}
+
+	/** Releases the lock, then records the sample taken when it was acquired */
+	FORCENOINLINE void UnlockProfiled()
+	{
+		const FLockContentionSample Sample = ContentionState.TakePendingSample();
+		pthread_mutex_unlock(&Mutex);
+		FLockContentionProfiler::RecordAcquire(this, ELockContentionType::CriticalSection, Sample.bContended, Sample.WaitCycles, Sample.OwnerThreadId);
+	}
+#endif
+
 	FPThreadsCriticalSection(const FPThreadsCriticalSection&);
 	FPThreadsCriticalSection& operator=(const FPThreadsCriticalSection&);
 };
@@ -570,6 +570,85 @@ DEPRECATED(4.8, "FQueuedWork has been renamed to IQueuedWork")
 typedef IQueuedWork FQueuedWork;
 
 
+/**
+ * Priority bands of a queued thread pool. Idle threads always pick the oldest work of the highest band,
+ * so latency sensitive work should not share a band with long running jobs.
+ */
+enum class EQueuedWorkPriority : uint8
+{
+	High,
+	Normal,
+	Low,
+
+	Count
+};
+
+
+/**
+ * Histogram with power of two buckets, used for the queued thread pool metrics.
+ */
+struct CORE_API FQueuedThreadPoolHistogram
+{
+	enum { NumBuckets = 20 };
+
+	/** Bucket 0 counts zeros, bucket N counts values in [2^(N-1), 2^N), the last bucket also counts everything above */
+	uint32 Buckets[NumBuckets];
+
+	FQueuedThreadPoolHistogram()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		FMemory::Memzero(Buckets);
+	}
+
+	void Add(uint64 Value)
+	{
+		// CountLeadingZeros(0) is 32, so zeros land in bucket 0
+		const int32 Bucket = 32 - (int32)FMath::CountLeadingZeros((uint32)FMath::Min<uint64>(Value, MAX_uint32));
+		Buckets[FMath::Min<int32>(Bucket, NumBuckets - 1)]++;
+	}
+
+	/** @return the number of values added */
+	uint32 GetCount() const;
+
+	/** @return approximation of the given percentile (0..1), as the upper bound of the bucket it falls into */
+	uint64 GetPercentile(float Percentile) const;
+};
+
+
+/**
+ * Snapshot of what a queued thread pool has been doing.
+ */
+struct FQueuedThreadPoolMetrics
+{
+	/** Number of threads in the pool */
+	int32 NumThreads;
+	/** Number of threads waiting for work */
+	int32 NumIdleThreads;
+	/** Number of jobs waiting for a thread, per priority band */
+	int32 QueueDepth[(int32)EQueuedWorkPriority::Count];
+	/** Number of jobs that were executed */
+	uint64 NumExecuted;
+	/** Number of jobs waiting for a thread (all bands), sampled every time a job is added */
+	FQueuedThreadPoolHistogram QueueDepthHistogram;
+	/** Time between queuing and starting a job, in microseconds */
+	FQueuedThreadPoolHistogram WaitTimeHistogram;
+	/** Time it took to execute a job, in microseconds */
+	FQueuedThreadPoolHistogram ExecutionTimeHistogram;
+
+	FQueuedThreadPoolMetrics()
+		: NumThreads(0)
+		, NumIdleThreads(0)
+		, NumExecuted(0)
+	{
+		FMemory::Memzero(QueueDepth);
+	}
+};
+
+
 /**
  * Interface for queued thread pools.
  *
@@ -586,9 +665,10 @@ public:
 	 * @param InNumQueuedThreads Specifies the number of threads to use in the pool
 	 * @param StackSize The size of stack the threads in the pool need (32K default)
 	 * @param ThreadPriority priority of new pool thread
+	 * @param Name name of the pool in the metrics
 	 * @return Whether the pool creation was successful or not
 	 */
-	virtual bool Create( uint32 InNumQueuedThreads, uint32 StackSize = (32 * 1024), EThreadPriority ThreadPriority=TPri_Normal ) = 0;
+	virtual bool Create( uint32 InNumQueuedThreads, uint32 StackSize = (32 * 1024), EThreadPriority ThreadPriority=TPri_Normal, const TCHAR* Name = TEXT("UnnamedThreadPool") ) = 0;
 
 	/** Tells the pool to clean up all background threads */
 	virtual void Destroy() = 0;
@@ -598,9 +678,10 @@ public:
 	 * it queues the work for later. Otherwise it is immediately dispatched.
 	 *
 	 * @param InQueuedWork The work that needs to be done asynchronously
+	 * @param InPriority The band the work is queued in if no thread is available
 	 * @see RetractQueuedWork
 	 */
-	virtual void AddQueuedWork( IQueuedWork* InQueuedWork ) = 0;
+	virtual void AddQueuedWork( IQueuedWork* InQueuedWork, EQueuedWorkPriority InPriority = EQueuedWorkPriority::Normal ) = 0;
 
 	/**
 	 * Attempts to retract a previously queued task.
@@ -619,6 +700,33 @@ public:
 	 */
 	virtual IQueuedWork* ReturnToPoolOrGetNextJob( class FQueuedThread* InQueuedThread ) = 0;
 
+	/**
+	 * Changes the number of threads at runtime. New threads start working on queued work right away,
+	 * busy threads that are no longer needed leave the pool after finishing their current job.
+	 *
+	 * @param InNumQueuedThreads The new number of threads, at least 1
+	 */
+	virtual void SetNumThreads( uint32 InNumQueuedThreads ) = 0;
+
+	/** @return the number of threads in the pool */
+	virtual int32 GetNumThreads() const = 0;
+
+	/**
+	 * Sets the CPU affinity masks threads created from now on are spread over, round robin.
+	 * Call before Create to apply them to all threads. An empty array restores the default pool thread mask.
+	 *
+	 * @param InAffinityMasks One mask per affinity group
+	 */
+	virtual void SetAffinityGroups( const TArray<uint64>& InAffinityMasks ) = 0;
+
+	/**
+	 * Gets the queue depth and the histograms of the pool.
+	 *
+	 * @param OutMetrics Receives the metrics
+	 * @param bReset Whether to start new histograms
+	 */
+	virtual void GetMetrics( FQueuedThreadPoolMetrics& OutMetrics, bool bReset = false ) = 0;
+
 public:
 
 	/** Virtual destructor. */
@@ -129,6 +129,11 @@ struct CORE_API FMemory
 	static void* Realloc( void* Original, SIZE_T Count, uint32 Alignment=DEFAULT_ALIGNMENT );
 	static void Free( void* Original );
 
+	/** Opts the calling thread in to the allocator's per-thread block caches, if it has any. */
+	static void SetupTLSCachesOnCurrentThread();
+	/** Flushes the calling thread's allocator caches; must be called before a thread that opted in exits. */
+	static void ClearAndDisableTLSCachesOnCurrentThread();
+
 	//
 	// Malloc for GPU mapped memory on UMA systems (XB1/PS4/etc)
 	// It is expected that the RHI on platforms that use these knows what to 
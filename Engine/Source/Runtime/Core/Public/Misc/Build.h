@@ -233,6 +233,18 @@
 	#define LOOKING_FOR_PERF_ISSUES (0 && !(UE_BUILD_SHIPPING))
 #endif
 
+/**
+ * Compile in the lock contention profiler (FLockContentionProfiler), it still has to be started at runtime.
+ * Off by default as it adds state and branches to every critical section and wraps every pooled event. Enable it
+ * per target with LOCK_CONTENTION_PROFILER=1 in the target's GlobalDefinitions, it has no effect in shipping builds.
+ */
+#ifndef LOCK_CONTENTION_PROFILER
+	#define LOCK_CONTENTION_PROFILER 0
+#elif UE_BUILD_SHIPPING
+	#undef LOCK_CONTENTION_PROFILER
+	#define LOCK_CONTENTION_PROFILER 0
+#endif
+
 /** Enable the use of the network profiler as long as we are a build that includes stats */
 #define USE_NETWORK_PROFILER         STATS
 
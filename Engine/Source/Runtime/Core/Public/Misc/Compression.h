@@ -15,6 +15,8 @@ enum ECompressionFlags
 	COMPRESS_ZLIB 					= 0x01,
 	/** Compress with GZIP															*/
 	COMPRESS_GZIP					= 0x02,
+	/** Compress with LZ4, decompresses several times faster than ZLIB at a lower ratio	*/
+	COMPRESS_LZ4					= 0x04,
 	/** Prefer compression that compresses smaller (ONLY VALID FOR COMPRESSION)		*/
 	COMPRESS_BiasMemory 			= 0x10,
 	/** Prefer compression that compresses faster (ONLY VALID FOR COMPRESSION)		*/
@@ -26,7 +28,7 @@ enum ECompressionFlags
 #define COMPRESS_Default			COMPRESS_ZLIB
 
 /** Compression Flag Masks **/
-/** mask out compression type flags */
+/** mask out compression type flags, the masked value is the compression type rather than a set of bits */
 #define COMPRESSION_FLAGS_TYPE_MASK		0x0F
 
 /** mask out compression type */
@@ -41,6 +43,39 @@ enum ECompressionFlags
 #define LOADING_COMPRESSION_CHUNK_SIZE			131072
 #define SAVING_COMPRESSION_CHUNK_SIZE			LOADING_COMPRESSION_CHUNK_SIZE
 
+/**
+ * A compression method that can be registered with FCompression for one compression type.
+ * All methods have to be thread-safe.
+ */
+class ICompressionCodec
+{
+public:
+	virtual ~ICompressionCodec() {}
+
+	/** Gets the name used to select this codec on the command line and in ini files, e.g. "LZ4". */
+	virtual const TCHAR* GetName() const = 0;
+
+	/**
+	 * Gets the maximum number of bytes CompressMemory may write for a buffer of the given size.
+	 *
+	 * @param	Flags						Compression flags, the option bits may select a different setting of the codec
+	 * @param	UncompressedSize			Size of uncompressed data in bytes
+	 */
+	virtual int32 CompressMemoryBound( ECompressionFlags Flags, int32 UncompressedSize ) const = 0;
+
+	/**
+	 * Compresses a buffer, see FCompression::CompressMemory.
+	 *
+	 * @param	Flags						Compression flags, COMPRESS_BiasMemory and COMPRESS_BiasSpeed select the trade-off between ratio and speed
+	 */
+	virtual bool CompressMemory( ECompressionFlags Flags, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize ) const = 0;
+
+	/**
+	 * Decompresses a buffer to exactly UncompressedSize bytes, see FCompression::UncompressMemory.
+	 */
+	virtual bool UncompressMemory( void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize ) const = 0;
+};
+
 struct FCompression
 {
 	/** Maximum allowed size of an uncompressed buffer passed to CompressMemory or UncompressMemory. */
@@ -88,6 +123,36 @@ struct FCompression
 	 * @return true if compression succeeds, false if it fails because CompressedBuffer was too small or other reasons
 	 */
 	CORE_API static bool UncompressMemory( ECompressionFlags Flags, void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize, bool bIsSourcePadded = false );
+
+	/**
+	 * Registers a codec for a compression type, replacing the previous codec of that type. ZLIB, GZIP and LZ4 are registered
+	 * by default. Not thread-safe, codecs should be registered during module startup before anything is compressed with them.
+	 *
+	 * @param	Type						Compression type within COMPRESSION_FLAGS_TYPE_MASK the codec handles
+	 * @param	Codec						Codec to use, has to outlive its registration
+	 */
+	CORE_API static void RegisterCodec( ECompressionFlags Type, ICompressionCodec* Codec );
+
+	/**
+	 * Unregisters the codec of a compression type, data of that type can't be [de]compressed afterwards.
+	 *
+	 * @param	Type						Compression type within COMPRESSION_FLAGS_TYPE_MASK
+	 */
+	CORE_API static void UnregisterCodec( ECompressionFlags Type );
+
+	/**
+	 * Finds the codec for the compression type of the passed in flags.
+	 *
+	 * @return The registered codec, NULL if there is none
+	 */
+	CORE_API static ICompressionCodec* FindCodec( ECompressionFlags Flags );
+
+	/**
+	 * Finds the compression type of a registered codec by name, ignoring case.
+	 *
+	 * @return The compression type, COMPRESS_None if no codec has the name
+	 */
+	CORE_API static ECompressionFlags GetCompressionTypeFromName( const TCHAR* Name );
 };
 
 
@@ -205,6 +205,71 @@ private:
 
 };
 
+/**
+ * Load time cache of a coalesced source ini hierarchy, stored as a flattened binary file.
+ *
+ * It is written the first time a hierarchy is parsed, next to the generated ini file. On the next run the whole file is read
+ * in one block, as long as the hash of the source files still matches, and the text parsing and merging is skipped.
+ * The config system copies the cache into an FConfigFile with CopyTo, so GConfig lookups cost the same as without the cache.
+ * FindValue only serves callers that hold on to the cache.
+ */
+class CORE_API FConfigCacheBinary
+{
+public:
+	/** @return true if source hierarchies are loaded through the binary cache, disabled with -NoBinaryConfigCache */
+	static bool IsEnabled();
+
+	/** Overrides the command line, mostly for testing */
+	static void SetEnabled(bool bInEnabled);
+
+	/**
+	 * Hashes the names, sizes and timestamps of the files in the hierarchy along with the engine version.
+	 *
+	 * @return the hash, 0 if the hierarchy can't be cached (e.g. it uses remote ini files)
+	 */
+	static uint64 HashSourceHierarchy(const FConfigFileHierarchy& Hierarchy);
+
+	/** @return the name of the binary cache that goes with a generated ini file */
+	static FString GetCacheFilename(const FString& DestIniFilename);
+
+	/**
+	 * Writes the sections of a config file into a binary cache.
+	 *
+	 * @param Filename The file to write
+	 * @param SourceHash The hash of the sources the config file was generated from, see HashSourceHierarchy
+	 * @param ConfigFile The config file to flatten
+	 * @return true if the file was written
+	 */
+	static bool Save(const FString& Filename, uint64 SourceHash, const FConfigFile& ConfigFile);
+
+	/**
+	 * Reads a binary cache.
+	 *
+	 * @return false if the file is missing, damaged, or was generated from different sources
+	 */
+	bool Load(const FString& Filename, uint64 SourceHash);
+
+	bool IsLoaded() const
+	{
+		return Data.Num() > 0;
+	}
+
+	/**
+	 * Finds a value in the loaded cache without allocating, the same one FConfigSection::Find would return.
+	 * GConfig doesn't use this, it reads the FConfigFile filled by CopyTo.
+	 *
+	 * @return the value which stays valid as long as this object, nullptr if not found
+	 */
+	const TCHAR* FindValue(const TCHAR* Section, const TCHAR* Key) const;
+
+	/** Replaces the contents of ConfigFile with all the sections of the cache */
+	void CopyTo(FConfigFile& ConfigFile) const;
+
+private:
+	/** The whole file, everything else points into it */
+	TArray<uint8> Data;
+};
+
 /**
  * Declares a delegate type that's used by the config system to allow iteration of key value pairs.
  */
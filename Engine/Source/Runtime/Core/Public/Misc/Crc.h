@@ -22,6 +22,15 @@ struct CORE_API FCrc
 	/** generates CRC hash of the memory area */
 	static uint32 MemCrc32( const void* Data, int32 Length, uint32 CRC=0 );
 
+	/** @return true if MemCrc32 uses the carry-less multiply instructions on this CPU. Only valid after Init. */
+	static bool IsMemCrc32HardwareAccelerated();
+
+	/**
+	 * Generates a 64 bit hash of the memory area (xxHash64). This is much faster than MemCrc32 on large inputs but is not
+	 * a CRC and not suitable for anything persistent that might need to be checked by other tools; use it for in-memory hashing.
+	 */
+	static uint64 MemHash64( const void* Data, int64 Length, uint64 Seed=0 );
+
 	/** String CRC. */
 	template <typename CharType>
 	static typename TEnableIf<sizeof(CharType) != 1, uint32>::Type StrCrc32(const CharType* Data, uint32 CRC = 0)
@@ -136,7 +136,7 @@ public:
 		check(!NumMarks && !MinMarksToAlloc);
 		FreeChunks(nullptr);
 	}
-	FORCEINLINE int32 GetNumMarks()
+	FORCEINLINE int32 GetNumMarks() const
 	{
 		return NumMarks;
 	}
@@ -394,3 +394,162 @@ private:
 	bool bPopped;
 	FMemMark* NextTopmostMark;
 };
+
+
+/**
+ * Thread local arena for temporary allocations made outside of rendering, e.g. per frame containers in tick and physics code.
+ * It is kept separate from FMemStack so marks taken by game code never interleave with the renderer's.
+ * Every thread, including the task graph workers, gets its own arena the first time it uses one.
+ * Allocating requires an FArenaScope (or an FMemMark) on the arena.
+ */
+class CORE_API FArenaMemStack : public TThreadSingleton<FArenaMemStack>, public FMemStackBase
+{
+public:
+
+	FArenaMemStack();
+	virtual ~FArenaMemStack();
+
+	/** Records the current byte count if it is the highest seen so far on this arena. Called when scopes end. */
+	void UpdatePeakByteCount();
+
+	/** @return the highest number of bytes in use seen at the end of a scope on this arena. */
+	int32 GetPeakByteCount() const
+	{
+		return PeakByteCount;
+	}
+
+	/** Logs the peak usage of every thread's arena. */
+	static void DumpStats(class FOutputDevice& Ar);
+
+private:
+
+	/** Highest byte count recorded by UpdatePeakByteCount. */
+	int32 PeakByteCount;
+};
+
+
+/**
+ * Marks the calling thread's arena and frees everything allocated from it within the scope when the scope ends.
+ * Scopes nest; containers using TArenaAllocator must not outlive the innermost scope that was open when they first allocated.
+ */
+class FArenaScope
+{
+public:
+
+	FArenaScope()
+		: Arena(FArenaMemStack::Get())
+		, Mark(Arena)
+	{
+	}
+
+	~FArenaScope()
+	{
+		Pop();
+	}
+
+	/** Frees the memory allocated since the scope was opened. The scope can't be used to allocate afterwards. */
+	void Pop()
+	{
+		Arena.UpdatePeakByteCount();
+		Mark.Pop();
+	}
+
+	/** @return the arena this scope marks. */
+	FArenaMemStack& GetArena()
+	{
+		return Arena;
+	}
+
+private:
+
+	FArenaMemStack& Arena;
+	FMemMark Mark;
+};
+
+
+/**
+ * A container allocator that allocates from the arena of the thread that first allocates for the container.
+ * Memory is never freed individually; growing copies into a new allocation and the old one is reclaimed when the scope ends.
+ * Containers must only be resized on that thread and must be destroyed before the arena scope ends.
+ */
+template<uint32 Alignment = DEFAULT_ALIGNMENT>
+class TArenaAllocator
+{
+public:
+
+	enum { NeedsElementType = true };
+	enum { RequireRangeCheck = true };
+
+	template<typename ElementType>
+	class ForElementType
+	{
+	public:
+
+		/** Default constructor. */
+		ForElementType()
+			: Data(nullptr)
+			, Arena(nullptr)
+		{}
+
+		// FContainerAllocatorInterface
+		FORCEINLINE ElementType* GetAllocation() const
+		{
+			return Data;
+		}
+		void ResizeAllocation(int32 PreviousNumElements, int32 NumElements, int32 NumBytesPerElement)
+		{
+			void* OldData = Data;
+			if (NumElements)
+			{
+				if (!Arena)
+				{
+					Arena = &FArenaMemStack::Get();
+				}
+				checkSlow(Arena == &FArenaMemStack::Get());
+
+				// Allocate memory from the arena.
+				Data = (ElementType*)Arena->PushBytes(
+					NumElements * NumBytesPerElement,
+					FMath::Max(Alignment, (uint32)ALIGNOF(ElementType))
+					);
+
+				// If the container previously held elements, copy them into the new allocation.
+				if (OldData && PreviousNumElements)
+				{
+					const int32 NumCopiedElements = FMath::Min(NumElements, PreviousNumElements);
+					FMemory::Memcpy(Data, OldData, NumCopiedElements * NumBytesPerElement);
+				}
+			}
+			else
+			{
+				Data = nullptr;
+			}
+		}
+		int32 CalculateSlack(int32 NumElements, int32 NumAllocatedElements, int32 NumBytesPerElement) const
+		{
+			return DefaultCalculateSlack(NumElements, NumAllocatedElements, NumBytesPerElement);
+		}
+
+		int32 GetAllocatedSize(int32 NumAllocatedElements, int32 NumBytesPerElement) const
+		{
+			return NumAllocatedElements * NumBytesPerElement;
+		}
+
+	private:
+
+		/** A pointer to the container's elements. */
+		ElementType* Data;
+
+		/** The arena the container allocates from, bound on the first allocation. */
+		FArenaMemStack* Arena;
+	};
+
+	typedef ForElementType<FScriptContainerElement> ForAnyElementType;
+};
+
+
+/** A set allocator (for TSet and TMap) that puts the elements, the allocation bits and the hash in the thread's arena. */
+template<uint32 Alignment = DEFAULT_ALIGNMENT>
+class TArenaSetAllocator : public TSetAllocator<TSparseArrayAllocator<TArenaAllocator<Alignment>, TArenaAllocator<>>, TArenaAllocator<>>
+{
+};
@@ -451,6 +451,17 @@ public:
 		return true; 
 	}
 
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		UsedMalloc->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		FScopeLock Lock( &CriticalSection );
+		UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+
 	/** Called once per frame, gathers and sets all memory allocator statistics into the corresponding stats. MUST BE THREAD SAFE. */
 	virtual void UpdateStats() override
 	{
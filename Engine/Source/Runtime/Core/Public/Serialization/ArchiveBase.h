@@ -600,6 +600,11 @@ public:
 		return ArWantBinaryPropertySerialization;
 	}
 
+	FORCEINLINE bool UseUnversionedPropertySerialization() const
+	{
+		return ArUseUnversionedPropertySerialization;
+	}
+
 	FORCEINLINE bool IsForcingUnicode() const
 	{
 		return ArForceUnicode;
@@ -874,6 +879,17 @@ public:
 		return ArIsSaveGame;
 	}
 
+	/**
+	 * Sets a flag indicating that tagged properties are serialized as a schema hash, a bitmask of the
+	 * non-default properties and their raw values instead of one tag per property.
+	 *
+	 * @param bInUseUnversioned Whether to use unversioned property serialization.
+	 */
+	void SetUseUnversionedPropertySerialization(bool bInUseUnversioned)
+	{
+		ArUseUnversionedPropertySerialization = bInUseUnversioned;
+	}
+
 	/**
 	 * Checks whether the archive is used for cooking.
 	 *
@@ -1009,6 +1025,9 @@ public:
 	
 	/** Whether this archive wants properties to be serialized in binary form instead of tagged. */
 	bool ArWantBinaryPropertySerialization;
+
+	/** Whether tagged properties are serialized without tags, relying on matching struct layouts (cooked data only). */
+	bool ArUseUnversionedPropertySerialization;
 	
 	/** Whether this archive wants to always save strings in unicode format */
 	bool ArForceUnicode;
@@ -79,6 +79,8 @@ namespace FNameDefs
 	// use of FNames to store asset path and content tags
 	static const uint32 NameHashBucketCount = 65536;
 #endif
+	// Hash buckets are split between this many insertion locks, lookups of existing names don't lock at all
+	static const uint32 NameHashShardCount = 32;
 }
 
 
@@ -1036,9 +1038,12 @@ private:
 #endif
 	}
 
-	/** Singleton to retrieve the critical section. */
+	/** Singleton to retrieve the critical section. Guards allocation of name indices and entries. */
 	static FCriticalSection* GetCriticalSection();
 
+	/** Returns the critical section that guards insertion into the given hash bucket. */
+	static FCriticalSection* GetHashShardCriticalSection(uint32 HashIndex);
+
 };
 
 template<> struct TIsZeroConstructType<class FName> { enum { Value = true }; };
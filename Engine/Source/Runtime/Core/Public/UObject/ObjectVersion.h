@@ -591,7 +591,9 @@ enum EUnrealEngineObjectUE4Version
 	// Updating custom material expression nodes for instanced stereo implementation
 	VER_UE4_INSTANCED_STEREO_UNIFORM_UPDATE,
 	// Texture streaming min and max distance to handle HLOD
-	VER_UE4_STREAMABLE_TEXTURE_MIN_MAX_DISTANCE,	// -----<new versions can be added before this line>-------------------------------------------------
+	VER_UE4_STREAMABLE_TEXTURE_MIN_MAX_DISTANCE,
+	// Package summary has an offset to the dependency graph precomputed for cooked packages
+	VER_UE4_PACKAGE_SUMMARY_HAS_DEPENDENCY_GRAPH,
 	// -----<new versions can be added before this line>-------------------------------------------------
 	// - this needs to be the last line (see note below)
 	VER_UE4_AUTOMATIC_VERSION_PLUS_ONE,
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "HAL/LockContentionProfiler.h"
+
 /**
  * This is the Windows version of a critical section. It uses an aggregate
  * CRITICAL_SECTION to implement its locking.
@@ -13,6 +15,11 @@ class FWindowsCriticalSection
 	 */
 	CRITICAL_SECTION CriticalSection;
 
+#if LOCK_CONTENTION_PROFILER
+	/** Holder tracking and the pending sample for the lock contention profiler */
+	FLockContentionState ContentionState;
+#endif
+
 public:
 
 	/**
@@ -40,6 +47,13 @@ public:
 	 */
 	FORCEINLINE void Lock()
 	{
+#if LOCK_CONTENTION_PROFILER
+		if (FLockContentionProfiler::IsEnabled())
+		{
+			LockProfiled();
+			return;
+		}
+#endif
 		// Spin first before entering critical section, causing ring-0 transition and context switch.
 		if( TryEnterCriticalSection(&CriticalSection) == 0 )
 		{
@@ -56,6 +70,12 @@ public:
 	{
 		if (TryEnterCriticalSection(&CriticalSection))
 		{
+#if LOCK_CONTENTION_PROFILER
+			if (FLockContentionProfiler::IsEnabled())
+			{
+				ContentionState.OnAcquired(FLockContentionProfiler::GetCurrentThreadId(), false, false, 0);
+			}
+#endif
 			return true;
 		};
 		return false;
@@ -66,10 +86,48 @@ public:
 	 */
 	FORCEINLINE void Unlock()
 	{
+#if LOCK_CONTENTION_PROFILER
+		if (ContentionState.bHasPendingSample)
+		{
+			UnlockProfiled();
+			return;
+		}
+#endif
 		LeaveCriticalSection(&CriticalSection);
 	}
 
 private:
+#if LOCK_CONTENTION_PROFILER
+	/** Lock that reports to the lock contention profiler */
+	FORCENOINLINE void LockProfiled()
+	{
+		const uint32 ThreadId = FLockContentionProfiler::GetCurrentThreadId();
+		if (!FLockContentionProfiler::ShouldSample())
+		{
+			EnterCriticalSection(&CriticalSection);
+			ContentionState.OnAcquired(ThreadId, false, false, 0);
+		}
+		else if (TryEnterCriticalSection(&CriticalSection))
+		{
+			ContentionState.OnAcquired(ThreadId, true, false, 0);
+		}
+		else
+		{
+			const uint32 StartCycles = FLockContentionProfiler::GetCycles();
+			EnterCriticalSection(&CriticalSection);
+			ContentionState.OnAcquired(ThreadId, true, true, FLockContentionProfiler::GetCycles() - StartCycles);
+		}
+	}
+
+	/** Releases the lock, then records the sample taken when it was acquired */
+	FORCENOINLINE void UnlockProfiled()
+	{
+		const FLockContentionSample Sample = ContentionState.TakePendingSample();
+		LeaveCriticalSection(&CriticalSection);
+		FLockContentionProfiler::RecordAcquire(this, ELockContentionType::CriticalSection, Sample.bContended, Sample.WaitCycles, Sample.OwnerThreadId);
+	}
+#endif
+
 	FWindowsCriticalSection(const FWindowsCriticalSection&);
 	FWindowsCriticalSection& operator=(const FWindowsCriticalSection&);
 };
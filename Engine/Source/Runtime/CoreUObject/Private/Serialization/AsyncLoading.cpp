@@ -264,6 +264,15 @@ static FAutoConsoleVariableRef CVarPreloadPackageDependencies(
 	ECVF_Default
 	);
 
+static int32 GMaxExportDataPrecacheSizeKB = 16 * 1024;
+static FAutoConsoleVariableRef CVarMaxExportDataPrecacheSizeKB(
+	TEXT("s.MaxExportDataPrecacheSizeKB"),
+	GMaxExportDataPrecacheSizeKB,
+	TEXT("Packages with a precomputed dependency graph and at most this much export data (in KB) read all of it with a single request\n") \
+	TEXT("and create their exports in preload order. 0 reads the exports one at a time in file order."),
+	ECVF_Default
+	);
+
 static FORCEINLINE bool IsTimeLimitExceeded(double InTickStartTime, bool bUseTimeLimit, float InTimeLimit, const TCHAR* InLastTypeOfWorkPerformed = nullptr, UObject* InLastObjectWorkWasPerformedOn = nullptr)
 {
 	bool bTimeLimitExceeded = false;
@@ -1035,6 +1044,8 @@ FAsyncPackage::FAsyncPackage(const FAsyncPackageDesc& InDesc)
 , LoadImportIndex(0)
 , ImportIndex(0)
 , ExportIndex(0)
+, ExportDataPrecacheOffset(0)
+, ExportDataPrecacheSize(0)
 , DeferredPostLoadIndex(0)
 , TimeLimit(FLT_MAX)
 , bUseTimeLimit(false)
@@ -1678,10 +1689,13 @@ EAsyncPackageState::Type FAsyncPackage::CreateImports()
 	// GC can't run in here
 	FGCScopeGuard GCGuard;
 
-	// Create imports.
+	// Create imports, outers first if the package has a precomputed dependency graph.
+	const TArray<int32>& ImportOrder = Linker->DependencyGraph.ImportOrder;
 	while( ImportIndex < Linker->ImportMap.Num() && !IsTimeLimitExceeded() )
 	{
- 		UObject* Object	= Linker->CreateImport( ImportIndex++ );
+		const int32 CreateIndex = ImportOrder.Num() ? ImportOrder[ImportIndex] : ImportIndex;
+		ImportIndex++;
+ 		UObject* Object	= Linker->CreateImport( CreateIndex );
 		LastObjectWorkWasPerformedOn	= Object;
 		LastTypeOfWorkPerformed			= TEXT("creating imports for");
 
@@ -1736,18 +1750,29 @@ EAsyncPackageState::Type FAsyncPackage::CreateExports()
 	// GC can't run in here
 	FGCScopeGuard GCGuard;
 
+	if (ExportIndex == 0)
+	{
+		ExportDataPrecacheSize = GetExportDataPrecacheRange(ExportDataPrecacheOffset);
+	}
+
 	// Create exports.
 	while( ExportIndex < Linker->ExportMap.Num() && !IsTimeLimitExceeded() )
 	{
-		const FObjectExport& Export = Linker->ExportMap[ExportIndex];
+		// With all export data precached at once the exports are created in preload order
+		const int32 CreateIndex = ExportDataPrecacheSize ? Linker->DependencyGraph.ExportOrder[ExportIndex] : ExportIndex;
+		const FObjectExport& Export = Linker->ExportMap[CreateIndex];
 		
 		// Precache data and see whether it's already finished.
+		const bool bIsPrecached = ExportDataPrecacheSize ?
+			Linker->Precache( ExportDataPrecacheOffset, ExportDataPrecacheSize ) :
+			Linker->Precache( Export.SerialOffset, Export.SerialSize );
 
 		// We have sufficient data in the cache so we can load.
-		if( Linker->Precache( Export.SerialOffset, Export.SerialSize ) )
+		if( bIsPrecached )
 		{
 			// Create the object...
-			UObject* Object	= Linker->CreateExport( ExportIndex++ );
+			UObject* Object	= Linker->CreateExport( CreateIndex );
+			ExportIndex++;
 			// ... and preload it.
 			if( Object )
 			{				
@@ -1776,6 +1801,33 @@ EAsyncPackageState::Type FAsyncPackage::CreateExports()
 	return ExportIndex == Linker->ExportMap.Num() ? EAsyncPackageState::Complete : EAsyncPackageState::TimeOut;
 }
 
+int64 FAsyncPackage::GetExportDataPrecacheRange(int64& OutOffset) const
+{
+	// Compressed packages are precached one chunk at a time
+	if (GMaxExportDataPrecacheSizeKB <= 0 || Linker->DependencyGraph.ExportOrder.Num() == 0 || Linker->Summary.CompressedChunks.Num())
+	{
+		return 0;
+	}
+
+	int64 DataStart = MAX_int64;
+	int64 DataEnd = 0;
+	for (const FObjectExport& Export : Linker->ExportMap)
+	{
+		if (Export.SerialSize > 0)
+		{
+			DataStart = FMath::Min<int64>(DataStart, Export.SerialOffset);
+			DataEnd = FMath::Max<int64>(DataEnd, (int64)Export.SerialOffset + Export.SerialSize);
+		}
+	}
+	if (DataEnd <= DataStart || DataEnd - DataStart > (int64)GMaxExportDataPrecacheSizeKB * 1024)
+	{
+		return 0;
+	}
+
+	OutOffset = DataStart;
+	return DataEnd - DataStart;
+}
+
 /**
  * Removes references to any imported packages.
  */
@@ -13,6 +13,54 @@
 #define TRACK_BULKDATA_USE 0
 
 DECLARE_STATS_GROUP(TEXT("Bulk Data"), STATGROUP_BulkData, STATCAT_Advanced);
+DECLARE_MEMORY_STAT(TEXT("Mapped Bulk Data"), STAT_MappedBulkDataMemory, STATGROUP_BulkData);
+
+static int32 GMapBulkData = 1;
+static FAutoConsoleVariableRef CVarMapBulkData(
+	TEXT("s.MapBulkData"),
+	GMapBulkData,
+	TEXT("If > 0, read-only locks of bulk data flagged BULKDATA_MemoryMappedPayload return a view of the memory mapped file\n")
+	TEXT("instead of a copy, if the platform file can map it."),
+	ECVF_Default
+	);
+
+/** Shares the mapped file handles between all bulk data payloads of the same file. */
+struct FMappedBulkDataFiles
+{
+	static FMappedBulkDataFiles& Get()
+	{
+		static FMappedBulkDataFiles Instance;
+		return Instance;
+	}
+
+	TSharedPtr<IMappedFileHandle, ESPMode::ThreadSafe> Open( const FString& Filename )
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+
+		TSharedPtr<IMappedFileHandle, ESPMode::ThreadSafe> Handle = Handles.FindRef(Filename).Pin();
+		if (!Handle.IsValid())
+		{
+			IMappedFileHandle* NewHandle = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename);
+			// regions of files the platform can't map are copies, loading the payload regularly is cheaper
+			if (!NewHandle || !NewHandle->IsMemoryMapped())
+			{
+				delete NewHandle;
+				Handles.Remove(Filename);
+				return nullptr;
+			}
+			Handle = TSharedPtr<IMappedFileHandle, ESPMode::ThreadSafe>(NewHandle);
+			Handles.Add(Filename, Handle);
+		}
+		return Handle;
+	}
+
+protected:
+	/** Map from filename to the mapped file, which is closed once the last payload mapped from it is released */
+	TMap<FString, TWeakPtr<IMappedFileHandle, ESPMode::ThreadSafe>> Handles;
+
+	/** CriticalSection. */
+	FCriticalSection CriticalSection;
+};
 
 #if TRACK_BULKDATA_USE
 
@@ -129,6 +177,7 @@ FUntypedBulkData::~FUntypedBulkData()
 	// Free memory.
 	BulkData     .Deallocate();
 	BulkDataAsync.Deallocate();
+	ReleaseMappedPayload();
 	
 #if WITH_EDITOR
 	// Detach from archive.
@@ -282,7 +331,7 @@ int32 FUntypedBulkData::GetBulkDataSize() const
 }
 /**
  * Returns the size of the bulk data on disk. This can differ from GetBulkDataSize if
- * BULKDATA_SerializeCompressed is set.
+ * a compression flag in BULKDATA_SerializeCompressedAny is set.
  *
  * @return Size of the bulk data on disk or INDEX_NONE in case there's no association
  */
@@ -306,7 +355,7 @@ int64 FUntypedBulkData::GetBulkDataOffsetInFile() const
  */
 bool FUntypedBulkData::IsStoredCompressedOnDisk() const
 {
-	return (BulkDataFlags & BULKDATA_SerializeCompressed) ? true : false;
+	return (BulkDataFlags & BULKDATA_SerializeCompressedAny) ? true : false;
 }
 
 bool FUntypedBulkData::CanLoadFromDisk() const
@@ -325,7 +374,12 @@ bool FUntypedBulkData::CanLoadFromDisk() const
  */
 ECompressionFlags FUntypedBulkData::GetDecompressionFlags() const
 {
-	return (BulkDataFlags & BULKDATA_SerializeCompressedZLIB) ? COMPRESS_ZLIB : COMPRESS_None;
+	// ZLIB wins if both flags are set, as it did before LZ4 was added
+	if( BulkDataFlags & BULKDATA_SerializeCompressedZLIB )
+	{
+		return COMPRESS_ZLIB;
+	}
+	return (BulkDataFlags & BULKDATA_SerializeCompressedLZ4) ? COMPRESS_LZ4 : COMPRESS_None;
 }
 
 /**
@@ -335,7 +389,17 @@ ECompressionFlags FUntypedBulkData::GetDecompressionFlags() const
  */
 bool FUntypedBulkData::IsBulkDataLoaded() const
 {
-	return !!BulkData;
+	return !!BulkData || MappedRegion.IsValid();
+}
+
+/**
+ * Returns whether the payload is currently a view of a memory mapped file rather than a copy.
+ *
+ * @return true if the payload is mapped, false otherwise
+ */
+bool FUntypedBulkData::IsBulkDataMapped() const
+{
+	return MappedRegion.IsValid();
 }
 
 bool FUntypedBulkData::IsAsyncLoadingComplete()
@@ -395,6 +459,10 @@ void FUntypedBulkData::GetCopy( void** Dest, bool bDiscardInternalCopy )
 		else
 		{
 			LoadDataIntoMemory( *Dest );
+			if( bDiscardInternalCopy )
+			{
+				ReleaseMappedPayload();
+			}
 		}
 	}
 	// Passed in memory is NULL so we need to allocate some.
@@ -447,6 +515,10 @@ void FUntypedBulkData::GetCopy( void** Dest, bool bDiscardInternalCopy )
 
 				// ... and directly load into it.
 				LoadDataIntoMemory( *Dest );
+				if( bDiscardInternalCopy )
+				{
+					ReleaseMappedPayload();
+				}
 			}
 			else
 			{
@@ -464,6 +536,16 @@ void FUntypedBulkData::GetCopy( void** Dest, bool bDiscardInternalCopy )
 void* FUntypedBulkData::Lock( uint32 LockFlags )
 {
 	check( LockStatus == LOCKSTATUS_Unlocked );
+
+	// Hand out a view of the mapped file instead of loading a copy if we can.
+	if( !(LockFlags & LOCK_READ_WRITE) && (LockFlags & LOCK_READ_ONLY) && !BulkData && CanMapPayload() )
+	{
+		if( const void* MappedPayload = MapPayload() )
+		{
+			LockStatus = LOCKSTATUS_ReadOnlyLock;
+			return const_cast<void*>(MappedPayload);
+		}
+	}
 	
 	// Make sure bulk data is loaded.
 	MakeSureBulkDataIsLoaded();
@@ -503,6 +585,16 @@ const void* FUntypedBulkData::LockReadOnly() const
 	
 	FUntypedBulkData* mutable_this = const_cast<FUntypedBulkData*>(this);
 
+	// Hand out a view of the mapped file instead of loading a copy if we can.
+	if (!BulkData && CanMapPayload())
+	{
+		if (const void* MappedPayload = mutable_this->MapPayload())
+		{
+			mutable_this->LockStatus = LOCKSTATUS_ReadOnlyLock;
+			return MappedPayload;
+		}
+	}
+
 	// Make sure bulk data is loaded.
 	mutable_this->MakeSureBulkDataIsLoaded();
 
@@ -546,6 +638,7 @@ void FUntypedBulkData::Unlock() const
 	if (BulkDataFlags & BULKDATA_SingleUse)
 	{
 		mutable_this->BulkData.Deallocate();
+		mutable_this->ReleaseMappedPayload();
 	}
 }
 
@@ -570,6 +663,8 @@ void FUntypedBulkData::RemoveBulkData()
 	// Resize to 0 elements.
 	ElementCount	= 0;
 	BulkData.Deallocate();
+	ReleaseMappedPayload();
+	bPayloadMappable = false;
 }
 
 /**
@@ -692,6 +787,49 @@ bool FUntypedBulkData::ShouldStreamBulkData()
 		GMinimumBulkDataSizeForAsyncLoading >= 0);
 }
 
+bool FUntypedBulkData::CanMapPayload() const
+{
+	return bPayloadMappable && GMapBulkData > 0 && !Filename.IsEmpty() && GetBulkDataSize() > 0;
+}
+
+const void* FUntypedBulkData::MapPayload()
+{
+	if (!MappedRegion.IsValid())
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FUntypedBulkData::MapPayload"), STAT_UBD_MapPayload, STATGROUP_Memory);
+
+		MappedHandle = FMappedBulkDataFiles::Get().Open(Filename);
+		if (MappedHandle.IsValid())
+		{
+			MappedRegion.Reset(MappedHandle->MapRegion(BulkDataOffsetInFile, GetBulkDataSize()));
+		}
+
+		const uint32 Alignment = FMath::Max<uint32>(BulkDataAlignment, 1);
+		if (!MappedRegion.IsValid() || MappedRegion->GetMappedSize() < GetBulkDataSize() || ((UPTRINT)MappedRegion->GetMappedPtr() & (Alignment - 1)) != 0)
+		{
+			// The file can't be mapped or doesn't satisfy the alignment, so copy the payload from now on.
+			MappedRegion.Reset();
+			MappedHandle.Reset();
+			bPayloadMappable = false;
+			return nullptr;
+		}
+		INC_MEMORY_STAT_BY(STAT_MappedBulkDataMemory, MappedRegion->GetMappedSize());
+	}
+	return MappedRegion->GetMappedPtr();
+}
+
+void FUntypedBulkData::ReleaseMappedPayload()
+{
+	if (MappedRegion.IsValid())
+	{
+		check(LockStatus == LOCKSTATUS_Unlocked);
+		DEC_MEMORY_STAT_BY(STAT_MappedBulkDataMemory, MappedRegion->GetMappedSize());
+		// the region has to be released before the file it was mapped from
+		MappedRegion.Reset();
+	}
+	MappedHandle.Reset();
+}
+
 /**
 * Serialize function used to serialize this bulk data structure.
 *
@@ -794,6 +932,14 @@ void FUntypedBulkData::Serialize( FArchive& Ar, UObject* Owner, int32 Idx )
 				BulkDataOffsetInFile += Owner->GetLinker()->Summary.BulkDataStartOffset;
 			}
 
+			// Mappable payloads at the end of the file are neither loaded nor streamed here, the first read-only lock maps them instead.
+			// Inline ones are mapped right away and only skipped if that worked, otherwise they're loaded as usual.
+			// The file offset is only meaningful if the package itself isn't compressed.
+			bPayloadMappable = !!(BulkDataFlags & BULKDATA_MemoryMappedPayload) && FPlatformProperties::RequiresCookedData()
+				&& !(BulkDataFlags & (BULKDATA_SerializeCompressedAny | BULKDATA_ForceSingleElementSerialization | BULKDATA_Unused))
+				&& !RequiresSingleElementSerialization(Ar) && !Ar.ForceByteSwapping()
+				&& Owner != NULL && Owner->GetLinker() && !Owner->GetLinker()->IsCompressed();
+
 			// We're allowing defered serialization.
 			if( Ar.IsAllowingLazyLoading() && Owner != NULL)
 			{				
@@ -812,7 +958,12 @@ void FUntypedBulkData::Serialize( FArchive& Ar, UObject* Owner, int32 Idx )
 #endif // WITH_EDITOR
 				if (bPayloadInline)
 				{
-					if (ShouldStreamBulkData())
+					if (CanMapPayload() && MapPayload())
+					{
+						// Skip the payload, the mapped file is used instead
+						Ar.Seek(Ar.Tell() + BulkDataSizeOnDisk);
+					}
+					else if (ShouldStreamBulkData())
 					{
 						// Start serializing immediately
 						StartSerializingBulkData(Ar, Owner, Idx, bPayloadInline);
@@ -833,7 +984,15 @@ void FUntypedBulkData::Serialize( FArchive& Ar, UObject* Owner, int32 Idx )
 				{
 					Filename = Owner->GetLinker()->Filename;
 				}
-				if (ShouldStreamBulkData())
+				if (bPayloadMappable && (!bPayloadInline || (CanMapPayload() && MapPayload())))
+				{
+					// Skip the payload, it is mapped when it is first locked or already has been if it's inline
+					if (bPayloadInline)
+					{
+						Ar.Seek(Ar.Tell() + BulkDataSizeOnDisk);
+					}
+				}
+				else if (ShouldStreamBulkData())
 				{
 					StartSerializingBulkData(Ar, Owner, Idx, bPayloadInline);
 				}
@@ -1035,13 +1194,15 @@ void FUntypedBulkData::StoreCompressedOnDisk( ECompressionFlags CompressionFlags
 		if( CompressionFlags == COMPRESS_None )
 		{
 			// clear all compression settings
-			BulkDataFlags &= ~BULKDATA_SerializeCompressed;
+			BulkDataFlags &= ~BULKDATA_SerializeCompressedAny;
 		}
 		else
 		{
 			// make sure a valid compression format was specified
-			check(CompressionFlags & COMPRESS_ZLIB);
-			BulkDataFlags |= (CompressionFlags & COMPRESS_ZLIB) ? BULKDATA_SerializeCompressedZLIB : BULKDATA_None;
+			const int32 CompressionType = CompressionFlags & COMPRESSION_FLAGS_TYPE_MASK;
+			check(CompressionType == COMPRESS_ZLIB || CompressionType == COMPRESS_LZ4);
+			BulkDataFlags &= ~BULKDATA_SerializeCompressedAny;
+			BulkDataFlags |= (CompressionType == COMPRESS_LZ4) ? BULKDATA_SerializeCompressedLZ4 : BULKDATA_SerializeCompressedZLIB;
 
 			// make sure we are not forcing the bulkdata to be stored inline if we use compression
 			BulkDataFlags &= ~BULKDATA_ForceInlinePayload;
@@ -1065,11 +1226,12 @@ void FUntypedBulkData::Copy( const FUntypedBulkData& Other )
 	if( Other.GetElementCount() )
 	{
 		// Make sure src is loaded without calling Lock as the object is const.
-		check(Other.BulkData);
+		check(Other.BulkData || Other.MappedRegion.IsValid());
 		check(BulkData);
 		check(ElementCount == Other.GetElementCount() );
 		// Copy from src to dest.
-		FMemory::Memcpy( BulkData.Get(), Other.BulkData.Get(), Other.GetBulkDataSize() );
+		const void* OtherData = Other.BulkData ? Other.BulkData.Get() : Other.MappedRegion->GetMappedPtr();
+		FMemory::Memcpy( BulkData.Get(), OtherData, Other.GetBulkDataSize() );
 	}
 }
 
@@ -1084,6 +1246,7 @@ void FUntypedBulkData::InitializeMemberVariables()
 	BulkDataSizeOnDisk = INDEX_NONE;
 	BulkDataAlignment = DEFAULT_ALIGNMENT;
 	LockStatus = LOCKSTATUS_Unlocked;
+	bPayloadMappable = false;
 #if WITH_EDITOR
 	Linker = nullptr;
 	AttachedAr = nullptr;
@@ -1138,7 +1301,7 @@ void FUntypedBulkData::SerializeBulkData( FArchive& Ar, void* Data )
 	if( bSerializeInBulk )
 	{
 		// Serialize data compressed.
-		if( BulkDataFlags & BULKDATA_SerializeCompressed )
+		if( BulkDataFlags & BULKDATA_SerializeCompressedAny )
 		{
 			Ar.SerializeCompressed( Data, GetBulkDataSize(), GetDecompressionFlags());
 		}
@@ -1154,7 +1317,7 @@ void FUntypedBulkData::SerializeBulkData( FArchive& Ar, void* Data )
 	else
 	{
 		// Serialize data compressed.
-		if( BulkDataFlags & BULKDATA_SerializeCompressed )
+		if( BulkDataFlags & BULKDATA_SerializeCompressedAny )
 		{
 			// Placeholder for to be serialized data.
 			TArray<uint8> SerializedData;
@@ -1228,6 +1391,9 @@ void FUntypedBulkData::MakeSureBulkDataIsLoaded()
 			{
 				LoadDataIntoMemory(BulkData.Get());
 			}
+
+			// The copy replaces the mapped view.
+			ReleaseMappedPayload();
 		}
 	}
 }
@@ -1268,6 +1434,13 @@ void FUntypedBulkData::LoadDataIntoMemory( void* Dest )
 		return;
 	}
 
+	// A mapped payload just needs to be copied.
+	if (MappedRegion.IsValid())
+	{
+		FMemory::Memcpy(Dest, MappedRegion->GetMappedPtr(), GetBulkDataSize());
+		return;
+	}
+
 #if WITH_EDITOR
 	checkf( AttachedAr, TEXT( "Attempted to load bulk data without an attached archive. Most likely the bulk data was loaded twice on console, which is not supported" ) );
 
@@ -19,6 +19,10 @@
 DEFINE_LOG_CATEGORY(LogScriptSerialization);
 DEFINE_LOG_CATEGORY(LogClass);
 
+DECLARE_CYCLE_STAT(TEXT("Serialize Tagged Properties"), STAT_SerializeTaggedProperties, STATGROUP_Object);
+DECLARE_CYCLE_STAT(TEXT("Serialize Unversioned Properties"), STAT_SerializeUnversionedProperties, STATGROUP_Object);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Unversioned Schema Mismatches"), STAT_UnversionedSchemaMismatches, STATGROUP_Object);
+
 #if _MSC_VER == 1900
 	#ifdef PRAGMA_DISABLE_SHADOW_VARIABLE_WARNINGS
 		PRAGMA_DISABLE_SHADOW_VARIABLE_WARNINGS
@@ -456,6 +460,7 @@ UStruct::UStruct( EStaticConstructor, int32 InSize, EObjectFlags InFlags )
 ,	DestructorLink	( NULL )
 , PostConstructLink( NULL )
 {
+	UnversionedSchemaNumElements[0] = UnversionedSchemaNumElements[1] = INDEX_NONE;
 }
 
 UStruct::UStruct(UStruct* InSuperStruct, SIZE_T ParamsSize, SIZE_T Alignment)
@@ -469,6 +474,7 @@ UStruct::UStruct(UStruct* InSuperStruct, SIZE_T ParamsSize, SIZE_T Alignment)
 	, DestructorLink(NULL)
 	, PostConstructLink(NULL)
 {
+	UnversionedSchemaNumElements[0] = UnversionedSchemaNumElements[1] = INDEX_NONE;
 }
 
 UStruct::UStruct(const FObjectInitializer& ObjectInitializer, UStruct* InSuperStruct, SIZE_T ParamsSize, SIZE_T Alignment )
@@ -482,6 +488,7 @@ UStruct::UStruct(const FObjectInitializer& ObjectInitializer, UStruct* InSuperSt
 ,	DestructorLink	( NULL )
 , PostConstructLink( NULL )
 {
+	UnversionedSchemaNumElements[0] = UnversionedSchemaNumElements[1] = INDEX_NONE;
 }
 
 /**
@@ -508,6 +515,45 @@ void UStruct::StaticLink(bool bRelinkExistingProperties)
 	Link(ArDummy, bRelinkExistingProperties);
 }
 
+/** Numeric properties serialize their raw bytes, so adjacent ones can be serialized with one call when the archive doesn't swap bytes */
+static bool CanSerializePropertyAsSpan(UProperty* Property)
+{
+	UByteProperty* ByteProperty = Cast<UByteProperty>(Property);
+	return Property->IsA<UNumericProperty>() && !(ByteProperty && ByteProperty->Enum);
+}
+
+/** Plain old data properties are copied with a memcpy, except bitfield bools which share their byte with other fields */
+static bool CanCopyPropertyAsSpan(UProperty* Property)
+{
+	UBoolProperty* BoolProperty = Cast<UBoolProperty>(Property);
+	return Property->HasAnyPropertyFlags(CPF_IsPlainOldData) && !(BoolProperty && !BoolProperty->IsNativeBool());
+}
+
+/** Flattens a PropertyLink list, coalescing adjacent properties accepted by CanCoalesce into spans. */
+static void BuildStructPropertyOps(UProperty* FirstProperty, bool (*CanCoalesce)(UProperty*), TArray<FStructPropertyOp>& OutOps)
+{
+	OutOps.Reset();
+	for (UProperty* Property = FirstProperty; Property; Property = Property->PropertyLinkNext)
+	{
+		const int32 Offset = Property->GetOffset_ForInternal();
+		const int32 Size = Property->GetSize();
+		if (!CanCoalesce(Property))
+		{
+			OutOps.Add(FStructPropertyOp(Property, 0, Offset, Size));
+		}
+		else if (OutOps.Num() && OutOps.Last().NumSpanProperties && OutOps.Last().Offset + OutOps.Last().Size == Offset)
+		{
+			OutOps.Last().NumSpanProperties++;
+			OutOps.Last().Size += Size;
+		}
+		else
+		{
+			OutOps.Add(FStructPropertyOp(Property, 1, Offset, Size));
+		}
+	}
+	OutOps.Shrink();
+}
+
 void UStruct::Link(FArchive& Ar, bool bRelinkExistingProperties)
 {
 	if (bRelinkExistingProperties)
@@ -720,6 +766,30 @@ void UStruct::Link(FArchive& Ar, bool bRelinkExistingProperties)
 	*PropertyLinkPtr = NULL;
 	*DestructorLinkPtr = NULL;
 	*RefLinkPtr = NULL;
+
+	// Function parameters are never serialized or copied through the op lists
+	if (IsA<UFunction>())
+	{
+		SerializeOps.Empty();
+		CopyOps.Empty();
+	}
+	else
+	{
+		BuildStructPropertyOps(PropertyLink, &CanSerializePropertyAsSpan, SerializeOps);
+		BuildStructPropertyOps(PropertyLink, &CanCopyPropertyAsSpan, CopyOps);
+	}
+	NonZeroInitProperties.Reset();
+	for (UProperty* Property = PropertyLink; Property; Property = Property->PropertyLinkNext)
+	{
+		if (!Property->HasAnyPropertyFlags(CPF_ZeroConstructor))
+		{
+			NonZeroInitProperties.Add(Property);
+		}
+	}
+	NonZeroInitProperties.Shrink();
+
+	// the property list may have changed, so the unversioned schema has to be recomputed
+	UnversionedSchemaNumElements[0] = UnversionedSchemaNumElements[1] = INDEX_NONE;
 }
 
 void UStruct::InitializeStruct(void* InDest, int32 ArrayDim/* = 1*/) const
@@ -729,22 +799,18 @@ void UStruct::InitializeStruct(void* InDest, int32 ArrayDim/* = 1*/) const
 
 	int32 Stride = GetStructureSize();
 
-	//@todo UE4 optimize
 	FMemory::Memzero(Dest, 1 * Stride);
 
-	bool bHitBase = false;
-	for (UProperty* Property = PropertyLink; Property && !bHitBase; Property = Property->PropertyLinkNext)
+	// Zero constructed properties are already initialized by the memzero above
+	for (UProperty* Property : NonZeroInitProperties)
 	{
-		if (!Property->IsInContainer(0))
+		if (Property->IsInContainer(0))
 		{
-			for (int32 ArrayIndex = 0; ArrayIndex < 1; ArrayIndex++)
-			{
-				Property->InitializeValue_InContainer(Dest + ArrayIndex * Stride);
-			}
+			break;
 		}
-		else
+		for (int32 ArrayIndex = 0; ArrayIndex < 1; ArrayIndex++)
 		{
-			bHitBase = true;
+			Property->InitializeValue_InContainer(Dest + ArrayIndex * Stride);
 		}
 	}
 }
@@ -787,13 +853,46 @@ void UStruct::SerializeBin( FArchive& Ar, void* Data ) const
 			RefLinkProperty->SerializeBinProperty( Ar, Data );
 		}
 	}
-	else
+	else if (Ar.IsByteSwapping() || !SerializeOps.Num())
 	{
+		// Byte swapping needs a call per property and functions have no SerializeOps
 		for (UProperty* Property = PropertyLink; Property != NULL; Property = Property->PropertyLinkNext)
 		{
 			Property->SerializeBinProperty(Ar, Data);
 		}
 	}
+	else
+	{
+		for (const FStructPropertyOp& Op : SerializeOps)
+		{
+			if (!Op.NumSpanProperties)
+			{
+				Op.Property->SerializeBinProperty(Ar, Data);
+				continue;
+			}
+
+			// A span is only serialized in one go if the archive wants every property in it
+			bool bSerializeSpan = true;
+			UProperty* Property = Op.Property;
+			for (int32 Index = 0; Index < Op.NumSpanProperties && bSerializeSpan; ++Index, Property = Property->PropertyLinkNext)
+			{
+				bSerializeSpan = Property->ShouldSerializeValue(Ar);
+			}
+
+			if (bSerializeSpan)
+			{
+				Ar.Serialize((uint8*)Data + Op.Offset, Op.Size);
+			}
+			else
+			{
+				Property = Op.Property;
+				for (int32 Index = 0; Index < Op.NumSpanProperties; ++Index, Property = Property->PropertyLinkNext)
+				{
+					Property->SerializeBinProperty(Ar, Data);
+				}
+			}
+		}
+	}
 }
 
 void UStruct::SerializeBinEx( FArchive& Ar, void* Data, void const* DefaultData, UStruct* DefaultStruct ) const
@@ -843,6 +942,13 @@ void UStruct::SerializeTaggedProperties(FArchive& Ar, uint8* Data, UStruct* Defa
 {
 	check(Ar.IsLoading() || Ar.IsSaving());
 
+	if (Ar.UseUnversionedPropertySerialization() && !Ar.IsTransacting() && SerializeUnversionedProperties(Ar, Data, DefaultsStruct, Defaults))
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_SerializeTaggedProperties);
+
 	UClass* DefaultsClass = dynamic_cast<UClass*>(DefaultsStruct);
 	UScriptStruct* DefaultsScriptStruct = dynamic_cast<UScriptStruct*>(DefaultsStruct);
 
@@ -1428,6 +1534,212 @@ void UStruct::SerializeTaggedProperties(FArchive& Ar, uint8* Data, UStruct* Defa
 		Ar << Temp;
 	}
 }
+
+/** Written instead of the schema hash when a struct's properties follow as tagged properties, no schema hashes to it. */
+static const uint32 UnversionedTaggedFallbackHash = 0;
+
+/**
+ * Whether the layout of a struct is fixed by the executable, so a cooked game loads it with the schema it was cooked with.
+ * Blueprint generated classes and user defined structs are not, their data always falls back to tagged properties.
+ */
+static bool IsUnversionedSchemaPinned(const UStruct* Struct)
+{
+	if (const UClass* Class = dynamic_cast<const UClass*>(Struct))
+	{
+		return Class->HasAnyClassFlags(CLASS_Native);
+	}
+	if (const UScriptStruct* ScriptStruct = dynamic_cast<const UScriptStruct*>(Struct))
+	{
+		return (ScriptStruct->StructFlags & STRUCT_Native) != 0;
+	}
+	return false;
+}
+
+/** Hashes what decides how a property value is serialized: the property class and the struct, enum or inner property it uses. */
+static uint32 HashUnversionedPropertyType(const UProperty* Property, uint32 Hash)
+{
+	Hash = FCrc::StrCrc32(*Property->GetClass()->GetName(), Hash);
+	if (const UStructProperty* StructProperty = dynamic_cast<const UStructProperty*>(Property))
+	{
+		Hash = FCrc::StrCrc32(*StructProperty->Struct->GetName(), Hash);
+	}
+	else if (const UByteProperty* ByteProperty = dynamic_cast<const UByteProperty*>(Property))
+	{
+		Hash = FCrc::StrCrc32(ByteProperty->Enum ? *ByteProperty->Enum->GetName() : TEXT("None"), Hash);
+	}
+	else if (const UArrayProperty* ArrayProperty = dynamic_cast<const UArrayProperty*>(Property))
+	{
+		Hash = HashUnversionedPropertyType(ArrayProperty->Inner, Hash);
+	}
+	return Hash;
+}
+
+void UStruct::CacheUnversionedSchema(bool bFilterEditorOnly) const
+{
+	if (UnversionedSchemaNumElements[bFilterEditorOnly] != INDEX_NONE)
+	{
+		return;
+	}
+
+	// Offsets and sizes are left out on purpose, they differ between the cooker and 32 bit targets but don't change the
+	// serialized form. Struct properties are validated by the nested struct's own header.
+	uint32 Hash = 0;
+	int32 NumElements = 0;
+	for (UProperty* Property = PropertyLink; Property; Property = Property->PropertyLinkNext)
+	{
+		if (bFilterEditorOnly && Property->IsEditorOnlyProperty())
+		{
+			continue;
+		}
+		Hash = FCrc::StrCrc32(*Property->GetName(), Hash);
+		Hash = HashUnversionedPropertyType(Property, Hash);
+		Hash = FCrc::MemCrc32(&Property->ArrayDim, sizeof(Property->ArrayDim), Hash);
+		NumElements += Property->ArrayDim;
+	}
+
+	if (Hash == UnversionedTaggedFallbackHash)
+	{
+		++Hash;
+	}
+
+	// the hash is written first so that a thread seeing the element count also sees the hash
+	UnversionedSchemaHash[bFilterEditorOnly] = Hash;
+	FPlatformMisc::MemoryBarrier();
+	UnversionedSchemaNumElements[bFilterEditorOnly] = NumElements;
+}
+
+uint32 UStruct::GetUnversionedSchemaHash(bool bFilterEditorOnly) const
+{
+	CacheUnversionedSchema(bFilterEditorOnly);
+	return UnversionedSchemaHash[bFilterEditorOnly];
+}
+
+bool UStruct::SerializeUnversionedProperties(FArchive& Ar, uint8* Data, UStruct* DefaultsStruct, uint8* Defaults) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_SerializeUnversionedProperties);
+
+	// Layout: schema hash, size of the rest of the block, one bit per property element in PropertyLink order
+	// telling whether it differs from the defaults, then the values of the set bits. Unlike tagged properties
+	// this can't survive a change to the struct, so it is only used for structs whose schema is pinned by the
+	// executable. The others write UnversionedTaggedFallbackHash followed by tagged properties.
+	if (Ar.IsSaving() && !IsUnversionedSchemaPinned(this))
+	{
+		uint32 TaggedFallbackHash = UnversionedTaggedFallbackHash;
+		Ar << TaggedFallbackHash;
+		return false;
+	}
+
+	const bool bFilterEditorOnly = Ar.IsFilterEditorOnly();
+	CacheUnversionedSchema(bFilterEditorOnly);
+	uint32 SchemaHash = UnversionedSchemaHash[bFilterEditorOnly];
+	const int32 NumElements = UnversionedSchemaNumElements[bFilterEditorOnly];
+
+	TArray<uint32, TInlineAllocator<4>> NonDefaultMask;
+	NonDefaultMask.AddZeroed((NumElements + 31) / 32);
+
+	/** If true, the values are saved without deltas against the defaults, as in SerializeTaggedProperties */
+	UScriptStruct* DefaultsScriptStruct = dynamic_cast<UScriptStruct*>(DefaultsStruct);
+	const bool bUseAtomicSerialization = Ar.IsSaving() && DefaultsScriptStruct && DefaultsScriptStruct->ShouldSerializeAtomically(Ar);
+
+	int32 BlockSize = 0;
+	int32 BlockSizeOffset = 0;
+	int32 BlockStart = 0;
+	if (Ar.IsLoading())
+	{
+		uint32 SavedSchemaHash = 0;
+		Ar << SavedSchemaHash;
+		if (SavedSchemaHash == UnversionedTaggedFallbackHash)
+		{
+			return false;
+		}
+		Ar << BlockSize;
+		if (SavedSchemaHash != SchemaHash)
+		{
+			// Loading the values as defaults would silently lose data, stale cooked content must not load at all
+			INC_DWORD_STAT(STAT_UnversionedSchemaMismatches);
+			UE_LOG(LogClass, Fatal, TEXT("Unversioned property schema mismatch for struct '%s' (saved %08X, expected %08X), archive '%s'. The content was cooked by a different build and needs to be recooked."),
+				*GetName(), SavedSchemaHash, SchemaHash, *Ar.GetArchiveName());
+			Ar.Seek(Ar.Tell() + BlockSize);
+			return true;
+		}
+		BlockStart = Ar.Tell();
+		for (uint32& Word : NonDefaultMask)
+		{
+			Ar << Word;
+		}
+	}
+	else
+	{
+		int32 ElementIndex = 0;
+		for (UProperty* Property = PropertyLink; Property; Property = Property->PropertyLinkNext)
+		{
+			if (bFilterEditorOnly && Property->IsEditorOnlyProperty())
+			{
+				continue;
+			}
+			const bool bShouldSerializeValue = Property->ShouldSerializeValue(Ar);
+			for (int32 Idx = 0; Idx < Property->ArrayDim; Idx++, ElementIndex++)
+			{
+				if (bShouldSerializeValue)
+				{
+					uint8* DataPtr      = Property->ContainerPtrToValuePtr           <uint8>(Data, Idx);
+					uint8* DefaultValue = Property->ContainerPtrToValuePtrForDefaults<uint8>(DefaultsStruct, Defaults, Idx);
+					// Atomic structs are saved whole, a value equal to the defaults must still overwrite the loading struct's value
+					if (bUseAtomicSerialization || !Ar.DoDelta() || (!Defaults && !dynamic_cast<const UClass*>(this)) || !Property->Identical(DataPtr, DefaultValue, Ar.GetPortFlags()))
+					{
+						NonDefaultMask[ElementIndex >> 5] |= 1u << (ElementIndex & 31);
+					}
+				}
+			}
+		}
+
+		Ar << SchemaHash;
+		BlockSizeOffset = Ar.Tell();
+		Ar << BlockSize;
+		BlockStart = Ar.Tell();
+		for (uint32& Word : NonDefaultMask)
+		{
+			Ar << Word;
+		}
+	}
+
+	int32 ElementIndex = 0;
+	for (UProperty* Property = PropertyLink; Property; Property = Property->PropertyLinkNext)
+	{
+		if (bFilterEditorOnly && Property->IsEditorOnlyProperty())
+		{
+			continue;
+		}
+		for (int32 Idx = 0; Idx < Property->ArrayDim; Idx++, ElementIndex++)
+		{
+			if (NonDefaultMask[ElementIndex >> 5] & (1u << (ElementIndex & 31)))
+			{
+				uint8* DataPtr      = Property->ContainerPtrToValuePtr           <uint8>(Data, Idx);
+				uint8* DefaultValue = bUseAtomicSerialization ? nullptr : Property->ContainerPtrToValuePtrForDefaults<uint8>(DefaultsStruct, Defaults, Idx);
+
+				FSerializedPropertyScope SerializedProperty(Ar, Property);
+				Property->SerializeItem(Ar, DataPtr, DefaultValue);
+			}
+		}
+	}
+
+	if (Ar.IsSaving())
+	{
+		// go back and write the size of the block now that we know it
+		const int32 EndOffset = Ar.Tell();
+		BlockSize = EndOffset - BlockStart;
+		Ar.Seek(BlockSizeOffset);
+		Ar << BlockSize;
+		Ar.Seek(EndOffset);
+	}
+	else if (Ar.Tell() != BlockStart + BlockSize)
+	{
+		UE_LOG(LogClass, Error, TEXT("Unversioned properties of struct '%s' read %d bytes instead of %d, archive '%s'."),
+			*GetName(), (int32)(Ar.Tell() - BlockStart), BlockSize, *Ar.GetArchiveName());
+		Ar.Seek(BlockStart + BlockSize);
+	}
+	return true;
+}
 void UStruct::FinishDestroy()
 {
 	Script.Empty();
@@ -2382,13 +2694,22 @@ void UScriptStruct::CopyScriptStruct(void* InDest, void const* InSrc, int32 Arra
 	{
 		FMemory::Memcpy(Dest, Src, ArrayDim * Stride);
 	}
-	else
+	else if (Dest != Src)
 	{
-		for( TFieldIterator<UProperty> It(this); It; ++It )
+		for (int32 Index = 0; Index < ArrayDim; Index++)
 		{
-			for (int32 Index = 0; Index < ArrayDim; Index++)
+			uint8* DestElement = Dest + Index * Stride;
+			uint8 const* SrcElement = Src + Index * Stride;
+			for (const FStructPropertyOp& Op : CopyOps)
 			{
-				It->CopyCompleteValue_InContainer((uint8*)Dest + Index * Stride,(uint8*)Src + Index * Stride);
+				if (Op.NumSpanProperties)
+				{
+					FMemory::Memcpy(DestElement + Op.Offset, SrcElement + Op.Offset, Op.Size);
+				}
+				else
+				{
+					Op.Property->CopyCompleteValue_InContainer(DestElement, SrcElement);
+				}
 			}
 		}
 	}
@@ -2401,7 +2722,6 @@ void UScriptStruct::InitializeStruct(void* InDest, int32 ArrayDim) const
 
 	int32 Stride = GetStructureSize();
 
-	//@todo UE4 optimize
 	FMemory::Memzero(Dest, ArrayDim * Stride);
 
 	int32 InitializedSize = 0;
@@ -2423,19 +2743,16 @@ void UScriptStruct::InitializeStruct(void* InDest, int32 ArrayDim) const
 
 	if (PropertiesSize > InitializedSize)
 	{
-		bool bHitBase = false;
-		for (UProperty* Property = PropertyLink; Property && !bHitBase; Property = Property->PropertyLinkNext)
+		// Zero constructed properties are already initialized by the memzero above
+		for (UProperty* Property : NonZeroInitProperties)
 		{
-			if (!Property->IsInContainer(InitializedSize))
+			if (Property->IsInContainer(InitializedSize))
 			{
-				for (int32 ArrayIndex = 0; ArrayIndex < ArrayDim; ArrayIndex++)
-				{
-					Property->InitializeValue_InContainer(Dest + ArrayIndex * Stride);
-				}
+				break;
 			}
-			else
+			for (int32 ArrayIndex = 0; ArrayIndex < ArrayDim; ArrayIndex++)
 			{
-				bHitBase = true;
+				Property->InitializeValue_InContainer(Dest + ArrayIndex * Stride);
 			}
 		}
 	}
@@ -3736,6 +4053,9 @@ void UClass::PurgeClass(bool bRecompilingOnLoad)
 	RefLink = NULL;
 	PropertyLink = NULL;
 	DestructorLink = NULL;
+	SerializeOps.Empty();
+	CopyOps.Empty();
+	NonZeroInitProperties.Empty();
 	ClassAddReferencedObjects = NULL;
 
 	ScriptObjectReferences.Empty();
@@ -4862,6 +5182,151 @@ IMPLEMENT_CORE_INTRINSIC_CLASS(UDynamicClass, UClass,
 }
 );
 
+#if !UE_BUILD_SHIPPING
+class FStructPropertyOpsExec : private FSelfRegisteringExec
+{
+public:
+
+	/** Console commands **/
+	virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override
+	{
+		if (FParse::Command(&Cmd, TEXT("StructOpsBenchmark")))
+		{
+			RunBenchmark(Cmd, Ar);
+			return true;
+		}
+		return false;
+	}
+
+private:
+
+	/** Times SerializeBin, property initialization and property copies of each struct with the flattened ops and with a PropertyLink walk. */
+	void RunBenchmark(const TCHAR* Cmd, FOutputDevice& Ar)
+	{
+		int32 NumIterations = 10000;
+		FParse::Value(Cmd, TEXT("-Iterations="), NumIterations);
+		NumIterations = FMath::Max(NumIterations, 1);
+
+		TArray<FString> StructPaths;
+		FString Token;
+		while (FParse::Token(Cmd, Token, false))
+		{
+			if (!Token.StartsWith(TEXT("-")))
+			{
+				StructPaths.Add(Token);
+			}
+		}
+		if (StructPaths.Num() == 0)
+		{
+			StructPaths.Add(TEXT("/Script/CoreUObject.Transform"));
+			StructPaths.Add(TEXT("/Script/Engine.HitResult"));
+			StructPaths.Add(TEXT("/Script/Engine.BodyInstance"));
+			StructPaths.Add(TEXT("/Script/Engine.PostProcessSettings"));
+		}
+
+		for (const FString& StructPath : StructPaths)
+		{
+			UScriptStruct* Struct = FindObject<UScriptStruct>(nullptr, *StructPath);
+			if (!Struct)
+			{
+				Ar.Logf(TEXT("%s: not found."), *StructPath);
+				continue;
+			}
+
+			const int32 Size = Struct->GetStructureSize();
+			uint8* Src = (uint8*)FMemory::Malloc(Size, Struct->GetMinAlignment());
+			uint8* Dest = (uint8*)FMemory::Malloc(Size, Struct->GetMinAlignment());
+			Struct->InitializeStruct(Src);
+			Struct->InitializeStruct(Dest);
+
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				Writer.Seek(0);
+				for (UProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
+				{
+					Property->SerializeBinProperty(Writer, Src);
+				}
+			}
+			const double SerializeLinkTime = FPlatformTime::Seconds() - StartTime;
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				Writer.Seek(0);
+				Struct->SerializeBin(Writer, Src);
+			}
+			const double SerializeOpsTime = FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				Struct->DestroyStruct(Dest);
+				FMemory::Memzero(Dest, Size);
+				for (UProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
+				{
+					Property->InitializeValue_InContainer(Dest);
+				}
+			}
+			const double InitLinkTime = FPlatformTime::Seconds() - StartTime;
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				Struct->DestroyStruct(Dest);
+				Struct->UStruct::InitializeStruct(Dest);
+			}
+			const double InitOpsTime = FPlatformTime::Seconds() - StartTime;
+
+			// Copy through the properties even if the struct has a native copy, that's the path the ops replace
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (TFieldIterator<UProperty> It(Struct); It; ++It)
+				{
+					It->CopyCompleteValue_InContainer(Dest, Src);
+				}
+			}
+			const double CopyLinkTime = FPlatformTime::Seconds() - StartTime;
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (const FStructPropertyOp& Op : Struct->CopyOps)
+				{
+					if (Op.NumSpanProperties)
+					{
+						FMemory::Memcpy(Dest + Op.Offset, Src + Op.Offset, Op.Size);
+					}
+					else
+					{
+						Op.Property->CopyCompleteValue_InContainer(Dest, Src);
+					}
+				}
+			}
+			const double CopyOpsTime = FPlatformTime::Seconds() - StartTime;
+
+			Struct->DestroyStruct(Src);
+			Struct->DestroyStruct(Dest);
+			FMemory::Free(Src);
+			FMemory::Free(Dest);
+
+			int32 NumProperties = 0;
+			for (UProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
+			{
+				NumProperties++;
+			}
+			const double NsPerIteration = 1000000000.0 / NumIterations;
+			Ar.Logf(TEXT("%s: %d properties, %d serialize ops, %d copy ops, %d non zero init. SerializeBin %.1f -> %.1f ns, Init %.1f -> %.1f ns, Copy %.1f -> %.1f ns"),
+				*StructPath, NumProperties, Struct->SerializeOps.Num(), Struct->CopyOps.Num(), Struct->NonZeroInitProperties.Num(),
+				SerializeLinkTime * NsPerIteration, SerializeOpsTime * NsPerIteration,
+				InitLinkTime * NsPerIteration, InitOpsTime * NsPerIteration,
+				CopyLinkTime * NsPerIteration, CopyOpsTime * NsPerIteration);
+		}
+	}
+};
+static FStructPropertyOpsExec GStructPropertyOpsExec;
+#endif
+
 #if _MSC_VER == 1900
 	#ifdef PRAGMA_ENABLE_SHADOW_VARIABLE_WARNINGS
 		PRAGMA_ENABLE_SHADOW_VARIABLE_WARNINGS
@@ -679,6 +679,12 @@ void FReferenceFinder::HandleObjectReference( UObject*& InObject, const UObject*
 bool SetTokenStreamMaybeDirty(bool bDirty);
 bool IsTokenStreamDirty();
 
+bool BeginGenerationalCollection(bool bForceMajor);
+void EndGenerationalCollection();
+void DissolveOldGeneration();
+const TBitArray<>& GetOldGenerationBits();
+const TSet<int32>& GetGenerationalRememberedSet();
+
 /**
  * Implementation of parallel realtime garbage collector using recursive subdivision
  *
@@ -701,7 +707,7 @@ public:
 	 * This function is a template to speed up the case where we don't need to assemble the token stream (saves about 6ms on PS4)
 	 */
 	template <bool bAssembleTokenStream>
-	void MarkObjectsAsUnreachable(TArray<UObject*>& ObjectsToSerialize, const EObjectFlags KeepFlags)
+	void MarkObjectsAsUnreachable(TArray<UObject*>& ObjectsToSerialize, const EObjectFlags KeepFlags, const TBitArray<>* OldGenerationBits)
 	{
 		const EInternalObjectFlags FastKeepFlags = EInternalObjectFlags::GarbageCollectionKeepFlags;
 
@@ -728,8 +734,8 @@ public:
 				checkCode(if (ObjectItem->IsPendingKill()) { UE_LOG(LogGarbage, Fatal, TEXT("Object %s is part of root set though has been marked RF_PendingKill!"), *Object->GetFullName()); });
 				ObjectsToSerialize.Add(Object);
 			}
-			// Regular objects.
-			else if (ObjectItem->GetOwnerIndex() == 0)
+			// Regular objects, minor collections keep old objects without tracing them.
+			else if (ObjectItem->GetOwnerIndex() == 0 && !(OldGenerationBits && IsOldGenerationBitSet(*OldGenerationBits, It.GetIndex())))
 			{
 				bool bMarkAsUnreachable = true;
 				if (!ObjectItem->IsPendingKill())
@@ -753,6 +759,13 @@ public:
 					checkSlow(Object->IsValidLowLevel());
 					ObjectsToSerialize.Add(Object);
 				}
+				// Old objects aren't traced by minor collections and usually reference young objects they own through
+				// natively updated properties (e.g. actors spawned into a level) so those are treated as roots.
+				else if (OldGenerationBits && !ObjectItem->IsPendingKill() && Object->GetOuter() && !GUObjectAllocator.ResidesInPermanentPool(Object->GetOuter()) &&
+					IsOldGenerationBitSet(*OldGenerationBits, GUObjectArray.ObjectToIndex(Object->GetOuter())))
+				{
+					ObjectsToSerialize.Add(Object);
+				}
 				else
 				{
 					ObjectItem->SetFlags(EInternalObjectFlags::Unreachable | EInternalObjectFlags::NoStrongReference);
@@ -775,12 +788,18 @@ public:
 		}
 	}
 
+	static FORCEINLINE bool IsOldGenerationBitSet(const TBitArray<>& OldGenerationBits, int32 ObjectIndex)
+	{
+		return ObjectIndex < OldGenerationBits.Num() && OldGenerationBits[ObjectIndex];
+	}
+
 	/**
 	 * Performs reachability analysis.
 	 *
 	 * @param KeepFlags		Objects with these flags will be kept regardless of being referenced or not
+	 * @param bMinorCollection	If true, objects in the old generation are kept and only their remembered references are traced
 	 */
-	void PerformReachabilityAnalysis(EObjectFlags KeepFlags, bool bForceSingleThreaded = false)
+	void PerformReachabilityAnalysis(EObjectFlags KeepFlags, bool bForceSingleThreaded = false, bool bMinorCollection = false)
 	{		
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FRealtimeGC::PerformReachabilityAnalysis"), STAT_FArchiveRealtimeGC_PerformReachabilityAnalysis, STATGROUP_GC);
 
@@ -798,14 +817,27 @@ public:
 			ObjectsToSerialize.Add(FGCObject::GGCObjectReferencer);
 		}
 
+		const TBitArray<>* OldGenerationBits = bMinorCollection ? &GetOldGenerationBits() : nullptr;
 		if (!IsTokenStreamDirty())
 		{
-			MarkObjectsAsUnreachable<false>(ObjectsToSerialize, KeepFlags);
+			MarkObjectsAsUnreachable<false>(ObjectsToSerialize, KeepFlags, OldGenerationBits);
 		}
 		else
 		{
 			SetTokenStreamMaybeDirty(false);
-			MarkObjectsAsUnreachable<true>(ObjectsToSerialize, KeepFlags);
+			MarkObjectsAsUnreachable<true>(ObjectsToSerialize, KeepFlags, OldGenerationBits);
+		}
+
+		if (bMinorCollection)
+		{
+			// Young objects referenced by old objects are roots. Old objects aren't traced so their references to
+			// PendingKill objects can't be nulled, those objects are kept until the next major collection.
+			FGCReferenceProcessor ReferenceProcessor;
+			for (int32 ObjectIndex : GetGenerationalRememberedSet())
+			{
+				UObject* Object = static_cast<UObject*>(GUObjectArray.IndexToObjectUnsafeForGC(ObjectIndex)->Object);
+				ReferenceProcessor.HandleObjectReference(ObjectsToSerialize, nullptr, Object, false);
+			}
 		}
 
 		{
@@ -822,6 +854,715 @@ public:
 	}
 };
 
+/*----------------------------------------------------------------------------
+	Incremental reachability analysis.
+----------------------------------------------------------------------------*/
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Incremental Reachability Slices"), STAT_GCIncrementalReachabilitySlices, STATGROUP_GC);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Incremental Reachability Worst Slice (ms)"), STAT_GCIncrementalReachabilityWorstSlice, STATGROUP_GC);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Incremental Reachability Final Slice (ms)"), STAT_GCIncrementalReachabilityFinalSlice, STATGROUP_GC);
+
+static int32 GIncrementalReachability = 0;
+static FAutoConsoleVariableRef CVarIncrementalReachability(
+	TEXT("gc.IncrementalReachability"),
+	GIncrementalReachability,
+	TEXT("If enabled, reachability analysis is spread across frames instead of blocking for the whole mark phase (ignored in the editor).\n") \
+	TEXT("Native code that stores object references in existing objects has to call GarbageCollectionWriteBarrier."),
+	ECVF_Default
+	);
+
+static float GIncrementalReachabilityTimeLimit = 2.0f;
+static FAutoConsoleVariableRef CVarIncrementalReachabilityTimeLimit(
+	TEXT("gc.IncrementalReachabilityTimeLimit"),
+	GIncrementalReachabilityTimeLimit,
+	TEXT("Time budget in milliseconds for each incremental reachability analysis slice."),
+	ECVF_Default
+	);
+
+COREUOBJECT_API bool GIsIncrementalReachabilityPending = false;
+
+/** Number of objects taken from the gray list between time limit checks */
+static const int32 GIncrementalReachabilityObjectsPerBatch = 64;
+
+/**
+ * Whether an object is reachable regardless of being referenced, same as the root set and kept objects
+ * FRealtimeGC::MarkObjectsAsUnreachable adds to the initial list of objects to serialize.
+ */
+static FORCEINLINE bool IsIncrementalReachabilityRoot(FUObjectItem* ObjectItem, EObjectFlags KeepFlags)
+{
+	if (ObjectItem->IsRootSet())
+	{
+		return true;
+	}
+	if (ObjectItem->GetOwnerIndex() != 0 || ObjectItem->IsPendingKill())
+	{
+		return false;
+	}
+	return ObjectItem->HasAnyFlags(EInternalObjectFlags::GarbageCollectionKeepFlags) ||
+		(KeepFlags != RF_NoFlags && static_cast<UObject*>(ObjectItem->Object)->HasAnyFlags(KeepFlags));
+}
+
+/**
+ * Handles UObject references found by TFastReferenceCollector during incremental reachability analysis.
+ *
+ * Unlike FGCReferenceProcessor this doesn't touch EInternalObjectFlags::Unreachable while the cycle is in progress so
+ * gameplay code keeps seeing valid objects. Reached objects are tracked in side bitmaps indexed by object index and
+ * newly reached objects go to a gray list that's scanned a batch at a time. The flags are only set when the cycle finishes.
+ */
+class FIncrementalReachabilityProcessor
+{
+public:
+
+	FIncrementalReachabilityProcessor()
+		: GrayObjects(nullptr)
+	{
+	}
+
+	FORCEINLINE int32 GetMinDesiredObjectsPerSubTask() const
+	{
+		return GMinDesiredObjectsPerSubTask;
+	}
+
+	/** Slices always run on the game thread, sub tasks are never spawned */
+	FORCEINLINE volatile bool IsRunningMultithreaded() const
+	{
+		return false;
+	}
+
+	FORCEINLINE void SetIsRunningMultithreaded(bool bIsParallel)
+	{
+		check(!bIsParallel);
+	}
+
+	void UpdateDetailedStats(UObject* CurrentObject, uint32 DeltaCycles)
+	{
+	}
+
+	void LogDetailedStatsSummary()
+	{
+	}
+
+	/** Prepares the bitmaps and the gray list for a new cycle */
+	void Init()
+	{
+		check(!GrayObjects);
+		GrayObjects = FGCArrayPool::Get().GetArrayFromPool();
+		ReachableBits.Init(false, GUObjectArray.GetObjectArrayNum());
+		StrongBits.Init(false, GUObjectArray.GetObjectArrayNum());
+	}
+
+	/** Releases all memory used by the current cycle */
+	void Release()
+	{
+		if (GrayObjects)
+		{
+			FGCArrayPool::Get().ReturnToPool(GrayObjects);
+			GrayObjects = nullptr;
+		}
+		ReachableBits.Empty();
+		StrongBits.Empty();
+	}
+
+	FORCEINLINE TArray<UObject*>& GetGrayObjects()
+	{
+		return *GrayObjects;
+	}
+
+	FORCEINLINE bool IsReachable(int32 ObjectIndex) const
+	{
+		return ObjectIndex < ReachableBits.Num() && ReachableBits[ObjectIndex];
+	}
+
+	FORCEINLINE bool IsStronglyReachable(int32 ObjectIndex) const
+	{
+		return ObjectIndex < StrongBits.Num() && StrongBits[ObjectIndex];
+	}
+
+	/** Marks a root set or kept object and queues it for scanning */
+	void MarkRoot(int32 ObjectIndex, FUObjectItem* ObjectItem)
+	{
+		GrowBits(ObjectIndex);
+		StrongBits[ObjectIndex] = true;
+		if (!ReachableBits[ObjectIndex])
+		{
+			ReachableBits[ObjectIndex] = true;
+			GrayObjects->Add(static_cast<UObject*>(ObjectItem->Object));
+		}
+	}
+
+	/**
+	 * Marks a referenced object. Objects that are part of a cluster mark their cluster root instead, cluster roots
+	 * mark the clusters they reference and everything else is queued for scanning.
+	 */
+	void MarkObject(int32 ObjectIndex, FUObjectItem* ObjectItem, bool bStrongReference)
+	{
+		GrowBits(ObjectIndex);
+		if (bStrongReference)
+		{
+			StrongBits[ObjectIndex] = true;
+		}
+		if (ObjectItem->GetOwnerIndex())
+		{
+			if (!ObjectItem->HasAnyFlags(EInternalObjectFlags::ReachableInCluster))
+			{
+				ObjectItem->SetFlags(EInternalObjectFlags::ReachableInCluster);
+				MarkClusterRoot(ObjectItem->GetOwnerIndex());
+			}
+		}
+		else if (!ReachableBits[ObjectIndex])
+		{
+			ReachableBits[ObjectIndex] = true;
+			if (ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot))
+			{
+				MarkReferencedClusters(ObjectIndex);
+			}
+			else
+			{
+				GrayObjects->Add(static_cast<UObject*>(ObjectItem->Object));
+			}
+		}
+	}
+
+	/** Makes sure the root of a cluster an already reached object has been added to since it was marked is reachable too */
+	void MarkClusterMember(int32 ObjectIndex, FUObjectItem* ObjectItem)
+	{
+		checkSlow(ObjectItem->GetOwnerIndex());
+		ObjectItem->SetFlags(EInternalObjectFlags::ReachableInCluster);
+		MarkClusterRoot(ObjectItem->GetOwnerIndex());
+	}
+
+	/**
+	 * Handles object reference, potentially NULL'ing
+	 *
+	 * @param Object						Object pointer passed by reference
+	 * @param bAllowReferenceElimination	Whether to allow NULL'ing the reference if RF_PendingKill is set
+	 * @param bStrongReference				Whether this is a strong reference
+	 */
+	FORCEINLINE void HandleObjectReference(UObject*& Object, const bool bAllowReferenceElimination, const bool bStrongReference)
+	{
+		if (Object == nullptr || GUObjectAllocator.ResidesInPermanentPool(Object))
+		{
+			return;
+		}
+
+		const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Object);
+		FUObjectItem* ObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ObjectIndex);
+		// Remove references to pending kill objects if we're allowed to do so.
+		if (ObjectItem->IsPendingKill() && bAllowReferenceElimination)
+		{
+			Object = nullptr;
+		}
+		else
+		{
+			MarkObject(ObjectIndex, ObjectItem, bStrongReference);
+		}
+	}
+
+	FORCEINLINE void HandleTokenStreamObjectReference(TArray<UObject*>& ObjectsToSerialize, UObject* ReferencingObject, UObject*& Object, const int32 TokenIndex, bool bAllowReferenceElimination)
+	{
+		HandleObjectReference(Object, bAllowReferenceElimination, true);
+	}
+
+private:
+
+	/** Objects created since the cycle started don't have bits yet */
+	FORCEINLINE void GrowBits(int32 ObjectIndex)
+	{
+		while (ReachableBits.Num() <= ObjectIndex)
+		{
+			ReachableBits.Add(false);
+			StrongBits.Add(false);
+		}
+	}
+
+	void MarkClusterRoot(int32 ClusterRootIndex)
+	{
+		GrowBits(ClusterRootIndex);
+		StrongBits[ClusterRootIndex] = true;
+		if (!ReachableBits[ClusterRootIndex])
+		{
+			ReachableBits[ClusterRootIndex] = true;
+			MarkReferencedClusters(ClusterRootIndex);
+		}
+	}
+
+	/** Marks all objects that can't be directly in a cluster but are referenced by it as reachable */
+	void MarkClusterMutableObjects(FUObjectCluster* Cluster)
+	{
+		for (int32 MutableObjectIndex : Cluster->MutableObjects)
+		{
+			GrowBits(MutableObjectIndex);
+			StrongBits[MutableObjectIndex] = true;
+			if (!ReachableBits[MutableObjectIndex])
+			{
+				ReachableBits[MutableObjectIndex] = true;
+				GrayObjects->Add(static_cast<UObject*>(GUObjectArray.IndexToObjectUnsafeForGC(MutableObjectIndex)->Object));
+			}
+		}
+	}
+
+	/** Marks all clusters referenced by another cluster as reachable */
+	void MarkReferencedClusters(int32 ClusterRootIndex)
+	{
+		FUObjectCluster* Cluster = GUObjectClusters.FindChecked(ClusterRootIndex);
+		MarkClusterMutableObjects(Cluster);
+		for (int32 ReferencedClusterIndex : Cluster->ReferencedClusters)
+		{
+			GrowBits(ReferencedClusterIndex);
+			StrongBits[ReferencedClusterIndex] = true;
+			if (!ReachableBits[ReferencedClusterIndex])
+			{
+				ReachableBits[ReferencedClusterIndex] = true;
+				MarkClusterMutableObjects(GUObjectClusters.FindChecked(ReferencedClusterIndex));
+			}
+		}
+	}
+
+	/** Objects that have been reached but not scanned yet */
+	TArray<UObject*>* GrayObjects;
+	/** One bit per object index, set when the object has been reached */
+	TBitArray<> ReachableBits;
+	/** One bit per object index, set when the object has been reached through a strong reference */
+	TBitArray<> StrongBits;
+};
+
+/**
+ * Specialized FReferenceCollector that uses FIncrementalReachabilityProcessor to mark objects as reachable.
+ */
+class FIncrementalReachabilityCollector : public FReferenceCollector
+{
+	FIncrementalReachabilityProcessor& ReferenceProcessor;
+	bool bAllowEliminatingReferences;
+	bool bShouldHandleAsWeakRef;
+
+public:
+
+	FIncrementalReachabilityCollector(FIncrementalReachabilityProcessor& InProcessor, TArray<UObject*>& InObjectArray)
+		: ReferenceProcessor(InProcessor)
+		, bAllowEliminatingReferences(true)
+		, bShouldHandleAsWeakRef(false)
+	{
+	}
+
+	virtual void HandleObjectReference(UObject*& Object, const UObject* ReferencingObject, const UProperty* ReferencingProperty) override
+	{
+		ReferenceProcessor.HandleObjectReference(Object, bAllowEliminatingReferences, !bShouldHandleAsWeakRef);
+	}
+	virtual void HandleObjectReferences(UObject** InObjects, const int32 ObjectNum, const UObject* InReferencingObject, const UProperty* InReferencingProperty) override
+	{
+		for (int32 ObjectIndex = 0; ObjectIndex < ObjectNum; ++ObjectIndex)
+		{
+			ReferenceProcessor.HandleObjectReference(InObjects[ObjectIndex], bAllowEliminatingReferences, !bShouldHandleAsWeakRef);
+		}
+	}
+
+	virtual bool IsIgnoringArchetypeRef() const override
+	{
+		return false;
+	}
+	virtual bool IsIgnoringTransient() const override
+	{
+		return false;
+	}
+	virtual void AllowEliminatingReferences(bool bAllow) override
+	{
+		bAllowEliminatingReferences = bAllow;
+	}
+
+	virtual void SetShouldHandleAsWeakRef(bool bWeakRef) override
+	{
+		bShouldHandleAsWeakRef = bWeakRef;
+	}
+};
+
+/**
+ * Time sliced version of FRealtimeGC::PerformReachabilityAnalysis.
+ *
+ * A cycle gathers the root set in slices, then scans the gray list in batches until it's empty. Objects created while
+ * the cycle is in progress are always kept. GarbageCollectionWriteBarrier reports objects that had references stored
+ * in them, each slice scans the reported objects that were already reached again. Finish runs atomically: it marks new
+ * roots and cluster members, scans the objects reported since the last slice and the GC object referencer, drains
+ * everything still queued and sets the unreachable flags like the blocking mark phase would.
+ */
+class FIncrementalRealtimeGC : public FUObjectArray::FUObjectCreateListener
+{
+	enum class EPhase
+	{
+		Idle,
+		GatherRoots,
+		Mark,
+	};
+
+public:
+
+	/** Gets the singleton instance */
+	static FIncrementalRealtimeGC& Get()
+	{
+		static FIncrementalRealtimeGC Singleton;
+		return Singleton;
+	}
+
+	FIncrementalRealtimeGC()
+		: Phase(EPhase::Idle)
+		, KeepFlags(RF_NoFlags)
+		, GatherIndex(0)
+		, NumSlices(0)
+		, WorstSliceTime(0.0)
+		, TotalSliceTime(0.0)
+	{
+	}
+
+	FORCEINLINE bool IsPending() const
+	{
+		return Phase != EPhase::Idle;
+	}
+
+	/** Starts a new cycle. Must be called with GC locked and no purge pending. */
+	void Start(EObjectFlags InKeepFlags)
+	{
+		check(!IsPending());
+		check(!GObjIncrementalPurgeIsInProgress && !GObjPurgeIsRequired);
+
+		Phase = EPhase::GatherRoots;
+		KeepFlags = InKeepFlags;
+		GatherIndex = GUObjectArray.GetObjectArrayNumPermanent();
+		NumSlices = 0;
+		WorstSliceTime = 0.0;
+		TotalSliceTime = 0.0;
+
+		// Incremental cycles trace old objects like any other and don't keep the remembered set up to date
+		DissolveOldGeneration();
+
+		Processor.Init();
+		GUObjectArray.AddUObjectCreateListener(this);
+		GIsIncrementalReachabilityPending = true;
+	}
+
+	/** Throws away the current cycle, a blocking collection supersedes it */
+	void Abort()
+	{
+		if (IsPending())
+		{
+			UE_LOG(LogGarbage, Log, TEXT("Incremental reachability analysis aborted after %d slices."), NumSlices);
+			Stop();
+		}
+	}
+
+	/**
+	 * Runs one slice of the current cycle.
+	 *
+	 * @param StartTime Time the slice started at
+	 * @param TimeLimit Soft time limit for the slice
+	 * @return true if there is nothing left to scan and the cycle can be finished
+	 */
+	bool Advance(double StartTime, double TimeLimit)
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FIncrementalRealtimeGC::Advance"), STAT_FIncrementalRealtimeGC_Advance, STATGROUP_GC);
+		check(IsPending());
+
+		if (Phase == EPhase::GatherRoots)
+		{
+			if (!GatherRoots(StartTime, TimeLimit))
+			{
+				return false;
+			}
+			Phase = EPhase::Mark;
+		}
+
+		MarkPendingObjects();
+		RescanDirtyObjects();
+		return ScanGrayObjects(StartTime, TimeLimit);
+	}
+
+	/**
+	 * Finishes the current cycle without a time limit and sets EInternalObjectFlags::Unreachable and NoStrongReference
+	 * on all objects that haven't been reached.
+	 *
+	 * @return Number of objects checked
+	 */
+	int32 Finish()
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FIncrementalRealtimeGC::Finish"), STAT_FIncrementalRealtimeGC_Finish, STATGROUP_GC);
+		check(IsPending());
+
+		// Roots may have changed since they were gathered and objects may have been moved in or out of clusters
+		Phase = EPhase::Mark;
+		MarkPendingObjects();
+		for (FRawObjectIterator It(true); It; ++It)
+		{
+			FUObjectItem* ObjectItem = *It;
+			const int32 ObjectIndex = It.GetIndex();
+			if (IsIncrementalReachabilityRoot(ObjectItem, KeepFlags))
+			{
+				Processor.MarkRoot(ObjectIndex, ObjectItem);
+			}
+			else if (ObjectItem->GetOwnerIndex())
+			{
+				if (Processor.IsReachable(ObjectIndex) || ObjectItem->HasAnyFlags(EInternalObjectFlags::ReachableInCluster))
+				{
+					Processor.MarkClusterMember(ObjectIndex, ObjectItem);
+				}
+			}
+			else if (ObjectItem->HasAnyFlags(EInternalObjectFlags::ReachableInCluster))
+			{
+				Processor.MarkObject(ObjectIndex, ObjectItem, true);
+			}
+		}
+		// Only objects written to since they were scanned need another look. FGCObjects report their references
+		// natively without a barrier, so the referencer is always scanned again.
+		RescanDirtyObjects();
+		if (FGCObject::GGCObjectReferencer)
+		{
+			Processor.GetGrayObjects().Add(FGCObject::GGCObjectReferencer);
+		}
+		ScanGrayObjects(0.0, 0.0);
+		check(Processor.GetGrayObjects().Num() == 0);
+
+		int32 ObjectCount = 0;
+		for (FRawObjectIterator It(true); It; ++It)
+		{
+			FUObjectItem* ObjectItem = *It;
+			const int32 ObjectIndex = It.GetIndex();
+			ObjectCount++;
+			if (ObjectItem->GetOwnerIndex() == 0 && !ObjectItem->IsRootSet())
+			{
+				if (!Processor.IsReachable(ObjectIndex))
+				{
+					ObjectItem->SetFlags(EInternalObjectFlags::Unreachable | EInternalObjectFlags::NoStrongReference);
+				}
+				else if (!Processor.IsStronglyReachable(ObjectIndex))
+				{
+					ObjectItem->SetFlags(EInternalObjectFlags::NoStrongReference);
+				}
+			}
+		}
+
+		Stop();
+		return ObjectCount;
+	}
+
+	/** Queues an object referenced by a write the current cycle may have missed */
+	void MarkObjectReferenced(const UObject* Object)
+	{
+		if (!GUObjectAllocator.ResidesInPermanentPool(Object))
+		{
+			FScopeLock PendingLock(&PendingObjectsCritical);
+			PendingObjectIndices.Add(GUObjectArray.ObjectToIndex(Object));
+		}
+	}
+
+	/** Queues an object that had references stored in it for another scan, if it was reached */
+	void MarkObjectDirty(const UObject* Object)
+	{
+		if (GUObjectAllocator.ResidesInPermanentPool(Object))
+		{
+			return;
+		}
+		const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Object);
+		FScopeLock PendingLock(&PendingObjectsCritical);
+		// The cycle may have finished since the caller checked GIsIncrementalReachabilityPending
+		if (!GIsIncrementalReachabilityPending)
+		{
+			return;
+		}
+		while (DirtyBits.Num() <= ObjectIndex)
+		{
+			DirtyBits.Add(false);
+		}
+		if (!DirtyBits[ObjectIndex])
+		{
+			DirtyBits[ObjectIndex] = true;
+			DirtyObjectIndices.Add(ObjectIndex);
+		}
+	}
+
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override
+	{
+		// Object isn't constructed yet, it's marked when the next slice starts
+		FScopeLock PendingLock(&PendingObjectsCritical);
+		PendingObjectIndices.Add(Index);
+	}
+
+	/** Updates the slice stats and logs a summary when the cycle is finished */
+	void RecordSlice(double SliceTime, bool bFinished)
+	{
+		NumSlices++;
+		WorstSliceTime = FMath::Max(WorstSliceTime, SliceTime);
+		TotalSliceTime += SliceTime;
+		if (bFinished)
+		{
+			SET_DWORD_STAT(STAT_GCIncrementalReachabilitySlices, NumSlices);
+			SET_FLOAT_STAT(STAT_GCIncrementalReachabilityWorstSlice, WorstSliceTime * 1000.0);
+			SET_FLOAT_STAT(STAT_GCIncrementalReachabilityFinalSlice, SliceTime * 1000.0);
+			UE_LOG(LogGarbage, Log, TEXT("Incremental reachability analysis finished in %d slices: %f ms worst slice, %f ms final slice, %f ms total"),
+				NumSlices, WorstSliceTime * 1000.0, SliceTime * 1000.0, TotalSliceTime * 1000.0);
+		}
+	}
+
+private:
+
+	void Stop()
+	{
+		GIsIncrementalReachabilityPending = false;
+		GUObjectArray.RemoveUObjectCreateListener(this);
+		{
+			FScopeLock PendingLock(&PendingObjectsCritical);
+			PendingObjectIndices.Empty();
+			DirtyObjectIndices.Empty();
+			DirtyBits.Empty();
+		}
+		Processor.Release();
+		Phase = EPhase::Idle;
+	}
+
+	/** Resumes iterating over GUObjectArray, returns true once all roots have been gathered */
+	bool GatherRoots(double StartTime, double TimeLimit)
+	{
+		const int32 TimeLimitEnforcementGranularity = 1024;
+		int32 TimePollCounter = 0;
+		for (; GatherIndex < GUObjectArray.GetObjectArrayNum(); ++GatherIndex)
+		{
+			FUObjectItem* ObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(GatherIndex);
+			if (ObjectItem->Object)
+			{
+				ObjectItem->ClearFlags(EInternalObjectFlags::ReachableInCluster);
+				if (IsIncrementalReachabilityRoot(ObjectItem, KeepFlags))
+				{
+					Processor.MarkRoot(GatherIndex, ObjectItem);
+				}
+			}
+			if (++TimePollCounter == TimeLimitEnforcementGranularity)
+			{
+				TimePollCounter = 0;
+				if ((FPlatformTime::Seconds() - StartTime) > TimeLimit)
+				{
+					++GatherIndex;
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	/** Marks objects reported by GarbageCollectionStoredReferenceBarrier and objects created since the last slice */
+	void MarkPendingObjects()
+	{
+		TArray<int32> ObjectIndices;
+		{
+			FScopeLock PendingLock(&PendingObjectsCritical);
+			Exchange(ObjectIndices, PendingObjectIndices);
+		}
+		for (int32 ObjectIndex : ObjectIndices)
+		{
+			FUObjectItem* ObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ObjectIndex);
+			if (ObjectItem->Object)
+			{
+				Processor.MarkObject(ObjectIndex, ObjectItem, true);
+			}
+		}
+	}
+
+	/** Queues the objects reported by the write barrier since the last slice for another scan */
+	void RescanDirtyObjects()
+	{
+		TArray<int32> ObjectIndices;
+		{
+			FScopeLock PendingLock(&PendingObjectsCritical);
+			Exchange(ObjectIndices, DirtyObjectIndices);
+			for (int32 ObjectIndex : ObjectIndices)
+			{
+				DirtyBits[ObjectIndex] = false;
+			}
+		}
+		TArray<UObject*>& GrayObjects = Processor.GetGrayObjects();
+		for (int32 ObjectIndex : ObjectIndices)
+		{
+			// Objects that haven't been reached are scanned when they are, cluster references are tracked by the cluster
+			FUObjectItem* ObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ObjectIndex);
+			if (ObjectItem->Object && Processor.IsReachable(ObjectIndex) &&
+				ObjectItem->GetOwnerIndex() == 0 && !ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot))
+			{
+				GrayObjects.Add(static_cast<UObject*>(ObjectItem->Object));
+			}
+		}
+	}
+
+	/**
+	 * Scans gray objects a batch at a time until the list is empty or the time limit is reached.
+	 *
+	 * @param TimeLimit Soft time limit, 0 to scan everything
+	 * @return true if the gray list is empty
+	 */
+	bool ScanGrayObjects(double StartTime, double TimeLimit)
+	{
+		TArray<UObject*>& GrayObjects = Processor.GetGrayObjects();
+		TArray<UObject*>& Batch = *FGCArrayPool::Get().GetArrayFromPool();
+		TFastReferenceCollector<FIncrementalReachabilityProcessor, FIncrementalReachabilityCollector, FGCArrayPool, true> ReferenceCollector(Processor, FGCArrayPool::Get());
+
+		while (GrayObjects.Num())
+		{
+			const int32 NumToScan = FMath::Min(GrayObjects.Num(), GIncrementalReachabilityObjectsPerBatch);
+			const int32 FirstToScan = GrayObjects.Num() - NumToScan;
+			Batch.Append(GrayObjects.GetData() + FirstToScan, NumToScan);
+			GrayObjects.RemoveAt(FirstToScan, NumToScan, false);
+
+			ReferenceCollector.CollectReferences(Batch, true);
+			Batch.Reset();
+
+			if (TimeLimit > 0.0 && (FPlatformTime::Seconds() - StartTime) > TimeLimit)
+			{
+				break;
+			}
+		}
+
+		FGCArrayPool::Get().ReturnToPool(&Batch);
+		return GrayObjects.Num() == 0;
+	}
+
+	/** Current phase of the cycle */
+	EPhase Phase;
+	/** Keep flags the cycle was started with */
+	EObjectFlags KeepFlags;
+	/** Next object index to gather roots from */
+	int32 GatherIndex;
+	/** Marking state */
+	FIncrementalReachabilityProcessor Processor;
+	/** Indices of objects reported by GarbageCollectionStoredReferenceBarrier or created since the last slice */
+	TArray<int32> PendingObjectIndices;
+	/** Indices of objects reported by GarbageCollectionWriteBarrier since the last slice */
+	TArray<int32> DirtyObjectIndices;
+	/** One bit per object index, set while the object is in DirtyObjectIndices */
+	TBitArray<> DirtyBits;
+	/** Guards PendingObjectIndices, DirtyObjectIndices and DirtyBits, objects may be created or written to on any thread */
+	FCriticalSection PendingObjectsCritical;
+	/** Slice stats for the current cycle */
+	int32 NumSlices;
+	double WorstSliceTime;
+	double TotalSliceTime;
+};
+
+void MarkObjectForIncrementalReachability(const UObject* Object)
+{
+	check(Object);
+	FIncrementalRealtimeGC::Get().MarkObjectReferenced(Object);
+}
+
+void MarkObjectDirtyForIncrementalReachability(const UObject* Object)
+{
+	check(Object);
+	FIncrementalRealtimeGC::Get().MarkObjectDirty(Object);
+}
+
+bool IsIncrementalReachabilityAnalysisEnabled()
+{
+	return GIncrementalReachability != 0 && !GIsEditor;
+}
+
+bool IsIncrementalReachabilityAnalysisPending()
+{
+	return GIsIncrementalReachabilityPending;
+}
+
 /**
  * Incrementally purge garbage by deleting all unreferenced objects after routing Destroy.
  *
@@ -1094,6 +1835,9 @@ bool IsIncrementalPurgePending()
 typedef void (*EditorPostReachabilityAnalysisCallbackType)();
 COREUOBJECT_API EditorPostReachabilityAnalysisCallbackType EditorPostReachabilityAnalysisCallback = NULL;
 
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Minor GC Reachability Time (ms)"), STAT_GCMinorCollectionTime, STATGROUP_GC);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Major GC Reachability Time (ms)"), STAT_GCMajorCollectionTime, STATGROUP_GC);
+
 // Allow parallel GC to be overridden to single threaded via console command.
 static int32 GAllowParallelGC = (!PLATFORM_MAC || !WITH_EDITORONLY_DATA) ? 1 : 0;
 static FAutoConsoleVariableRef CVarAllowParallelGC(
@@ -1131,8 +1875,9 @@ bool VerifyClusterAssumptions(UObject* ClusterRootObject);
  *
  * @param	KeepFlags			objects with those flags will be kept regardless of being referenced or not
  * @param	bPerformFullPurge	if true, perform a full purge after the mark pass
+ * @param	bFinishIncrementalReachability	if true, finish the pending incremental reachability analysis instead of running a blocking one
  */
-void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge)
+void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge, bool bFinishIncrementalReachability = false)
 {
 	DECLARE_SCOPE_CYCLE_COUNTER( TEXT( "CollectGarbageInternal" ), STAT_CollectGarbageInternal, STATGROUP_GC );
 	STAT_ADD_CUSTOMMESSAGE_NAME( STAT_NamedMarker, TEXT( "GarbageCollection - Begin" ) );
@@ -1234,12 +1979,35 @@ void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge)
 		true;
 #endif	//PLATFORM_SUPPORTS_MULTITHREADED_GC
 
+	// Minor collections only trace young objects, full purges always perform a major collection
+	const bool bMinorCollection = BeginGenerationalCollection(bPerformFullPurge || bFinishIncrementalReachability);
+
 	// Perform reachability analysis.
+	if (bFinishIncrementalReachability)
 	{
+		const double StartTime = FPlatformTime::Seconds();
+		GObjectCountDuringLastMarkPhase = FIncrementalRealtimeGC::Get().Finish();
+		UE_LOG(LogGarbage, Log, TEXT("%f ms for finishing incremental GC"), (FPlatformTime::Seconds() - StartTime) * 1000 );
+	}
+	else
+	{
+		// A blocking collection supersedes any pending incremental one
+		FIncrementalRealtimeGC::Get().Abort();
+
 		const double StartTime = FPlatformTime::Seconds();
 		FRealtimeGC TagUsedRealtimeGC;
-		TagUsedRealtimeGC.PerformReachabilityAnalysis( KeepFlags, bForceSingleThreadedGC );
-		UE_LOG(LogGarbage, Log, TEXT("%f ms for GC"), (FPlatformTime::Seconds() - StartTime) * 1000 );
+		TagUsedRealtimeGC.PerformReachabilityAnalysis( KeepFlags, bForceSingleThreadedGC, bMinorCollection );
+		const double ElapsedTime = (FPlatformTime::Seconds() - StartTime) * 1000;
+		if (bMinorCollection)
+		{
+			SET_FLOAT_STAT(STAT_GCMinorCollectionTime, ElapsedTime);
+			UE_LOG(LogGarbage, Log, TEXT("%f ms for minor GC"), ElapsedTime );
+		}
+		else
+		{
+			SET_FLOAT_STAT(STAT_GCMajorCollectionTime, ElapsedTime);
+			UE_LOG(LogGarbage, Log, TEXT("%f ms for GC"), ElapsedTime );
+		}
 	}
 
 #if WITH_EDITOR
@@ -1304,6 +2072,9 @@ void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge)
 		UE_LOG(LogGarbage, Log, TEXT("%f ms for unhashing unreachable objects. Clusters removed: %d."), (FPlatformTime::Seconds() - StartTime) * 1000, ClustersRemoved);
 	}
 
+	// Promote objects that survived enough collections to the old generation
+	EndGenerationalCollection();
+
 	// Set flag to indicate that we are relying on a purge to be performed.
 	GObjPurgeIsRequired = true;
 	// Reset purged count.
@@ -1365,6 +2136,48 @@ bool TryCollectGarbage(EObjectFlags KeepFlags, bool bPerformFullPurge)
 	return bCanRunGC;
 }
 
+bool TryCollectGarbageIncremental(EObjectFlags KeepFlags, float TimeLimit)
+{
+	// Slices are skipped, never forced, while other threads hold a lock on GC
+	if (!GGarbageCollectionGuardCritical.TryGCLock())
+	{
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double SliceTimeLimit = TimeLimit > 0.0f ? TimeLimit : GIncrementalReachabilityTimeLimit * 0.001f;
+	FIncrementalRealtimeGC& IncrementalGC = FIncrementalRealtimeGC::Get();
+	bool bFinished = false;
+
+	if (!IncrementalGC.IsPending() && (GObjIncrementalPurgeIsInProgress || GObjPurgeIsRequired))
+	{
+		// Unreachable objects from the last collection have to be gone before a new cycle can start
+		IncrementalPurgeGarbage(true, SliceTimeLimit);
+	}
+	else
+	{
+		if (!IncrementalGC.IsPending())
+		{
+			IncrementalGC.Start(KeepFlags);
+		}
+
+		bool bMarkingComplete = false;
+		{
+			FGCScopeLock GCLock;
+			bMarkingComplete = IncrementalGC.Advance(StartTime, SliceTimeLimit);
+		}
+		if (bMarkingComplete)
+		{
+			CollectGarbageInternal(KeepFlags, false, true);
+			bFinished = true;
+		}
+		IncrementalGC.RecordSlice(FPlatformTime::Seconds() - StartTime, bFinished);
+	}
+
+	GGarbageCollectionGuardCritical.GCUnlock();
+	return bFinished;
+}
+
 
 /**
  * Helper function to add referenced objects via serialization
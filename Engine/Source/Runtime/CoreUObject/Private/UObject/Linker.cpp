@@ -77,6 +77,15 @@ void FGenerationInfo::Serialize(FArchive& Ar, const struct FPackageFileSummary&
 	Ar << ExportCount << NameCount;
 }
 
+/** I/O function */
+FArchive& operator<<(FArchive& Ar, FPackageDependencyGraph& Graph)
+{
+	Ar << Graph.ImportOrder;
+	Ar << Graph.ImportClassIndices;
+	Ar << Graph.ExportOrder;
+	return Ar;
+}
+
 #if WITH_EDITORONLY_DATA
 extern int32 GLinkerAllowDynamicClasses;
 #endif
@@ -138,6 +147,7 @@ void FLinker::Serialize( FArchive& Ar )
 		Ar << ImportMap;
 		Ar << ExportMap;
 		Ar << DependsMap;
+		Ar << DependencyGraph;
 
 		if (Ar.IsSaving() || Ar.UE4Ver() >= VER_UE4_ADD_STRING_ASSET_REFERENCES_MAP)
 		{
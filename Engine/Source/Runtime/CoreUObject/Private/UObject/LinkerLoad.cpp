@@ -670,6 +670,12 @@ FLinkerLoad::ELinkerStatus FLinkerLoad::Tick( float InTimeLimit, bool bInUseTime
 				Status = SerializeDependsMap();
 			}
 
+			// Serialize the dependency graph.
+			if( Status == LINKER_Loaded )
+			{
+				Status = SerializeDependencyGraph();
+			}
+
 			// Hash exports.
 			if( Status == LINKER_Loaded )
 			{
@@ -731,6 +737,7 @@ FLinkerLoad::FLinkerLoad(UPackage* InParent, const TCHAR* InFilename, uint32 InL
 , bHasSerializedPackageFileSummary(false)
 , bHasFixedUpImportMap(false)
 , bHasFoundExistingExports(false)
+, bHasSerializedDependencyGraph(false)
 , bHasFinishedInitialization(false)
 , bIsGatheringDependencies(false)
 , bTimeLimitExceeded(false)
@@ -1703,6 +1710,46 @@ FLinkerLoad::ELinkerStatus FLinkerLoad::SerializeDependsMap()
 	return ((DependsMapIndex == Summary.ExportCount) && !IsTimeLimitExceeded( TEXT("serializing depends map") )) ? LINKER_Loaded : LINKER_TimedOut;
 }
 
+FLinkerLoad::ELinkerStatus FLinkerLoad::SerializeDependencyGraph()
+{
+	if (bHasSerializedDependencyGraph)
+	{
+		return LINKER_Loaded;
+	}
+	bHasSerializedDependencyGraph = true;
+
+	if (Summary.DependencyGraphOffset > 0)
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FLinkerLoad::SerializeDependencyGraph"), STAT_LinkerLoad_SerializeDependencyGraph, STATGROUP_LinkerLoad);
+
+		Seek(Summary.DependencyGraphOffset);
+		*this << DependencyGraph;
+
+		// The graph is only usable if the import and export maps haven't changed since the package was cooked
+		bool bIsValid = DependencyGraph.IsValidFor(ImportMap.Num(), ExportMap.Num());
+		for (int32 Index = 0; bIsValid && Index < ImportMap.Num(); ++Index)
+		{
+			bIsValid = ImportMap.IsValidIndex(DependencyGraph.ImportOrder[Index]) && ImportMap.IsValidIndex(DependencyGraph.ImportClassIndices[Index]);
+		}
+		for (int32 Index = 0; bIsValid && Index < ExportMap.Num(); ++Index)
+		{
+			bIsValid = ExportMap.IsValidIndex(DependencyGraph.ExportOrder[Index]);
+		}
+
+		if (bIsValid)
+		{
+			NativeImportClasses.AddZeroed(ImportMap.Num());
+		}
+		else
+		{
+			UE_LOG(LogLinker, Warning, TEXT("Ignoring dependency graph of %s, it doesn't match the import and export maps."), *Filename);
+			DependencyGraph.Empty();
+		}
+	}
+
+	return LINKER_Loaded;
+}
+
 /**
  * Serializes thumbnails
  */
@@ -4008,73 +4055,74 @@ UObject* FLinkerLoad::CreateImport( int32 Index )
 		if (!GIsEditor && !IsRunningCommandlet())
 		{
 			// Try to find existing version in memory first.
-			if( UPackage* ClassPackage = FindObjectFast<UPackage>( NULL, Import.ClassPackage, false, false ) )
+			if( UClass* FindClass = FindImportClassFast( Index ) )
 			{
-				if( UClass*	FindClass = FindObjectFast<UClass>( ClassPackage, Import.ClassName, false, false ) ) // 
+				// Make sure the class has been loaded and linked before creating a CDO.
+				// This is an edge case, but can happen if a blueprint package has not finished creating exports for a class
+				// during async loading, and another package creates the class via CreateImport while in cooked builds because
+				// we don't call preload immediately after creating a class in CreateExport like in non-cooked builds.
+				Preload( FindClass );
+
+				FindClass->GetDefaultObject(); // build the CDO if it isn't already built
+				UObject*	FindObject		= NULL;
+
+				// Import is a toplevel package, avoid going through its name string if it is already in memory.
+				if( Import.OuterIndex.IsNull() )
 				{
-					// Make sure the class has been loaded and linked before creating a CDO.
-					// This is an edge case, but can happen if a blueprint package has not finished creating exports for a class
-					// during async loading, and another package creates the class via CreateImport while in cooked builds because
-					// we don't call preload immediately after creating a class in CreateExport like in non-cooked builds.
-					Preload( FindClass );
-
-					FindClass->GetDefaultObject(); // build the CDO if it isn't already built
-					UObject*	FindObject		= NULL;
-	
-					// Import is a toplevel package.
-					if( Import.OuterIndex.IsNull() )
+					FindObject = FindObjectFast<UPackage>(NULL, Import.ObjectName, false, false);
+					if( !FindObject )
 					{
 						FindObject = CreatePackage(NULL, *Import.ObjectName.ToString());
 					}
-					// Import is regular import/ export.
-					else
+				}
+				// Import is regular import/ export.
+				else
+				{
+					// Find the imports' outer.
+					UObject* FindOuter = NULL;
+					// Import.
+					if( Import.OuterIndex.IsImport() )
 					{
-						// Find the imports' outer.
-						UObject* FindOuter = NULL;
-						// Import.
-						if( Import.OuterIndex.IsImport() )
+						FObjectImport& OuterImport = Imp(Import.OuterIndex);
+						// Outer already in memory.
+						if( OuterImport.XObject )
 						{
-							FObjectImport& OuterImport = Imp(Import.OuterIndex);
-							// Outer already in memory.
-							if( OuterImport.XObject )
-							{
-								FindOuter = OuterImport.XObject;
-							}
-							// Outer is toplevel package, create/ find it.
-							else if( OuterImport.OuterIndex.IsNull() )
-							{
-								FindOuter = CreatePackage( NULL, *OuterImport.ObjectName.ToString() );
-							}
-							// Outer is regular import/ export, use IndexToObject to potentially recursively load/ find it.
-							else
-							{
-								FindOuter = IndexToObject( Import.OuterIndex );
-							}
+							FindOuter = OuterImport.XObject;
 						}
-						// Export.
-						else 
+						// Outer is toplevel package, create/ find it.
+						else if( OuterImport.OuterIndex.IsNull() )
 						{
-							// Create/ find the object's outer.
-							FindOuter = IndexToObject( Import.OuterIndex );
+							FindOuter = CreatePackage( NULL, *OuterImport.ObjectName.ToString() );
 						}
-						if (!FindOuter)
+						// Outer is regular import/ export, use IndexToObject to potentially recursively load/ find it.
+						else
 						{
-							FString OuterName = Import.OuterIndex.IsNull() ? LinkerRoot->GetFullName() : GetFullImpExpName(Import.OuterIndex);
-							UE_LOG(LogLinker, Warning, TEXT("CreateImport: Failed to load Outer for resource '%s': %s"), *Import.ObjectName.ToString(), *OuterName);
-							return NULL;
+							FindOuter = IndexToObject( Import.OuterIndex );
 						}
-	
-						// Find object now that we know it's class, outer and name.
-						FindObject = FindImportFast(FindClass, FindOuter, Import.ObjectName);
 					}
-
-					if( FindObject )
-					{		
-						// Associate import and indicate that we associated an import for later cleanup.
-						Import.XObject = FindObject;
-						FUObjectThreadContext::Get().ImportCount++;
-						FLinkerManager::Get().AddLoaderWithNewImports(this);
+					// Export.
+					else 
+					{
+						// Create/ find the object's outer.
+						FindOuter = IndexToObject( Import.OuterIndex );
+					}
+					if (!FindOuter)
+					{
+						FString OuterName = Import.OuterIndex.IsNull() ? LinkerRoot->GetFullName() : GetFullImpExpName(Import.OuterIndex);
+						UE_LOG(LogLinker, Warning, TEXT("CreateImport: Failed to load Outer for resource '%s': %s"), *Import.ObjectName.ToString(), *OuterName);
+						return NULL;
 					}
+
+					// Find object now that we know it's class, outer and name.
+					FindObject = FindImportFast(FindClass, FindOuter, Import.ObjectName);
+				}
+
+				if( FindObject )
+				{		
+					// Associate import and indicate that we associated an import for later cleanup.
+					Import.XObject = FindObject;
+					FUObjectThreadContext::Get().ImportCount++;
+					FLinkerManager::Get().AddLoaderWithNewImports(this);
 				}
 			}
 		}
@@ -4123,6 +4171,29 @@ UObject* FLinkerLoad::CreateImport( int32 Index )
 	return Import.XObject;
 }
 
+UClass* FLinkerLoad::FindImportClassFast(int32 ImportIndex)
+{
+	const int32 ClassImportIndex = NativeImportClasses.Num() ? DependencyGraph.ImportClassIndices[ImportIndex] : INDEX_NONE;
+	if (ClassImportIndex != INDEX_NONE && NativeImportClasses[ClassImportIndex])
+	{
+		return NativeImportClasses[ClassImportIndex];
+	}
+
+	const FObjectImport& Import = ImportMap[ImportIndex];
+	UClass* FindClass = nullptr;
+	if (UPackage* ClassPackage = FindObjectFast<UPackage>(NULL, Import.ClassPackage, false, false))
+	{
+		FindClass = FindObjectFast<UClass>(ClassPackage, Import.ClassName, false, false);
+	}
+
+	// Only native classes are cached, they can't be garbage collected while the linker is alive
+	if (ClassImportIndex != INDEX_NONE && FindClass && FindClass->HasAnyClassFlags(CLASS_Native))
+	{
+		NativeImportClasses[ClassImportIndex] = FindClass;
+	}
+	return FindClass;
+}
+
 // Map an import/export index to an object; all errors here are fatal.
 UObject* FLinkerLoad::IndexToObject( FPackageIndex Index )
 {
@@ -3387,6 +3387,42 @@ bool StaticExec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar )
 			FUntypedBulkData::DumpBulkDataUsage( Ar );
 			return true;
 		}
+		else if( FParse::Command(&Str,TEXT("RETAINED")) )
+		{
+			// OBJ RETAINED [-Max=<Classes>] [-Snapshot=<File>] [-Diff=<Snapshot>]
+			int32 MaxClasses = 50;
+			FParse::Value(Str, TEXT("-Max="), MaxClasses);
+
+			const double StartTime = FPlatformTime::Seconds();
+			FObjectRetainedSizeAnalyzer Analyzer;
+			Analyzer.Analyze();
+			Ar.Logf(TEXT("Computed retained sizes in %.2fs"), FPlatformTime::Seconds() - StartTime);
+
+			FString BaselineFilename;
+			if (FParse::Value(Str, TEXT("-Diff="), BaselineFilename))
+			{
+				TArray<FClassRetainedSize> Baseline;
+				if (FObjectRetainedSizeAnalyzer::LoadSnapshot(*BaselineFilename, Baseline))
+				{
+					FObjectRetainedSizeAnalyzer::PrintDiff(Ar, Baseline, Analyzer.GetClassSizes(), MaxClasses);
+				}
+				else
+				{
+					Ar.Logf(TEXT("Unable to read retained size snapshot %s."), *BaselineFilename);
+				}
+			}
+			else
+			{
+				Analyzer.PrintResults(Ar, MaxClasses);
+			}
+
+			FString SnapshotFilename;
+			if (FParse::Value(Str, TEXT("-Snapshot="), SnapshotFilename) && !Analyzer.SaveSnapshot(*SnapshotFilename))
+			{
+				Ar.Logf(TEXT("Unable to write retained size snapshot %s."), *SnapshotFilename);
+			}
+			return true;
+		}
 		else if( FParse::Command(&Str,TEXT("LISTCONTENTREFS")) )
 		{
 			UClass*	Class		= NULL;
@@ -2,6 +2,7 @@
 
 #include "CoreUObjectPrivate.h"
 #include "UObject/ObjectMemoryAnalyzer.h"
+#include "ParallelFor.h"
 
 FObjectMemoryAnalyzer::FObjectMemoryAnalyzer(uint32 Flags)
 	: BaseClass(NULL)
@@ -363,3 +364,374 @@ const FObjectMemoryUsage& FObjectMemoryAnalyzer::GetObjectMemoryUsage( class UOb
 
 	return Annotation;
 }
+
+/** Reference finder that keeps duplicates, they are removed once per object after sorting the node indices */
+class FRetainedSizeReferenceFinder : public FReferenceFinder
+{
+public:
+	FRetainedSizeReferenceFinder(TArray<UObject*>& InObjectArray)
+		: FReferenceFinder(InObjectArray, nullptr, false, false, false, false)
+	{
+	}
+
+	virtual void HandleObjectReference(UObject*& InObject, const UObject* InReferencingObject, const UProperty* InReferencingProperty) override
+	{
+		if (InObject)
+		{
+			ObjectArray.Add(InObject);
+		}
+	}
+};
+
+/** Version of retained size snapshot files */
+static const int32 RetainedSizeSnapshotVersion = 1;
+static const uint32 RetainedSizeSnapshotTag = 0x52535A53;
+
+void FObjectRetainedSizeAnalyzer::Analyze()
+{
+	check(IsInGameThread());
+
+	// Node 0 is a virtual root, every object gets the next node
+	ObjectIndexToNode.Init(INDEX_NONE, GUObjectArray.GetObjectArrayNum());
+	NodeObjects.Reset();
+	NodeObjects.Add(nullptr);
+	for (FRawObjectIterator It; It; ++It)
+	{
+		ObjectIndexToNode[It.GetIndex()] = NodeObjects.Add(static_cast<UObject*>((*It)->Object));
+	}
+	const int32 NumNodes = NodeObjects.Num();
+
+	// Counting memory runs each object's Serialize, which may have side effects, so exclusive sizes are counted here
+	TArray<uint64> ExclusiveSizes;
+	ExclusiveSizes.AddZeroed(NumNodes);
+	for (int32 Node = 1; Node < NumNodes; ++Node)
+	{
+		FArchiveCountMem MemCount(const_cast<UObject*>(NodeObjects[Node]));
+		ExclusiveSizes[Node] = MemCount.GetMax();
+	}
+
+	// Gathering references only reads the objects, so it is done in parallel
+	TArray<TArray<int32>> Successors;
+	Successors.SetNum(NumNodes);
+	ParallelFor(NumNodes - 1, [&](int32 Index)
+	{
+		const int32 Node = Index + 1;
+		UObject* Object = const_cast<UObject*>(NodeObjects[Node]);
+
+		TArray<UObject*> References;
+		FRetainedSizeReferenceFinder ReferenceFinder(References);
+		ReferenceFinder.FindReferences(Object);
+
+		TArray<int32>& NodeSuccessors = Successors[Node];
+		NodeSuccessors.Reserve(References.Num());
+		for (UObject* Reference : References)
+		{
+			const int32 ReferenceIndex = GUObjectArray.ObjectToIndex(Reference);
+			const int32 Successor = ObjectIndexToNode.IsValidIndex(ReferenceIndex) ? ObjectIndexToNode[ReferenceIndex] : INDEX_NONE;
+			if (Successor != INDEX_NONE && Successor != Node)
+			{
+				NodeSuccessors.Add(Successor);
+			}
+		}
+		NodeSuccessors.Sort();
+		int32 NumUnique = 0;
+		for (int32 SuccessorIndex = 0; SuccessorIndex < NodeSuccessors.Num(); ++SuccessorIndex)
+		{
+			if (NumUnique == 0 || NodeSuccessors[NumUnique - 1] != NodeSuccessors[SuccessorIndex])
+			{
+				NodeSuccessors[NumUnique++] = NodeSuccessors[SuccessorIndex];
+			}
+		}
+		NodeSuccessors.SetNum(NumUnique, false);
+	});
+
+	// The virtual root references whatever GC treats as a root
+	const EObjectFlags KeepFlags = GARBAGE_COLLECTION_KEEPFLAGS;
+	for (int32 Node = 1; Node < NumNodes; ++Node)
+	{
+		const UObject* Object = NodeObjects[Node];
+		if (Object->IsRooted() || GUObjectArray.IsDisregardForGC(Object) || Object->HasAnyFlags(KeepFlags))
+		{
+			Successors[0].Add(Node);
+		}
+	}
+
+	// Objects that can't be reached from the roots are garbage that hasn't been collected yet, they hang off the virtual root too
+	TBitArray<> Visited(false, NumNodes);
+	TArray<int32> NodeStack;
+	for (int32 StartNode = 0; StartNode < NumNodes; ++StartNode)
+	{
+		if (Visited[StartNode])
+		{
+			continue;
+		}
+		if (StartNode != 0)
+		{
+			Successors[0].Add(StartNode);
+		}
+		Visited[StartNode] = true;
+		NodeStack.Add(StartNode);
+		while (NodeStack.Num())
+		{
+			const int32 Node = NodeStack.Pop(false);
+			for (int32 Successor : Successors[Node])
+			{
+				if (!Visited[Successor])
+				{
+					Visited[Successor] = true;
+					NodeStack.Add(Successor);
+				}
+			}
+		}
+	}
+
+	// Depth first post order from the virtual root, which ends up last
+	TArray<int32> PostOrder;
+	PostOrder.Reserve(NumNodes);
+	TArray<int32> PostOrderIndex;
+	PostOrderIndex.AddUninitialized(NumNodes);
+	Visited.Init(false, NumNodes);
+	Visited[0] = true;
+	TArray<TPair<int32, int32>> Stack;
+	Stack.Add(TPairInitializer<int32, int32>(0, 0));
+	while (Stack.Num())
+	{
+		TPair<int32, int32>& Top = Stack.Last();
+		if (Top.Value < Successors[Top.Key].Num())
+		{
+			const int32 Successor = Successors[Top.Key][Top.Value++];
+			if (!Visited[Successor])
+			{
+				Visited[Successor] = true;
+				Stack.Add(TPairInitializer<int32, int32>(Successor, 0));
+			}
+		}
+		else
+		{
+			PostOrderIndex[Top.Key] = PostOrder.Add(Top.Key);
+			Stack.Pop(false);
+		}
+	}
+	check(PostOrder.Num() == NumNodes);
+
+	// Predecessor lists, flattened
+	TArray<int32> PredecessorStart;
+	PredecessorStart.AddZeroed(NumNodes + 1);
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		for (int32 Successor : Successors[Node])
+		{
+			PredecessorStart[Successor + 1]++;
+		}
+	}
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		PredecessorStart[Node + 1] += PredecessorStart[Node];
+	}
+	TArray<int32> Predecessors;
+	Predecessors.AddUninitialized(PredecessorStart[NumNodes]);
+	{
+		TArray<int32> Cursor(PredecessorStart);
+		for (int32 Node = 0; Node < NumNodes; ++Node)
+		{
+			for (int32 Successor : Successors[Node])
+			{
+				Predecessors[Cursor[Successor]++] = Node;
+			}
+		}
+	}
+	Successors.Empty();
+
+	// Immediate dominators, see Cooper, Harvey and Kennedy, "A Simple, Fast Dominance Algorithm"
+	TArray<int32> ImmediateDominators;
+	ImmediateDominators.Init(INDEX_NONE, NumNodes);
+	ImmediateDominators[0] = 0;
+	bool bChanged = true;
+	while (bChanged)
+	{
+		bChanged = false;
+		for (int32 Order = NumNodes - 2; Order >= 0; --Order)
+		{
+			const int32 Node = PostOrder[Order];
+			int32 NewDominator = INDEX_NONE;
+			for (int32 PredecessorIndex = PredecessorStart[Node]; PredecessorIndex < PredecessorStart[Node + 1]; ++PredecessorIndex)
+			{
+				int32 Predecessor = Predecessors[PredecessorIndex];
+				if (ImmediateDominators[Predecessor] == INDEX_NONE)
+				{
+					continue;
+				}
+				if (NewDominator == INDEX_NONE)
+				{
+					NewDominator = Predecessor;
+					continue;
+				}
+				while (Predecessor != NewDominator)
+				{
+					while (PostOrderIndex[Predecessor] < PostOrderIndex[NewDominator])
+					{
+						Predecessor = ImmediateDominators[Predecessor];
+					}
+					while (PostOrderIndex[NewDominator] < PostOrderIndex[Predecessor])
+					{
+						NewDominator = ImmediateDominators[NewDominator];
+					}
+				}
+			}
+			if (ImmediateDominators[Node] != NewDominator)
+			{
+				ImmediateDominators[Node] = NewDominator;
+				bChanged = true;
+			}
+		}
+	}
+
+	// Dominators come after everything they dominate in post order
+	RetainedSizes = ExclusiveSizes;
+	for (int32 Order = 0; Order < NumNodes - 1; ++Order)
+	{
+		const int32 Node = PostOrder[Order];
+		RetainedSizes[ImmediateDominators[Node]] += RetainedSizes[Node];
+	}
+
+	TMap<UClass*, FClassRetainedSize> ClassSizeMap;
+	for (int32 Node = 1; Node < NumNodes; ++Node)
+	{
+		UClass* Class = NodeObjects[Node]->GetClass();
+		FClassRetainedSize& ClassSize = ClassSizeMap.FindOrAdd(Class);
+		ClassSize.NumObjects++;
+		ClassSize.ExclusiveSize += ExclusiveSizes[Node];
+
+		// Nested objects of the same class are already part of their dominator's retained size
+		const int32 Dominator = ImmediateDominators[Node];
+		if (Dominator == 0 || NodeObjects[Dominator]->GetClass() != Class)
+		{
+			ClassSize.RetainedSize += RetainedSizes[Node];
+		}
+	}
+	ClassSizes.Reset(ClassSizeMap.Num());
+	for (TMap<UClass*, FClassRetainedSize>::TIterator It(ClassSizeMap); It; ++It)
+	{
+		It.Value().ClassPath = It.Key()->GetPathName();
+		ClassSizes.Add(It.Value());
+	}
+	ClassSizes.Sort([](const FClassRetainedSize& A, const FClassRetainedSize& B)
+	{
+		return A.RetainedSize > B.RetainedSize;
+	});
+}
+
+uint64 FObjectRetainedSizeAnalyzer::GetRetainedSize(const UObject* Object) const
+{
+	const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Object);
+	const int32 Node = ObjectIndexToNode.IsValidIndex(ObjectIndex) ? ObjectIndexToNode[ObjectIndex] : INDEX_NONE;
+	return Node != INDEX_NONE && NodeObjects[Node] == Object ? RetainedSizes[Node] : 0;
+}
+
+bool FObjectRetainedSizeAnalyzer::SaveSnapshot(const TCHAR* Filename) const
+{
+	TAutoPtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(Filename));
+	if (!Writer.IsValid())
+	{
+		return false;
+	}
+
+	uint32 Tag = RetainedSizeSnapshotTag;
+	int32 Version = RetainedSizeSnapshotVersion;
+	*Writer << Tag << Version;
+	*Writer << const_cast<TArray<FClassRetainedSize>&>(ClassSizes);
+	return Writer->Close();
+}
+
+bool FObjectRetainedSizeAnalyzer::LoadSnapshot(const TCHAR* Filename, TArray<FClassRetainedSize>& OutClassSizes)
+{
+	TAutoPtr<FArchive> Reader(IFileManager::Get().CreateFileReader(Filename));
+	if (!Reader.IsValid())
+	{
+		return false;
+	}
+
+	uint32 Tag = 0;
+	int32 Version = 0;
+	*Reader << Tag << Version;
+	if (Tag != RetainedSizeSnapshotTag || Version != RetainedSizeSnapshotVersion)
+	{
+		return false;
+	}
+	*Reader << OutClassSizes;
+	return !Reader->IsError();
+}
+
+void FObjectRetainedSizeAnalyzer::PrintResults(FOutputDevice& Ar, int32 MaxClasses) const
+{
+	uint64 TotalSize = 0;
+	int32 TotalObjects = 0;
+	for (const FClassRetainedSize& ClassSize : ClassSizes)
+	{
+		TotalSize += ClassSize.ExclusiveSize;
+		TotalObjects += ClassSize.NumObjects;
+	}
+
+	Ar.Logf(TEXT("%-80s %-10s %-14s %-14s"), TEXT("Class"), TEXT("Count"), TEXT("ExclKBytes"), TEXT("RetainedKBytes"));
+	for (int32 Index = 0; Index < ClassSizes.Num() && Index < MaxClasses; ++Index)
+	{
+		const FClassRetainedSize& ClassSize = ClassSizes[Index];
+		Ar.Logf(TEXT("%-80s %-10d %-14.1f %-14.1f"), *ClassSize.ClassPath, ClassSize.NumObjects, ClassSize.ExclusiveSize / 1024.0, ClassSize.RetainedSize / 1024.0);
+	}
+	Ar.Logf(TEXT("%d objects of %d classes, %.1f KBytes"), TotalObjects, ClassSizes.Num(), TotalSize / 1024.0);
+}
+
+void FObjectRetainedSizeAnalyzer::PrintDiff(FOutputDevice& Ar, const TArray<FClassRetainedSize>& Before, const TArray<FClassRetainedSize>& After, int32 MaxClasses)
+{
+	struct FClassDelta
+	{
+		const FString* ClassPath;
+		int32 NumObjects;
+		int64 ExclusiveSize;
+		int64 RetainedSize;
+	};
+
+	TMap<FString, FClassDelta> Deltas;
+	for (const FClassRetainedSize& ClassSize : Before)
+	{
+		FClassDelta& Delta = Deltas.Add(ClassSize.ClassPath);
+		Delta.NumObjects = -ClassSize.NumObjects;
+		Delta.ExclusiveSize = -(int64)ClassSize.ExclusiveSize;
+		Delta.RetainedSize = -(int64)ClassSize.RetainedSize;
+	}
+	for (const FClassRetainedSize& ClassSize : After)
+	{
+		FClassDelta* Delta = Deltas.Find(ClassSize.ClassPath);
+		if (!Delta)
+		{
+			Delta = &Deltas.Add(ClassSize.ClassPath);
+			Delta->NumObjects = 0;
+			Delta->ExclusiveSize = 0;
+			Delta->RetainedSize = 0;
+		}
+		Delta->NumObjects += ClassSize.NumObjects;
+		Delta->ExclusiveSize += ClassSize.ExclusiveSize;
+		Delta->RetainedSize += ClassSize.RetainedSize;
+	}
+
+	TArray<FClassDelta> SortedDeltas;
+	for (TMap<FString, FClassDelta>::TIterator It(Deltas); It; ++It)
+	{
+		if (It.Value().NumObjects || It.Value().RetainedSize)
+		{
+			It.Value().ClassPath = &It.Key();
+			SortedDeltas.Add(It.Value());
+		}
+	}
+	SortedDeltas.Sort([](const FClassDelta& A, const FClassDelta& B)
+	{
+		return FMath::Abs(A.RetainedSize) > FMath::Abs(B.RetainedSize);
+	});
+
+	Ar.Logf(TEXT("%-80s %-10s %-14s %-14s"), TEXT("Class"), TEXT("Count"), TEXT("ExclKBytes"), TEXT("RetainedKBytes"));
+	for (int32 Index = 0; Index < SortedDeltas.Num() && Index < MaxClasses; ++Index)
+	{
+		const FClassDelta& Delta = SortedDeltas[Index];
+		Ar.Logf(TEXT("%-80s %+-10d %+-14.1f %+-14.1f"), **Delta.ClassPath, Delta.NumObjects, Delta.ExclusiveSize / 1024.0, Delta.RetainedSize / 1024.0);
+	}
+}
@@ -164,6 +164,10 @@ FArchive& operator<<( FArchive& Ar, FPackageFileSummary& Sum )
 		{
 			Ar.SetFilterEditorOnly(true);
 		}
+		if( Sum.PackageFlags & PKG_UnversionedProperties )
+		{
+			Ar.SetUseUnversionedPropertySerialization(true);
+		}
 		Ar << Sum.NameCount					<< Sum.NameOffset;
 		if (Sum.FileVersionUE4 >= VER_UE4_SERIALIZE_TEXT_IN_PACKAGES)
 		{
@@ -280,6 +284,11 @@ FArchive& operator<<( FArchive& Ar, FPackageFileSummary& Sum )
 				}
 			}
 		}
+
+		if (Sum.GetFileVersionUE4() >= VER_UE4_PACKAGE_SUMMARY_HAS_DEPENDENCY_GRAPH)
+		{
+			Ar << Sum.DependencyGraphOffset;
+		}
 	}
 
 	return Ar;
@@ -64,6 +64,7 @@ void UObjectProperty::SerializeItem( FArchive& Ar, void* Value, void const* Defa
 void UObjectProperty::SetObjectPropertyValue(void* PropertyValueAddress, UObject* Value) const
 {
 	SetPropertyValue(PropertyValueAddress, Value);
+	GarbageCollectionStoredReferenceBarrier(Value);
 }
 
 IMPLEMENT_CORE_INTRINSIC_CLASS(UObjectProperty, UObjectPropertyBase,
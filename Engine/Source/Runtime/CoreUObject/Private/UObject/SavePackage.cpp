@@ -8,6 +8,7 @@
 #include "BlueprintSupport.h"
 #include "DebugSerializationFlags.h"
 #include "UObject/GCScopeLock.h"
+#include "ParallelFor.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogSavePackage, Log, All);
 
@@ -209,6 +210,28 @@ static bool EndSavingIfCancelled( FLinkerSave* Linker, const FString& TempFilena
 
 static FThreadSafeCounter OutstandingAsyncWrites;
 
+static int32 GMaxOutstandingAsyncWrites = 16;
+static FAutoConsoleVariableRef CVarMaxOutstandingAsyncWrites(
+	TEXT("s.MaxOutstandingAsyncSaves"),
+	GMaxOutstandingAsyncWrites,
+	TEXT("Maximum number of SAVE_Async packages that may be compressed and written on worker threads at once.\n") \
+	TEXT("Saving another package waits for a slot, which bounds the memory held by in flight packages. 0 means no limit."),
+	ECVF_Default
+	);
+
+static int32 GSavePackageParallelBulkData = 1;
+static FAutoConsoleVariableRef CVarSavePackageParallelBulkData(
+	TEXT("s.SavePackageParallelBulkData"),
+	GSavePackageParallelBulkData,
+	TEXT("If non-zero, compressed bulk data appended to the end of a package is compressed on worker threads\n") \
+	TEXT("and only copied into the package on the game thread."),
+	ECVF_Default
+	);
+
+DECLARE_CYCLE_STAT(TEXT("Wait For Async Save Slot"), STAT_WaitForAsyncSaveSlot, STATGROUP_LoadTime);
+DECLARE_CYCLE_STAT(TEXT("Compress Bulk Data In Parallel"), STAT_CompressBulkDataInParallel, STATGROUP_LoadTime);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Outstanding Async Saves"), STAT_OutstandingAsyncSaves, STATGROUP_LoadTime);
+
 void UPackage::WaitForAsyncFileWrites()
 {
 	while (OutstandingAsyncWrites.GetValue())
@@ -217,7 +240,39 @@ void UPackage::WaitForAsyncFileWrites()
 	}
 }
 
-void AsyncWriteFile(const TArray<uint8>& Data, const TCHAR* Filename, const FDateTime& TimeStamp)
+/** Triggered whenever an async write finishes and releases its slot */
+static FEvent* GetAsyncFileWriteFinishedEvent()
+{
+	static FEvent* Event = FPlatformProcess::GetSynchEventFromPool(false);
+	return Event;
+}
+
+/** Blocks until fewer than s.MaxOutstandingAsyncSaves packages are being written, then claims a slot. */
+static void BeginAsyncFileWrite()
+{
+	FEvent* WriteFinishedEvent = GetAsyncFileWriteFinishedEvent();
+	if (GMaxOutstandingAsyncWrites > 0 && OutstandingAsyncWrites.GetValue() >= GMaxOutstandingAsyncWrites)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_WaitForAsyncSaveSlot);
+		while (OutstandingAsyncWrites.GetValue() >= GMaxOutstandingAsyncWrites)
+		{
+			// The event is auto reset, a write that finished after the check above leaves it triggered
+			WriteFinishedEvent->Wait();
+		}
+	}
+	OutstandingAsyncWrites.Increment();
+	INC_DWORD_STAT(STAT_OutstandingAsyncSaves);
+}
+
+/** Releases the slot claimed by BeginAsyncFileWrite. Called from the worker thread. */
+static void EndAsyncFileWrite()
+{
+	DEC_DWORD_STAT(STAT_OutstandingAsyncSaves);
+	OutstandingAsyncWrites.Decrement();
+	GetAsyncFileWriteFinishedEvent()->Trigger();
+}
+
+void AsyncWriteFile(TArray<uint8>&& Data, const TCHAR* Filename, const FDateTime& TimeStamp)
 {
 	class FAsyncWriteWorker : public FNonAbandonableTask
 	{
@@ -231,9 +286,9 @@ void AsyncWriteFile(const TArray<uint8>& Data, const TCHAR* Filename, const FDat
 
 		/** Constructor
 		*/
-		FAsyncWriteWorker(const TCHAR* InFilename, const TArray<uint8>* InData, const FDateTime& InTimeStamp)
+		FAsyncWriteWorker(const TCHAR* InFilename, TArray<uint8>&& InData, const FDateTime& InTimeStamp)
 			: Filename(InFilename)
-			, Data(*InData)
+			, Data(MoveTemp(InData))
 			, FinalTimeStamp(InTimeStamp)
 		{
 		}
@@ -278,7 +333,7 @@ void AsyncWriteFile(const TArray<uint8>& Data, const TCHAR* Filename, const FDat
 			{
 				IFileManager::Get().Delete(*TempFilename);
 			}
-			OutstandingAsyncWrites.Decrement();
+			EndAsyncFileWrite();
 		}
 
 		FORCEINLINE TStatId GetStatId() const
@@ -287,8 +342,8 @@ void AsyncWriteFile(const TArray<uint8>& Data, const TCHAR* Filename, const FDat
 		}
 	};
 
-	OutstandingAsyncWrites.Increment();
-	(new FAutoDeleteAsyncTask<FAsyncWriteWorker>(Filename, &Data, TimeStamp))->StartBackgroundTask();
+	BeginAsyncFileWrite();
+	(new FAutoDeleteAsyncTask<FAsyncWriteWorker>(Filename, MoveTemp(Data), TimeStamp))->StartBackgroundTask();
 }
 
 /** 
@@ -1307,7 +1362,7 @@ private:
 
 
 
-void AsyncWriteCompressedFile(const TArray<uint8>& Data, const TCHAR* Filename, const FDateTime& TimeStamp, const bool bForceByteSwapping, const int32 TotalHeaderSize, const TArray<int32>& ExportSizes)
+void AsyncWriteCompressedFile(TArray<uint8>&& Data, const TCHAR* Filename, const FDateTime& TimeStamp, const bool bForceByteSwapping, const int32 TotalHeaderSize, const TArray<int32>& ExportSizes)
 {
 	class FAsyncWriteWorker : public FNonAbandonableTask
 	{
@@ -1325,9 +1380,9 @@ void AsyncWriteCompressedFile(const TArray<uint8>& Data, const TCHAR* Filename,
 
 		/** Constructor
 		*/
-		FAsyncWriteWorker(const TArray<uint8>& InData, const TCHAR* InFilename, const FDateTime& InTimeStamp, bool InBForceByteSwapping, const int32 InTotalHeaderSize, const TArray<int32>& InExportSizes)
+		FAsyncWriteWorker(TArray<uint8>&& InData, const TCHAR* InFilename, const FDateTime& InTimeStamp, bool InBForceByteSwapping, const int32 InTotalHeaderSize, const TArray<int32>& InExportSizes)
 			: Filename(InFilename)
-			, Data(InData)
+			, Data(MoveTemp(InData))
 			, FinalTimeStamp(InTimeStamp)
 			, bForceByteSwapping(InBForceByteSwapping)
 			, TotalHeaderSize(InTotalHeaderSize)
@@ -1373,7 +1428,7 @@ void AsyncWriteCompressedFile(const TArray<uint8>& Data, const TCHAR* Filename,
 				}
 			}
 
-			OutstandingAsyncWrites.Decrement();
+			EndAsyncFileWrite();
 		}
 
 		FORCEINLINE TStatId GetStatId() const
@@ -1382,8 +1437,8 @@ void AsyncWriteCompressedFile(const TArray<uint8>& Data, const TCHAR* Filename,
 		}
 	};
 
-	OutstandingAsyncWrites.Increment();
-	(new FAutoDeleteAsyncTask<FAsyncWriteWorker>(Data, Filename, TimeStamp, bForceByteSwapping, TotalHeaderSize, ExportSizes))->StartBackgroundTask();
+	BeginAsyncFileWrite();
+	(new FAutoDeleteAsyncTask<FAsyncWriteWorker>(MoveTemp(Data), Filename, TimeStamp, bForceByteSwapping, TotalHeaderSize, ExportSizes))->StartBackgroundTask();
 }
 
 
@@ -3183,6 +3238,179 @@ public:
 
 #endif
 
+/**
+ * Builds the dependency graph the loader uses for cooked packages: imports ordered outers first, the first import of
+ * every import class and the order in which exports can be created and preloaded without recursing into other exports.
+ *
+ * @param Linker Linker with the final import and export maps
+ * @param ExportToIndexMap Maps export objects to their index in the export map
+ */
+static void BuildDependencyGraph(FLinkerSave* Linker, const TMap<UObject*, FPackageIndex>& ExportToIndexMap)
+{
+	FPackageDependencyGraph& Graph = Linker->DependencyGraph;
+	const int32 NumImports = Linker->ImportMap.Num();
+	const int32 NumExports = Linker->ExportMap.Num();
+	Graph.Empty();
+
+	// Imports, each one after its outer chain
+	Graph.ImportOrder.Reserve(NumImports);
+	TBitArray<> VisitedImports(false, NumImports);
+	TArray<int32> OuterChain;
+	for (int32 ImportIndex = 0; ImportIndex < NumImports; ++ImportIndex)
+	{
+		OuterChain.Reset();
+		for (int32 ChainIndex = ImportIndex; ChainIndex != INDEX_NONE && !VisitedImports[ChainIndex];)
+		{
+			VisitedImports[ChainIndex] = true;
+			OuterChain.Add(ChainIndex);
+			const FPackageIndex OuterIndex = Linker->ImportMap[ChainIndex].OuterIndex;
+			ChainIndex = OuterIndex.IsImport() ? OuterIndex.ToImport() : INDEX_NONE;
+		}
+		for (int32 ChainIndex = OuterChain.Num() - 1; ChainIndex >= 0; --ChainIndex)
+		{
+			Graph.ImportOrder.Add(OuterChain[ChainIndex]);
+		}
+	}
+
+	// First import of each class package and class name pair
+	Graph.ImportClassIndices.Reserve(NumImports);
+	TMap<FName, TMap<FName, int32>> FirstImportOfClass;
+	for (int32 ImportIndex = 0; ImportIndex < NumImports; ++ImportIndex)
+	{
+		const FObjectImport& Import = Linker->ImportMap[ImportIndex];
+		Graph.ImportClassIndices.Add(FirstImportOfClass.FindOrAdd(Import.ClassPackage).FindOrAdd(Import.ClassName, ImportIndex));
+	}
+
+	// Exports, each one after the exports it needs before it can be serialized
+	TArray<TArray<int32>> ExportDependencies;
+	ExportDependencies.AddDefaulted(NumExports);
+	for (int32 ExportIndex = 0; ExportIndex < NumExports; ++ExportIndex)
+	{
+		const FObjectExport& Export = Linker->ExportMap[ExportIndex];
+		TArray<int32>& Dependencies = ExportDependencies[ExportIndex];
+
+		FPackageIndex ArchetypeIndex;
+		if (Export.Object && !Export.Object->HasAnyFlags(RF_ClassDefaultObject))
+		{
+			ArchetypeIndex = ExportToIndexMap.FindRef(Export.Object->GetArchetype());
+		}
+		const FPackageIndex DependencyIndices[] = { Export.ClassIndex, Export.SuperIndex, Export.OuterIndex, ArchetypeIndex };
+		for (const FPackageIndex& DependencyIndex : DependencyIndices)
+		{
+			if (DependencyIndex.IsExport() && DependencyIndex.ToExport() != ExportIndex)
+			{
+				Dependencies.AddUnique(DependencyIndex.ToExport());
+			}
+		}
+	}
+
+	// Depth first post order, starting in file order so that independent exports keep their file order.
+	// Cycles are broken by ignoring dependencies that are still being visited, CreateExport resolves those.
+	enum class EVisitState : uint8 { NotVisited, Visiting, Visited };
+	TArray<EVisitState> VisitStates;
+	VisitStates.AddZeroed(NumExports);
+	TArray<TPair<int32, int32>> Stack;
+	Graph.ExportOrder.Reserve(NumExports);
+	for (int32 RootIndex = 0; RootIndex < NumExports; ++RootIndex)
+	{
+		if (VisitStates[RootIndex] != EVisitState::NotVisited)
+		{
+			continue;
+		}
+		VisitStates[RootIndex] = EVisitState::Visiting;
+		Stack.Add(TPairInitializer<int32, int32>(RootIndex, 0));
+		while (Stack.Num())
+		{
+			TPair<int32, int32>& Top = Stack.Last();
+			const TArray<int32>& Dependencies = ExportDependencies[Top.Key];
+			if (Top.Value < Dependencies.Num())
+			{
+				const int32 DependencyIndex = Dependencies[Top.Value++];
+				if (VisitStates[DependencyIndex] == EVisitState::NotVisited)
+				{
+					VisitStates[DependencyIndex] = EVisitState::Visiting;
+					Stack.Add(TPairInitializer<int32, int32>(DependencyIndex, 0));
+				}
+			}
+			else
+			{
+				VisitStates[Top.Key] = EVisitState::Visited;
+				Graph.ExportOrder.Add(Top.Key);
+				Stack.Pop(false);
+			}
+		}
+	}
+	check(Graph.IsValidFor(NumImports, NumExports));
+}
+
+/**
+ * Serializes the compressed bulk data payloads that are about to be appended to the end of a package on worker threads.
+ * Compressing large payloads dominates the bulk data phase of a save and each payload only depends on its own data and
+ * the byte swapping of the archive, so it can be done up front into memory and copied into the package afterwards.
+ *
+ * @param	Linker		linker whose BulkDataToAppend is about to be written
+ * @param	OutPayloads	receives the serialized payload of each entry in BulkDataToAppend, empty for entries that weren't precompressed
+ */
+static void PrecompressBulkDataToAppend(FLinkerSave* Linker, TArray<TArray<uint8>>& OutPayloads)
+{
+	OutPayloads.Reset();
+
+	TArray<int32> PayloadIndices;
+	TSet<FUntypedBulkData*> BulkDataSeen;
+	for (int32 Index = 0; Index < Linker->BulkDataToAppend.Num(); ++Index)
+	{
+		const FLinkerSave::FBulkDataStorageInfo& BulkDataStorageInfo = Linker->BulkDataToAppend[Index];
+		const uint32 BulkDataFlags = BulkDataStorageInfo.BulkDataFlags | BulkDataStorageInfo.BulkData->GetBulkDataFlags();
+
+		// Bulk data can only be locked once, so repeated entries are left to the sequential path
+		bool bAlreadySeen = false;
+		BulkDataSeen.Add(BulkDataStorageInfo.BulkData, &bAlreadySeen);
+		if (!bAlreadySeen && (BulkDataFlags & BULKDATA_SerializeCompressedAny) && !(BulkDataFlags & BULKDATA_Unused) && BulkDataStorageInfo.BulkData->GetBulkDataSize() > 0)
+		{
+			PayloadIndices.Add(Index);
+		}
+	}
+	if (PayloadIndices.Num() < 2)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CompressBulkDataInParallel);
+	OutPayloads.SetNum(Linker->BulkDataToAppend.Num());
+
+	// Locking may load the payload through the owner's linker, so that part stays on the game thread
+	TArray<void*> LockedData;
+	TArray<uint32> OldBulkDataFlags;
+	for (int32 PayloadIndex : PayloadIndices)
+	{
+		FLinkerSave::FBulkDataStorageInfo& BulkDataStorageInfo = Linker->BulkDataToAppend[PayloadIndex];
+		OldBulkDataFlags.Add(BulkDataStorageInfo.BulkData->GetBulkDataFlags());
+		BulkDataStorageInfo.BulkData->SetBulkDataFlags(BulkDataStorageInfo.BulkDataFlags);
+		LockedData.Add(BulkDataStorageInfo.BulkData->Lock(LOCK_READ_ONLY));
+	}
+
+	ParallelFor(PayloadIndices.Num(), [&](int32 Index)
+	{
+		// The payload has to serialize exactly as it would into the linker
+		FMemoryWriter PayloadWriter(OutPayloads[PayloadIndices[Index]], Linker->IsPersistent());
+		PayloadWriter.SetByteSwapping(Linker->ForceByteSwapping());
+		PayloadWriter.SetCookingTarget(Linker->CookingTarget());
+		PayloadWriter.SetFilterEditorOnly(Linker->IsFilterEditorOnly());
+		PayloadWriter.SetUE4Ver(Linker->UE4Ver());
+		PayloadWriter.SetLicenseeUE4Ver(Linker->LicenseeUE4Ver());
+		PayloadWriter.SetEngineVer(Linker->EngineVer());
+		Linker->BulkDataToAppend[PayloadIndices[Index]].BulkData->SerializeBulkData(PayloadWriter, LockedData[Index]);
+	});
+
+	for (int32 Index = 0; Index < PayloadIndices.Num(); ++Index)
+	{
+		FUntypedBulkData* BulkData = Linker->BulkDataToAppend[PayloadIndices[Index]].BulkData;
+		BulkData->Unlock();
+		BulkData->ClearBulkDataFlags(0xFFFFFFFF);
+		BulkData->SetBulkDataFlags(OldBulkDataFlags[Index]);
+	}
+}
+
 extern FGCCSyncObject GGarbageCollectionGuardCritical;
 
 ESavePackageResult UPackage::Save(UPackage* InOuter, UObject* Base, EObjectFlags TopLevelFlags, const TCHAR* Filename,
@@ -3522,6 +3750,9 @@ ESavePackageResult UPackage::Save(UPackage* InOuter, UObject* Base, EObjectFlags
 				Linker->SetFilterEditorOnly( FilterEditorOnly );
 				Linker->SetCookingTarget(TargetPlatform);
 
+				// Unversioned properties can only be loaded by a build with the same struct layouts, which only holds for cooked data
+				Linker->SetUseUnversionedPropertySerialization(Linker->IsCooking() && !!(SaveFlags & SAVE_UnversionedProperties));
+
 				// Make sure the package has the same version as the linker
 				InOuter->LinkerPackageVersion = Linker->UE4Ver();
 				InOuter->LinkerLicenseeVersion = Linker->LicenseeUE4Ver();
@@ -4214,6 +4445,11 @@ ESavePackageResult UPackage::Save(UPackage* InOuter, UObject* Base, EObjectFlags
 					}
 				}
 
+				// Precompute the import and export dependency graph for the loader
+				if (Linker->IsCooking())
+				{
+					BuildDependencyGraph(Linker, ExportToIndexMap);
+				}
 
 
 				if ( EndSavingIfCancelled( Linker, TempFilename ) ) 
@@ -4363,6 +4599,14 @@ ESavePackageResult UPackage::Save(UPackage* InOuter, UObject* Base, EObjectFlags
 				}
 
 
+				// save the dependency graph, only cooked packages have one
+				Linker->Summary.DependencyGraphOffset = 0;
+				if (Linker->IsCooking())
+				{
+					Linker->Summary.DependencyGraphOffset = Linker->Tell();
+					*Linker << Linker->DependencyGraph;
+				}
+
 				UE_LOG_COOK_TIME(TEXT("SerializeDependencyMap"));
 
 				if (EndSavingIfCancelled(Linker, TempFilename)) 
@@ -4528,20 +4772,40 @@ ESavePackageResult UPackage::Save(UPackage* InOuter, UObject* Base, EObjectFlags
 				{
 					FScopedSlowTask BulkDataFeedback(Linker->BulkDataToAppend.Num());
 
+					TArray<TArray<uint8>> PrecompressedPayloads;
+					if (GSavePackageParallelBulkData)
+					{
+						PrecompressBulkDataToAppend(Linker, PrecompressedPayloads);
+					}
+
 					for (int32 i=0; i < Linker->BulkDataToAppend.Num(); ++i)
 					{
 						BulkDataFeedback.EnterProgressFrame();
 
 						FLinkerSave::FBulkDataStorageInfo& BulkDataStorageInfo = Linker->BulkDataToAppend[i];
 
-						// Set bulk data flags to what they were during initial serialization (they might have changed after that)
-						const uint32 OldBulkDataFlags = BulkDataStorageInfo.BulkData->GetBulkDataFlags();
-						BulkDataStorageInfo.BulkData->SetBulkDataFlags(BulkDataStorageInfo.BulkDataFlags);
-
 						int64 BulkStartOffset = Linker->Tell();
 						int64 StoredBulkStartOffset = BulkStartOffset - StartOfBulkDataArea;
 
-						BulkDataStorageInfo.BulkData->SerializeBulkData(*Linker, BulkDataStorageInfo.BulkData->Lock(LOCK_READ_ONLY));
+						if (PrecompressedPayloads.IsValidIndex(i) && PrecompressedPayloads[i].Num())
+						{
+							Linker->Serialize(PrecompressedPayloads[i].GetData(), PrecompressedPayloads[i].Num());
+							PrecompressedPayloads[i].Empty();
+						}
+						else
+						{
+							// Set bulk data flags to what they were during initial serialization (they might have changed after that)
+							const uint32 OldBulkDataFlags = BulkDataStorageInfo.BulkData->GetBulkDataFlags();
+							BulkDataStorageInfo.BulkData->SetBulkDataFlags(BulkDataStorageInfo.BulkDataFlags);
+
+							BulkDataStorageInfo.BulkData->SerializeBulkData(*Linker, BulkDataStorageInfo.BulkData->Lock(LOCK_READ_ONLY));
+
+							// Restore BulkData flags to before serialization started
+							BulkDataStorageInfo.BulkData->ClearBulkDataFlags(0xFFFFFFFF);
+							BulkDataStorageInfo.BulkData->SetBulkDataFlags(OldBulkDataFlags);
+
+							BulkDataStorageInfo.BulkData->Unlock();
+						}
 
 						int64 BulkEndOffset = Linker->Tell();
 						int32 SizeOnDisk = (int32)(BulkEndOffset - BulkStartOffset);
@@ -4553,12 +4817,6 @@ ESavePackageResult UPackage::Save(UPackage* InOuter, UObject* Base, EObjectFlags
 						*Linker << SizeOnDisk;
 
 						Linker->Seek(BulkEndOffset);
-
-						// Restore BulkData flags to before serialization started
-						BulkDataStorageInfo.BulkData->ClearBulkDataFlags(0xFFFFFFFF);
-						BulkDataStorageInfo.BulkData->SetBulkDataFlags(OldBulkDataFlags);
-
-						BulkDataStorageInfo.BulkData->Unlock();
 					}
 				}
 
@@ -4652,7 +4910,11 @@ ESavePackageResult UPackage::Save(UPackage* InOuter, UObject* Base, EObjectFlags
 				Linker->LinkerRoot->ThisRequiresLocalizationGather(Linker->RequiresLocalizationGather());
 				
 				// Update package flags from package, in case serialization has modified package flags.
-				Linker->Summary.PackageFlags = Linker->LinkerRoot->GetPackageFlags() & ~PKG_NewlyCreated;
+				Linker->Summary.PackageFlags = Linker->LinkerRoot->GetPackageFlags() & ~(PKG_NewlyCreated | PKG_UnversionedProperties);
+				if (Linker->UseUnversionedPropertySerialization())
+				{
+					Linker->Summary.PackageFlags |= PKG_UnversionedProperties;
+				}
 
 				Linker->Seek(0);
 				*Linker << Linker->Summary;
@@ -4693,7 +4955,7 @@ ESavePackageResult UPackage::Save(UPackage* InOuter, UObject* Base, EObjectFlags
 							{
 								ExportSizes.Add(Linker->ExportMap[I].SerialSize);
 							}
-							AsyncWriteCompressedFile(*(FBufferArchive*)(Linker->Saver), *NewPath, FinalTimeStamp, Linker->ForceByteSwapping(), Linker->Summary.TotalHeaderSize, ExportSizes);
+							AsyncWriteCompressedFile(MoveTemp(*(FBufferArchive*)(Linker->Saver)), *NewPath, FinalTimeStamp, Linker->ForceByteSwapping(), Linker->Summary.TotalHeaderSize, ExportSizes);
 							Linker->Detach();
 						}
 						UE_LOG_COOK_TIME(TEXT("AsyncWrite"));
@@ -4735,7 +4997,7 @@ ESavePackageResult UPackage::Save(UPackage* InOuter, UObject* Base, EObjectFlags
 						// Detach archive used for memory saving.
 						if( Linker )
 						{
-							AsyncWriteFile(*(FBufferArchive*)(Linker->Saver), *NewPath, FinalTimeStamp);
+							AsyncWriteFile(MoveTemp(*(FBufferArchive*)(Linker->Saver)), *NewPath, FinalTimeStamp);
 							Linker->Detach();
 						}
 						UE_LOG_COOK_TIME(TEXT("AsyncWrite"));
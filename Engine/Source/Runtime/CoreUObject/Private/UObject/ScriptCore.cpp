@@ -777,6 +777,9 @@ void UObject::ProcessInternal( FFrame& Stack, RESULT_DECL )
 		FScopeCycleCounterUObject ContextScope(Stack.Object);
 		FScopeCycleCounterUObject FunctionScope((UFunction*)Stack.Node);
 
+		// Script can store object references in any of this object's properties
+		GarbageCollectionWriteBarrier(this);
+
 		// Execute the bytecode
 		while (*Stack.Code != EX_Return)
 		{
@@ -1908,6 +1911,9 @@ void UObject::ProcessContextOpcode( FFrame& Stack, RESULT_DECL, bool bCanFailSil
 	// Execute or skip the following expression in the object's context.
 	if (bValidContext)
 	{
+		// The expression may write to the context's properties
+		GarbageCollectionWriteBarrier(NewContext);
+
 		Stack.Code += sizeof(CodeSkipSizeType)	// Code offset for NULL expressions.
 			+ sizeof(ScriptPointerType);		// Property corresponding to the r-value data, in case the l-value needs to be cleared
 		Stack.Step( NewContext, RESULT_PARAM );
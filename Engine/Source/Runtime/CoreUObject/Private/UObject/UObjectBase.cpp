@@ -193,6 +193,7 @@ void UObjectBase::LowLevelRename(FName NewName,UObject *NewOuter)
 	if (NewOuter)
 	{
 		Outer = NewOuter;
+		GarbageCollectionWriteBarrier((UObject*)this);
 	}
 	HashObject(this);
 }
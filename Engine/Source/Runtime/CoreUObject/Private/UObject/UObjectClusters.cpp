@@ -27,6 +27,8 @@ static FAutoConsoleVariableRef CMergeGCClusters(
 	ECVF_Default
 	);
 
+bool IsInOldGeneration(int32 ObjectIndex);
+
 #if !UE_BUILD_SHIPPING
 
 // Dumps all clusters to log.
@@ -364,7 +366,12 @@ public:
 			// Add encountered object reference to list of to be serialized objects if it hasn't already been added.
 			if (ObjectItem->GetOwnerIndex() != ClusterRootIndex)
 			{
-				if (ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot) || ObjectItem->GetOwnerIndex() != 0)
+				if (IsInOldGeneration(GUObjectArray.ObjectToIndex(Object)))
+				{
+					// Old objects are collected by major collections like any other so they can't become part of a cluster
+					Cluster.MutableObjects.AddUnique(GUObjectArray.ObjectToIndex(Object));
+				}
+				else if (ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot) || ObjectItem->GetOwnerIndex() != 0)
 				{					
 					if (GMergeGCClusters)
 					{
@@ -629,7 +636,8 @@ public:
 			if (ObjectItem->GetOwnerIndex() == 0)
 			{
 				// We are allowed to reference other clusters, root set objects and objects from diregard for GC pool
-				if (!ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot|EInternalObjectFlags::RootSet) && !GUObjectArray.IsDisregardForGC(Object) && Object->CanBeInCluster())
+				if (!ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot|EInternalObjectFlags::RootSet) && !GUObjectArray.IsDisregardForGC(Object) && Object->CanBeInCluster() &&
+					!IsInOldGeneration(GUObjectArray.ObjectToIndex(Object)))
 				{
 					UE_LOG(LogObj, Warning, TEXT("Object %s from cluster %s is referencing 0x%016llx %s which is not part of root set or cluster."),
 						*ReferencingObject->GetFullName(),
@@ -687,3 +695,367 @@ bool VerifyClusterAssumptions(UObject* ClusterRootObject)
 	ReferenceCollector.CollectReferences(ObjectsToProcess, true);
 	return Processor.NoExternalReferencesFound();
 }
+
+/*-----------------------------------------------------------------------------
+	Generational garbage collection.
+-----------------------------------------------------------------------------*/
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Old Generation Objects"), STAT_GCOldGenerationObjects, STATGROUP_GC);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Old Generation Remembered Objects"), STAT_GCOldGenerationRememberedObjects, STATGROUP_GC);
+
+int32 GGenerationalGC = 0;
+static FAutoConsoleVariableRef CGenerationalGC(
+	TEXT("gc.Generational"),
+	GGenerationalGC,
+	TEXT("If true, objects that survive gc.GenerationalPromotionAge collections are moved to an old generation which is only collected by major collections, minor collections only retrace the direct references of old objects reported by GarbageCollectionWriteBarrier (ignored in the editor and with gc.IncrementalReachability)."),
+	ECVF_Default
+	);
+
+int32 GGenerationalPromotionAge = 3;
+static FAutoConsoleVariableRef CGenerationalPromotionAge(
+	TEXT("gc.GenerationalPromotionAge"),
+	GGenerationalPromotionAge,
+	TEXT("Number of collections an object has to survive before it's promoted to the old generation."),
+	ECVF_Default
+	);
+
+int32 GGenerationalMinorCollectionsPerMajor = 8;
+static FAutoConsoleVariableRef CGenerationalMinorCollectionsPerMajor(
+	TEXT("gc.GenerationalMinorCollectionsPerMajor"),
+	GGenerationalMinorCollectionsPerMajor,
+	TEXT("Number of minor collections between two major collections. Collections that request a full purge are always major."),
+	ECVF_Default
+	);
+
+COREUOBJECT_API bool GHasOldGeneration = false;
+
+/** One bit per object index, set for objects in the old generation */
+static TBitArray<> GOldGenerationBits;
+/** Number of bits set in GOldGenerationBits */
+static int32 GNumOldObjects = 0;
+/** Young objects referenced by old objects, minor collections treat them as roots until the next major collection */
+static TSet<int32> GRememberedObjects;
+/** Number of collections each young object has survived, indexed by object index */
+static TArray<uint8> GGenerationalObjectAges;
+/** Young objects stored by GarbageCollectionStoredReferenceBarrier since the last collection */
+static TArray<int32> GPendingRememberedObjects;
+/** Old objects reported by GarbageCollectionWriteBarrier since the last collection */
+static TArray<int32> GDirtyOldObjects;
+/** One bit per object index, set while the object is in GDirtyOldObjects */
+static TBitArray<> GDirtyOldObjectBits;
+/** Guards GOldGenerationBits, GPendingRememberedObjects, GDirtyOldObjects and GDirtyOldObjectBits */
+static FCriticalSection GPendingRememberedObjectsCritical;
+/** Number of minor collections since the last major one */
+static int32 GNumMinorCollectionsSinceMajor = 0;
+/** Whether the collection in progress is a minor one */
+static bool GIsMinorCollection = false;
+/** Whether generational collection was enabled the last time a collection started */
+static bool GWasGenerationalGCEnabled = false;
+
+bool IsGenerationalGCEnabled()
+{
+	return GGenerationalGC != 0 && !GIsEditor && !IsIncrementalReachabilityAnalysisEnabled();
+}
+
+bool IsInOldGeneration(int32 ObjectIndex)
+{
+	return GHasOldGeneration && ObjectIndex < GOldGenerationBits.Num() && GOldGenerationBits[ObjectIndex];
+}
+
+const TBitArray<>& GetOldGenerationBits()
+{
+	return GOldGenerationBits;
+}
+
+const TSet<int32>& GetGenerationalRememberedSet()
+{
+	return GRememberedObjects;
+}
+
+void AddToGenerationalRememberedSet(const UObject* Object)
+{
+	check(Object);
+	if (!GUObjectAllocator.ResidesInPermanentPool(Object))
+	{
+		const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Object);
+		FUObjectItem* ObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ObjectIndex);
+		if (!ObjectItem->IsUnreachable())
+		{
+			FScopeLock PendingLock(&GPendingRememberedObjectsCritical);
+			GPendingRememberedObjects.Add(ObjectIndex);
+		}
+	}
+}
+
+void MarkOldGenerationObjectDirty(const UObject* Object)
+{
+	check(Object);
+	if (!GUObjectAllocator.ResidesInPermanentPool(Object))
+	{
+		const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Object);
+		FScopeLock PendingLock(&GPendingRememberedObjectsCritical);
+		if (IsInOldGeneration(ObjectIndex))
+		{
+			while (GDirtyOldObjectBits.Num() <= ObjectIndex)
+			{
+				GDirtyOldObjectBits.Add(false);
+			}
+			if (!GDirtyOldObjectBits[ObjectIndex])
+			{
+				GDirtyOldObjectBits[ObjectIndex] = true;
+				GDirtyOldObjects.Add(ObjectIndex);
+			}
+		}
+	}
+}
+
+/** Takes the objects reported by the write barriers since the last collection */
+static void TakePendingGenerationalObjects(TArray<int32>& OutRememberedObjects, TArray<int32>& OutDirtyOldObjects)
+{
+	FScopeLock PendingLock(&GPendingRememberedObjectsCritical);
+	Exchange(OutRememberedObjects, GPendingRememberedObjects);
+	Exchange(OutDirtyOldObjects, GDirtyOldObjects);
+	for (int32 ObjectIndex : OutDirtyOldObjects)
+	{
+		GDirtyOldObjectBits[ObjectIndex] = false;
+	}
+}
+
+/** Moves all objects back to the young generation */
+void DissolveOldGeneration()
+{
+	if (!GHasOldGeneration)
+	{
+		return;
+	}
+	FScopeLock PendingLock(&GPendingRememberedObjectsCritical);
+	GHasOldGeneration = false;
+	GOldGenerationBits.Empty();
+	GNumOldObjects = 0;
+	GRememberedObjects.Empty();
+	GPendingRememberedObjects.Empty();
+	GDirtyOldObjects.Empty();
+	GDirtyOldObjectBits.Empty();
+}
+
+/** Adds the young objects among ObjectIndices to the remembered set, old and unreachable objects are dropped */
+static void AddRememberedObjects(const TArray<int32>& ObjectIndices)
+{
+	for (int32 ObjectIndex : ObjectIndices)
+	{
+		FUObjectItem* ObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ObjectIndex);
+		if (ObjectItem->Object && !ObjectItem->IsUnreachable() && !ObjectItem->IsRootSet() && !IsInOldGeneration(ObjectIndex))
+		{
+			GRememberedObjects.Add(ObjectIndex);
+		}
+	}
+	SET_DWORD_STAT(STAT_GCOldGenerationObjects, GNumOldObjects);
+	SET_DWORD_STAT(STAT_GCOldGenerationRememberedObjects, GRememberedObjects.Num());
+}
+
+/**
+ * Collects the indices of all objects referenced by old generation objects. Unlike FClusterReferenceProcessor this
+ * never adds objects to ObjectsToSerialize, only direct references of old objects are interesting.
+ * References to PendingKill objects are nulled where allowed, like reachability analysis does.
+ */
+class FOldGenerationReferenceProcessor
+{
+	TArray<int32>& ReferencedObjects;
+	volatile bool bIsRunningMultithreaded;
+
+public:
+
+	FOldGenerationReferenceProcessor(TArray<int32>& InReferencedObjects)
+		: ReferencedObjects(InReferencedObjects)
+		, bIsRunningMultithreaded(false)
+	{}
+
+	FORCEINLINE int32 GetMinDesiredObjectsPerSubTask() const
+	{
+		// We're not running the processor in parallel when promoting objects
+		return 0;
+	}
+
+	FORCEINLINE volatile bool IsRunningMultithreaded() const
+	{
+		// This should always be false
+		return bIsRunningMultithreaded;
+	}
+
+	FORCEINLINE void SetIsRunningMultithreaded(bool bIsParallel)
+	{
+		check(!bIsParallel);
+		bIsRunningMultithreaded = bIsParallel;
+	}
+
+	void UpdateDetailedStats(UObject* CurrentObject, uint32 DeltaCycles)
+	{
+	}
+
+	void LogDetailedStatsSummary()
+	{
+	}
+
+	FORCEINLINE void HandleTokenStreamObjectReference(TArray<UObject*>& ObjectsToSerialize, UObject* ReferencingObject, UObject*& Object, const int32 TokenIndex, bool bAllowReferenceElimination)
+	{
+		if (Object && !GUObjectArray.IsDisregardForGC(Object))
+		{
+			const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Object);
+			if (bAllowReferenceElimination && GUObjectArray.IndexToObjectUnsafeForGC(ObjectIndex)->IsPendingKill())
+			{
+				Object = nullptr;
+			}
+			else
+			{
+				ReferencedObjects.Add(ObjectIndex);
+			}
+		}
+	}
+};
+
+/** Adds the indices of all objects directly referenced by Objects to ReferencedObjects */
+static void CollectOldGenerationReferences(const TArray<UObject*>& Objects, TArray<int32>& ReferencedObjects)
+{
+	FOldGenerationReferenceProcessor Processor(ReferencedObjects);
+	TFastReferenceCollector<FOldGenerationReferenceProcessor, TClusterCollector<FOldGenerationReferenceProcessor>, FClusterArrayPool, true> ReferenceCollector(Processor, FClusterArrayPool::Get());
+	TArray<UObject*> ObjectsToProcess(Objects);
+	ReferenceCollector.CollectReferences(ObjectsToProcess, true);
+}
+
+/** Whether a young object that survived a collection can be moved to the old generation */
+static FORCEINLINE bool CanBePromoted(FUObjectItem* ObjectItem, UObject* Object)
+{
+	// Objects that are still being loaded don't have all their references yet
+	return ObjectItem->GetOwnerIndex() == 0 &&
+		!ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot | EInternalObjectFlags::RootSet | EInternalObjectFlags::PendingKill | EInternalObjectFlags::GarbageCollectionKeepFlags) &&
+		!Object->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad | RF_NeedInitialization) &&
+		Object->CanBeInCluster();
+}
+
+bool BeginGenerationalCollection(bool bForceMajor)
+{
+	const bool bEnabled = IsGenerationalGCEnabled();
+	if (bEnabled != GWasGenerationalGCEnabled)
+	{
+		// Ages weren't kept up to date while generational collection was disabled
+		GGenerationalObjectAges.Empty();
+		GWasGenerationalGCEnabled = bEnabled;
+	}
+	if (!bEnabled)
+	{
+		DissolveOldGeneration();
+	}
+
+	TArray<int32> RememberedObjects;
+	TArray<int32> DirtyOldObjects;
+	TakePendingGenerationalObjects(RememberedObjects, DirtyOldObjects);
+
+	GIsMinorCollection = bEnabled && GHasOldGeneration && !bForceMajor && GNumMinorCollectionsSinceMajor < GGenerationalMinorCollectionsPerMajor;
+	if (GIsMinorCollection)
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("BeginGenerationalCollection"), STAT_BeginGenerationalCollection, STATGROUP_GC);
+
+		// Only old objects written to since the last collection can reference young objects the remembered set doesn't
+		// know about yet. Entries are never removed before the next major collection, an old object that stopped
+		// referencing a young one keeps it alive until then.
+		TArray<UObject*> OldObjects;
+		OldObjects.Reserve(DirtyOldObjects.Num());
+		for (int32 ObjectIndex : DirtyOldObjects)
+		{
+			if (UObject* Object = static_cast<UObject*>(GUObjectArray.IndexToObjectUnsafeForGC(ObjectIndex)->Object))
+			{
+				OldObjects.Add(Object);
+			}
+		}
+		CollectOldGenerationReferences(OldObjects, RememberedObjects);
+		AddRememberedObjects(RememberedObjects);
+		GNumMinorCollectionsSinceMajor++;
+	}
+	else
+	{
+		// Major collections trace old objects like any other, the remembered set is rebuilt from the survivors afterwards
+		GRememberedObjects.Empty();
+		GNumMinorCollectionsSinceMajor = 0;
+	}
+	return GIsMinorCollection;
+}
+
+void EndGenerationalCollection()
+{
+	if (!IsGenerationalGCEnabled())
+	{
+		return;
+	}
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("EndGenerationalCollection"), STAT_EndGenerationalCollection, STATGROUP_GC);
+
+	const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+	if (GGenerationalObjectAges.Num() < NumObjects)
+	{
+		GGenerationalObjectAges.AddZeroed(NumObjects - GGenerationalObjectAges.Num());
+	}
+
+	// After a major collection every surviving old object is traced once to rebuild the remembered set
+	TArray<UObject*> ObjectsToTrace;
+	TArray<int32> PromotedObjectIndices;
+	const uint8 PromotionAge = (uint8)FMath::Clamp(GGenerationalPromotionAge, 1, 255);
+	{
+		FScopeLock PendingLock(&GPendingRememberedObjectsCritical);
+		for (FRawObjectIterator It(true); It; ++It)
+		{
+			FUObjectItem* ObjectItem = *It;
+			const int32 ObjectIndex = It.GetIndex();
+			const bool bOld = IsInOldGeneration(ObjectIndex);
+			uint8& Age = GGenerationalObjectAges[ObjectIndex];
+			if (ObjectItem->IsUnreachable())
+			{
+				// The slot will be reused by a new object after the purge
+				Age = 0;
+				if (bOld)
+				{
+					GOldGenerationBits[ObjectIndex] = false;
+					GNumOldObjects--;
+				}
+			}
+			else if (bOld)
+			{
+				if (!GIsMinorCollection)
+				{
+					ObjectsToTrace.Add(static_cast<UObject*>(ObjectItem->Object));
+				}
+			}
+			else if (ObjectItem->GetOwnerIndex() == 0)
+			{
+				Age = (uint8)FMath::Min<int32>(Age + 1, 255);
+				UObject* Object = static_cast<UObject*>(ObjectItem->Object);
+				if (Age >= PromotionAge && CanBePromoted(ObjectItem, Object))
+				{
+					ObjectsToTrace.Add(Object);
+					PromotedObjectIndices.Add(ObjectIndex);
+				}
+			}
+		}
+
+		// Remember everything promoted objects reference before they stop being traced by minor collections
+		for (int32 ObjectIndex : PromotedObjectIndices)
+		{
+			while (GOldGenerationBits.Num() <= ObjectIndex)
+			{
+				GOldGenerationBits.Add(false);
+			}
+			GOldGenerationBits[ObjectIndex] = true;
+			GRememberedObjects.Remove(ObjectIndex);
+		}
+		GNumOldObjects += PromotedObjectIndices.Num();
+		GHasOldGeneration = GNumOldObjects > 0;
+	}
+
+	TArray<int32> ReferencedObjects;
+	CollectOldGenerationReferences(ObjectsToTrace, ReferencedObjects);
+	AddRememberedObjects(ReferencedObjects);
+
+	if (PromotedObjectIndices.Num())
+	{
+		UE_LOG(LogGarbage, Log, TEXT("Promoted %d objects to the old generation (%d old objects, %d remembered)."),
+			PromotedObjectIndices.Num(), GNumOldObjects, GRememberedObjects.Num());
+	}
+}
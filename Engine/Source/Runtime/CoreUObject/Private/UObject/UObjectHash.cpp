@@ -5,6 +5,7 @@
 =============================================================================*/
 
 #include "CoreUObjectPrivate.h"
+#include "TaskGraphInterfaces.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogUObjectHash, Log, All);
 
@@ -37,242 +38,344 @@ FUObjectArray GUObjectArray;
 */
 #define OBJECT_HASH_BINS (1024*1024)
 
-/*
- * Special hash bucket to conserve memory.
- * Contains a pointer to head element and an optional list of items if more than one element exists in the bucket.
- * The item list is only allocated if needed.
+/**
+ * Number of independently locked stripes the hash tables are split into. Name hashes are striped by their low
+ * bits, outer and class maps by the outer and class pointers.
+ *
+ * NOTE: This must be power of 2 and match OBJECT_HASH_STRIPE_SHIFT
+ */
+#define OBJECT_HASH_STRIPES 64
+#define OBJECT_HASH_STRIPE_SHIFT 6
+
+/** Number of name hash bins each stripe starts with, stripes grow up to OBJECT_HASH_BINS / OBJECT_HASH_STRIPES bins */
+#define OBJECT_HASH_STRIPE_MIN_BINS 256
+
+/** Number of unlinked hash nodes a stripe keeps around before it tries to recycle them outside of GC */
+#define OBJECT_HASH_STRIPE_MAX_RETIRED_NODES 1024
+
+/**
+ * Hash chain node. Once a node is linked into a chain only its Next pointer ever changes and only with the stripe
+ * locked, so lock-free readers can walk the chain while it's being modified. Unlinked nodes are retired and only
+ * recycled once no reader can still be walking them.
  */
-struct FHashBucket
+struct FHashNode
+{
+	UObjectBase* Object;
+	int32 Hash;
+	FHashNode* volatile Next;
+};
+
+/** Bin array of a stripe's name hash. Never resized in place, growing publishes a new array with new nodes. */
+struct FHashBins
+{
+	int32 NumBins;
+	FHashNode* volatile* Heads;
+
+	static FHashBins* Create(int32 InNumBins)
+	{
+		checkSlow(FMath::IsPowerOfTwo(InNumBins));
+		FHashBins* Bins = new FHashBins;
+		Bins->NumBins = InNumBins;
+		Bins->Heads = (FHashNode* volatile*)FMemory::Malloc(InNumBins * sizeof(FHashNode*));
+		FMemory::Memzero((void*)Bins->Heads, InNumBins * sizeof(FHashNode*));
+		return Bins;
+	}
+	static void Destroy(FHashBins* Bins)
+	{
+		FMemory::Free((void*)Bins->Heads);
+		delete Bins;
+	}
+	/** Returns the head of the chain the hash belongs to. The low bits of the hash select the stripe and are the same for all nodes. */
+	FORCEINLINE FHashNode* volatile& GetHead(int32 InHash) const
+	{
+		return Heads[(InHash >> OBJECT_HASH_STRIPE_SHIFT) & (NumBins - 1)];
+	}
+	FORCEINLINE uint32 GetAllocatedSize() const
+	{
+		return (uint32)(sizeof(*this) + NumBins * sizeof(FHashNode*));
+	}
+};
+
+/** One of the name hashes of a stripe */
+struct FHashChains
 {
-	friend struct FHashBucketIterator;
-
-	/** This always empty set is used to get an iterator if the bucket doesn't use a TSet (has only 1 element) */
-	static TSet<UObjectBase*> EmptyBucket;
-	/** Used when the bucket has only one item, does not necessarily represent the first item if Items TSet is non-null */
-	UObjectBase* Head;
-	/** If more than one items belongs to this bucket this is non-null and contains all elements of this bucker (including Head element) */
-	TSet<UObjectBase*>* Items;
-
-	/** Constructor */
-	FHashBucket()
-		: Head(nullptr)
-		, Items(nullptr)
+	FHashBins* volatile Bins;
+	int32 NumNodes;
+
+	FHashChains()
+		: Bins(FHashBins::Create(OBJECT_HASH_STRIPE_MIN_BINS))
+		, NumNodes(0)
 	{}
-	~FHashBucket()
+	~FHashChains()
 	{
-		delete Items;
+		FHashBins::Destroy(Bins);
 	}
-	/** Adds an Object to the bucket */
-	FORCEINLINE void Add(UObjectBase* Object)
+};
+
+/**
+ * A single stripe of the hash tables.
+ * Name hashes can be read without locking by registering with NumReaders (see FHashStripeReadScope), everything else
+ * including all modifications requires CriticalSection to be locked.
+ */
+MS_ALIGN(PLATFORM_CACHE_LINE_SIZE) class FUObjectHashStripe
+{
+	/** Nodes unlinked from the name hashes which lock-free readers may still be walking */
+	TArray<FHashNode*> RetiredNodes;
+	/** Bin arrays replaced by bigger ones which lock-free readers may still be walking */
+	TArray<FHashBins*> RetiredBins;
+	/** Recycled nodes */
+	FHashNode* FreeNodes;
+
+public:
+
+	FCriticalSection CriticalSection;
+	/** Number of lock-free readers currently walking the name hashes of this stripe */
+	FThreadSafeCounter NumReaders;
+
+	/** Name hash and name + outer hash of all objects whose hash falls into this stripe */
+	FHashChains Hash;
+	FHashChains HashOuter;
+
+	/** Map of object to their outers, used to avoid an object iterator to find such things. Contains the outers that fall into this stripe. **/
+	TMap<UObjectBase*, TSet<UObjectBase*> > ObjectOuterMap;
+	/** Map of class to their objects. Contains the classes that fall into this stripe. **/
+	TMap<UClass*, TSet<UObjectBase*> > ClassToObjectListMap;
+
+	FUObjectHashStripe()
+		: FreeNodes(nullptr)
 	{
-		if (Items)
-		{
-			Items->Add(Object);
-		}
-		else if (Head)
-		{
-			Items = new TSet<UObjectBase*>();
-			Items->Add(Head);
-			Items->Add(Object);
-		}
-		else
+	}
+	~FUObjectHashStripe()
+	{
+		ReclaimRetired();
+		FreeChains(Hash);
+		FreeChains(HashOuter);
+		while (FreeNodes)
 		{
-			Head = Object;
+			FHashNode* Node = FreeNodes;
+			FreeNodes = Node->Next;
+			delete Node;
 		}
 	}
-	/** Removes an Object from the bucket */
-	FORCEINLINE int32 Remove(UObjectBase* Object)
+
+	/** Checks if the Hash/Object pair exists in the chains */
+	FORCEINLINE bool PairExistsInHash(const FHashChains& Chains, int32 InHash, UObjectBase* Object) const
 	{
-		int32 Result = 0;
-		if (Items)
+		for (FHashNode* Node = Chains.Bins->GetHead(InHash); Node; Node = Node->Next)
 		{
-			Result = Items->Remove(Object);
-			if (Items->Num() <= 1)
+			if (Node->Object == Object && Node->Hash == InHash)
 			{
-				if (Items->Num() == 1)
-				{
-					Head = *TSet<UObjectBase*>::TIterator(*Items);
-				}
-				else
-				{
-					// This is probably a bug, we should be able to delete Items set when it has 1 element.
-					Head = nullptr;
-				}
-				delete Items;
-				Items = nullptr;
-			}
-			else if (Head == Object)
-			{
-				Head = *TSet<UObjectBase*>::TIterator(*Items);
+				return true;
 			}
 		}
-		else
-		{
-			check(Head == Object);
-			Head = nullptr;
-			Result = 1;
-		}
-		return Result;
+		return false;
 	}
-	/** Checks if an Object exists in this bucket */
-	FORCEINLINE bool Contains(UObjectBase* Object) const
+	/** Adds the Hash/Object pair to the chains, requires the stripe to be locked */
+	void AddToHash(FHashChains& Chains, int32 InHash, UObjectBase* Object)
 	{
-		bool bContains = (Head == Object);
-		if (!bContains && Items)
+		if (Chains.NumNodes >= Chains.Bins->NumBins * 2 && Chains.Bins->NumBins < (OBJECT_HASH_BINS >> OBJECT_HASH_STRIPE_SHIFT))
 		{
-			bContains = Items->Contains(Object);
+			Grow(Chains);
 		}
-		return bContains;
+		FHashNode* volatile& Head = Chains.Bins->GetHead(InHash);
+		FHashNode* Node = AllocateNode(Object, InHash, Head);
+		// The node has to be fully visible before it's reachable from the bins
+		FPlatformMisc::MemoryBarrier();
+		Head = Node;
+		Chains.NumNodes++;
 	}
-	/** Returns the number of Objects in this bucket */
-	FORCEINLINE int32 Num() const
+	/** Removes the Hash/Object pair from the chains, requires the stripe to be locked */
+	int32 RemoveFromHash(FHashChains& Chains, int32 InHash, UObjectBase* Object)
 	{
-		int32 Result = 0;
-		if (Items)
-		{
-			Result = Items->Num();
-		}
-		else if (Head)
+		for (FHashNode* volatile* Link = &Chains.Bins->GetHead(InHash); *Link; Link = &(*Link)->Next)
 		{
-			Result = 1;
+			FHashNode* Node = *Link;
+			if (Node->Object == Object && Node->Hash == InHash)
+			{
+				// Readers that are already on Node can still follow its Next pointer
+				*Link = Node->Next;
+				Chains.NumNodes--;
+				RetiredNodes.Add(Node);
+				if (RetiredNodes.Num() >= OBJECT_HASH_STRIPE_MAX_RETIRED_NODES)
+				{
+					TryReclaimRetired();
+				}
+				return 1;
+			}
 		}
-		return Result;
+		return 0;
 	}
-	/** Returns the amount of memory allocated for and by Items TSet */
-	FORCEINLINE uint32 GetItemsSize() const
+	/** Recycles retired nodes and bins. Requires the stripe to be locked and no lock-free readers in this stripe. */
+	void ReclaimRetired()
 	{
-		uint32 AllocatedSize = 0;
-		if (Items)
+		for (FHashNode* Node : RetiredNodes)
 		{
-			AllocatedSize = (uint32)sizeof(*Items) + Items->GetAllocatedSize();
+			Node->Next = FreeNodes;
+			FreeNodes = Node;
 		}
-		return AllocatedSize;
+		RetiredNodes.Reset();
+		for (FHashBins* Bins : RetiredBins)
+		{
+			FHashBins::Destroy(Bins);
+		}
+		RetiredBins.Reset();
 	}
-private:
-	/** Gets an iterator for the TSet in this bucket or for the EmptyBucker if Items is null */
-	FORCEINLINE TSet<UObjectBase*>::TIterator GetIteratorForSet()
+	/** Returns the memory allocated by the chains */
+	uint32 GetAllocatedSize(const FHashChains& Chains) const
 	{
-		return Items ? Items->CreateIterator() : EmptyBucket.CreateIterator();
+		return Chains.Bins->GetAllocatedSize() + Chains.NumNodes * sizeof(FHashNode);
 	}
-};
-TSet<UObjectBase*> FHashBucket::EmptyBucket;
 
-/** Hash Bucket Iterator. Iterates over all Objects in the bucket */
-struct FHashBucketIterator
-{
-	FHashBucket& Bucket;
-	TSet<UObjectBase*>::TIterator SetIterator;
-	bool bReachedEndNoItems;
+private:
 
-	FORCEINLINE FHashBucketIterator(FHashBucket& InBucket)
-		: Bucket(InBucket)
-		, SetIterator(InBucket.GetIteratorForSet())
-		, bReachedEndNoItems(InBucket.Head == nullptr)
-	{
-	}
-	/** Advances the iterator to the next element. */
-	FORCEINLINE FHashBucketIterator& operator++()
+	FORCEINLINE FHashNode* AllocateNode(UObjectBase* Object, int32 InHash, FHashNode* Next)
 	{
-		if (Bucket.Items)
+		FHashNode* Node = FreeNodes;
+		if (Node)
 		{
-			++SetIterator;
+			FreeNodes = Node->Next;
 		}
 		else
 		{
-			bReachedEndNoItems = true;
+			Node = new FHashNode;
 		}
-		return *this;
+		Node->Object = Object;
+		Node->Hash = InHash;
+		Node->Next = Next;
+		return Node;
 	}
-	/** conversion to "bool" returning true if the iterator is valid. */
-	FORCEINLINE_EXPLICIT_OPERATOR_BOOL() const
+	/** Recycles retired nodes if no lock-free reader can be walking them */
+	void TryReclaimRetired()
 	{
-		if (Bucket.Items)
+		// Readers register before they load any bins, so once the nodes are unlinked and there are no readers no one can reach them anymore
+		FPlatformMisc::MemoryBarrier();
+		if (NumReaders.GetValue() == 0)
 		{
-			return (bool)SetIterator;
+			ReclaimRetired();
 		}
-		else
-		{
-			return !bReachedEndNoItems;
-		}
-	}
-	/** inverse of the "bool" operator */
-	FORCEINLINE bool operator !() const
-	{
-		return !(bool)*this;
 	}
-	FORCEINLINE UObjectBase*& operator*()
+	/** Publishes twice as many bins. Existing nodes are copied so that readers of the old bins are unaffected. */
+	void Grow(FHashChains& Chains)
 	{
-		if (Bucket.Items)
+		FHashBins* OldBins = Chains.Bins;
+		FHashBins* NewBins = FHashBins::Create(OldBins->NumBins * 2);
+		for (int32 BinIndex = 0; BinIndex < OldBins->NumBins; BinIndex++)
 		{
-			return *SetIterator;
+			for (FHashNode* Node = OldBins->Heads[BinIndex]; Node; Node = Node->Next)
+			{
+				FHashNode* volatile& Head = NewBins->GetHead(Node->Hash);
+				Head = AllocateNode(Node->Object, Node->Hash, Head);
+				RetiredNodes.Add(Node);
+			}
 		}
-		else
+		FPlatformMisc::MemoryBarrier();
+		Chains.Bins = NewBins;
+		RetiredBins.Add(OldBins);
+	}
+	void FreeChains(FHashChains& Chains)
+	{
+		for (int32 BinIndex = 0; BinIndex < Chains.Bins->NumBins; BinIndex++)
 		{
-			return Bucket.Head;
+			for (FHashNode* Node = Chains.Bins->Heads[BinIndex]; Node; )
+			{
+				FHashNode* Next = Node->Next;
+				delete Node;
+				Node = Next;
+			}
 		}
 	}
-};
+} GCC_ALIGN(PLATFORM_CACHE_LINE_SIZE);
 
 class FUObjectHashTables
 {
-	FCriticalSection CriticalSection;
+	/** Hash stripes */
+	FUObjectHashStripe Stripes[OBJECT_HASH_STRIPES];
+	/** Thread that currently holds all stripes (see LockUObjectHashTables) */
+	volatile uint32 ExclusiveThreadId;
+	/** Non-zero while a thread holds or is acquiring all stripes */
+	volatile int32 bExclusive;
+	/** Number of times the exclusive thread has locked all stripes */
+	int32 ExclusiveLockCount;
 
 public:
 
-	/** Hash sets */
-	TMap<int32, FHashBucket> Hash;
-	TMultiMap<int32, class UObjectBase*> HashOuter;
-
-	/** Map of object to their outers, used to avoid an object iterator to find such things. **/
-	TMap<UObjectBase*, TSet<UObjectBase*> > ObjectOuterMap;
-	TMap<UClass*, TSet<UObjectBase*> > ClassToObjectListMap;
+	/** Guards ClassToChildListMap. Classes are rarely created so this one isn't striped. */
+	FCriticalSection ClassToChildListCritical;
 	TMap<UClass*, TSet<UClass*> > ClassToChildListMap;
 
 	FUObjectHashTables()
+		: ExclusiveThreadId(0)
+		, bExclusive(0)
+		, ExclusiveLockCount(0)
 	{
 	}
 
-	/** Checks if the Hash/Object pair exists in the FName hash table */
-	FORCEINLINE bool PairExistsInHash(int32 InHash, UObjectBase* Object)
+	/** Returns the stripe that owns a name hash */
+	FORCEINLINE FUObjectHashStripe& GetStripe(int32 InHash)
 	{
-		bool bResult = false;
-		FHashBucket* Bucket = Hash.Find(InHash);
-		if (Bucket)
-		{
-			bResult = Bucket->Contains(Object);
-		}
-		return bResult;
+		return Stripes[InHash & (OBJECT_HASH_STRIPES - 1)];
 	}
-	/** Adds the Hash/Object pair to the FName hash table */
-	FORCEINLINE void AddToHash(int32 InHash, UObjectBase* Object)
+	/** Returns the stripe that owns an outer or class key */
+	FORCEINLINE FUObjectHashStripe& GetStripe(const UObjectBase* Key)
 	{
-		FHashBucket& Bucket = Hash.FindOrAdd(InHash);
-		Bucket.Add(Object);
+		return Stripes[PointerHash(Key) & (OBJECT_HASH_STRIPES - 1)];
 	}
-	/** Removes the Hash/Object pair from the FName hash table */
-	FORCEINLINE int32 RemoveFromHash(int32 InHash, UObjectBase* Object)
+	FORCEINLINE FUObjectHashStripe& GetStripeByIndex(int32 StripeIndex)
 	{
-		int32 NumRemoved = 0;
-		FHashBucket* Bucket = Hash.Find(InHash);
-		if (Bucket)
+		return Stripes[StripeIndex];
+	}
+
+	/** Returns true if the current thread holds all stripes */
+	FORCEINLINE bool IsLockedByCurrentThread() const
+	{
+		return ExclusiveThreadId == FPlatformTLS::GetCurrentThreadId();
+	}
+	/** Returns true if any thread holds or is acquiring all stripes */
+	FORCEINLINE bool IsLockedExclusively() const
+	{
+		return bExclusive != 0;
+	}
+
+	/** Locks all stripes and waits for lock-free readers to leave. Recursive. */
+	void Lock()
+	{
+		if (IsLockedByCurrentThread())
+		{
+			ExclusiveLockCount++;
+			return;
+		}
+		for (FUObjectHashStripe& Stripe : Stripes)
 		{
-			NumRemoved = Bucket->Remove(Object);
-			if (Bucket->Num() == 0)
+			Stripe.CriticalSection.Lock();
+		}
+		ClassToChildListCritical.Lock();
+		ExclusiveThreadId = FPlatformTLS::GetCurrentThreadId();
+		FPlatformAtomics::InterlockedExchange(&bExclusive, 1);
+		// New readers see bExclusive and fall back to locking their stripe, only wait for the ones that are already in
+		for (FUObjectHashStripe& Stripe : Stripes)
+		{
+			while (Stripe.NumReaders.GetValue() != 0)
 			{
-				Hash.Remove(InHash);
+				FPlatformProcess::Sleep(0.0f);
 			}
+			Stripe.ReclaimRetired();
 		}
-		return NumRemoved;
-	}
-
-	FORCEINLINE void Lock()
-	{
-		CriticalSection.Lock();
+		ExclusiveLockCount = 1;
 	}
 
-	FORCEINLINE void Unlock()
+	void Unlock()
 	{
-		CriticalSection.Unlock();
+		check(IsLockedByCurrentThread());
+		if (--ExclusiveLockCount == 0)
+		{
+			ExclusiveThreadId = 0;
+			FPlatformAtomics::InterlockedExchange(&bExclusive, 0);
+			ClassToChildListCritical.Unlock();
+			for (int32 StripeIndex = OBJECT_HASH_STRIPES - 1; StripeIndex >= 0; StripeIndex--)
+			{
+				Stripes[StripeIndex].CriticalSection.Unlock();
+			}
+		}
 	}
 
 	static FUObjectHashTables& Get()
@@ -282,18 +385,20 @@ public:
 	}
 };
 
+/** Locks one of the hash table locks unless the current thread already holds all of them */
 class FHashTableLock
 {
-	FUObjectHashTables& Tables;
+	FCriticalSection* LockedCritical;
 public:
-	FORCEINLINE FHashTableLock(FUObjectHashTables& InTables)
-		: Tables(InTables)
+	FORCEINLINE FHashTableLock(FUObjectHashTables& Tables, FCriticalSection& Critical)
+		: LockedCritical(nullptr)
 	{
 #if THREADSAFE_UOBJECTS
 		// GC locks everything on the main thread so no need to lock here
-		if (!(IsGarbageCollecting() && IsInGameThread()))
+		if (!Tables.IsLockedByCurrentThread())
 		{
-			Tables.Lock();
+			LockedCritical = &Critical;
+			LockedCritical->Lock();
 		}
 #else
 		check(IsInGameThread());
@@ -302,9 +407,56 @@ public:
 	FORCEINLINE ~FHashTableLock()
 	{
 #if THREADSAFE_UOBJECTS
-		if (!(IsGarbageCollecting() && IsInGameThread()))
+		if (LockedCritical)
+		{
+			LockedCritical->Unlock();
+		}
+#endif
+	}
+};
+
+/**
+ * Lets the current thread walk the name hashes of a stripe without locking it. While another thread holds all
+ * hash tables (GC) this falls back to waiting on the stripe lock.
+ */
+class FHashStripeReadScope
+{
+	FUObjectHashStripe* CountedStripe;
+	FUObjectHashStripe* LockedStripe;
+public:
+	FORCEINLINE FHashStripeReadScope(FUObjectHashTables& Tables, FUObjectHashStripe& Stripe)
+		: CountedStripe(nullptr)
+		, LockedStripe(nullptr)
+	{
+#if THREADSAFE_UOBJECTS
+		if (!Tables.IsLockedByCurrentThread())
 		{
-			Tables.Unlock();
+			Stripe.NumReaders.Increment();
+			if (!Tables.IsLockedExclusively())
+			{
+				CountedStripe = &Stripe;
+			}
+			else
+			{
+				Stripe.NumReaders.Decrement();
+				LockedStripe = &Stripe;
+				LockedStripe->CriticalSection.Lock();
+			}
+		}
+#else
+		check(IsInGameThread());
+#endif
+	}
+	FORCEINLINE ~FHashStripeReadScope()
+	{
+#if THREADSAFE_UOBJECTS
+		if (CountedStripe)
+		{
+			CountedStripe->NumReaders.Decrement();
+		}
+		else if (LockedStripe)
+		{
+			LockedStripe->CriticalSection.Unlock();
 		}
 #endif
 	}
@@ -338,31 +490,30 @@ UObject* StaticFindObjectFastExplicitThreadSafe(FUObjectHashTables& ThreadHash,
 {
 	// Find an object with the specified name and (optional) class, in any package; if bAnyPackage is false, only matches top-level packages
 	int32 Hash = GetObjectHash(ObjectName);
-	FHashTableLock HashLock(ThreadHash);
-	FHashBucket* Bucket = ThreadHash.Hash.Find(Hash);
-	if (Bucket)
+	FUObjectHashStripe& Stripe = ThreadHash.GetStripe(Hash);
+	FHashStripeReadScope ReadScope(ThreadHash, Stripe);
+	for (FHashNode* Node = Stripe.Hash.Bins->GetHead(Hash); Node; Node = Node->Next)
 	{
-		for (FHashBucketIterator It(*Bucket); It; ++It)
-		{
-			UObject* Object = (UObject*)*It;
-			if
-				((Object->GetFName() == ObjectName)
+		UObject* Object = (UObject*)Node->Object;
+		if
+			((Node->Hash == Hash)
 
-				/* Don't return objects that have any of the exclusive flags set */
-				&& !Object->HasAnyFlags(ExcludeFlags)
+			&& (Object->GetFName() == ObjectName)
 
-				/** If a class was specified, check that the object is of the correct class */
-				&& (ObjectClass == nullptr || (bExactClass ? Object->GetClass() == ObjectClass : Object->IsA(ObjectClass)))
-				)
+			/* Don't return objects that have any of the exclusive flags set */
+			&& !Object->HasAnyFlags(ExcludeFlags)
 
+			/** If a class was specified, check that the object is of the correct class */
+			&& (ObjectClass == nullptr || (bExactClass ? Object->GetClass() == ObjectClass : Object->IsA(ObjectClass)))
+			)
+
+		{
+			FString ObjectPath = Object->GetPathName();
+			/** Finally check the explicit path */
+			if (ObjectPath == ObjectPathName)
 			{
-				FString ObjectPath = Object->GetPathName();
-				/** Finally check the explicit path */
-				if (ObjectPath == ObjectPathName)
-				{
-					checkf(!Object->IsUnreachable(), TEXT("%s"), *Object->GetFullName());
-					return Object;
-				}
+				checkf(!Object->IsUnreachable(), TEXT("%s"), *Object->GetFullName());
+				return Object;
 			}
 		}
 	}
@@ -400,13 +551,16 @@ UObject* StaticFindObjectFastInternalThreadSafe(FUObjectHashTables& ThreadHash,
 	if (ObjectPackage != nullptr)
 	{
 		int32 Hash = GetObjectOuterHash(ObjectName, (PTRINT)ObjectPackage);
-		FHashTableLock HashLock(ThreadHash);
-		for (TMultiMap<int32, class UObjectBase*>::TConstKeyIterator HashIt(ThreadHash.HashOuter, Hash); HashIt; ++HashIt)
+		FUObjectHashStripe& Stripe = ThreadHash.GetStripe(Hash);
+		FHashStripeReadScope ReadScope(ThreadHash, Stripe);
+		for (FHashNode* Node = Stripe.HashOuter.Bins->GetHead(Hash); Node; Node = Node->Next)
 		{
-			UObject *Object = (UObject *)HashIt.Value();
+			UObject *Object = (UObject *)Node->Object;
 			if
+				((Node->Hash == Hash)
+
 				/* check that the name matches the name we're searching for */
-				((Object->GetFName() == ObjectName)
+				&& (Object->GetFName() == ObjectName)
 
 				/* Don't return objects that have any of the exclusive flags set */
 				&& !Object->HasAnyFlags(ExcludeFlags)
@@ -447,45 +601,44 @@ UObject* StaticFindObjectFastInternalThreadSafe(FUObjectHashTables& ThreadHash,
 			ActualObjectName = FName(*ObjectNameString.Mid(DotIndex + 1));
 		}
 		const int32 Hash = GetObjectHash(ActualObjectName);
-		FHashTableLock HashLock(ThreadHash);
+		FUObjectHashStripe& Stripe = ThreadHash.GetStripe(Hash);
+		FHashStripeReadScope ReadScope(ThreadHash, Stripe);
 
-		FHashBucket* Bucket = ThreadHash.Hash.Find(Hash);
-		if (Bucket)
+		for (FHashNode* Node = Stripe.Hash.Bins->GetHead(Hash); Node; Node = Node->Next)
 		{
-			for (FHashBucketIterator It(*Bucket); It; ++It)
-			{
-				UObject* Object = (UObject*)*It;
-				if
-					((Object->GetFName() == ActualObjectName)
+			UObject* Object = (UObject*)Node->Object;
+			if
+				((Node->Hash == Hash)
+
+				&& (Object->GetFName() == ActualObjectName)
 
-					/* Don't return objects that have any of the exclusive flags set */
-					&& !Object->HasAnyFlags(ExcludeFlags)
+				/* Don't return objects that have any of the exclusive flags set */
+				&& !Object->HasAnyFlags(ExcludeFlags)
 
-					/*If there is no package (no InObjectPackage specified, and InName's package is "")
-					and the caller specified any_package, then accept it, regardless of its package.
-					Or, if the object is a top-level package then accept it immediately.*/
-					&& (bAnyPackage || !Object->GetOuter())
+				/*If there is no package (no InObjectPackage specified, and InName's package is "")
+				and the caller specified any_package, then accept it, regardless of its package.
+				Or, if the object is a top-level package then accept it immediately.*/
+				&& (bAnyPackage || !Object->GetOuter())
 
 
-					/** If a class was specified, check that the object is of the correct class */
-					&& (ObjectClass == nullptr || (bExactClass ? Object->GetClass() == ObjectClass : Object->IsA(ObjectClass)))
+				/** If a class was specified, check that the object is of the correct class */
+				&& (ObjectClass == nullptr || (bExactClass ? Object->GetClass() == ObjectClass : Object->IsA(ObjectClass)))
 
-					/** Ensure that the partial path provided matches the object found */
-					&& (Object->GetPathName().EndsWith(ObjectNameString)))
+				/** Ensure that the partial path provided matches the object found */
+				&& (Object->GetPathName().EndsWith(ObjectNameString)))
+			{
+				checkf(!Object->IsUnreachable(), TEXT("%s"), *Object->GetFullName());
+				if (Result)
 				{
-					checkf(!Object->IsUnreachable(), TEXT("%s"), *Object->GetFullName());
-					if (Result)
-					{
-						UE_LOG(LogUObjectHash, Warning, TEXT("Ambiguous search, could be %s or %s"), *GetFullNameSafe(Result), *GetFullNameSafe(Object));
-					}
-					else
-					{
-						Result = Object;
-					}
+					UE_LOG(LogUObjectHash, Warning, TEXT("Ambiguous search, could be %s or %s"), *GetFullNameSafe(Result), *GetFullNameSafe(Object));
+				}
+				else
+				{
+					Result = Object;
+				}
 #if (UE_BUILD_SHIPPING || UE_BUILD_TEST)
-					break;
+				break;
 #endif
-				}
 			}
 		}
 	}
@@ -505,21 +658,23 @@ UObject* StaticFindObjectFastInternal(UClass* ObjectClass, UObject* ObjectPackag
 	return Result;
 }
 
-// Assumes that ThreadHash's critical is already locked
 static void AddToOuterMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 {
-	TSet<UObjectBase*>& Inners = ThreadHash.ObjectOuterMap.FindOrAdd(Object->GetOuter());
+	FUObjectHashStripe& Stripe = ThreadHash.GetStripe(Object->GetOuter());
+	FHashTableLock HashLock(ThreadHash, Stripe.CriticalSection);
+	TSet<UObjectBase*>& Inners = Stripe.ObjectOuterMap.FindOrAdd(Object->GetOuter());
 	bool bIsAlreadyInSetPtr = false;
 	Inners.Add(Object, &bIsAlreadyInSetPtr);
 	check(!bIsAlreadyInSetPtr); // if it already exists, something is wrong with the external code
 }
 
-// Assumes that ThreadHash's critical is already locked
 static void AddToClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 {
 	{
 		check(Object->GetClass());
-		TSet<UObjectBase*>& ObjectList = ThreadHash.ClassToObjectListMap.FindOrAdd(Object->GetClass());
+		FUObjectHashStripe& Stripe = ThreadHash.GetStripe(Object->GetClass());
+		FHashTableLock HashLock(ThreadHash, Stripe.CriticalSection);
+		TSet<UObjectBase*>& ObjectList = Stripe.ClassToObjectListMap.FindOrAdd(Object->GetClass());
 		bool bIsAlreadyInSetPtr = false;
 		ObjectList.Add(Object, &bIsAlreadyInSetPtr);
 		check(!bIsAlreadyInSetPtr); // if it already exists, something is wrong with the external code
@@ -532,6 +687,7 @@ static void AddToClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 		UClass* SuperClass = Class->GetSuperClass();
 		if ( SuperClass )
 		{
+			FHashTableLock HashLock(ThreadHash, ThreadHash.ClassToChildListCritical);
 			TSet<UClass*>& ChildList = ThreadHash.ClassToChildListMap.FindOrAdd(SuperClass);
 			bool bIsAlreadyInSetPtr = false;
 			ChildList.Add(Class, &bIsAlreadyInSetPtr);
@@ -540,10 +696,11 @@ static void AddToClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 	}
 }
 
-// Assumes that ThreadHash's critical is already locked
 static void RemoveFromOuterMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 {
-	TSet<UObjectBase*>& Inners = ThreadHash.ObjectOuterMap.FindOrAdd(Object->GetOuter());
+	FUObjectHashStripe& Stripe = ThreadHash.GetStripe(Object->GetOuter());
+	FHashTableLock HashLock(ThreadHash, Stripe.CriticalSection);
+	TSet<UObjectBase*>& Inners = Stripe.ObjectOuterMap.FindOrAdd(Object->GetOuter());
 	int32 NumRemoved = Inners.Remove(Object);
 	if (NumRemoved != 1)
 	{
@@ -552,17 +709,18 @@ static void RemoveFromOuterMap(FUObjectHashTables& ThreadHash, UObjectBase* Obje
 	check(NumRemoved == 1); // must have existed, else something is wrong with the external code
 	if (!Inners.Num())
 	{
-		ThreadHash.ObjectOuterMap.Remove(Object->GetOuter());
+		Stripe.ObjectOuterMap.Remove(Object->GetOuter());
 	}
 }
 
-// Assumes that ThreadHash's critical is already locked
 static void RemoveFromClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Object)
 {
 	UObjectBaseUtility* ObjectWithUtility = static_cast<UObjectBaseUtility*>(Object);
 
 	{
-		TSet<UObjectBase*>& ObjectList = ThreadHash.ClassToObjectListMap.FindOrAdd(Object->GetClass());
+		FUObjectHashStripe& Stripe = ThreadHash.GetStripe(Object->GetClass());
+		FHashTableLock HashLock(ThreadHash, Stripe.CriticalSection);
+		TSet<UObjectBase*>& ObjectList = Stripe.ClassToObjectListMap.FindOrAdd(Object->GetClass());
 		int32 NumRemoved = ObjectList.Remove(Object);
 		if (NumRemoved != 1)
 		{
@@ -571,7 +729,7 @@ static void RemoveFromClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Obje
 		check(NumRemoved == 1); // must have existed, else something is wrong with the external code
 		if (!ObjectList.Num())
 		{
-			ThreadHash.ClassToObjectListMap.Remove(Object->GetClass());
+			Stripe.ClassToObjectListMap.Remove(Object->GetClass());
 		}
 	}
 
@@ -582,6 +740,7 @@ static void RemoveFromClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Obje
 		if ( SuperClass )
 		{
 			// Remove the class from the SuperClass' child list
+			FHashTableLock HashLock(ThreadHash, ThreadHash.ClassToChildListCritical);
 			TSet<UClass*>& ChildList = ThreadHash.ClassToChildListMap.FindOrAdd(SuperClass);
 			int32 NumRemoved = ChildList.Remove(Class);
 			if (NumRemoved != 1)
@@ -597,6 +756,29 @@ static void RemoveFromClassMap(FUObjectHashTables& ThreadHash, UObjectBase* Obje
 	}
 }
 
+/**
+ * Copies the direct inners of Outer to OutInners. Only the stripe of Outer is locked and only while copying,
+ * so callers never hold more than one stripe and can safely run arbitrary code on the results.
+ */
+template <typename ObjectType, typename AllocatorType>
+static void GetInnersThreadSafe(FUObjectHashTables& ThreadHash, const UObjectBase* Outer, TArray<ObjectType*, AllocatorType>& OutInners, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
+{
+	FUObjectHashStripe& Stripe = ThreadHash.GetStripe(Outer);
+	FHashTableLock HashLock(ThreadHash, Stripe.CriticalSection);
+	TSet<UObjectBase*> const* Inners = Stripe.ObjectOuterMap.Find(Outer);
+	if (Inners)
+	{
+		for (TSet<UObjectBase*>::TConstIterator It(*Inners); It; ++It)
+		{
+			UObject *Object = static_cast<UObject *>(*It);
+			if (!Object->HasAnyFlags(ExclusionFlags) && !Object->HasAnyInternalFlags(ExclusionInternalFlags))
+			{
+				OutInners.Add(Object);
+			}
+		}
+	}
+}
+
 void GetObjectsWithOuter(const class UObjectBase* Outer, TArray<UObject *>& Results, bool bIncludeNestedObjects, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
 {
 	SCOPE_CYCLE_COUNTER( STAT_Hash_GetObjectsWithOuter );	
@@ -608,41 +790,18 @@ void GetObjectsWithOuter(const class UObjectBase* Outer, TArray<UObject *>& Resu
 	}
 	int32 StartNum = Results.Num();
 	auto& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
-	TSet<UObjectBase*> const* Inners = ThreadHash.ObjectOuterMap.Find(Outer);
-	if (Inners)
+	GetInnersThreadSafe(ThreadHash, Outer, Results, ExclusionFlags, ExclusionInternalFlags);
+	int32 MaxResults = GUObjectArray.GetObjectArrayNum();
+	while (StartNum != Results.Num() && bIncludeNestedObjects)
 	{
-		for (TSet<UObjectBase*>::TConstIterator It(*Inners); It; ++It)
+		int32 RangeStart = StartNum;
+		int32 RangeEnd = Results.Num();
+		StartNum = RangeEnd;
+		for (int32 Index = RangeStart; Index < RangeEnd; Index++)
 		{
-			UObject *Object = static_cast<UObject *>(*It);
-			if (!Object->HasAnyFlags(ExclusionFlags) && !Object->HasAnyInternalFlags(ExclusionInternalFlags))
-			{
-				Results.Add(Object);
-			}
-		}
-		int32 MaxResults = GUObjectArray.GetObjectArrayNum();
-		while (StartNum != Results.Num() && bIncludeNestedObjects)
-		{
-			int32 RangeStart = StartNum;
-			int32 RangeEnd = Results.Num();
-			StartNum = RangeEnd;
-			for (int32 Index = RangeStart; Index < RangeEnd; Index++)
-			{
-				TSet<UObjectBase*> const* InnerInners = ThreadHash.ObjectOuterMap.Find(Results[Index]);
-				if (InnerInners)
-				{
-					for (TSet<UObjectBase*>::TConstIterator It(*InnerInners); It; ++It)
-					{
-						UObject *Object = static_cast<UObject *>(*It);
-						if (!Object->HasAnyFlags(ExclusionFlags) && !Object->HasAnyInternalFlags(ExclusionInternalFlags))
-						{
-							Results.Add(Object);
-						}
-					}
-				}
-			}
-			check(Results.Num() <= MaxResults); // otherwise we have a cycle in the outer chain, which should not be possible
+			GetInnersThreadSafe(ThreadHash, Results[Index], Results, ExclusionFlags, ExclusionInternalFlags);
 		}
+		check(Results.Num() <= MaxResults); // otherwise we have a cycle in the outer chain, which should not be possible
 	}
 }
 
@@ -655,30 +814,20 @@ void ForEachObjectWithOuter(const class UObjectBase* Outer, TFunctionRef<void(UO
 		ExclusionInternalFlags |= EInternalObjectFlags::AsyncLoading;
 	}
 	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
-	TArray<TSet<UObjectBase*> const*> AllInners;
 
-	if (TSet<UObjectBase*> const* Inners = ThreadHash.ObjectOuterMap.Find(Outer))
-	{
-		AllInners.Add(Inners);
-	}
+	// Operation runs without any stripe locked, nested objects are visited whether their outer passed the filter or not
+	TArray<UObject*, TInlineAllocator<64> > AllInners;
+	GetInnersThreadSafe(ThreadHash, Outer, AllInners, RF_NoFlags, EInternalObjectFlags::None);
 	while (AllInners.Num())
 	{
-		TSet<UObjectBase*> const* Inners = AllInners.Pop();
-		for (TSet<UObjectBase*>::TConstIterator It(*Inners); It; ++It)
+		UObject* Object = AllInners.Pop(false);
+		if (!Object->HasAnyFlags(ExclusionFlags) && !Object->HasAnyInternalFlags(ExclusionInternalFlags))
 		{
-			UObject *Object = static_cast<UObject*>(*It);
-			if (!Object->HasAnyFlags(ExclusionFlags) && !Object->HasAnyInternalFlags(ExclusionInternalFlags))
-			{
-				Operation(Object);
-			}
-			if (bIncludeNestedObjects)
-			{
-				if (TSet<UObjectBase*> const* ObjectInners = ThreadHash.ObjectOuterMap.Find(Object))
-				{
-					AllInners.Add(ObjectInners);
-				}
-			}
+			Operation(Object);
+		}
+		if (bIncludeNestedObjects)
+		{
+			GetInnersThreadSafe(ThreadHash, Object, AllInners, RF_NoFlags, EInternalObjectFlags::None);
 		}
 	}
 }
@@ -703,8 +852,9 @@ UObjectBase* FindObjectWithOuter(class UObjectBase* Outer, class UClass* ClassTo
 	else
 	{
 		auto& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock HashLock(ThreadHash);
-		TSet<UObjectBase*> const* Inners = ThreadHash.ObjectOuterMap.Find( Outer );
+		FUObjectHashStripe& Stripe = ThreadHash.GetStripe(Outer);
+		FHashTableLock HashLock(ThreadHash, Stripe.CriticalSection);
+		TSet<UObjectBase*> const* Inners = Stripe.ObjectOuterMap.Find( Outer );
 		if (Inners)
 		{
 			for (TSet<UObjectBase*>::TConstIterator It(*Inners); It; ++It)
@@ -726,7 +876,7 @@ UObjectBase* FindObjectWithOuter(class UObjectBase* Outer, class UClass* ClassTo
 	return Result;
 }
 
-/** Helper function that returns all the children of the specified class recursively */
+/** Helper function that returns all the children of the specified class recursively. Assumes that ClassToChildListCritical is already locked. */
 static void RecursivelyPopulateDerivedClasses(FUObjectHashTables& ThreadHash, UClass* ParentClass, TSet<UClass*>& OutAllDerivedClass)
 {
 	TSet<UClass*>* ChildSet = ThreadHash.ClassToChildListMap.Find(ParentClass);
@@ -747,11 +897,12 @@ static void RecursivelyPopulateDerivedClasses(FUObjectHashTables& ThreadHash, UC
 static void GetObjectsOfClassThreadSafe(FUObjectHashTables& ThreadHash, TSet<UClass*>& ClassesToSearch, TArray<UObject *>& Results, EObjectFlags ExclusionFlags, EInternalObjectFlags ExclusionInternalFlags)
 {
 	ExclusionInternalFlags |= EInternalObjectFlags::Unreachable;
-	FHashTableLock HashLock(ThreadHash);
 	
 	for (auto ClassIt = ClassesToSearch.CreateConstIterator(); ClassIt; ++ClassIt)
 	{
-		TSet<UObjectBase*> const* List = ThreadHash.ClassToObjectListMap.Find(*ClassIt);
+		FUObjectHashStripe& Stripe = ThreadHash.GetStripe(*ClassIt);
+		FHashTableLock HashLock(ThreadHash, Stripe.CriticalSection);
+		TSet<UObjectBase*> const* List = Stripe.ClassToObjectListMap.Find(*ClassIt);
 		if (List)
 		{
 			for (auto ObjectIt = List->CreateConstIterator(); ObjectIt; ++ObjectIt)
@@ -781,7 +932,7 @@ void GetObjectsOfClass(UClass* ClassToLookFor, TArray<UObject *>& Results, bool
 	if( bIncludeDerivedClasses )
 	{
 		auto& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock HashLock( ThreadHash );
+		FHashTableLock HashLock( ThreadHash, ThreadHash.ClassToChildListCritical );
 		RecursivelyPopulateDerivedClasses( ThreadHash, ClassToLookFor, ClassesToSearch );
 	}
 
@@ -800,46 +951,36 @@ void ForEachObjectOfClass(UClass* ClassToLookFor, TFunctionRef<void(UObject*)> O
 	}
 
 	FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
-	FHashTableLock HashLock(ThreadHash);
 
 	TSet<UClass*> ClassesToSearch;
 	ClassesToSearch.Add( ClassToLookFor );
 	if( bIncludeDerivedClasses )
 	{
+		FHashTableLock HashLock( ThreadHash, ThreadHash.ClassToChildListCritical );
 		RecursivelyPopulateDerivedClasses( ThreadHash, ClassToLookFor, ClassesToSearch );
 	}
 
-	for (auto ClassIt = ClassesToSearch.CreateConstIterator(); ClassIt; ++ClassIt)
+	// Gather first so that Operation runs without any stripe locked
+	TArray<UObject*> Objects;
+	GetObjectsOfClassThreadSafe(ThreadHash, ClassesToSearch, Objects, ExclusionFlags, ExclusionInternalFlags);
+	for (UObject* Object : Objects)
 	{
-		TSet<UObjectBase*> const* List = ThreadHash.ClassToObjectListMap.Find(*ClassIt);
-		if (List)
-		{
-			for (auto ObjectIt = List->CreateConstIterator(); ObjectIt; ++ObjectIt)
-			{
-				UObject *Object = static_cast<UObject*>(*ObjectIt);
-				if (!Object->HasAnyFlags(ExclusionFlags) && !Object->HasAnyInternalFlags(ExclusionInternalFlags))
-				{
-					Operation(Object);
-				}
-			}
-		}
+		Operation(Object);
 	}
 }
 
 void GetDerivedClasses(UClass* ClassToLookFor, TArray<UClass *>& Results, bool bRecursive)
 {
+	auto& ThreadHash = FUObjectHashTables::Get();
+	FHashTableLock HashLock(ThreadHash, ThreadHash.ClassToChildListCritical);
 	if (bRecursive)
 	{
 		TSet<UClass*> AllDerivedClasses;
-		auto& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock HashLock(ThreadHash);
 		RecursivelyPopulateDerivedClasses(ThreadHash, ClassToLookFor, AllDerivedClasses);
 		Results.Append( AllDerivedClasses.Array() );
 	}
 	else
 	{
-		auto& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock HashLock(ThreadHash);
 		TSet<UClass*>* DerivedClasses = ThreadHash.ClassToChildListMap.Find(ClassToLookFor);
 		if ( DerivedClasses )
 		{
@@ -863,15 +1004,22 @@ void HashObject(UObjectBase* Object)
 		int32 Hash = 0;
 
 		auto& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock HashLock(ThreadHash);
 
-		Hash = GetObjectHash(Name);				
-		checkSlow(!ThreadHash.PairExistsInHash(Hash, Object));  // if it already exists, something is wrong with the external code
-		ThreadHash.AddToHash(Hash, Object);
+		Hash = GetObjectHash(Name);
+		{
+			FUObjectHashStripe& Stripe = ThreadHash.GetStripe(Hash);
+			FHashTableLock HashLock(ThreadHash, Stripe.CriticalSection);
+			checkSlow(!Stripe.PairExistsInHash(Stripe.Hash, Hash, Object));  // if it already exists, something is wrong with the external code
+			Stripe.AddToHash(Stripe.Hash, Hash, Object);
+		}
 
 		Hash = GetObjectOuterHash( Name, (PTRINT)Object->GetOuter() );
-		checkSlow( !ThreadHash.HashOuter.FindPair( Hash, Object ) );  // if it already exists, something is wrong with the external code
-		ThreadHash.HashOuter.Add( Hash, Object );
+		{
+			FUObjectHashStripe& Stripe = ThreadHash.GetStripe(Hash);
+			FHashTableLock HashLock(ThreadHash, Stripe.CriticalSection);
+			checkSlow(!Stripe.PairExistsInHash(Stripe.HashOuter, Hash, Object));  // if it already exists, something is wrong with the external code
+			Stripe.AddToHash(Stripe.HashOuter, Hash, Object);
+		}
 
 		AddToOuterMap( ThreadHash, Object );
 		AddToClassMap( ThreadHash, Object );
@@ -894,14 +1042,21 @@ void UnhashObject(UObjectBase* Object)
 		int32 NumRemoved = 0;
 
 		auto& ThreadHash = FUObjectHashTables::Get();
-		FHashTableLock LockHash(ThreadHash);
 
 		Hash = GetObjectHash(Name);
-		NumRemoved = ThreadHash.RemoveFromHash(Hash, Object);
+		{
+			FUObjectHashStripe& Stripe = ThreadHash.GetStripe(Hash);
+			FHashTableLock HashLock(ThreadHash, Stripe.CriticalSection);
+			NumRemoved = Stripe.RemoveFromHash(Stripe.Hash, Hash, Object);
+		}
 		check(NumRemoved == 1); // must have existed, else something is wrong with the external code
 
 		Hash = GetObjectOuterHash( Name, (PTRINT)Object->GetOuter() );
-		NumRemoved = ThreadHash.HashOuter.RemoveSingle( Hash, Object );
+		{
+			FUObjectHashStripe& Stripe = ThreadHash.GetStripe(Hash);
+			FHashTableLock HashLock(ThreadHash, Stripe.CriticalSection);
+			NumRemoved = Stripe.RemoveFromHash(Stripe.HashOuter, Hash, Object);
+		}
 		check( NumRemoved == 1 ); // must have existed, else something is wrong with the external code
 
 		RemoveFromOuterMap( ThreadHash, Object );
@@ -933,75 +1088,27 @@ void UnlockUObjectHashTables()
 #endif
 }
 
-void LogHashStatisticsInternal(TMultiMap<int32, UObjectBase*>& Hash, FOutputDevice& Ar, const bool bShowHashBucketCollisionInfo)
+static void LogHashStatisticsInternal(FUObjectHashTables& ThreadHash, bool bOuterHash, FOutputDevice& Ar, const bool bShowHashBucketCollisionInfo)
 {
-	TArray<int32> HashBuckets;
-	// Get the set of keys in use, which is the number of hash buckets
-	int32 SlotsInUse = Hash.GetKeys(HashBuckets);
-
-	int32 TotalCollisions = 0;
-	int32 MinCollisions = OBJECT_HASH_BINS;
-	int32 MaxCollisions = 0;
-	int32 MaxBin = 0;
-
-	// Dump how many slots are in use
-	Ar.Logf(TEXT("Slots in use %d"), SlotsInUse);
-
-	// Work through each slot and figure out how many collisions
-	for (auto HashBucket : HashBuckets)
+	// Count the objects in each hash slot, each stripe owns a distinct set of slots
+	TMap<int32, int32> SlotCollisions;
+	uint32 HashtableAllocatedSize = 0;
+	int32 NumBins = 0;
+	for (int32 StripeIndex = 0; StripeIndex < OBJECT_HASH_STRIPES; StripeIndex++)
 	{
-		int32 Collisions = 0;
-
-		for (TMultiMap<int32, UObjectBase*>::TConstKeyIterator HashIt(Hash, HashBucket); HashIt; ++HashIt)
+		FUObjectHashStripe& Stripe = ThreadHash.GetStripeByIndex(StripeIndex);
+		const FHashChains& Chains = bOuterHash ? Stripe.HashOuter : Stripe.Hash;
+		for (int32 BinIndex = 0; BinIndex < Chains.Bins->NumBins; BinIndex++)
 		{
-			// There's one collision per object in a given bucket
-			Collisions++;
-		}
-
-		// Keep the global stats
-		TotalCollisions += Collisions;
-		if (Collisions > MaxCollisions)
-		{
-			MaxBin = HashBucket;
-		}
-		MaxCollisions = FMath::Max<int32>(Collisions, MaxCollisions);
-		MinCollisions = FMath::Min<int32>(Collisions, MinCollisions);
-
-		if (bShowHashBucketCollisionInfo)
-		{
-			// Now log the output
-			Ar.Logf(TEXT("\tSlot %d has %d collisions"), HashBucket, Collisions);
+			for (FHashNode* Node = Chains.Bins->Heads[BinIndex]; Node; Node = Node->Next)
+			{
+				SlotCollisions.FindOrAdd(Node->Hash)++;
+			}
 		}
+		NumBins += Chains.Bins->NumBins;
+		HashtableAllocatedSize += Stripe.GetAllocatedSize(Chains);
 	}
-	Ar.Logf(TEXT(""));
-
-	// Dump the first 30 objects in the worst bin for inspection
-	Ar.Logf(TEXT("Worst hash bucket contains:"));
-	int32 Count = 0;
-	for (TMultiMap<int32, UObjectBase*>::TConstKeyIterator HashIt(Hash, MaxBin); HashIt && Count < 30; ++HashIt)
-	{
-		UObject* Object = (UObject*)HashIt.Value();
-		Ar.Logf(TEXT("\tObject is %s (%s)"), *Object->GetName(), *Object->GetFullName());
-		Count++;
-	}
-	Ar.Logf(TEXT(""));
-
-	// Now dump how efficient the hash is
-	Ar.Logf(TEXT("Collision Stats: Best Case (%d), Average Case (%d), Worst Case (%d)"),
-		MinCollisions,
-		FMath::FloorToInt(((float)TotalCollisions / (float)SlotsInUse)),
-		MaxCollisions);
-
-	// Calculate Hashtable size
-	const uint32 HashtableAllocatedSize = Hash.GetAllocatedSize();
-	Ar.Logf(TEXT("Total memory allocated for Object Outer Hash: %u bytes."), HashtableAllocatedSize);
-}
-
-void LogHashStatisticsInternal(TMap<int32, FHashBucket>& Hash, FOutputDevice& Ar, const bool bShowHashBucketCollisionInfo)
-{
-	TArray<int32> HashBuckets;
-	// Get the set of keys in use, which is the number of hash buckets
-	int32 SlotsInUse = Hash.Num();
+	int32 SlotsInUse = SlotCollisions.Num();
 
 	int32 TotalCollisions = 0;
 	int32 MinCollisions = OBJECT_HASH_BINS;
@@ -1010,13 +1117,12 @@ void LogHashStatisticsInternal(TMap<int32, FHashBucket>& Hash, FOutputDevice& Ar
 	int32 NumBucketsWithMoreThanOneItem = 0;
 
 	// Dump how many slots are in use
-	Ar.Logf(TEXT("Slots in use %d"), SlotsInUse);
+	Ar.Logf(TEXT("Slots in use %d (%d stripes, %d bins)"), SlotsInUse, OBJECT_HASH_STRIPES, NumBins);
 
 	// Work through each slot and figure out how many collisions
-	for (auto& HashPair : Hash)
+	for (auto& SlotPair : SlotCollisions)
 	{
-		int32 Collisions = HashPair.Value.Num();
-		check(Collisions >= 0);
+		int32 Collisions = SlotPair.Value;
 		if (Collisions > 1)
 		{
 			NumBucketsWithMoreThanOneItem++;
@@ -1026,7 +1132,7 @@ void LogHashStatisticsInternal(TMap<int32, FHashBucket>& Hash, FOutputDevice& Ar
 		TotalCollisions += Collisions;
 		if (Collisions > MaxCollisions)
 		{
-			MaxBin = HashPair.Key;
+			MaxBin = SlotPair.Key;
 		}
 		MaxCollisions = FMath::Max<int32>(Collisions, MaxCollisions);
 		MinCollisions = FMath::Min<int32>(Collisions, MinCollisions);
@@ -1034,7 +1140,7 @@ void LogHashStatisticsInternal(TMap<int32, FHashBucket>& Hash, FOutputDevice& Ar
 		if (bShowHashBucketCollisionInfo)
 		{
 			// Now log the output
-			Ar.Logf(TEXT("\tSlot %d has %d collisions"), HashPair.Key, Collisions);
+			Ar.Logf(TEXT("\tSlot %d has %d collisions"), SlotPair.Key, Collisions);
 		}
 	}
 	Ar.Logf(TEXT(""));
@@ -1042,31 +1148,28 @@ void LogHashStatisticsInternal(TMap<int32, FHashBucket>& Hash, FOutputDevice& Ar
 	// Dump the first 30 objects in the worst bin for inspection
 	Ar.Logf(TEXT("Worst hash bucket contains:"));
 	int32 Count = 0;
-	FHashBucket& WorstBucket = Hash.FindChecked(MaxBin);
-	for (FHashBucketIterator It(WorstBucket); It; ++It)
+	FUObjectHashStripe& WorstStripe = ThreadHash.GetStripe(MaxBin);
+	const FHashChains& WorstChains = bOuterHash ? WorstStripe.HashOuter : WorstStripe.Hash;
+	for (FHashNode* Node = WorstChains.Bins->GetHead(MaxBin); Node && Count < 30; Node = Node->Next)
 	{
-		UObject* Object = (UObject*)*It;
-		Ar.Logf(TEXT("\tObject is %s (%s)"), *Object->GetName(), *Object->GetFullName());
-		Count++;
+		if (Node->Hash == MaxBin)
+		{
+			UObject* Object = (UObject*)Node->Object;
+			Ar.Logf(TEXT("\tObject is %s (%s)"), *Object->GetName(), *Object->GetFullName());
+			Count++;
+		}
 	}
 	Ar.Logf(TEXT(""));
 
 	// Now dump how efficient the hash is
 	Ar.Logf(TEXT("Collision Stats: Best Case (%d), Average Case (%d), Worst Case (%d), Number of buckets with more than one item (%d/%d)"),
 		MinCollisions,
-		FMath::FloorToInt(((float)TotalCollisions / (float)SlotsInUse)),
+		FMath::FloorToInt(((float)TotalCollisions / (float)FMath::Max(SlotsInUse, 1))),
 		MaxCollisions,
 		NumBucketsWithMoreThanOneItem,
 		SlotsInUse);
 
-	// Calculate Hashtable size
-	uint32 HashtableAllocatedSize = Hash.GetAllocatedSize();
-	// Calculate the size of a all Allocations inside of the buckets (TSet Items)
-	for (auto& Pair : Hash)
-	{
-		HashtableAllocatedSize += Pair.Value.GetItemsSize();
-	}
-	Ar.Logf(TEXT("Total memory allocated for and by Object Hash: %u bytes."), HashtableAllocatedSize);
+	Ar.Logf(TEXT("Total memory allocated for and by %s: %u bytes."), bOuterHash ? TEXT("Object Outer Hash") : TEXT("Object Hash"), HashtableAllocatedSize);
 }
 
 void LogHashStatistics(FOutputDevice& Ar, const bool bShowHashBucketCollisionInfo)
@@ -1074,8 +1177,9 @@ void LogHashStatistics(FOutputDevice& Ar, const bool bShowHashBucketCollisionInf
 	Ar.Logf(TEXT("Hash efficiency statistics for the Object Hash"));
 	Ar.Logf(TEXT("-------------------------------------------------"));
 	Ar.Logf(TEXT(""));
-	FHashTableLock HashLock(FUObjectHashTables::Get());
-	LogHashStatisticsInternal(FUObjectHashTables::Get().Hash, Ar, bShowHashBucketCollisionInfo);
+	LockUObjectHashTables();
+	LogHashStatisticsInternal(FUObjectHashTables::Get(), false, Ar, bShowHashBucketCollisionInfo);
+	UnlockUObjectHashTables();
 	Ar.Logf(TEXT(""));
 }
 
@@ -1084,8 +1188,104 @@ void LogHashOuterStatistics(FOutputDevice& Ar, const bool bShowHashBucketCollisi
 	Ar.Logf(TEXT("Hash efficiency statistics for the Outer Object Hash"));
 	Ar.Logf(TEXT("-------------------------------------------------"));
 	Ar.Logf(TEXT(""));
-	FHashTableLock HashLock(FUObjectHashTables::Get());
-	LogHashStatisticsInternal(FUObjectHashTables::Get().HashOuter, Ar, bShowHashBucketCollisionInfo);
+	LockUObjectHashTables();
+	LogHashStatisticsInternal(FUObjectHashTables::Get(), true, Ar, bShowHashBucketCollisionInfo);
+	UnlockUObjectHashTables();
 	Ar.Logf(TEXT(""));
 }
 
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Measures hash table throughput with several threads finding objects while the game thread creates new ones.
+ * Worker tasks look existing objects up by outer and by name. Objects are only created on the game thread, as NewObject requires.
+ * Usage: obj.HashBenchmark [NumThreads] [NumObjectsPerThread]
+ */
+static void HashBenchmark(const TArray<FString>& Args)
+{
+	check(IsInGameThread());
+	const int32 NumThreads = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 2) : 8;
+	const int32 NumObjectsPerThread = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 10000;
+	const int32 NumFindsPerThread = NumObjectsPerThread * 4;
+	const int32 NumFindThreads = NumThreads - 1;
+	static int32 RunIndex = 0;
+	RunIndex++;
+
+	// Names are made up front so that the threads only measure the hash tables and object creation
+	UPackage* Outer = GetTransientPackage();
+	UClass* ObjectClass = UObjectRedirector::StaticClass();
+	TArray<UObject*> ExistingObjects;
+	TArray<FName> NewObjectNames;
+	for (int32 Index = 0; Index < NumObjectsPerThread; Index++)
+	{
+		FName ExistingName(*FString::Printf(TEXT("HashBenchmark%d_Existing"), RunIndex), Index + 1);
+		ExistingObjects.Add(NewObject<UObject>(Outer, ObjectClass, ExistingName, RF_Transient));
+		NewObjectNames.Add(FName(*FString::Printf(TEXT("HashBenchmark%d_New"), RunIndex), Index + 1));
+	}
+
+	TArray<UObject*> NewObjects;
+	NewObjects.Reserve(NewObjectNames.Num());
+	TArray<double> FindThreadTimes;
+	FindThreadTimes.AddZeroed(NumFindThreads);
+	FThreadSafeCounter NumMisses;
+
+	const double StartTime = FPlatformTime::Seconds();
+	FGraphEventArray FindTasks;
+	for (int32 ThreadIndex = 0; ThreadIndex < NumFindThreads; ThreadIndex++)
+	{
+		FindTasks.Add(FFunctionGraphTask::CreateAndDispatchWhenReady([&, ThreadIndex]()
+		{
+			const double ThreadStartTime = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < NumFindsPerThread; Index++)
+			{
+				UObject* Expected = ExistingObjects[(Index * 7 + ThreadIndex) % ExistingObjects.Num()];
+				UObject* Found = (Index & 1)
+					? StaticFindObjectFast(ObjectClass, Outer, Expected->GetFName())
+					: StaticFindObjectFast(ObjectClass, nullptr, Expected->GetFName(), false, true);
+				if (Found != Expected)
+				{
+					NumMisses.Increment();
+				}
+			}
+			FindThreadTimes[ThreadIndex] = FPlatformTime::Seconds() - ThreadStartTime;
+		}, TStatId()));
+	}
+
+	const double CreateStartTime = FPlatformTime::Seconds();
+	for (const FName& Name : NewObjectNames)
+	{
+		NewObjects.Add(NewObject<UObject>(Outer, ObjectClass, Name, RF_Transient));
+	}
+	const double CreateTime = FPlatformTime::Seconds() - CreateStartTime;
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(FindTasks, ENamedThreads::GameThread);
+	const double TotalTime = FPlatformTime::Seconds() - StartTime;
+
+	double FindTime = 0.0;
+	for (double ThreadTime : FindThreadTimes)
+	{
+		FindTime += ThreadTime;
+	}
+	UE_LOG(LogUObjectHash, Display, TEXT("Hash benchmark: %d threads, %.2f ms total"), NumThreads, TotalTime * 1000.0);
+	UE_LOG(LogUObjectHash, Display, TEXT("  %d find threads: %.0f finds/s per thread, %d misses"),
+		NumFindThreads, NumFindsPerThread * NumFindThreads / FMath::Max(FindTime, SMALL_NUMBER), NumMisses.GetValue());
+	UE_LOG(LogUObjectHash, Display, TEXT("  game thread: %.0f objects/s created"),
+		NumObjectsPerThread / FMath::Max(CreateTime, SMALL_NUMBER));
+
+	// Leave everything to the next GC
+	for (UObject* Object : NewObjects)
+	{
+		Object->MarkPendingKill();
+	}
+	for (UObject* Object : ExistingObjects)
+	{
+		Object->MarkPendingKill();
+	}
+}
+
+static FAutoConsoleCommand HashBenchmarkCommand(
+	TEXT("obj.HashBenchmark"),
+	TEXT("Measures UObject hash table throughput with worker threads finding objects while the game thread creates new ones. Arguments: [NumThreads] [NumObjectsPerThread]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(HashBenchmark)
+	);
+
+#endif // !UE_BUILD_SHIPPING
@@ -150,6 +150,10 @@ private:
 	int32							ImportIndex;
 	/** Current index into linkers export table used to spread creation over several frames				*/
 	int32							ExportIndex;
+	/** Offset of the export data precached with a single request											*/
+	int64							ExportDataPrecacheOffset;
+	/** Size of the export data precached with a single request, 0 if exports are precached one at a time	*/
+	int64							ExportDataPrecacheSize;
 	/** Current index into GObjLoaded array used to spread routing PreLoad over several frames			*/
 	static int32					PreLoadIndex;
 	/** Current index into GObjLoaded array used to spread routing PostLoad over several frames			*/
@@ -296,6 +300,13 @@ private:
 	 * @return true if we finished creating and preloading all exports, false otherwise.
 	 */
 	EAsyncPackageState::Type CreateExports();
+	/**
+	 * Gets the range of export data to read with a single request before creating any exports.
+	 *
+	 * @param OutOffset Offset of the first export's data
+	 * @return Size of the export data, 0 if the exports should be precached one at a time
+	 */
+	int64 GetExportDataPrecacheRange(int64& OutOffset) const;
 	/**
 	 * Preloads aka serializes all loaded objects.
 	 *
@@ -16,6 +16,8 @@ enum EBulkDataFlags
 	BULKDATA_PayloadAtEndOfFile					= 1<<0,
 	/** If set, payload should be [un]compressed using ZLIB during serialization.	*/
 	BULKDATA_SerializeCompressedZLIB			= 1<<1,
+	/** If set, payload should be [un]compressed using LZ4 during serialization.	*/
+	BULKDATA_SerializeCompressedLZ4				= 1<<9,
 	/** Force usage of SerializeElement over bulk serialization.					*/
 	BULKDATA_ForceSingleElementSerialization	= 1<<2,
 	/** Bulk data is only used once at runtime in the game.							*/
@@ -24,10 +26,14 @@ enum EBulkDataFlags
 	BULKDATA_Unused								= 1<<5,
 	/** Forces the payload to be saved inline, regardless of its size				*/
 	BULKDATA_ForceInlinePayload					= 1<<6,
-	/** Flag to check if either compression mode is specified						*/
+	/** ZLIB compression, used by callers that don't pick a codec						*/
 	BULKDATA_SerializeCompressed				= (BULKDATA_SerializeCompressedZLIB),
+	/** Flag to check if either compression mode is specified						*/
+	BULKDATA_SerializeCompressedAny				= (BULKDATA_SerializeCompressedZLIB | BULKDATA_SerializeCompressedLZ4),
 	/** Forces the payload to be always streamed, regardless of its size */
 	BULKDATA_ForceStreamPayload = 1 << 7,
+	/** Read-only locks of an uncompressed payload in cooked builds return a view of the memory mapped file instead of a copy */
+	BULKDATA_MemoryMappedPayload = 1 << 8,
 
 };
 
@@ -211,7 +217,7 @@ public:
 	int32 GetBulkDataSize() const;
 	/**
 	 * Returns the size of the bulk data on disk. This can differ from GetBulkDataSize if
-	 * BULKDATA_SerializeCompressed is set.
+	 * a compression flag in BULKDATA_SerializeCompressedAny is set.
 	 *
 	 * @return Size of the bulk data on disk or INDEX_NONE in case there's no association
 	 */
@@ -248,6 +254,13 @@ public:
 	 */
 	bool IsBulkDataLoaded() const;
 
+	/**
+	 * Returns whether the payload is currently a view of a memory mapped file rather than a copy.
+	 *
+	 * @return true if the payload is mapped, false otherwise
+	 */
+	bool IsBulkDataMapped() const;
+
 	/**
 	* Returns whether the bulk data asynchronous load has completed.
 	*
@@ -318,6 +331,9 @@ public:
 	/**
 	 * Locks the bulk data and returns a pointer to it.
 	 *
+	 * With BULKDATA_MemoryMappedPayload, a LOCK_READ_ONLY lock may return a view of the mapped file which
+	 * must not be written to. A LOCK_READ_WRITE lock copies a mapped payload into memory and unmaps it.
+	 *
 	 * @param	LockFlags	Flags determining lock behavior
 	 */
 	void* Lock( uint32 LockFlags );
@@ -472,6 +488,23 @@ private:
 	/** Returns true if bulk data should be loaded asynchronously */
 	bool ShouldStreamBulkData();
 
+	/**
+	 * Returns true if the payload can be handed out as a view of the mapped file: it has to be flagged
+	 * BULKDATA_MemoryMappedPayload, uncompressed, serialized in bulk and part of an uncompressed cooked package.
+	 */
+	bool CanMapPayload() const;
+
+	/**
+	 * Maps the payload if it isn't already. The pak file or platform file decides whether the file can be
+	 * mapped at all, e.g. compressed or encrypted pak entries can't.
+	 *
+	 * @return pointer to the mapped payload, or nullptr if it couldn't be mapped and has to be copied
+	 */
+	const void* MapPayload();
+
+	/** Unmaps the payload, the pointers returned for it are no longer valid afterwards. */
+	void ReleaseMappedPayload();
+
 	/*-----------------------------------------------------------------------------
 		Member variables.
 	-----------------------------------------------------------------------------*/
@@ -495,6 +528,12 @@ private:
 	uint32				LockStatus;
 	/** Async helper for loading bulk data on a separate thread */
 	TFuture<bool> SerializeFuture;
+	/** Mapped file the payload is mapped from, shared by all bulk data of the same file						*/
+	TSharedPtr<IMappedFileHandle, ESPMode::ThreadSafe> MappedHandle;
+	/** Mapped region containing the payload, needs to be released before MappedHandle							*/
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	/** Whether the payload was found to be mappable when it was serialized										*/
+	bool				bPayloadMappable;
 
 protected:
 	/** name of the package file containing the bulkdata */
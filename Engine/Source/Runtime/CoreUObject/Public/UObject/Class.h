@@ -232,6 +232,31 @@ class COREUOBJECT_API UField : public UObject
 	UStruct.
 -----------------------------------------------------------------------------*/
 
+/**
+ * One step of a flattened walk over a struct's properties, built by UStruct::Link.
+ * A step either covers a run of adjacent properties that can be handled with a single memory operation,
+ * or a single property that needs its virtual functions called.
+ */
+struct FStructPropertyOp
+{
+	FStructPropertyOp(UProperty* InProperty, int32 InNumSpanProperties, int32 InOffset, int32 InSize)
+		: Property(InProperty)
+		, NumSpanProperties(InNumSpanProperties)
+		, Offset(InOffset)
+		, Size(InSize)
+	{
+	}
+
+	/** First property of the step, the rest of a span follows it in PropertyLink */
+	UProperty* Property;
+	/** Number of properties in the span, 0 if Property has to be handled on its own */
+	int32 NumSpanProperties;
+	/** Offset of the step within the struct */
+	int32 Offset;
+	/** Number of bytes covered by the step */
+	int32 Size;
+};
+
 /**
  * Base class for all UObject types that contain fields.
  */
@@ -260,6 +285,12 @@ public:
 	UProperty* DestructorLink;
 	/** In memory only: Linked list of properties requiring post constructor initialization.**/
 	UProperty* PostConstructLink;
+	/** In memory only: PropertyLink flattened for SerializeBin, runs of adjacent numeric properties are serialized with a single call. Empty for functions **/
+	TArray<FStructPropertyOp> SerializeOps;
+	/** In memory only: PropertyLink flattened for copying, runs of adjacent plain old data properties (other than bitfield bools) are copied with a single memcpy. Empty for functions **/
+	TArray<FStructPropertyOp> CopyOps;
+	/** In memory only: Properties from PropertyLink that need more than zeroed memory to be initialized **/
+	TArray<UProperty*> NonZeroInitProperties;
 
 	/** Array of object references embedded in script code. Mirrored for easy access by realtime garbage collection code */
 	TArray<UObject*> ScriptObjectReferences;
@@ -319,6 +350,35 @@ public:
 
 	virtual void SerializeTaggedProperties( FArchive& Ar, uint8* Data, UStruct* DefaultsStruct, uint8* Defaults, const UObject* BreakRecursionIfFullyLoad=NULL) const;
 
+	/**
+	 * Returns a hash of the names and types of the properties written by unversioned property serialization,
+	 * used to reject cooked data that was saved against a different layout of this struct.
+	 *
+	 * @param	bFilterEditorOnly	whether editor-only properties are left out, as they are in cooked data
+	 */
+	uint32 GetUnversionedSchemaHash(bool bFilterEditorOnly) const;
+
+private:
+	/**
+	 * Serializes the properties as the schema hash, a bitmask of the non-default property elements and their raw values.
+	 * Used by SerializeTaggedProperties when the archive uses unversioned property serialization.
+	 * Structs whose schema isn't pinned by the executable only serialize a marker, a mismatching schema is a fatal error.
+	 *
+	 * @return false if the properties have to be serialized as tagged properties after the marker.
+	 */
+	bool SerializeUnversionedProperties(FArchive& Ar, uint8* Data, UStruct* DefaultsStruct, uint8* Defaults) const;
+
+	/** Computes the unversioned schema hash and element count if they haven't been since the last Link. */
+	void CacheUnversionedSchema(bool bFilterEditorOnly) const;
+
+	/** Cached unversioned schema hash, indexed by bFilterEditorOnly. */
+	mutable uint32 UnversionedSchemaHash[2];
+
+	/** Number of property elements in the cached unversioned schema, INDEX_NONE until computed. */
+	mutable int32 UnversionedSchemaNumElements[2];
+
+public:
+
 	/**
 	 * Initialize a struct over uninitialized memory. This may be done by calling the native constructor or individually initializing properties
 	 *
@@ -404,6 +404,39 @@ struct FGenerationInfo
 	void Serialize(FArchive& Ar, const struct FPackageFileSummary& Summary);
 };
 
+/**
+ * Index based dependency graph of a package's imports and exports, precomputed by the cooker so that the loader
+ * doesn't have to discover the dependencies one import at a time.
+ */
+struct FPackageDependencyGraph
+{
+	/** Import indices ordered so that every import comes after its outer */
+	TArray<int32> ImportOrder;
+
+	/** For every import, the index of the first import with the same class so that each class is only looked up once */
+	TArray<int32> ImportClassIndices;
+
+	/** Export indices in the order they should be created and preloaded, after their class, super, outer and archetype */
+	TArray<int32> ExportOrder;
+
+	/** Returns true if this graph was built for a package with the given number of imports and exports */
+	bool IsValidFor(int32 NumImports, int32 NumExports) const
+	{
+		return ImportOrder.Num() == NumImports && ImportClassIndices.Num() == NumImports && ExportOrder.Num() == NumExports;
+	}
+
+	/** Removes all entries */
+	void Empty()
+	{
+		ImportOrder.Empty();
+		ImportClassIndices.Empty();
+		ExportOrder.Empty();
+	}
+
+	/** I/O function */
+	friend COREUOBJECT_API FArchive& operator<<(FArchive& Ar, FPackageDependencyGraph& Graph);
+};
+
 #if WITH_ENGINE
 /**
  * Information about the textures stored in the package.
@@ -721,6 +754,11 @@ public:
 	 */
 	TArray<int32>	ChunkIDs;
 
+	/**
+	 * Location into the file on disk for the precomputed dependency graph, 0 if the package doesn't have one
+	 */
+	int32	DependencyGraphOffset;
+
 
 	/** Constructor */
 	COREUOBJECT_API FPackageFileSummary();
@@ -765,6 +803,8 @@ public:
 	TArray<FObjectExport> ExportMap;
 	/** List of dependency lists for each export */
 	TArray<TArray<FPackageIndex> > DependsMap;
+	/** Import and export dependency graph, only written to and used for cooked packages */
+	FPackageDependencyGraph DependencyGraph;
 	/** Map that holds info about string asset references from the package. */
 	TArray<FString> StringAssetReferencesMap;
 
@@ -1383,6 +1423,8 @@ private:
 	int32						DependsMapIndex;
 	/** Current index into export hash map, used by async linker creation for spreading out hashing exports.					*/
 	int32						ExportHashIndex;
+	/** Native classes of imports, indexed by the first import of each class in the dependency graph.							*/
+	TArray<UClass*>				NativeImportClasses;
 
 
 	/** Whether we already serialized the package file summary.																*/
@@ -1391,6 +1433,8 @@ private:
 	bool					bHasFixedUpImportMap;
 	/** Whether we already matched up existing exports.																		*/
 	bool					bHasFoundExistingExports;
+	/** Whether we already serialized the dependency graph.																	*/
+	bool					bHasSerializedDependencyGraph;
 	/** Whether we are already fully initialized.																			*/
 	bool					bHasFinishedInitialization;
 	/** Whether we are gathering dependencies, can be used to streamline VerifyImports, etc									*/
@@ -1757,6 +1801,15 @@ private:
 
 	UObject* CreateImport( int32 Index );
 
+	/**
+	 * Finds the class of an import if it is already in memory. With a precomputed dependency graph all imports
+	 * of the same native class share a single lookup.
+	 *
+	 * @param  ImportIndex    An index into the ImportMap
+	 * @return The class of the import if it exists, nullptr otherwise
+	 */
+	UClass* FindImportClassFast(int32 ImportIndex);
+
 	/**
 	 * Determines if the specified import belongs to a native "compiled in"
 	 * package (as opposed to an asset-file package). Recursive if the
@@ -1953,6 +2006,11 @@ private:
 	 */
 	ELinkerStatus SerializeDependsMap();
 
+	/**
+	 * Serializes the dependency graph precomputed for cooked packages.
+	 */
+	ELinkerStatus SerializeDependencyGraph();
+
 public:
 	/**
 	 * Serializes the gatherable text data container.
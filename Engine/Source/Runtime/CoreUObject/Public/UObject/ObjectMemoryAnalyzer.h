@@ -164,3 +164,74 @@ private:
 	/** Flags to modify mem counting behavior */
 	uint32 AnalyzeFlags;
 };
+
+
+/** Retained size of all objects of one class, as stored in a retained size snapshot */
+struct FClassRetainedSize
+{
+	FClassRetainedSize()
+		: NumObjects(0)
+		, ExclusiveSize(0)
+		, RetainedSize(0)
+	{
+	}
+
+	/** Path name of the class */
+	FString ClassPath;
+	/** Number of objects of the class */
+	int32 NumObjects;
+	/** Sum of the exclusive sizes of the objects */
+	uint64 ExclusiveSize;
+	/** Sum of the retained sizes of the objects that aren't immediately dominated by an object of the same class */
+	uint64 RetainedSize;
+
+	friend FArchive& operator<<(FArchive& Ar, FClassRetainedSize& Entry)
+	{
+		return Ar << Entry.ClassPath << Entry.NumObjects << Entry.ExclusiveSize << Entry.RetainedSize;
+	}
+};
+
+
+/**
+ * Computes the retained size of every object in a single pass over the reference graph.
+ *
+ * The retained size of an object is the memory that would be freed along with it: its exclusive size plus the
+ * exclusive size of every object it dominates, i.e. every object that can only be reached from the GC roots through it.
+ * Exclusive sizes are counted on the game thread and references are gathered in parallel with an FReferenceCollector,
+ * then the dominator tree is built for the whole graph.
+ * The per-class aggregates can be saved to a snapshot file and diffed against a later run to find what is growing.
+ **/
+struct COREUOBJECT_API FObjectRetainedSizeAnalyzer
+{
+	/** Analyzes all live objects. Must be called on the game thread. */
+	void Analyze();
+
+	/** Returns the retained size of the object, 0 if it didn't exist during the last Analyze */
+	uint64 GetRetainedSize(const UObject* Object) const;
+
+	/** Returns the per-class aggregates of the last Analyze, sorted by descending retained size */
+	const TArray<FClassRetainedSize>& GetClassSizes() const
+	{
+		return ClassSizes;
+	}
+
+	/** Writes the per-class aggregates to a snapshot file */
+	bool SaveSnapshot(const TCHAR* Filename) const;
+	/** Reads the per-class aggregates from a snapshot file written by SaveSnapshot */
+	static bool LoadSnapshot(const TCHAR* Filename, TArray<FClassRetainedSize>& OutClassSizes);
+
+	/** Prints the classes with the largest retained size */
+	void PrintResults(FOutputDevice& Ar, int32 MaxClasses) const;
+	/** Prints the classes whose retained size changed the most between two sets of aggregates */
+	static void PrintDiff(FOutputDevice& Ar, const TArray<FClassRetainedSize>& Before, const TArray<FClassRetainedSize>& After, int32 MaxClasses);
+
+private:
+	/** Graph node of each object array index, INDEX_NONE for free slots */
+	TArray<int32> ObjectIndexToNode;
+	/** Object of each graph node, node 0 is the virtual root that references all GC roots */
+	TArray<const UObject*> NodeObjects;
+	/** Retained size of each graph node */
+	TArray<uint64> RetainedSizes;
+	/** Per-class aggregates sorted by descending retained size */
+	TArray<FClassRetainedSize> ClassSizes;
+};
@@ -389,6 +389,88 @@ COREUOBJECT_API void CollectGarbage(EObjectFlags KeepFlags, bool bPerformFullPur
 */
 COREUOBJECT_API bool TryCollectGarbage(EObjectFlags KeepFlags, bool bPerformFullPurge = true);
 
+/**
+ * Advances an incremental garbage collection cycle by one time slice, starting a new cycle if none is pending.
+ * Reachability analysis is spread across calls and the cycle finishes with an atomic pass that picks up new roots,
+ * scans the objects reported by GarbageCollectionWriteBarrier since they were scanned and the GC object referencer,
+ * followed by the usual unhash. Does nothing if another thread holds a lock on GC.
+ *
+ * @param	KeepFlags			objects with those flags will be kept regardless of being referenced or not
+ * @param	TimeLimit			soft time limit in seconds for this slice, 0 to use gc.IncrementalReachabilityTimeLimit
+ * @return	true if the cycle has finished and unreachable objects are waiting to be purged
+ */
+COREUOBJECT_API bool TryCollectGarbageIncremental(EObjectFlags KeepFlags, float TimeLimit = 0.0f);
+
+/** Whether gc.IncrementalReachability is set and incremental reachability analysis can be used (never in the editor). */
+COREUOBJECT_API bool IsIncrementalReachabilityAnalysisEnabled();
+
+/** Whether an incremental reachability analysis cycle has been started and not finished yet. */
+COREUOBJECT_API bool IsIncrementalReachabilityAnalysisPending();
+
+/** Set while an incremental reachability analysis cycle is in progress. */
+extern COREUOBJECT_API bool GIsIncrementalReachabilityPending;
+
+/** Marks an object as reachable in the current incremental reachability analysis cycle and queues it for scanning. */
+COREUOBJECT_API void MarkObjectForIncrementalReachability(const UObject* Object);
+
+/** Makes the current incremental reachability analysis cycle scan an object it has already reached again. */
+COREUOBJECT_API void MarkObjectDirtyForIncrementalReachability(const UObject* Object);
+
+/** Whether gc.Generational is set and minor collections skip the old generation (never in the editor). */
+COREUOBJECT_API bool IsGenerationalGCEnabled();
+
+/** Set while there are objects in the old generation. */
+extern COREUOBJECT_API bool GHasOldGeneration;
+
+/** Keeps a young object alive in minor collections until the next major collection. */
+COREUOBJECT_API void AddToGenerationalRememberedSet(const UObject* Object);
+
+/** Makes the next minor collection retrace the direct references of an old object. Does nothing for young objects. */
+COREUOBJECT_API void MarkOldGenerationObjectDirty(const UObject* Object);
+
+/**
+ * Write barrier, called after a UObject reference is stored in one of Object's properties, containers or native members.
+ * A pending incremental reachability analysis cycle scans Object again before it finishes, and if Object is old the next
+ * minor collection retraces its references. The script VM calls this for the object a script function runs on and for
+ * every context it writes through, and renames call it for the renamed object. Plain pointer assignments can't be
+ * intercepted, so native code that stores references in existing objects must call it while gc.IncrementalReachability
+ * or gc.Generational is enabled.
+ */
+FORCEINLINE void GarbageCollectionWriteBarrier(const UObject* Object)
+{
+	if (Object)
+	{
+		if (GIsIncrementalReachabilityPending)
+		{
+			MarkObjectDirtyForIncrementalReachability(Object);
+		}
+		if (GHasOldGeneration)
+		{
+			MarkOldGenerationObjectDirty(Object);
+		}
+	}
+}
+
+/**
+ * Called after a reference to Object is stored somewhere the caller can't name the owner of, e.g. by reflected object
+ * property setters. A pending incremental reachability analysis cycle marks Object right away and minor collections
+ * remember it.
+ */
+FORCEINLINE void GarbageCollectionStoredReferenceBarrier(const UObject* Object)
+{
+	if (Object)
+	{
+		if (GIsIncrementalReachabilityPending)
+		{
+			MarkObjectForIncrementalReachability(Object);
+		}
+		if (GHasOldGeneration)
+		{
+			AddToGenerationalRememberedSet(Object);
+		}
+	}
+}
+
 /**
  * Returns whether an incremental purge is still pending/ in progress.
  *
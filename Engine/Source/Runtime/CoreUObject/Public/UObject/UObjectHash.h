@@ -53,6 +53,9 @@ COREUOBJECT_API void GetObjectsWithOuter(const class UObjectBase* Outer, TArray<
 /**
  * Performs an operation on all objects with a given outer
  *
+ * The hash tables are not locked while Operation runs: objects are gathered one outer at a time first, so objects created or
+ * renamed meanwhile may or may not be visited and Operation must not assume it sees a consistent snapshot of the hierarchy.
+ *
  * @param	Outer						Outer to search for
  * @param	Operation					Function to be called for each object
  * @param	bIncludeNestedObjects		If true, then things whose outers directly or indirectly have Outer as an outer are included, these are the nested objects.
@@ -84,6 +87,9 @@ COREUOBJECT_API void GetObjectsOfClass(UClass* ClassToLookFor, TArray<UObject *>
 /**
  * Performs an operation on all objects with a given outer
  *
+ * The objects are gathered before Operation is called for them and the hash tables are not locked while it runs, so
+ * objects created meanwhile are not visited and flags are only checked when the objects are gathered.
+ *
  * @param	Outer						Outer to search for
  * @param	Operation					Function to be called for each object
  * @param	bIncludeDerivedClasses		If true, the results will include objects of child classes as well.
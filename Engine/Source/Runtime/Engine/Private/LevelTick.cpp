@@ -1381,6 +1381,12 @@ void UWorld::Tick( ELevelTick TickType, float DeltaSeconds )
 		{
 			bShouldDelayGarbageCollect = false;
 		}
+		// Keep advancing incremental reachability analysis every frame once a cycle has started.
+		else if (IsIncrementalReachabilityAnalysisPending())
+		{
+			SCOPE_CYCLE_COUNTER(STAT_GCMarkTime);
+			PerformGarbageCollectionAndCleanupActors();
+		}
 		// Perform incremental purge update if it's pending or in progress.
 		else if( !IsIncrementalPurgePending() 
 		// Purge reference to pending kill objects every now and so often.
@@ -1478,8 +1484,11 @@ void UWorld::PerformGarbageCollectionAndCleanupActors()
 	// to block on loading the remaining data.
 	if( !IsAsyncLoading() )
 	{
-		// Perform housekeeping.
-		if (TryCollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, false))
+		// Perform housekeeping, a time slice at a time if incremental reachability analysis is enabled.
+		const bool bCollectedGarbage = IsIncrementalReachabilityAnalysisEnabled() ?
+			TryCollectGarbageIncremental(GARBAGE_COLLECTION_KEEPFLAGS) :
+			TryCollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, false);
+		if (bCollectedGarbage)
 		{
 			CleanupActors();
 
@@ -1156,7 +1156,7 @@ int32 FEngineLoop::PreInit( const TCHAR* CmdLine )
 		{
 			NumThreadsInThreadPool = 1;
 		}
-		verify(GThreadPool->Create(NumThreadsInThreadPool));
+		verify(GThreadPool->Create(NumThreadsInThreadPool, 32 * 1024, TPri_Normal, TEXT("ThreadPool")));
 
 #if WITH_EDITOR
 		// when we are in the editor we like to do things like build lighting and such
@@ -1164,7 +1164,7 @@ int32 FEngineLoop::PreInit( const TCHAR* CmdLine )
 		GLargeThreadPool = FQueuedThreadPool::Allocate();
 		int32 NumThreadsInLargeThreadPool = FPlatformMisc::NumberOfCoresIncludingHyperthreads() - 2;
 
-		verify(GLargeThreadPool->Create(NumThreadsInLargeThreadPool));
+		verify(GLargeThreadPool->Create(NumThreadsInLargeThreadPool, 32 * 1024, TPri_Normal, TEXT("LargeThreadPool")));
 #endif
 	}
 
@@ -2330,6 +2330,7 @@ void FEngineLoop::Exit()
 
 	FTaskGraphInterface::Shutdown();
 	IStreamingManager::Shutdown();
+	FQueuedAsyncReadFileHandle::ShutdownIOThreads();
 	FIOSystem::Shutdown();
 }
 
@@ -15,6 +15,17 @@
 
 DEFINE_LOG_CATEGORY(LogPakFile);
 
+DECLARE_CYCLE_STAT(TEXT("Wait For Pak Block"), STAT_WaitForPakBlock, STATGROUP_PakFile);
+
+static int32 GPakReadAheadBlocks = 4;
+static FAutoConsoleVariableRef CVarPakReadAheadBlocks(
+	TEXT("pak.ReadAheadBlocks"),
+	GPakReadAheadBlocks,
+	TEXT("Number of compression blocks decompressed on worker threads ahead of sequential reads from compressed pak files.\n") \
+	TEXT("Each open compressed file caches up to this many blocks plus one. 0 disables the cache and read-ahead. Applies to files opened afterwards."),
+	ECVF_Default
+	);
+
 
 /**
  * Class to handle correctly reading from a compressed file within a compressed package
@@ -81,6 +92,9 @@ public:
 	class FPakUncompressTask : public FNonAbandonableTask
 	{
 	public:
+		/** Pak file to read the compressed block from on the thread running the task, NULL if CompressedBuffer is already filled. */
+		const FPakFile*		ReadPakFile;
+		int64				ReadOffset;
 		uint8*				UncompressedBuffer;
 		int32				UncompressedSize;
 		uint8*				CompressedBuffer;
@@ -90,8 +104,20 @@ public:
 		int64				CopyOffset;
 		int64				CopyLength;
 
+		FPakUncompressTask()
+			: ReadPakFile(nullptr)
+			, ReadOffset(0)
+		{
+		}
+
 		void DoWork()
 		{
+			if (ReadPakFile)
+			{
+				FArchive* Reader = ReadPakFile->GetWorkerReader();
+				Reader->Seek(ReadOffset);
+				Reader->Serialize(CompressedBuffer, EncryptionPolicy::AlignReadRequest(CompressedSize));
+			}
 			// Decrypt and Uncompress from memory to memory.
 			int64 EncryptionSize = EncryptionPolicy::AlignReadRequest(CompressedSize);
 			EncryptionPolicy::DecryptBlock(CompressedBuffer, EncryptionSize);
@@ -110,10 +136,46 @@ public:
 		}
 	};
 
+	/** Decompressed block held by the read-ahead cache. */
+	struct FCachedBlock
+	{
+		/** Index of the block held here, INDEX_NONE if the slot is free. */
+		int32				BlockIndex;
+		/** True if UncompressTask was started and hasn't been waited for. */
+		bool				bPending;
+		/** Compressed (and encrypted) block data. */
+		TArray<uint8>		CompressedData;
+		/** Decompressed block data. */
+		TArray<uint8>		UncompressedData;
+		FAsyncTask<FPakUncompressTask> UncompressTask;
+
+		FCachedBlock()
+			: BlockIndex(INDEX_NONE)
+			, bPending(false)
+		{
+		}
+
+		~FCachedBlock()
+		{
+			Wait();
+		}
+
+		void Wait()
+		{
+			if (bPending)
+			{
+				UncompressTask.EnsureCompletion();
+				bPending = false;
+			}
+		}
+	};
+
 	FPakCompressedReaderPolicy(const FPakFile& InPakFile, const FPakEntry& InPakEntry, FArchive* InPakReader)
 		: PakFile(InPakFile)
 		, PakEntry(InPakEntry)
 		, PakReader(InPakReader)
+		, NumReadAheadBlocks(FMath::Max(GPakReadAheadBlocks, 0))
+		, SequentialPosition(-1)
 	{
 	}
 
@@ -123,6 +185,12 @@ public:
 	const FPakEntry&	PakEntry;
 	/** Pak file archive to read the data from. */
 	FArchive*			PakReader;
+	/** Number of blocks decompressed ahead of sequential reads, 0 if this handle doesn't cache blocks. */
+	const int32			NumReadAheadBlocks;
+	/** Position right after the previous read, a read starting here is sequential. */
+	int64				SequentialPosition;
+	/** Decompressed blocks, NumReadAheadBlocks + 1 slots allocated by the first read. */
+	TIndirectArray<FCachedBlock> CachedBlocks;
 
 	FORCEINLINE int64 FileSize() const
 	{
@@ -130,6 +198,140 @@ public:
 	}
 
 	void Serialize(int64 DesiredPosition, void* V, int64 Length)
+	{
+		if (NumReadAheadBlocks > 0)
+		{
+			SerializeCached(DesiredPosition, V, Length);
+		}
+		else
+		{
+			SerializeUncached(DesiredPosition, V, Length);
+		}
+	}
+
+private:
+
+	/**
+	 * Reads through the block cache. The blocks following the current one are handed to worker threads, which read
+	 * and decompress them while the caller waits for the current block and consumes the data.
+	 * Past the requested range this only happens for sequential reads.
+	 */
+	void SerializeCached(int64 DesiredPosition, void* V, int64 Length)
+	{
+		const int64 CompressionBlockSize = PakEntry.CompressionBlockSize;
+		const int32 LastRequestedBlock = (int32)((DesiredPosition + Length - 1) / CompressionBlockSize);
+		const int32 LastWantedBlock = DesiredPosition == SequentialPosition ? PakEntry.CompressionBlocks.Num() - 1 : LastRequestedBlock;
+		int32 CompressionBlockIndex = (int32)(DesiredPosition / CompressionBlockSize);
+		int64 DirectCopyStart = DesiredPosition % CompressionBlockSize;
+		SequentialPosition = DesiredPosition + Length;
+
+		if (CachedBlocks.Num() == 0)
+		{
+			for (int32 SlotIndex = 0; SlotIndex <= NumReadAheadBlocks; ++SlotIndex)
+			{
+				CachedBlocks.Add(new FCachedBlock());
+			}
+		}
+
+		while (Length > 0)
+		{
+			const int32 LastWindowBlock = FMath::Min(CompressionBlockIndex + NumReadAheadBlocks, LastWantedBlock);
+			for (int32 AheadBlockIndex = CompressionBlockIndex + 1; AheadBlockIndex <= LastWindowBlock; ++AheadBlockIndex)
+			{
+				if (!FindCachedBlock(AheadBlockIndex))
+				{
+					StartBlock(AheadBlockIndex, CompressionBlockIndex, LastWindowBlock, false);
+				}
+			}
+
+			FCachedBlock* Block = FindCachedBlock(CompressionBlockIndex);
+			if (!Block)
+			{
+				Block = &StartBlock(CompressionBlockIndex, CompressionBlockIndex, LastWindowBlock, true);
+			}
+			{
+				SCOPE_CYCLE_COUNTER(STAT_WaitForPakBlock);
+				Block->Wait();
+			}
+
+			const int64 WriteSize = FMath::Min<int64>(Block->UncompressedData.Num() - DirectCopyStart, Length);
+			FMemory::Memcpy(V, Block->UncompressedData.GetData() + DirectCopyStart, WriteSize);
+			V = (void*)((uint8*)V + WriteSize);
+			Length -= WriteSize;
+			DirectCopyStart = 0;
+			++CompressionBlockIndex;
+		}
+	}
+
+	FCachedBlock* FindCachedBlock(int32 CompressionBlockIndex)
+	{
+		for (FCachedBlock& Block : CachedBlocks)
+		{
+			if (Block.BlockIndex == CompressionBlockIndex)
+			{
+				return &Block;
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Starts reading and decompressing a block into a cache slot holding a block outside of [FirstKeptBlock, LastKeptBlock].
+	 * Synchronous blocks are read on the calling thread.
+	 */
+	FCachedBlock& StartBlock(int32 CompressionBlockIndex, int32 FirstKeptBlock, int32 LastKeptBlock, bool bSynchronous)
+	{
+		FCachedBlock* FreeBlock = nullptr;
+		for (FCachedBlock& Block : CachedBlocks)
+		{
+			if (Block.BlockIndex < FirstKeptBlock || Block.BlockIndex > LastKeptBlock)
+			{
+				FreeBlock = &Block;
+				break;
+			}
+		}
+		check(FreeBlock);
+		FreeBlock->Wait();
+
+		const FPakCompressedBlock& CompressedBlock = PakEntry.CompressionBlocks[CompressionBlockIndex];
+		const int64 CompressedSize = CompressedBlock.CompressedEnd - CompressedBlock.CompressedStart;
+		const int64 Pos = (int64)CompressionBlockIndex * PakEntry.CompressionBlockSize;
+		FreeBlock->BlockIndex = CompressionBlockIndex;
+		FreeBlock->CompressedData.SetNumUninitialized(EncryptionPolicy::AlignReadRequest(CompressedSize));
+		FreeBlock->UncompressedData.SetNumUninitialized(FMath::Min<int64>(PakEntry.UncompressedSize - Pos, PakEntry.CompressionBlockSize));
+
+		// read-ahead blocks are read by the worker, so the caller only waits for the block it needs
+		FPakUncompressTask& TaskDetails = FreeBlock->UncompressTask.GetTask();
+		const bool bReadOnWorker = !bSynchronous && PakFile.CanOpenWorkerReaders();
+		if (!bReadOnWorker)
+		{
+			PakReader->Seek(CompressedBlock.CompressedStart);
+			PakReader->Serialize(FreeBlock->CompressedData.GetData(), FreeBlock->CompressedData.Num());
+		}
+		TaskDetails.ReadPakFile = bReadOnWorker ? &PakFile : nullptr;
+		TaskDetails.ReadOffset = CompressedBlock.CompressedStart;
+		TaskDetails.Flags = (ECompressionFlags)PakEntry.CompressionMethod;
+		TaskDetails.UncompressedBuffer = FreeBlock->UncompressedData.GetData();
+		TaskDetails.UncompressedSize = FreeBlock->UncompressedData.Num();
+		TaskDetails.CompressedBuffer = FreeBlock->CompressedData.GetData();
+		TaskDetails.CompressedSize = CompressedSize;
+		TaskDetails.CopyOut = nullptr;
+		if (bSynchronous)
+		{
+			FreeBlock->UncompressTask.StartSynchronousTask();
+		}
+		else
+		{
+			FreeBlock->UncompressTask.StartBackgroundTask();
+		}
+		FreeBlock->bPending = true;
+		return *FreeBlock;
+	}
+
+	/**
+	 * Reads without caching, overlapping the decompression of each block with reading the next one.
+	 */
+	void SerializeUncached(int64 DesiredPosition, void* V, int64 Length)
 	{
 		const int32 CompressionBlockSize = PakEntry.CompressionBlockSize;
 		uint32 CompressionBlockIndex = DesiredPosition / CompressionBlockSize;
@@ -235,8 +437,11 @@ bool FPakEntry::VerifyPakEntriesMatch(const FPakEntry& FileEntryA, const FPakEnt
 
 FPakFile::FPakFile(const TCHAR* Filename, bool bIsSigned)
 	: PakFilename(Filename)
+	, ReaderLowerLevel(NULL)
+	, IndexLoadTime(0.0)
 	, bSigned(bIsSigned)
 	, bIsValid(false)
+	, bCompactIndex(false)
 {
 	FArchive* Reader = GetSharedReader(NULL);
 	if (Reader)
@@ -248,8 +453,11 @@ FPakFile::FPakFile(const TCHAR* Filename, bool bIsSigned)
 
 FPakFile::FPakFile(IPlatformFile* LowerLevel, const TCHAR* Filename, bool bIsSigned)
 	: PakFilename(Filename)
+	, ReaderLowerLevel(LowerLevel)
+	, IndexLoadTime(0.0)
 	, bSigned(bIsSigned)
 	, bIsValid(false)
+	, bCompactIndex(false)
 {
 	FArchive* Reader = GetSharedReader(LowerLevel);
 	if (Reader)
@@ -260,8 +468,11 @@ FPakFile::FPakFile(IPlatformFile* LowerLevel, const TCHAR* Filename, bool bIsSig
 }
 
 FPakFile::FPakFile(FArchive* Archive)
-	: bSigned(false)
+	: ReaderLowerLevel(NULL)
+	, IndexLoadTime(0.0)
+	, bSigned(false)
 	, bIsValid(false)
+	, bCompactIndex(false)
 {
 	Initialize(Archive);
 }
@@ -282,11 +493,18 @@ FArchive* FPakFile::CreatePakReader(IFileHandle& InHandle, const TCHAR* Filename
 	return SetupSignedPakReader(ReaderArchive);
 }
 
-FArchive* FPakFile::SetupSignedPakReader(FArchive* ReaderArchive)
+bool FPakFile::IsSigned() const
 {
-#if !USING_SIGNED_CONTENT
-	if (bSigned || FParse::Param(FCommandLine::Get(), TEXT("signedpak")) || FParse::Param(FCommandLine::Get(), TEXT("signed")))
+#if USING_SIGNED_CONTENT
+	return true;
+#else
+	return bSigned || FParse::Param(FCommandLine::Get(), TEXT("signedpak")) || FParse::Param(FCommandLine::Get(), TEXT("signed"));
 #endif
+}
+
+FArchive* FPakFile::SetupSignedPakReader(FArchive* ReaderArchive)
+{
+	if (IsSigned())
 	{	
 		if (!Decryptor.IsValid())
 		{
@@ -325,6 +543,8 @@ void FPakFile::LoadIndex(FArchive* Reader)
 	}
 	else
 	{
+		const double StartTime = FPlatformTime::Seconds();
+
 		// Load index into memory first.
 		Reader->Seek(Info.IndexOffset);
 		TArray<uint8> IndexData;
@@ -346,10 +566,26 @@ void FPakFile::LoadIndex(FArchive* Reader)
 		IndexReader << NumEntries;
 
 		MakeDirectoryFromPath(MountPoint);
+
+		bCompactIndex = FParse::Param(FCommandLine::Get(), TEXT("CompactPakIndex"));
+		if (bCompactIndex)
+		{
+			const int64 EntriesOffset = IndexReader.Tell();
+			bCompactIndex = LoadCompactIndex(IndexData, IndexReader, NumEntries);
+			if (!bCompactIndex)
+			{
+				UE_LOG(LogPakFile, Warning, TEXT("Path hash collision in pak file \"%s\", using the directory map index."), *PakFilename);
+				IndexReader.Seek(EntriesOffset);
+			}
+		}
+
 		// Allocate enough memory to hold all entries (and not reallocate while they're being added to it).
-		Files.Empty(NumEntries);
+		if (!bCompactIndex)
+		{
+			Files.Empty(NumEntries);
+		}
 
-		for (int32 EntryIndex = 0; EntryIndex < NumEntries; EntryIndex++)
+		for (int32 EntryIndex = 0; !bCompactIndex && EntryIndex < NumEntries; EntryIndex++)
 		{
 			// Serialize from memory.
 			FPakEntry Entry;
@@ -396,6 +632,434 @@ void FPakFile::LoadIndex(FArchive* Reader)
 				}
 			}
 		}
+
+		IndexLoadTime = FPlatformTime::Seconds() - StartTime;
+		UE_LOG(LogPakFile, Log, TEXT("Loaded %s index of pak file \"%s\": %d files, %.1f KB, %.2f ms."), bCompactIndex ? TEXT("compact") : TEXT("map"), *PakFilename, Files.Num(), GetIndexAllocatedSize() / 1024.0f, IndexLoadTime * 1000.0);
+	}
+}
+
+/** 64-bit FNV-1a hash of a lower case path, so lookups are case insensitive like the directory map. */
+template <typename CharType>
+static uint64 HashPakPath(const CharType* Path, int32 Len)
+{
+	uint64 Hash = 0xcbf29ce484222325ull;
+	for (int32 CharIndex = 0; CharIndex < Len; ++CharIndex)
+	{
+		Hash = (Hash ^ (uint64)FChar::ToLower((TCHAR)Path[CharIndex])) * 0x00000100000001b3ull;
+	}
+	return Hash;
+}
+
+/** Finds a hash in a sorted hash array, returns the index it maps to or INDEX_NONE. */
+static int32 FindPakPathHash(const TArray<FPakPathHash>& Hashes, uint64 Hash)
+{
+	int32 Min = 0;
+	int32 Max = Hashes.Num();
+	while (Min < Max)
+	{
+		const int32 Mid = Min + (Max - Min) / 2;
+		if (Hashes[Mid].Hash < Hash)
+		{
+			Min = Mid + 1;
+		}
+		else
+		{
+			Max = Mid;
+		}
+	}
+	return (Min < Hashes.Num() && Hashes[Min].Hash == Hash) ? Hashes[Min].Index : INDEX_NONE;
+}
+
+/** Sorts path hashes and checks that no two paths share a hash. */
+static bool SortPakPathHashes(TArray<FPakPathHash>& Hashes)
+{
+	Hashes.Sort();
+	for (int32 HashIndex = 1; HashIndex < Hashes.Num(); ++HashIndex)
+	{
+		if (Hashes[HashIndex].Hash == Hashes[HashIndex - 1].Hash)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Builds the directory table and path table of a compact pak index.
+ */
+class FPakCompactIndexBuilder
+{
+	/** Directories being built. */
+	TArray<FPakCompactDirectory>& Directories;
+	/** Path table being built. */
+	TArray<ANSICHAR>& PathTable;
+	/** Directory path hash to directory index. */
+	TMap<uint64, int32> DirectoryLookup;
+	/** Lower case paths of all directories, used to detect hash collisions while building. */
+	TArray<FString> DirectoryPaths;
+
+public:
+
+	/** Directory path hashes, in directory order. */
+	TArray<uint64> DirectoryHashes;
+	/** True if two different directories have the same hash. */
+	bool bHashCollision;
+
+	FPakCompactIndexBuilder(TArray<FPakCompactDirectory>& InDirectories, TArray<ANSICHAR>& InPathTable)
+		: Directories(InDirectories)
+		, PathTable(InPathTable)
+		, bHashCollision(false)
+	{
+		// The mount point and empty names live at offset 0.
+		PathTable.Add(0);
+		AddDirectory(INDEX_NONE, 0, HashPakPath(TEXT(""), 0), FString());
+	}
+
+	/** Appends a UTF-8 name to the path table and returns its offset. */
+	int32 AddName(const TCHAR* Name, int32 Len)
+	{
+		const int32 Offset = PathTable.Num();
+		FTCHARToUTF8 Converted(Name, Len);
+		PathTable.Append((const ANSICHAR*)Converted.Get(), Converted.Length());
+		PathTable.Add(0);
+		return Offset;
+	}
+
+	/** Serialized ANSI names are pure ASCII so they're already valid UTF-8. */
+	int32 AddName(const ANSICHAR* Name, int32 Len)
+	{
+		const int32 Offset = PathTable.Num();
+		PathTable.Append(Name, Len);
+		PathTable.Add(0);
+		return Offset;
+	}
+
+	/**
+	 * Finds or adds the directory of a path and all its parents.
+	 *
+	 * @param Path Path relative to the mount point.
+	 * @param Len Length of the directory part of the path, including the trailing '/'.
+	 * @return Directory index.
+	 */
+	template <typename CharType>
+	int32 FindOrAddDirectory(const CharType* Path, int32 Len)
+	{
+		const uint64 Hash = HashPakPath(Path, Len);
+		const int32* ExistingIndex = DirectoryLookup.Find(Hash);
+		if (ExistingIndex)
+		{
+			const FString& ExistingPath = DirectoryPaths[*ExistingIndex];
+			if (ExistingPath.Len() != Len)
+			{
+				bHashCollision = true;
+			}
+			for (int32 CharIndex = 0; CharIndex < Len && !bHashCollision; ++CharIndex)
+			{
+				bHashCollision = ExistingPath[CharIndex] != FChar::ToLower((TCHAR)Path[CharIndex]);
+			}
+			return *ExistingIndex;
+		}
+
+		int32 ParentLen = Len - 1;
+		while (ParentLen > 0 && Path[ParentLen - 1] != '/')
+		{
+			--ParentLen;
+		}
+		const int32 Parent = FindOrAddDirectory(Path, ParentLen);
+
+		FString LowerPath;
+		TArray<TCHAR>& LowerChars = LowerPath.GetCharArray();
+		LowerChars.AddUninitialized(Len + 1);
+		for (int32 CharIndex = 0; CharIndex < Len; ++CharIndex)
+		{
+			LowerChars[CharIndex] = FChar::ToLower((TCHAR)Path[CharIndex]);
+		}
+		LowerChars[Len] = 0;
+		return AddDirectory(Parent, AddName(Path + ParentLen, Len - ParentLen), Hash, MoveTemp(LowerPath));
+	}
+
+private:
+
+	int32 AddDirectory(int32 Parent, int32 NameOffset, uint64 Hash, FString&& LowerPath)
+	{
+		FPakCompactDirectory Directory;
+		Directory.Parent = Parent;
+		Directory.NameOffset = NameOffset;
+		Directory.FirstFile = 0;
+		Directory.NumFiles = 0;
+		Directory.FirstChild = 0;
+		Directory.NumChildren = 0;
+		const int32 DirectoryIndex = Directories.Add(Directory);
+		DirectoryLookup.Add(Hash, DirectoryIndex);
+		DirectoryPaths.Add(MoveTemp(LowerPath));
+		DirectoryHashes.Add(Hash);
+		return DirectoryIndex;
+	}
+};
+
+/**
+ * Adds a serialized filename to the compact index being built.
+ *
+ * @return Directory index of the file.
+ */
+template <typename CharType>
+static int32 AddCompactIndexFilename(FPakCompactIndexBuilder& Builder, const CharType* Filename, int32 Len, FPakPathHash& OutHash, int32& OutNameOffset)
+{
+	int32 DirectoryLen = Len;
+	while (DirectoryLen > 0 && Filename[DirectoryLen - 1] != '/')
+	{
+		--DirectoryLen;
+	}
+	OutHash.Hash = HashPakPath(Filename, Len);
+	OutNameOffset = Builder.AddName(Filename + DirectoryLen, Len - DirectoryLen);
+	return Builder.FindOrAddDirectory(Filename, DirectoryLen);
+}
+
+bool FPakFile::LoadCompactIndex(const TArray<uint8>& IndexData, FArchive& IndexReader, int32 NumEntries)
+{
+	Files.Empty(NumEntries);
+	Files.AddDefaulted(NumEntries);
+	FileHashes.Empty(NumEntries);
+	FileHashes.AddUninitialized(NumEntries);
+	FileNameOffsets.Empty(NumEntries);
+	FileNameOffsets.AddUninitialized(NumEntries);
+	Directories.Empty();
+	PathTable.Empty();
+
+	TArray<int32> FileDirectories;
+	FileDirectories.AddUninitialized(NumEntries);
+
+	// Filenames are hashed straight from the index data, only wide names are converted to strings.
+	FPakCompactIndexBuilder Builder(Directories, PathTable);
+	FString WideFilename;
+	for (int32 EntryIndex = 0; EntryIndex < NumEntries; EntryIndex++)
+	{
+		const int64 FilenameOffset = IndexReader.Tell();
+		int32 SaveNum = 0;
+		IndexReader << SaveNum;
+		if (SaveNum >= 0)
+		{
+			if (IndexReader.Tell() + SaveNum > IndexData.Num())
+			{
+				UE_LOG(LogPakFile, Fatal, TEXT("Corrupted index in pak file (filename out of bounds)."));
+			}
+			const ANSICHAR* Filename = (const ANSICHAR*)IndexData.GetData() + IndexReader.Tell();
+			FileDirectories[EntryIndex] = AddCompactIndexFilename(Builder, Filename, FMath::Max(SaveNum - 1, 0), FileHashes[EntryIndex], FileNameOffsets[EntryIndex]);
+			IndexReader.Seek(IndexReader.Tell() + SaveNum);
+		}
+		else
+		{
+			IndexReader.Seek(FilenameOffset);
+			IndexReader << WideFilename;
+			FileDirectories[EntryIndex] = AddCompactIndexFilename(Builder, *WideFilename, WideFilename.Len(), FileHashes[EntryIndex], FileNameOffsets[EntryIndex]);
+		}
+		Files[EntryIndex].Serialize(IndexReader, Info.Version);
+	}
+
+	// Group files by directory.
+	for (int32 EntryIndex = 0; EntryIndex < NumEntries; EntryIndex++)
+	{
+		Directories[FileDirectories[EntryIndex]].NumFiles++;
+	}
+	int32 FirstFile = 0;
+	for (FPakCompactDirectory& Directory : Directories)
+	{
+		Directory.FirstFile = FirstFile;
+		FirstFile += Directory.NumFiles;
+		Directory.NumFiles = 0;
+	}
+	TArray<FPakEntry> SortedFiles;
+	SortedFiles.AddDefaulted(NumEntries);
+	TArray<int32> SortedNameOffsets;
+	SortedNameOffsets.AddUninitialized(NumEntries);
+	for (int32 EntryIndex = 0; EntryIndex < NumEntries; EntryIndex++)
+	{
+		FPakCompactDirectory& Directory = Directories[FileDirectories[EntryIndex]];
+		const int32 SortedIndex = Directory.FirstFile + Directory.NumFiles++;
+		Exchange(SortedFiles[SortedIndex], Files[EntryIndex]);
+		SortedNameOffsets[SortedIndex] = FileNameOffsets[EntryIndex];
+		FileHashes[EntryIndex].Index = SortedIndex;
+	}
+	Exchange(Files, SortedFiles);
+	Exchange(FileNameOffsets, SortedNameOffsets);
+
+	// Group sub-directories by parent.
+	for (int32 DirectoryIndex = 1; DirectoryIndex < Directories.Num(); DirectoryIndex++)
+	{
+		Directories[Directories[DirectoryIndex].Parent].NumChildren++;
+	}
+	int32 FirstChild = 0;
+	for (FPakCompactDirectory& Directory : Directories)
+	{
+		Directory.FirstChild = FirstChild;
+		FirstChild += Directory.NumChildren;
+		Directory.NumChildren = 0;
+	}
+	DirectoryChildren.Empty(Directories.Num() - 1);
+	DirectoryChildren.AddUninitialized(Directories.Num() - 1);
+	for (int32 DirectoryIndex = 1; DirectoryIndex < Directories.Num(); DirectoryIndex++)
+	{
+		FPakCompactDirectory& Parent = Directories[Directories[DirectoryIndex].Parent];
+		DirectoryChildren[Parent.FirstChild + Parent.NumChildren++] = DirectoryIndex;
+	}
+
+	// Like the directory map, the mount point is only a directory if it has files.
+	DirectoryHashes.Empty(Directories.Num());
+	for (int32 DirectoryIndex = Directories[0].NumFiles > 0 ? 0 : 1; DirectoryIndex < Directories.Num(); DirectoryIndex++)
+	{
+		FPakPathHash& DirectoryHash = DirectoryHashes[DirectoryHashes.AddUninitialized()];
+		DirectoryHash.Hash = Builder.DirectoryHashes[DirectoryIndex];
+		DirectoryHash.Index = DirectoryIndex;
+	}
+
+	PathTable.Shrink();
+	const bool bUniqueHashes = !Builder.bHashCollision && SortPakPathHashes(FileHashes) && SortPakPathHashes(DirectoryHashes);
+	if (!bUniqueHashes)
+	{
+		Files.Empty();
+		FileHashes.Empty();
+		DirectoryHashes.Empty();
+		Directories.Empty();
+		DirectoryChildren.Empty();
+		FileNameOffsets.Empty();
+		PathTable.Empty();
+	}
+	return bUniqueHashes;
+}
+
+SIZE_T FPakFile::GetIndexAllocatedSize() const
+{
+	SIZE_T Size = Files.GetAllocatedSize() + Index.GetAllocatedSize()
+		+ FileHashes.GetAllocatedSize() + DirectoryHashes.GetAllocatedSize() + Directories.GetAllocatedSize()
+		+ DirectoryChildren.GetAllocatedSize() + FileNameOffsets.GetAllocatedSize() + PathTable.GetAllocatedSize();
+	for (const FPakEntry& Entry : Files)
+	{
+		Size += Entry.CompressionBlocks.GetAllocatedSize();
+	}
+	for (TMap<FString, FPakDirectory>::TConstIterator It(Index); It; ++It)
+	{
+		Size += It.Key().GetAllocatedSize() + It.Value().GetAllocatedSize();
+		for (FPakDirectory::TConstIterator DirectoryIt(It.Value()); DirectoryIt; ++DirectoryIt)
+		{
+			Size += DirectoryIt.Key().GetAllocatedSize();
+		}
+	}
+	return Size;
+}
+
+const FPakEntry* FPakFile::FindCompactFile(const TCHAR* RelativeFilename, int32 Len) const
+{
+	const int32 FileIndex = FindPakPathHash(FileHashes, HashPakPath(RelativeFilename, Len));
+	return FileIndex != INDEX_NONE ? &Files[FileIndex] : NULL;
+}
+
+int32 FPakFile::FindCompactDirectory(const TCHAR* RelativePath, int32 Len) const
+{
+	return FindPakPathHash(DirectoryHashes, HashPakPath(RelativePath, Len));
+}
+
+FString FPakFile::GetCompactDirectoryPath(int32 DirectoryIndex) const
+{
+	TArray<int32, TInlineAllocator<32>> Path;
+	for (int32 PathIndex = DirectoryIndex; PathIndex > 0; PathIndex = Directories[PathIndex].Parent)
+	{
+		Path.Add(PathIndex);
+	}
+	FString Result;
+	for (int32 PathIndex = Path.Num() - 1; PathIndex >= 0; --PathIndex)
+	{
+		Result += UTF8_TO_TCHAR(&PathTable[Directories[Path[PathIndex]].NameOffset]);
+	}
+	return Result;
+}
+
+FString FPakFile::GetCompactFilename(int32 FileIndex) const
+{
+	// Directories own consecutive files in directory order, find the last one starting at or before the file.
+	int32 Min = 0;
+	int32 Max = Directories.Num();
+	while (Min < Max)
+	{
+		const int32 Mid = Min + (Max - Min) / 2;
+		if (Directories[Mid].FirstFile <= FileIndex)
+		{
+			Min = Mid + 1;
+		}
+		else
+		{
+			Max = Mid;
+		}
+	}
+	return GetCompactDirectoryPath(Min - 1) + UTF8_TO_TCHAR(&PathTable[FileNameOffsets[FileIndex]]);
+}
+
+void FPakFile::FindCompactFilesAtPath(TArray<FString>& OutFiles, const FString& Directory, bool bIncludeFiles, bool bIncludeDirectories, bool bRecursive) const
+{
+	TArray<FString> DirectoriesInPak;
+	if (Directory.StartsWith(MountPoint))
+	{
+		const int32 DirectoryIndex = FindCompactDirectory(*Directory + MountPoint.Len(), Directory.Len() - MountPoint.Len());
+		if (DirectoryIndex == INDEX_NONE)
+		{
+			return;
+		}
+		const FString DirectoryPath = MountPoint + GetCompactDirectoryPath(DirectoryIndex);
+		if (bRecursive)
+		{
+			AddCompactDirectoryContents(OutFiles, DirectoriesInPak, DirectoryIndex, DirectoryPath, bIncludeFiles, bIncludeDirectories);
+		}
+		else
+		{
+			const FPakCompactDirectory& PakDirectory = Directories[DirectoryIndex];
+			for (int32 FileIndex = PakDirectory.FirstFile; bIncludeFiles && FileIndex < PakDirectory.FirstFile + PakDirectory.NumFiles; ++FileIndex)
+			{
+				OutFiles.Add(DirectoryPath + UTF8_TO_TCHAR(&PathTable[FileNameOffsets[FileIndex]]));
+			}
+			for (int32 ChildIndex = PakDirectory.FirstChild; bIncludeDirectories && ChildIndex < PakDirectory.FirstChild + PakDirectory.NumChildren; ++ChildIndex)
+			{
+				DirectoriesInPak.Add(DirectoryPath + UTF8_TO_TCHAR(&PathTable[Directories[DirectoryChildren[ChildIndex]].NameOffset]));
+			}
+		}
+	}
+	else if (MountPoint.StartsWith(Directory) && Files.Num() > 0)
+	{
+		// The whole pak is below the specified path.
+		if (bRecursive)
+		{
+			if (bIncludeDirectories && Directories[0].NumFiles > 0)
+			{
+				DirectoriesInPak.Add(MountPoint);
+			}
+			AddCompactDirectoryContents(OutFiles, DirectoriesInPak, 0, MountPoint, bIncludeFiles, bIncludeDirectories);
+		}
+		else if (bIncludeDirectories)
+		{
+			const int32 SubDirIndex = MountPoint.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Directory.Len() + 1);
+			if (SubDirIndex != INDEX_NONE)
+			{
+				DirectoriesInPak.Add(MountPoint.Left(SubDirIndex + 1));
+			}
+		}
+	}
+	OutFiles.Append(DirectoriesInPak);
+}
+
+void FPakFile::AddCompactDirectoryContents(TArray<FString>& OutFiles, TArray<FString>& OutDirectories, int32 DirectoryIndex, const FString& DirectoryPath, bool bIncludeFiles, bool bIncludeDirectories) const
+{
+	const FPakCompactDirectory& PakDirectory = Directories[DirectoryIndex];
+	for (int32 FileIndex = PakDirectory.FirstFile; bIncludeFiles && FileIndex < PakDirectory.FirstFile + PakDirectory.NumFiles; ++FileIndex)
+	{
+		OutFiles.Add(DirectoryPath + UTF8_TO_TCHAR(&PathTable[FileNameOffsets[FileIndex]]));
+	}
+	for (int32 ChildIndex = PakDirectory.FirstChild; ChildIndex < PakDirectory.FirstChild + PakDirectory.NumChildren; ++ChildIndex)
+	{
+		const int32 ChildDirectoryIndex = DirectoryChildren[ChildIndex];
+		const FString ChildPath = DirectoryPath + UTF8_TO_TCHAR(&PathTable[Directories[ChildDirectoryIndex].NameOffset]);
+		if (bIncludeDirectories)
+		{
+			OutDirectories.Add(ChildPath);
+		}
+		AddCompactDirectoryContents(OutFiles, OutDirectories, ChildDirectoryIndex, ChildPath, bIncludeFiles, bIncludeDirectories);
 	}
 }
 
@@ -467,6 +1131,16 @@ public:
 			PlatformFile.HandlePakListCommand(Cmd, Ar);
 			return true;
 		}
+		else if (FParse::Command(&Cmd, TEXT("PakIndexStats")))
+		{
+			PlatformFile.HandlePakIndexStatsCommand(Cmd, Ar);
+			return true;
+		}
+		else if (FParse::Command(&Cmd, TEXT("PakReadBenchmark")))
+		{
+			PlatformFile.HandlePakReadBenchmarkCommand(Cmd, Ar);
+			return true;
+		}
 		return false;
 	}
 };
@@ -500,6 +1174,93 @@ void FPakPlatformFile::HandlePakListCommand(const TCHAR* Cmd, FOutputDevice& Ar)
 		Ar.Logf(TEXT("%s"), *Pak.PakFile->GetFilename());
 	}	
 }
+
+void FPakPlatformFile::HandlePakIndexStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	TArray<FPakListEntry> Paks;
+	GetMountedPaks(Paks);
+	int32 TotalFiles = 0;
+	SIZE_T TotalSize = 0;
+	double TotalLoadTime = 0.0;
+	for (auto Pak : Paks)
+	{
+		const SIZE_T IndexSize = Pak.PakFile->GetIndexAllocatedSize();
+		Ar.Logf(TEXT("%s: %s index, %d files, %.1f KB, loaded in %.2f ms"), *Pak.PakFile->GetFilename(), Pak.PakFile->IsCompactIndex() ? TEXT("compact") : TEXT("map"),
+			Pak.PakFile->GetNumFiles(), IndexSize / 1024.0f, Pak.PakFile->GetIndexLoadTime() * 1000.0);
+		TotalFiles += Pak.PakFile->GetNumFiles();
+		TotalSize += IndexSize;
+		TotalLoadTime += Pak.PakFile->GetIndexLoadTime();
+	}
+	Ar.Logf(TEXT("%d paks, %d files, %.1f KB of index, loaded in %.2f ms"), Paks.Num(), TotalFiles, TotalSize / 1024.0f, TotalLoadTime * 1000.0);
+}
+
+void FPakPlatformFile::HandlePakReadBenchmarkCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	// PakReadBenchmark [PakFilenameSubstring] [-ReadSize=KB] [-ReadAhead=Blocks]
+	int32 ReadSizeKB = 256;
+	int32 ReadAheadBlocks = GPakReadAheadBlocks > 0 ? GPakReadAheadBlocks : 4;
+	FParse::Value(Cmd, TEXT("-ReadSize="), ReadSizeKB);
+	FParse::Value(Cmd, TEXT("-ReadAhead="), ReadAheadBlocks);
+	FString PakFilter = FParse::Token(Cmd, false);
+	if (PakFilter.StartsWith(TEXT("-")))
+	{
+		PakFilter.Empty();
+	}
+
+	// Compressed files of the matching paks.
+	TArray<FString> CompressedFiles;
+	int64 CompressedSize = 0;
+	TArray<FPakListEntry> Paks;
+	GetMountedPaks(Paks);
+	for (auto Pak : Paks)
+	{
+		if (PakFilter.IsEmpty() || Pak.PakFile->GetFilename().Contains(PakFilter))
+		{
+			for (FPakFile::FFileIterator It(*Pak.PakFile); It; ++It)
+			{
+				if (It.Info().CompressionMethod != COMPRESS_None)
+				{
+					CompressedFiles.Add(Pak.PakFile->GetMountPoint() + It.Filename());
+					CompressedSize += It.Info().Size;
+				}
+			}
+		}
+	}
+	if (CompressedFiles.Num() == 0)
+	{
+		Ar.Logf(TEXT("No compressed files found in the mounted paks."));
+		return;
+	}
+
+	TArray<uint8> Buffer;
+	Buffer.AddUninitialized(FMath::Max(ReadSizeKB, 1) * 1024);
+	const int32 SavedReadAheadBlocks = GPakReadAheadBlocks;
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		// Handles pick the setting up when they're opened.
+		GPakReadAheadBlocks = Pass == 0 ? 0 : ReadAheadBlocks;
+		int64 UncompressedSize = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (const FString& Filename : CompressedFiles)
+		{
+			TAutoPtr<IFileHandle> Handle(OpenRead(*Filename));
+			if (Handle.IsValid())
+			{
+				const int64 FileSize = Handle->Size();
+				for (int64 Offset = 0; Offset < FileSize; Offset += Buffer.Num())
+				{
+					Handle->Read(Buffer.GetData(), FMath::Min<int64>(Buffer.Num(), FileSize - Offset));
+				}
+				UncompressedSize += FileSize;
+			}
+		}
+		const double Seconds = FMath::Max(FPlatformTime::Seconds() - StartTime, 0.001);
+		Ar.Logf(TEXT("%d read-ahead blocks: %d files, %.1f MB compressed, %.1f MB uncompressed in %.2f s, %.1f MB/s compressed, %.1f MB/s uncompressed"),
+			GPakReadAheadBlocks, CompressedFiles.Num(), CompressedSize / (1024.0 * 1024.0), UncompressedSize / (1024.0 * 1024.0), Seconds,
+			CompressedSize / (1024.0 * 1024.0) / Seconds, UncompressedSize / (1024.0 * 1024.0) / Seconds);
+	}
+	GPakReadAheadBlocks = SavedReadAheadBlocks;
+}
 #endif // !UE_BUILD_SHIPPING
 
 FPakPlatformFile::FPakPlatformFile()
@@ -840,6 +1601,104 @@ IFileHandle* FPakPlatformFile::OpenRead(const TCHAR* Filename, bool bAllowWrite)
 	return Result;
 }
 
+IAsyncReadFileHandle* FPakPlatformFile::OpenAsyncRead(const TCHAR* Filename)
+{
+	IAsyncReadFileHandle* Result = NULL;
+	FPakFile* PakFile = NULL;
+	const FPakEntry* FileEntry = FindFileInPakFiles(Filename, &PakFile);
+	if (FileEntry != NULL)
+	{
+		if (FileEntry->CompressionMethod == COMPRESS_None && !FileEntry->bEncrypted && !PakFile->IsSigned())
+		{
+			// Stored entries are read straight from their range of the pak file.
+			// That skips signature checks, so signed paks always go through pak file handles.
+			const int64 DataOffset = FileEntry->Offset + FileEntry->GetSerializedSize(PakFile->GetInfo().Version);
+			Result = new FGenericAsyncReadFileHandle(LowerLevel, *PakFile->GetFilename(), DataOffset, FileEntry->Size);
+		}
+		else
+		{
+			// Compressed, encrypted and signed entries go through pak file handles, which decompress, decrypt and verify.
+			Result = IPlatformFile::OpenAsyncRead(Filename);
+		}
+	}
+#if !USING_SIGNED_CONTENT
+	else if (!bSigned)
+	{
+		// Default to wrapped file but only if we don't force use signed content
+		Result = LowerLevel->OpenAsyncRead(Filename);
+	}
+#endif
+	return Result;
+}
+
+/**
+ * Mapped handle to a stored pak entry, maps regions of the entry's range of the pak file.
+ */
+class FPakMappedFileHandle : public IMappedFileHandle
+{
+public:
+	FPakMappedFileHandle(IMappedFileHandle* InPakHandle, int64 InDataOffset, int64 InSize)
+		: IMappedFileHandle(InSize)
+		, PakHandle(InPakHandle)
+		, DataOffset(InDataOffset)
+	{
+	}
+
+	virtual bool IsMemoryMapped() const override
+	{
+		return PakHandle->IsMemoryMapped();
+	}
+
+	virtual IMappedFileRegion* MapRegion(int64 Offset, int64 BytesToMap) override
+	{
+		if (Offset < 0 || Offset >= GetFileSize() || BytesToMap <= 0)
+		{
+			return nullptr;
+		}
+		return PakHandle->MapRegion(DataOffset + Offset, FMath::Min(BytesToMap, GetFileSize() - Offset));
+	}
+
+private:
+	/** Mapped handle to the pak file. */
+	TUniquePtr<IMappedFileHandle> PakHandle;
+	/** Offset of the entry's data within the pak file. */
+	int64 DataOffset;
+};
+
+IMappedFileHandle* FPakPlatformFile::OpenMapped(const TCHAR* Filename)
+{
+	IMappedFileHandle* Result = NULL;
+	FPakFile* PakFile = NULL;
+	const FPakEntry* FileEntry = FindFileInPakFiles(Filename, &PakFile);
+	if (FileEntry != NULL)
+	{
+		if (FileEntry->CompressionMethod == COMPRESS_None && !FileEntry->bEncrypted && !PakFile->IsSigned())
+		{
+			// Stored entries are mapped straight from their range of the pak file.
+			// Mapped memory can't be verified, so signed paks always go through pak file handles.
+			IMappedFileHandle* PakHandle = LowerLevel->OpenMapped(*PakFile->GetFilename());
+			if (PakHandle)
+			{
+				const int64 DataOffset = FileEntry->Offset + FileEntry->GetSerializedSize(PakFile->GetInfo().Version);
+				Result = new FPakMappedFileHandle(PakHandle, DataOffset, FileEntry->Size);
+			}
+		}
+		else
+		{
+			// Compressed, encrypted and signed entries can't be mapped, their regions are read through pak file handles.
+			Result = IPlatformFile::OpenMapped(Filename);
+		}
+	}
+#if !USING_SIGNED_CONTENT
+	else if (!bSigned)
+	{
+		// Default to wrapped file but only if we don't force use signed content
+		Result = LowerLevel->OpenMapped(Filename);
+	}
+#endif
+	return Result;
+}
+
 bool FPakPlatformFile::BufferedCopyFile(IFileHandle& Dest, IFileHandle& Source, const int64 FileSize, uint8* Buffer, const int64 BufferSize) const
 {	
 	int64 RemainingSizeToCopy = FileSize;
@@ -245,6 +245,41 @@ struct FPakEntry
 /** Pak directory type. */
 typedef TMap<FString, FPakEntry*> FPakDirectory;
 
+/**
+ * Hashed path stored in the compact pak index.
+ */
+struct FPakPathHash
+{
+	/** Case insensitive hash of the path relative to the mount point. */
+	uint64 Hash;
+	/** Index of the file or directory with this path. */
+	int32 Index;
+
+	FORCEINLINE bool operator<(const FPakPathHash& Other) const
+	{
+		return Hash < Other.Hash;
+	}
+};
+
+/**
+ * Directory stored in the compact pak index.
+ */
+struct FPakCompactDirectory
+{
+	/** Index of the parent directory, INDEX_NONE for the mount point. */
+	int32 Parent;
+	/** Offset of the directory name (including the trailing '/') in the path table. */
+	int32 NameOffset;
+	/** Index of the first file in this directory, files are grouped by directory. */
+	int32 FirstFile;
+	/** Number of files in this directory. */
+	int32 NumFiles;
+	/** Index of the first sub-directory in the children list. */
+	int32 FirstChild;
+	/** Number of sub-directories. */
+	int32 NumChildren;
+};
+
 /**
  * Pak file.
  */
@@ -254,6 +289,8 @@ class PAKFILE_API FPakFile : FNoncopyable
 	FString PakFilename;
 	/** Archive to serialize the pak file from. */
 	TAutoPtr<class FChunkCacheWorker> Decryptor;
+	/** Lower level platform file the pak was opened with, NULL if it is opened through the file manager. */
+	IPlatformFile* ReaderLowerLevel;
 	/** Map of readers assigned to threads. */
 	TMap<uint32, TAutoPtr<FArchive>> ReaderMap;
 	/** Critical section for accessing ReaderMap. */
@@ -264,14 +301,30 @@ class PAKFILE_API FPakFile : FNoncopyable
 	FString MountPoint;
 	/** Info on all files stored in pak. */
 	TArray<FPakEntry> Files;	
-	/** Pak Index organized as a map of directories for faster Directory iteration. */
+	/** Pak Index organized as a map of directories for faster Directory iteration. Empty when the index is compact. */
 	TMap<FString, FPakDirectory> Index;
+	/** Sorted file path hashes of the compact index. */
+	TArray<FPakPathHash> FileHashes;
+	/** Sorted directory path hashes of the compact index. */
+	TArray<FPakPathHash> DirectoryHashes;
+	/** Directories of the compact index, the mount point comes first. */
+	TArray<FPakCompactDirectory> Directories;
+	/** Sub-directory indices of the compact index, grouped by parent. */
+	TArray<int32> DirectoryChildren;
+	/** Offset of each file name in the path table. */
+	TArray<int32> FileNameOffsets;
+	/** UTF-8 encoded, null terminated file and directory names of the compact index. */
+	TArray<ANSICHAR> PathTable;
 	/** Timestamp of this pak file. */
 	FDateTime Timestamp;	
+	/** Time spent loading the index, in seconds. */
+	double IndexLoadTime;
 	/** True if this is a signed pak file. */
 	bool bSigned;
 	/** True if this pak file is valid and usable. */
 	bool bIsValid;
+	/** True if the index is stored as path hashes and a path table instead of the directory map. */
+	bool bCompactIndex;
 
 	FArchive* CreatePakReader(const TCHAR* Filename);
 	FArchive* CreatePakReader(IFileHandle& InHandle, const TCHAR* Filename);
@@ -315,6 +368,14 @@ public:
 		return bIsValid;
 	}
 
+	/**
+	 * Checks if reads from this pak file are verified against its signatures.
+	 * Readers that bypass GetSharedReader must not be used for signed pak files.
+	 *
+	 * @return true if this pak file is signed.
+	 */
+	bool IsSigned() const;
+
 	/**
 	 * Gets pak filename.
 	 *
@@ -328,13 +389,50 @@ public:
 	/**
 	 * Gets pak file index.
 	 *
-	 * @return Pak index.
+	 * @return Pak index, empty if the index is compact.
 	 */
 	const TMap<FString, FPakDirectory>& GetIndex() const
 	{
 		return Index;
 	}
 
+	/**
+	 * Checks if the index is stored as path hashes and a path table instead of the directory map.
+	 *
+	 * @return true if the index is compact.
+	 */
+	bool IsCompactIndex() const
+	{
+		return bCompactIndex;
+	}
+
+	/**
+	 * Gets the number of files stored in this pak.
+	 *
+	 * @return Number of files.
+	 */
+	int32 GetNumFiles() const
+	{
+		return Files.Num();
+	}
+
+	/**
+	 * Gets the time spent loading the index when this pak file was opened.
+	 *
+	 * @return Index load time in seconds.
+	 */
+	double GetIndexLoadTime() const
+	{
+		return IndexLoadTime;
+	}
+
+	/**
+	 * Gets the memory used by the index.
+	 *
+	 * @return Allocated size in bytes.
+	 */
+	SIZE_T GetIndexAllocatedSize() const;
+
 	/**
 	 * Gets shared pak file archive for given thread.
 	 *
@@ -342,6 +440,28 @@ public:
 	 */
 	FArchive* GetSharedReader(IPlatformFile* LowerLevel);
 
+	/**
+	 * Checks if readers for other threads can be opened, which is not the case for pak files created from an archive.
+	 *
+	 * @return true if GetWorkerReader can be used.
+	 */
+	bool CanOpenWorkerReaders() const
+	{
+		return !PakFilename.IsEmpty();
+	}
+
+	/**
+	 * Gets the shared pak file archive of the calling thread, opened the same way as the pak file itself.
+	 * Used by worker threads reading on behalf of a file handle.
+	 *
+	 * @return Pointer to pak file archive used to read data from pak.
+	 */
+	FArchive* GetWorkerReader() const
+	{
+		// ReaderMap is guarded by CriticalSection, so handing out readers doesn't change the pak file itself
+		return const_cast<FPakFile*>(this)->GetSharedReader(ReaderLowerLevel);
+	}
+
 	/**
 	 * Finds an entry in the pak file matching the given filename.
 	 *
@@ -350,6 +470,10 @@ public:
 	 */
 	const FPakEntry* Find(const FString& Filename) const
 	{		
+		if (bCompactIndex)
+		{
+			return Filename.StartsWith(MountPoint) ? FindCompactFile(*Filename + MountPoint.Len(), Filename.Len() - MountPoint.Len()) : NULL;
+		}
 		const FPakEntry*const * FoundFile = NULL;
 		if (Filename.StartsWith(MountPoint))
 		{
@@ -364,6 +488,30 @@ public:
 		return FoundFile ? *FoundFile : NULL;
 	}
 
+	/**
+	 * Gets the filename an entry is stored under, relative to the mount point.
+	 *
+	 * @param Filename Full path the entry was found with.
+	 * @param Entry Entry returned by Find for this path.
+	 * @param OutFilename Filename with the case it was stored with.
+	 * @return true if the filename was found.
+	 */
+	bool GetStoredFilename(const FString& Filename, const FPakEntry* Entry, FString& OutFilename) const
+	{
+		if (bCompactIndex)
+		{
+			OutFilename = GetCompactFilename((int32)(Entry - Files.GetData()));
+			return true;
+		}
+		const FPakDirectory* PakDirectory = FindDirectory(*FPaths::GetPath(Filename));
+		const FString* StoredFilename = PakDirectory ? PakDirectory->FindKey(const_cast<FPakEntry*>(Entry)) : NULL;
+		if (StoredFilename)
+		{
+			OutFilename = *StoredFilename;
+		}
+		return StoredFilename != NULL;
+	}
+
 	/**
 	 * Sets the pak file mount point.
 	 *
@@ -406,6 +554,17 @@ public:
 		// pak files that are a subdirectory of the actual directory.
 		if ((Directory.StartsWith(MountPoint)) || (MountPoint.StartsWith(Directory)))
 		{
+			if (bCompactIndex)
+			{
+				TArray<FString> FilesInPak;
+				FindCompactFilesAtPath(FilesInPak, Directory, bIncludeFiles, bIncludeDirectories, bRecursive);
+				for (const FString& File : FilesInPak)
+				{
+					OutFiles.Add(File);
+				}
+				return;
+			}
+
 			TArray<FString> DirectoriesInPak; // List of all unique directories at path
 			for (TMap<FString, FPakDirectory>::TConstIterator It(Index); It; ++It)
 			{
@@ -458,7 +617,7 @@ public:
 	 * Finds a directory in pak file.
 	 *
 	 * @param InPath Directory path.
-	 * @return Pointer to a map with directory contents if the directory was found, NULL otherwise.
+	 * @return Pointer to a map with directory contents if the directory was found, NULL otherwise. Always NULL if the index is compact.
 	 */
 	const FPakDirectory* FindDirectory(const TCHAR* InPath) const
 	{
@@ -482,6 +641,12 @@ public:
 	 */
 	bool DirectoryExists(const TCHAR* InPath) const
 	{
+		if (bCompactIndex)
+		{
+			FString Directory(InPath);
+			MakeDirectoryFromPath(Directory);
+			return Directory.StartsWith(MountPoint) && FindCompactDirectory(*Directory + MountPoint.Len(), Directory.Len() - MountPoint.Len()) != INDEX_NONE;
+		}
 		return !!FindDirectory(InPath);
 	}
 
@@ -494,6 +659,10 @@ public:
 		TMap<FString, FPakDirectory>::TConstIterator IndexIt;
 		/** Directory iterator. */
 		FPakDirectory::TConstIterator DirectoryIt;
+		/** Current file when iterating a compact index. */
+		int32 FileIndex;
+		/** Filename of the current file when iterating a compact index. */
+		FString CompactFilename;
 
 	public:
 		/**
@@ -505,11 +674,25 @@ public:
 		:	PakFile(InPakFile)
 		, IndexIt(PakFile.GetIndex())
 		, DirectoryIt((IndexIt ? FPakDirectory::TConstIterator(IndexIt.Value()): FPakDirectory()))
+		, FileIndex(0)
 		{
+			if (PakFile.bCompactIndex && PakFile.Files.Num() > 0)
+			{
+				CompactFilename = PakFile.GetCompactFilename(0);
+			}
 		}
 
 		FFileIterator& operator++()		
 		{ 
+			if (PakFile.bCompactIndex)
+			{
+				// Files are stored in a flat array, names are rebuilt from the path table.
+				if (++FileIndex < PakFile.Files.Num())
+				{
+					CompactFilename = PakFile.GetCompactFilename(FileIndex);
+				}
+				return *this;
+			}
 			// Continue with the next file
 			++DirectoryIt;
 			while (!DirectoryIt && IndexIt)
@@ -531,7 +714,7 @@ public:
 		/** conversion to "bool" returning true if the iterator is valid. */
 		FORCEINLINE_EXPLICIT_OPERATOR_BOOL() const
 		{ 
-			return !!IndexIt; 
+			return PakFile.bCompactIndex ? FileIndex < PakFile.Files.Num() : !!IndexIt; 
 		}
 		/** inverse of the "bool" operator */
 		FORCEINLINE bool operator !() const
@@ -539,8 +722,8 @@ public:
 			return !(bool)*this;
 		}
 
-		const FString& Filename() const		{ return DirectoryIt.Key(); }
-		const FPakEntry& Info() const	{ return *DirectoryIt.Value(); }
+		const FString& Filename() const		{ return PakFile.bCompactIndex ? CompactFilename : DirectoryIt.Key(); }
+		const FPakEntry& Info() const	{ return PakFile.bCompactIndex ? PakFile.Files[FileIndex] : *DirectoryIt.Value(); }
 	};
 
 	/**
@@ -575,6 +758,34 @@ private:
 	 */
 	void LoadIndex(FArchive* Reader);
 
+	/**
+	 * Builds the compact index from the serialized entries.
+	 *
+	 * @param IndexData Serialized index.
+	 * @param IndexReader Reader positioned at the first entry.
+	 * @param NumEntries Number of entries in the index.
+	 * @return false if two paths have the same hash, in which case the directory map has to be used.
+	 */
+	bool LoadCompactIndex(const TArray<uint8>& IndexData, FArchive& IndexReader, int32 NumEntries);
+
+	/** Finds a file in the compact index given its path relative to the mount point. */
+	const FPakEntry* FindCompactFile(const TCHAR* RelativeFilename, int32 Len) const;
+
+	/** Finds a directory in the compact index given its path relative to the mount point, including the trailing '/'. */
+	int32 FindCompactDirectory(const TCHAR* RelativePath, int32 Len) const;
+
+	/** Rebuilds the path of a compact index directory, relative to the mount point. */
+	FString GetCompactDirectoryPath(int32 DirectoryIndex) const;
+
+	/** Rebuilds the filename of a compact index file, relative to the mount point. */
+	FString GetCompactFilename(int32 FileIndex) const;
+
+	/** Compact index version of FindFilesAtPath. */
+	void FindCompactFilesAtPath(TArray<FString>& OutFiles, const FString& Directory, bool bIncludeFiles, bool bIncludeDirectories, bool bRecursive) const;
+
+	/** Adds the files and sub-directories of a compact index directory, recursively. */
+	void AddCompactDirectoryContents(TArray<FString>& OutFiles, TArray<FString>& OutDirectories, int32 DirectoryIndex, const FString& DirectoryPath, bool bIncludeFiles, bool bIncludeDirectories) const;
+
 public:
 
 	/**
@@ -1121,15 +1332,10 @@ public:
 		auto FileEntry = FindFileInPakFiles(Filename, &PakFile);
 		if (FileEntry)
 		{
-			const FString Path(FPaths::GetPath(Filename));
-			const FPakDirectory* PakDirectory = PakFile->FindDirectory(*Path);
-			if (PakDirectory != nullptr)
+			FString RealFilename;
+			if (PakFile->GetStoredFilename(Filename, FileEntry, RealFilename))
 			{
-				const FString* RealFilename = PakDirectory->FindKey(const_cast<FPakEntry*>(FileEntry));
-				if (RealFilename != nullptr)
-				{
-					return *RealFilename;
-				}
+				return RealFilename;
 			}
 		}
 
@@ -1139,6 +1345,10 @@ public:
 
 	virtual IFileHandle* OpenRead(const TCHAR* Filename, bool bAllowWrite = false) override;
 
+	virtual IAsyncReadFileHandle* OpenAsyncRead(const TCHAR* Filename) override;
+
+	virtual IMappedFileHandle* OpenMapped(const TCHAR* Filename) override;
+
 	virtual IFileHandle* OpenWrite(const TCHAR* Filename, bool bAppend = false, bool bAllowRead = false) override
 	{
 		// No modifications allowed on pak files.
@@ -1509,6 +1719,8 @@ public:
 	void HandlePakListCommand(const TCHAR* Cmd, FOutputDevice& Ar);
 	void HandleMountCommand(const TCHAR* Cmd, FOutputDevice& Ar);
 	void HandleUnmountCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	void HandlePakIndexStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	void HandlePakReadBenchmarkCommand(const TCHAR* Cmd, FOutputDevice& Ar);
 #endif
 	// END Console commands
 };
@@ -396,6 +396,26 @@ public:
 		return LowerLevel->OpenWrite( *ConvertToSandboxPath( Filename ), bAppend, bAllowRead );
 	}
 
+	virtual IAsyncReadFileHandle*	OpenAsyncRead(const TCHAR* Filename) override
+	{
+		IAsyncReadFileHandle* Result = LowerLevel->OpenAsyncRead( *ConvertToSandboxPath(Filename) );
+		if( !Result && OkForInnerAccess(Filename) )
+		{
+			Result = LowerLevel->OpenAsyncRead( Filename );
+		}
+		return Result;
+	}
+
+	virtual IMappedFileHandle*	OpenMapped(const TCHAR* Filename) override
+	{
+		IMappedFileHandle* Result = LowerLevel->OpenMapped( *ConvertToSandboxPath(Filename) );
+		if( !Result && OkForInnerAccess(Filename) )
+		{
+			Result = LowerLevel->OpenMapped( Filename );
+		}
+		return Result;
+	}
+
 	virtual bool		DirectoryExists(const TCHAR* Directory) override
 	{
 		bool Result = LowerLevel->DirectoryExists( *ConvertToSandboxPath( Directory ) );